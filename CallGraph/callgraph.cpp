@@ -25,6 +25,7 @@
 
 #include "callgraph.h"
 
+#include "callgrindparser.h"
 #include "fileutils.h"
 #include "macromanager.h"
 #include "uicallgraphpanel.h"
@@ -97,6 +98,8 @@ CallGraph::CallGraph(IManager* manager)
 
     m_mgr->GetTheApp()->Connect(XRCID("cg_show_callgraph"), wxEVT_COMMAND_TOOL_CLICKED,
                                 wxCommandEventHandler(CallGraph::OnShowCallGraph), NULL, this);
+    m_mgr->GetTheApp()->Connect(XRCID("cg_import_callgrind"), wxEVT_COMMAND_MENU_SELECTED,
+                                wxCommandEventHandler(CallGraph::OnImportCallgrind), NULL, this);
 }
 
 //---- DTOR -------------------------------------------------------------------
@@ -110,6 +113,8 @@ CallGraph::~CallGraph()
 
     m_mgr->GetTheApp()->Disconnect(XRCID("cg_show_callgraph"), wxEVT_COMMAND_TOOL_CLICKED,
                                    wxCommandEventHandler(CallGraph::OnShowCallGraph), NULL, this);
+    m_mgr->GetTheApp()->Disconnect(XRCID("cg_import_callgrind"), wxEVT_COMMAND_MENU_SELECTED,
+                                   wxCommandEventHandler(CallGraph::OnImportCallgrind), NULL, this);
 }
 
 //-----------------------------------------------------------------------------
@@ -125,6 +130,9 @@ void CallGraph::CreatePluginMenu(wxMenu* pluginsMenu)
     item = new wxMenuItem(menu, XRCID("cg_show_callgraph"), _("Show call graph"),
                           _("Show call graph for selected/active project"), wxITEM_NORMAL);
     menu->Append(item);
+    item = new wxMenuItem(menu, XRCID("cg_import_callgrind"), _("Import callgrind profile..."),
+                          _("Show call graph of a profile created by 'valgrind --tool=callgrind'"), wxITEM_NORMAL);
+    menu->Append(item);
     menu->AppendSeparator();
     item = new wxMenuItem(menu, XRCID("cg_settings"), _("Settings..."), wxEmptyString, wxITEM_NORMAL);
     menu->Append(item);
@@ -355,6 +363,47 @@ void CallGraph::OnShowCallGraph(wxCommandEvent& event)
 
     delete proc;
 
+    ShowCallGraph(&(pgp.lines), pgp.GetSuggestedNodeThreshold(), base_path, wxT("s"));
+}
+
+//---- Import callgrind profile ------------------------------------------------
+
+void CallGraph::OnImportCallgrind(wxCommandEvent& event)
+{
+    if(!wxFileExists(GetDotPath()))
+        return MessageBox(_T("Failed to locate required tool (dot). Please check the plugin settings."),
+                          wxICON_ERROR);
+
+    wxString base_path;
+    if(clCxxWorkspaceST::Get()->IsOpen()) base_path = clCxxWorkspaceST::Get()->GetWorkspaceFileName().GetPath();
+
+    wxString profile_fn = wxFileSelector(_("Please select the callgrind profile"), base_path, "", "",
+                                         wxT("callgrind profiles (callgrind.out.*)|callgrind.out.*|all files|*"),
+                                         wxFD_OPEN | wxFD_FILE_MUST_EXIST);
+    if(profile_fn.IsEmpty()) return;
+
+    // without workspace the call graph files are created next to the profile
+    if(base_path.IsEmpty()) base_path = wxFileName(profile_fn).GetPath();
+
+    CallgrindParser parser;
+    {
+        wxBusyCursor busy;
+        if(!parser.Parse(profile_fn))
+            return MessageBox(_("Failed to read the callgrind profile ") + profile_fn, wxICON_ERROR);
+    }
+
+    if(parser.lines.IsEmpty()) return MessageBox(_("The callgrind profile contains no costs."), wxICON_INFORMATION);
+
+    ShowCallGraph(&(parser.lines), parser.GetSuggestedNodeThreshold(), base_path, parser.GetCostUnit());
+}
+
+//---- Write DOT file and show the call graph ----------------------------------
+
+void CallGraph::ShowCallGraph(LineParserList* lines, int suggestedThreshold, const wxString& base_path,
+                              const wxString& costUnit)
+{
+    IConfigTool* config_tool = m_mgr->GetConfigTool();
+
     ConfCallGraph conf;
 
     config_tool->ReadObject(wxT("CallGraph"), &conf);
@@ -362,9 +411,8 @@ void CallGraph::OnShowCallGraph(wxCommandEvent& event)
     DotWriter dotWriter;
 
     // DotWriter
-    dotWriter.SetLineParser(&(pgp.lines));
-
-    int suggestedThreshold = pgp.GetSuggestedNodeThreshold();
+    dotWriter.SetLineParser(lines);
+    dotWriter.SetCostUnit(costUnit);
 
     if(suggestedThreshold <= conf.GetTresholdNode()) {
         suggestedThreshold = conf.GetTresholdNode();
@@ -386,7 +434,7 @@ void CallGraph::OnShowCallGraph(wxCommandEvent& event)
     dotWriter.WriteToDotLanguage();
 
     // build output dir
-    cfn.Assign(base_path, "");
+    wxFileName cfn(base_path, "");
     cfn.AppendDir(CALLGRAPH_DIR);
     cfn.Normalize();
 
@@ -416,7 +464,7 @@ void CallGraph::OnShowCallGraph(wxCommandEvent& event)
 
     // show image and create table in the editor tab page
     uicallgraphpanel* panel = new uicallgraphpanel(m_mgr->GetEditorPaneNotebook(), m_mgr, output_png_fn, base_path,
-                                                   suggestedThreshold, &(pgp.lines));
+                                                   suggestedThreshold, lines, costUnit);
 
     wxString tstamp = wxDateTime::Now().Format(wxT(" %Y-%m-%d %H:%M:%S"));
 
@@ -109,6 +109,20 @@ protected:
      * @param event Reference to event class
      */
     void OnShowCallGraph(wxCommandEvent& event);
+    /**
+     * @brief Function reads profile created by valgrind's callgrind tool and shows its call graph.
+     * @param event Reference to event class
+     */
+    void OnImportCallgrind(wxCommandEvent& event);
+    /**
+     * @brief Function writes the call graph in DOT language, runs dot and shows the picture in new tab page.
+     * @param lines parsed profile
+     * @param suggestedThreshold node threshold suggested by the parser, -1 if none
+     * @param base_path directory where the CallGraph folder with output files is created
+     * @param costUnit unit of the self/children costs in lines
+     */
+    void ShowCallGraph(LineParserList* lines, int suggestedThreshold, const wxString& base_path,
+                       const wxString& costUnit);
     /**
      * @brief Handle function to open dialog with settings for Call graph plugin.
      * @param event Reference to event class
@@ -0,0 +1,311 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// copyright            : (C) 2014 Eran Ifrah
+// file name            : callgrindparser.cpp
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "callgrindparser.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <wx/ffile.h>
+#include <wx/math.h>
+
+namespace
+{
+// functions cheaper than this (inclusive cost, in percent of the total cost) are not passed to DotWriter
+constexpr double PRUNE_PERCENT = 0.1;
+// and never more than this number of functions, dot can't layout much bigger graphs in reasonable time
+constexpr size_t PRUNE_MAX_FUNCTIONS = 1000;
+constexpr size_t SUGGESTED_MAX_NODES = 100;
+constexpr double COST_SCALE = 1000000.0; // costs in lines are in millions of events
+constexpr size_t READ_CHUNK_SIZE = 1024 * 1024;
+
+bool StartsWith(const char* line, size_t len, const char* prefix, size_t& prefixLen)
+{
+    prefixLen = strlen(prefix);
+    return len >= prefixLen && memcmp(line, prefix, prefixLen) == 0;
+}
+
+const char* SkipSpaces(const char* p, const char* end)
+{
+    while(p < end && (*p == ' ' || *p == '\t'))
+        ++p;
+    return p;
+}
+
+const char* SkipToken(const char* p, const char* end)
+{
+    while(p < end && *p != ' ' && *p != '\t')
+        ++p;
+    return p;
+}
+} // namespace
+
+bool CallgrindParser::Parse(const wxString& fileName)
+{
+    lines.DeleteContents(true);
+    lines.Clear();
+    m_functions.clear();
+    m_functionsByName.clear();
+    m_compressedFunctions.clear();
+    m_lineFunctions.clear();
+    m_eventName.Clear();
+    m_totalCost = 0;
+    m_positionsCount = 1;
+    m_currentFunction = -1;
+    m_calledFunction = -1;
+    m_callCount = -1;
+    m_skipCostLine = false;
+    m_valid = false;
+
+    wxFFile file(fileName, "rb");
+    if(!file.IsOpened()) return false;
+
+    std::vector<char> buffer(READ_CHUNK_SIZE);
+    std::string pending; // incomplete line from the previous chunk
+    while(!file.Eof()) {
+        size_t count = file.Read(buffer.data(), buffer.size());
+        if(count == 0) break;
+
+        const char* start = buffer.data();
+        const char* end = start + count;
+        while(start < end) {
+            const char* eol = (const char*)memchr(start, '\n', end - start);
+            if(!eol) {
+                pending.append(start, end - start);
+                break;
+            }
+            const char* line = start;
+            size_t len = eol - start;
+            if(!pending.empty()) {
+                pending.append(start, len);
+                line = pending.c_str();
+                len = pending.size();
+            }
+            if(len && line[len - 1] == '\r') --len;
+            ParseLine(line, len);
+            pending.clear();
+            start = eol + 1;
+        }
+    }
+    if(!pending.empty()) ParseLine(pending.c_str(), pending.size());
+
+    if(!m_valid) return false;
+
+    ComputeInclusiveCosts();
+    CreateLines();
+    return true;
+}
+
+void CallgrindParser::ParseLine(const char* line, size_t len)
+{
+    if(len == 0 || line[0] == '#') return;
+
+    const char* end = line + len;
+    size_t prefixLen = 0;
+    char c = line[0];
+    if((c >= '0' && c <= '9') || c == '+' || c == '-' || c == '*') {
+        if(m_skipCostLine) {
+            m_skipCostLine = false;
+            return;
+        }
+
+        // skip positions (line and/or instruction address), the first event is the cost we show
+        const char* p = SkipSpaces(line, end);
+        for(size_t i = 0; i < m_positionsCount && p < end; ++i)
+            p = SkipSpaces(SkipToken(p, end), end);
+        long long cost = p < end ? strtoll(p, NULL, 10) : 0;
+
+        if(m_callCount != -1) {
+            if(m_currentFunction != -1 && m_calledFunction != -1) {
+                Call& call = m_functions[m_currentFunction].calls[m_calledFunction];
+                call.count += m_callCount;
+                call.inclusive += cost;
+                m_functions[m_calledFunction].called += m_callCount;
+            }
+            m_callCount = -1;
+        } else if(m_currentFunction != -1) {
+            m_functions[m_currentFunction].self += cost;
+        }
+
+    } else if(StartsWith(line, len, "fn=", prefixLen)) {
+        m_currentFunction = GetFunction(line + prefixLen, len - prefixLen);
+        m_callCount = -1;
+
+    } else if(StartsWith(line, len, "cfn=", prefixLen) || StartsWith(line, len, "cfunc=", prefixLen)) {
+        m_calledFunction = GetFunction(line + prefixLen, len - prefixLen);
+
+    } else if(StartsWith(line, len, "calls=", prefixLen)) {
+        m_callCount = strtoll(line + prefixLen, NULL, 10);
+
+    } else if(StartsWith(line, len, "jump=", prefixLen) || StartsWith(line, len, "jcnd=", prefixLen)) {
+        m_skipCostLine = true;
+
+    } else if(StartsWith(line, len, "events:", prefixLen)) {
+        const char* p = SkipSpaces(line + prefixLen, end);
+        m_eventName = wxString::FromUTF8(p, SkipToken(p, end) - p);
+        m_valid = true;
+
+    } else if(StartsWith(line, len, "positions:", prefixLen)) {
+        m_positionsCount = 0;
+        const char* p = SkipSpaces(line + prefixLen, end);
+        while(p < end) {
+            ++m_positionsCount;
+            p = SkipSpaces(SkipToken(p, end), end);
+        }
+        if(m_positionsCount == 0) m_positionsCount = 1;
+
+    } else if(StartsWith(line, len, "summary:", prefixLen) || StartsWith(line, len, "totals:", prefixLen)) {
+        m_totalCost = std::max(m_totalCost, strtoll(line + prefixLen, NULL, 10));
+    }
+    // file and object names (fl=, fi=, fe=, ob=, ...) are not needed for the call graph
+}
+
+int CallgrindParser::GetFunction(const char* spec, size_t len)
+{
+    const char* end = spec + len;
+    long id = -1;
+    if(len && spec[0] == '(') {
+        // name compression: "(id) name" defines the id, "(id)" refers to it
+        char* close = NULL;
+        id = strtol(spec + 1, &close, 10);
+        if(!close || close >= end || *close != ')') return -1;
+        spec = SkipSpaces(close + 1, end);
+        if(spec == end) {
+            auto iter = m_compressedFunctions.find(id);
+            return iter == m_compressedFunctions.end() ? -1 : iter->second;
+        }
+    }
+
+    std::string name(spec, end - spec);
+    int index;
+    auto iter = m_functionsByName.find(name);
+    if(iter == m_functionsByName.end()) {
+        index = (int)m_functions.size();
+        m_functions.emplace_back();
+        m_functions.back().name = wxString::FromUTF8(name.c_str(), name.size());
+        m_functionsByName.insert({ std::move(name), index });
+    } else {
+        index = iter->second;
+    }
+
+    if(id != -1) m_compressedFunctions[id] = index;
+    return index;
+}
+
+void CallgrindParser::ComputeInclusiveCosts()
+{
+    long long totalSelf = 0;
+    for(size_t i = 0; i < m_functions.size(); ++i) {
+        Function& function = m_functions[i];
+        function.inclusive = function.self;
+        for(const auto& call : function.calls) {
+            // recursive calls are already included in the cost of the outer call
+            if(call.first != (int)i) function.inclusive += call.second.inclusive;
+        }
+        totalSelf += function.self;
+    }
+
+    if(m_totalCost == 0) m_totalCost = totalSelf;
+}
+
+void CallgrindParser::CreateLines()
+{
+    if(m_totalCost <= 0) return;
+
+    // prune: keep the most expensive functions only
+    long long minCost = (long long)(m_totalCost * PRUNE_PERCENT / 100.0);
+    for(size_t i = 0; i < m_functions.size(); ++i) {
+        if(m_functions[i].inclusive >= minCost && m_functions[i].inclusive > 0) m_lineFunctions.push_back(i);
+    }
+
+    auto byCost = [this](int a, int b) { return m_functions[a].inclusive > m_functions[b].inclusive; };
+    if(m_lineFunctions.size() > PRUNE_MAX_FUNCTIONS) {
+        std::nth_element(m_lineFunctions.begin(), m_lineFunctions.begin() + PRUNE_MAX_FUNCTIONS,
+                         m_lineFunctions.end(), byCost);
+        m_lineFunctions.resize(PRUNE_MAX_FUNCTIONS);
+    }
+    std::sort(m_lineFunctions.begin(), m_lineFunctions.end(), byCost);
+
+    // node index used by DotWriter for each kept function
+    std::unordered_map<int, int> nodeIndex;
+    for(size_t i = 0; i < m_lineFunctions.size(); ++i)
+        nodeIndex[m_lineFunctions[i]] = i + 1;
+
+    for(int functionIndex : m_lineFunctions) {
+        const Function& function = m_functions[functionIndex];
+        int index = nodeIndex[functionIndex];
+
+        LineParser* line = new LineParser();
+        line->index = index;
+        line->time = std::min(100.0, function.inclusive * 100.0 / m_totalCost);
+        line->self = function.self / COST_SCALE;
+        line->children = (function.inclusive - function.self) / COST_SCALE;
+        line->called0 = function.called ? (int)function.called : -1;
+        line->called1 = -1;
+        line->name = function.name;
+        line->nameid = index;
+        line->parents = false;
+        line->pline = true;
+        line->child = false;
+        line->cycle = false;
+        line->recursive = function.calls.count(functionIndex) > 0;
+        line->cycleid = -1;
+        lines.Append(line);
+
+        for(const auto& call : function.calls) {
+            auto callee = nodeIndex.find(call.first);
+            if(call.first == functionIndex || callee == nodeIndex.end()) continue;
+
+            LineParser* child = new LineParser();
+            child->index = -1;
+            child->time = -1;
+            child->self = call.second.inclusive / COST_SCALE;
+            child->children = 0;
+            child->called0 = (int)call.second.count;
+            child->called1 = -1;
+            child->name = m_functions[call.first].name;
+            child->nameid = callee->second;
+            child->parents = false;
+            child->pline = false;
+            child->child = true;
+            child->cycle = false;
+            child->recursive = false;
+            child->cycleid = -1;
+            lines.Append(child);
+        }
+    }
+}
+
+int CallgrindParser::GetSuggestedNodeThreshold() const
+{
+    if(m_lineFunctions.size() <= SUGGESTED_MAX_NODES || m_totalCost <= 0) return -1;
+
+    // functions are sorted by cost, use the cost of the last one that fits
+    const Function& last = m_functions[m_lineFunctions[SUGGESTED_MAX_NODES - 1]];
+    int threshold = wxRound(last.inclusive * 100.0 / m_totalCost);
+    return std::min(100, std::max(0, threshold));
+}
+
+wxString CallgrindParser::GetCostUnit() const { return wxString::Format(" M%s", m_eventName); }
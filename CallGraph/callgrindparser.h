@@ -0,0 +1,111 @@
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//
+// copyright            : (C) 2014 Eran Ifrah
+// file name            : callgrindparser.h
+//
+// -------------------------------------------------------------------------
+// A
+//              _____           _      _     _ _
+//             /  __ \         | |    | |   (_) |
+//             | /  \/ ___   __| | ___| |    _| |_ ___
+//             | |    / _ \ / _  |/ _ \ |   | | __/ _ )
+//             | \__/\ (_) | (_| |  __/ |___| | ||  __/
+//              \____/\___/ \__,_|\___\_____/_|\__\___|
+//
+//                                                  F i l e
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _CALLGRINDPARSER_H__
+#define _CALLGRINDPARSER_H__
+
+#include "lineparser.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <wx/string.h>
+
+/**
+ * @class CallgrindParser
+ * @brief Reads profile written by 'valgrind --tool=callgrind' and builds call graph with inclusive and exclusive
+ * costs of every function.
+ *
+ * Functions and calls are indexed by hash maps, so even profiles with hundreds of thousands of functions are read in
+ * linear time. Only the most expensive functions are converted to the LineParserList used by DotWriter and the call
+ * graph panel.
+ */
+class CallgrindParser
+{
+public:
+    struct Call {
+        long long count = 0;
+        long long inclusive = 0; ///< cost of the callee spent on behalf of the caller
+    };
+
+    struct Function {
+        wxString name;
+        long long self = 0;
+        long long inclusive = 0;
+        long long called = 0;
+        std::unordered_map<int, Call> calls; ///< callee index -> call
+    };
+
+    CallgrindParser() = default;
+    ~CallgrindParser() = default;
+
+    /**
+     * @brief  List lines type LineParserList, filled by Parse().
+     */
+    LineParserList lines;
+
+    /**
+     * @brief Read callgrind output file, build the call graph and fill 'lines' with the most expensive functions.
+     * @param fileName callgrind output (callgrind.out.<pid>)
+     * @return false if the file can't be read or is not a callgrind profile
+     */
+    bool Parse(const wxString& fileName);
+
+    /**
+     * @brief Suggest call diagram's node threshold so no more than 100 items should be displayed at once.
+     */
+    int GetSuggestedNodeThreshold() const;
+
+    /**
+     * @brief Unit of self and children costs stored in lines, e.g. " MIr" for millions of instructions.
+     */
+    wxString GetCostUnit() const;
+
+    const std::vector<Function>& GetFunctions() const { return m_functions; }
+    long long GetTotalCost() const { return m_totalCost; }
+
+protected:
+    void ParseLine(const char* line, size_t len);
+    int GetFunction(const char* spec, size_t len);
+    void ComputeInclusiveCosts();
+    void CreateLines();
+
+private:
+    std::vector<Function> m_functions;
+    std::unordered_map<std::string, int> m_functionsByName;
+    std::unordered_map<long, int> m_compressedFunctions; ///< "fn=(id)" -> function index
+    std::vector<int> m_lineFunctions;                     ///< functions converted to 'lines', by inclusive cost
+
+    wxString m_eventName;
+    long long m_totalCost = 0;
+    size_t m_positionsCount = 1;
+    int m_currentFunction = -1;
+    int m_calledFunction = -1;
+    long long m_callCount = -1; ///< != -1 if the next cost line is the inclusive cost of a call
+    bool m_skipCostLine = false; ///< next line is the target of a jump, not a cost
+    bool m_valid = false;
+};
+
+#endif // _CALLGRINDPARSER_H__
@@ -55,6 +55,7 @@ DotWriter::DotWriter()
     dwhideparams = false;
     dwhidenamespaces = false;
     dwstripparams = false;
+    dwcostunit = wxT("s");
 }
 
 void DotWriter::SetLineParser(LineParserList* pLines) //, int numOfLines)
@@ -96,7 +97,7 @@ void DotWriter::WriteToDotLanguage()
     int pl_index = 0;
     float pl_time = 0;
     bool is_node = false;
-    wxArrayInt index_pl_nodes;
+    std::unordered_set<int> index_pl_nodes;
 
     if(mlines == NULL) return;
 
@@ -118,7 +119,7 @@ void DotWriter::WriteToDotLanguage()
 
         if(line->pline && wxRound(line->time) >= dwtn) {
             is_node = true;
-            index_pl_nodes.Add(line->index);
+            index_pl_nodes.insert(line->index);
             dlabel = wxString::Format(wxT("%i"), line->index);
             dlabel += wxT(" [label=\"");
             dlabel += OptionsShortNameAndParameters(line->name);
@@ -131,7 +132,7 @@ void DotWriter::WriteToDotLanguage()
             //	dlabel += wxString::Format(wxT("%.2f"), line->self);
             // else
             dlabel += wxString::Format(wxT("%.2f"), line->self + line->children);
-            dlabel += wxT("s)");
+            dlabel += dwcostunit + wxT(")");
             dlabel += wxT("\\n");
             if(line->called0 != -1) dlabel += wxString::Format(wxT("%i"), line->called0) + wxT("x");
             // if(line->recursive)
@@ -164,7 +165,7 @@ void DotWriter::WriteToDotLanguage()
             pl_time = line->time;   // time for primary node
         }
 
-        if(line->child && IsInArray(line->nameid, index_pl_nodes) && IsInArray(pl_index, index_pl_nodes) &&
+        if(line->child && index_pl_nodes.count(line->nameid) && index_pl_nodes.count(pl_index) &&
            (wxRound(pl_time) >= dwte)) {
             dedge = wxString::Format(wxT("%i"), pl_index);
             dedge += wxT(" -> ");
@@ -325,14 +326,6 @@ wxString DotWriter::DefineColorForNodeEdge(int index)
     return colors[index];
 }
 
-bool DotWriter::IsInArray(int index, const wxArrayInt& arr)
-{
-    for(unsigned int i = 0; i < arr.GetCount(); i++) {
-        if(arr.Item(i) == index) return true;
-    }
-    return false;
-}
-
 wxString DotWriter::DefineColorForLabel(int index)
 {
     if((index < 3) || (index > 6)) {
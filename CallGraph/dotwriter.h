@@ -43,6 +43,7 @@
 #include <wx/dir.h> 
 #include <wx/filefn.h>
 #include <wx/file.h>
+#include <unordered_set>
 /**
  * @class DotWriter
  * @brief Class write data from lineparser structure to dot language.
@@ -60,6 +61,7 @@ private:
 	bool dwhideparams;
 	bool dwstripparams;
 	bool dwhidenamespaces;
+	wxString dwcostunit;
 	int dwcn;
 	int dwce;
 	int dwtn;
@@ -111,6 +113,11 @@ public:
 	 * @param hidenamespaces
 	 */
 	void SetDotWriterFromDetails(int colnode, int coledge, int thrnode, int thredge, bool hideparams, bool stripparams, bool hidenamespaces);
+	/**
+	 * @brief Function sets unit of the self and children costs shown in the nodes, seconds by default.
+	 * @param unit
+	 */
+	void SetCostUnit(const wxString& unit) { dwcostunit = unit; }
 	//
 	/**
 	 * @brief Function create data in the DOT language and prepare it to write.
@@ -137,12 +144,6 @@ public:
 	 * @param index of the color, this value return function ReturnIndexForColor.
 	 */
 	wxString DefineColorForLabel(int index);
-	/**
-	 * @brief Function return bool value if index exists in the array.
-	 * @param index of the function stored in the list of objects.
-	 * @param array of index by nodes added to the call graph.
-	 */
-	bool IsInArray(int index, const wxArrayInt& array);
 	/**
 	 * @brief Function return optimal index for color by the value time and options in the dialog settings of the plugin.
 	 * @param time of the function stored in the list of objects.
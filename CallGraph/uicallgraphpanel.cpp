@@ -34,14 +34,19 @@
 #include <wx/xrc/xmlres.h>
 
 uicallgraphpanel::uicallgraphpanel(wxWindow* parent, IManager* mgr, const wxString& imagepath,
-                                   const wxString& projectpath, int suggestedThreshold, LineParserList* pLines)
+                                   const wxString& projectpath, int suggestedThreshold, LineParserList* pLines,
+                                   const wxString& costUnit)
     : uicallgraph(parent)
 {
     m_mgr = mgr;
     m_pathimage = imagepath;
     m_pathproject = projectpath;
+    m_costUnit = costUnit;
     m_scale = 1;
 
+    if(m_costUnit != wxT("s"))
+        m_grid->SetColLabelValue(2, wxString::Format(_(" Cost [%s]"), m_costUnit.Strip(wxString::both)));
+
     m_scrolledWindow->SetBackgroundColour(wxColour(255, 255, 255));
     m_scrolledWindow->SetBackgroundStyle(wxBG_STYLE_PAINT);
 
@@ -138,6 +143,7 @@ void uicallgraphpanel::OnRefreshClick(wxCommandEvent& event)
     // write to output png file
     DotWriter dw;
     dw.SetLineParser(&m_lines);
+    dw.SetCostUnit(m_costUnit);
     dw.SetDotWriterFromDetails(confData.GetColorsNode(), confData.GetColorsEdge(), m_spinNT->GetValue(),
                                m_spinET->GetValue(), m_checkBoxHP->GetValue(), confData.GetStripParams(),
                                m_checkBoxHN->GetValue());
@@ -46,7 +46,7 @@ class uicallgraphpanel : public uicallgraph
 {
 
 public:
-	uicallgraphpanel(wxWindow *parent, IManager *mgr, const wxString& imagepath, const wxString& projectpath, int suggestedThreshold, LineParserList *pLines);
+	uicallgraphpanel(wxWindow *parent, IManager *mgr, const wxString& imagepath, const wxString& projectpath, int suggestedThreshold, LineParserList *pLines, const wxString& costUnit = wxT("s"));
 	virtual ~uicallgraphpanel();
 
 protected:
@@ -71,6 +71,7 @@ protected:
 	IManager *m_mgr;
 	wxString m_pathimage;
 	wxString m_pathproject;
+	wxString m_costUnit; // unit of self/children costs in m_lines
 	LineParserList m_lines;
 	ConfCallGraph confData; // stored configuration data
 	wxPoint m_viewPortOrigin;
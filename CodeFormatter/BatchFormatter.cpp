@@ -0,0 +1,284 @@
+#include "BatchFormatter.hpp"
+
+#include "CodeFormatterManager.hpp"
+#include "event_notifier.h"
+#include "file_logger.h"
+#include "fileutils.h"
+#include "globals.h"
+#include "imanager.h"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <wx/ffile.h>
+#include <wx/progdlg.h>
+
+namespace
+{
+size_t hash_combine(size_t seed, size_t value) { return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2)); }
+
+/// a formatter command change (e.g. new options) must not be hidden by the cache
+size_t get_formatter_hash(const GenericFormatter& formatter)
+{
+    std::hash<wxString> hasher;
+    size_t hash = hasher(formatter.GetName());
+    hash = hash_combine(hash, hasher(formatter.GetCommandAsString()));
+    hash = hash_combine(hash, hasher(formatter.GetWorkingDirectory()));
+    return hash;
+}
+
+/// hash the raw bytes of the file. Safe to call from a secondary thread
+bool get_file_hash(const wxString& filepath, size_t formatter_hash, size_t* hash)
+{
+    wxFFile fp;
+    if (!wxFileExists(filepath) || !fp.Open(filepath, "rb")) {
+        return false;
+    }
+
+    std::string content;
+    content.resize(fp.Length());
+    if (!content.empty() && fp.Read(content.data(), content.size()) != content.size()) {
+        return false;
+    }
+    *hash = hash_combine(formatter_hash, std::hash<std::string>{}(content));
+    return true;
+}
+} // namespace
+
+BatchFormatter::BatchFormatter(CodeFormatterManager& manager, wxEvtHandler* owner)
+    : m_manager(manager)
+    , m_owner(owner)
+{
+    Bind(wxEVT_FORMAT_COMPELTED, &BatchFormatter::OnFormatCompleted, this);
+    Bind(wxEVT_FORMAT_INPLACE_COMPELTED, &BatchFormatter::OnInplaceFormatCompleted, this);
+    Bind(wxEVT_FORMAT_FAILED, &BatchFormatter::OnFormatFailed, this);
+}
+
+BatchFormatter::~BatchFormatter()
+{
+    // the scan thread posts its result to us
+    m_scanCancelled = true;
+    if (m_scanThread.joinable()) {
+        m_scanThread.join();
+    }
+
+    Unbind(wxEVT_FORMAT_COMPELTED, &BatchFormatter::OnFormatCompleted, this);
+    Unbind(wxEVT_FORMAT_INPLACE_COMPELTED, &BatchFormatter::OnInplaceFormatCompleted, this);
+    Unbind(wxEVT_FORMAT_FAILED, &BatchFormatter::OnFormatFailed, this);
+    if (m_progress) {
+        m_progress->Destroy();
+    }
+}
+
+size_t BatchFormatter::GetMaxJobs() { return std::max(1u, std::thread::hardware_concurrency()); }
+
+bool BatchFormatter::Start(const std::vector<wxString>& files, bool silent)
+{
+    if (m_running) {
+        return false;
+    }
+
+    m_running = true;
+    m_cancelled = false;
+    m_silent = silent;
+    m_done = 0;
+    m_failed = 0;
+    m_skipped = 0;
+    m_queue.clear();
+    m_next = 0;
+
+    // the formatters are not thread safe: compute their hashes here
+    std::vector<std::pair<wxString, size_t>> jobs;
+    jobs.reserve(files.size());
+    for (const wxString& file : files) {
+        auto formatter = m_manager.GetFormatter(file);
+        if (formatter) {
+            jobs.push_back({ file, get_formatter_hash(*formatter) });
+        }
+    }
+
+    if (!m_silent) {
+        clGetManager()->SetStatusMessage(_("Code Formatter: checking for modified files..."));
+    }
+
+    // the previous scan already posted its result
+    if (m_scanThread.joinable()) {
+        m_scanThread.join();
+    }
+
+    // reading and hashing thousands of files takes a while, do it in the background
+    m_scanCancelled = false;
+    m_scanThread = std::thread(
+        [jobs = std::move(jobs), hashes = m_hashes](BatchFormatter* batch) {
+            std::vector<wxString> modified_files;
+            modified_files.reserve(jobs.size());
+            size_t skipped = 0;
+            for (const auto& [filepath, formatter_hash] : jobs) {
+                if (batch->m_scanCancelled) {
+                    return;
+                }
+                size_t hash = 0;
+                auto iter = hashes.find(filepath);
+                if (iter != hashes.end() && get_file_hash(filepath, formatter_hash, &hash) && iter->second == hash) {
+                    ++skipped;
+                    continue;
+                }
+                modified_files.push_back(filepath);
+            }
+            batch->CallAfter(&BatchFormatter::OnScanCompleted, modified_files, skipped);
+        },
+        this);
+    return true;
+}
+
+void BatchFormatter::OnScanCompleted(const std::vector<wxString>& files, size_t skipped)
+{
+    m_queue = files;
+    m_skipped = skipped;
+    clDEBUG() << "Batch format:" << m_queue.size() << "files to format," << m_skipped << "unchanged files skipped"
+              << endl;
+
+    if (!m_silent && !m_queue.empty()) {
+        m_progress = new wxProgressDialog(_("Source Code Formatter"),
+                                          _("Formatting files..."),
+                                          (int)m_queue.size(),
+                                          EventNotifier::Get()->TopFrame(),
+                                          wxPD_CAN_ABORT | wxPD_AUTO_HIDE | wxPD_SMOOTH | wxPD_ELAPSED_TIME |
+                                              wxPD_REMAINING_TIME);
+    }
+    ProcessQueue();
+}
+
+void BatchFormatter::ProcessQueue()
+{
+    // the progress dialog processes events while it is updated, so we may be called after the batch was finished
+    if (!m_running) {
+        return;
+    }
+
+    while (!m_cancelled && m_next < m_queue.size() && m_inFlight.size() < GetMaxJobs()) {
+        const wxString& filepath = m_queue[m_next++];
+        auto formatter = m_manager.GetFormatter(filepath);
+        if (!formatter) {
+            // the formatter was disabled in the meantime
+            ++m_done;
+            continue;
+        }
+
+        // insert before formatting: the completion event may not arrive before we return
+        if (!m_inFlight.insert({ filepath, get_formatter_hash(*formatter) }).second) {
+            // duplicate entry, already being formatted
+            ++m_done;
+            continue;
+        }
+        if (!formatter->FormatFile(filepath, this)) {
+            m_inFlight.erase(filepath);
+            m_hashes.erase(filepath);
+            ++m_done;
+            ++m_failed;
+        }
+    }
+
+    if (m_inFlight.empty() && (m_cancelled || m_next >= m_queue.size())) {
+        Finish();
+    }
+}
+
+void BatchFormatter::FileCompleted(const wxString& filepath, bool success, bool cache_hash)
+{
+    auto iter = m_inFlight.find(filepath);
+    if (iter == m_inFlight.end()) {
+        return;
+    }
+
+    size_t hash = 0;
+    if (success && cache_hash && get_file_hash(filepath, iter->second, &hash)) {
+        m_hashes[filepath] = hash;
+    } else {
+        m_hashes.erase(filepath);
+    }
+    m_inFlight.erase(iter);
+
+    ++m_done;
+    if (!success) {
+        ++m_failed;
+    }
+    UpdateProgress();
+    ProcessQueue();
+}
+
+void BatchFormatter::OnFormatCompleted(clSourceFormatEvent& event)
+{
+    const wxString& filepath = event.GetFileName();
+    if (clGetManager()->FindEditor(filepath)) {
+        // let the owner update the editor. The file is saved later, so we can't cache its hash
+        m_owner->AddPendingEvent(event);
+        FileCompleted(filepath, true, false);
+        return;
+    }
+
+    // only touch files that were actually changed by the formatter
+    wxString content;
+    bool success = true;
+    if (!FileUtils::ReadFileContent(filepath, content) || content != event.GetFormattedString()) {
+        success = FileUtils::WriteFileContent(filepath, event.GetFormattedString());
+    }
+    FileCompleted(filepath, success);
+}
+
+void BatchFormatter::OnInplaceFormatCompleted(clSourceFormatEvent& event)
+{
+    // opened editors are reloaded when the batch is completed
+    FileCompleted(event.GetFileName(), true);
+}
+
+void BatchFormatter::OnFormatFailed(clSourceFormatEvent& event) { FileCompleted(event.GetFileName(), false); }
+
+void BatchFormatter::UpdateProgress()
+{
+    if (!m_progress || m_cancelled) {
+        return;
+    }
+
+    wxString msg;
+    msg << _("Formatting file: ") << m_done << "/" << m_queue.size();
+    if (!m_progress->Update((int)std::min(m_done, m_queue.size()), msg)) {
+        // stop starting new formatters, the running ones are allowed to complete so no file is left half written
+        m_cancelled = true;
+        if (m_progress) {
+            m_progress->Update((int)std::min(m_done, m_queue.size()), _("Cancelling..."));
+        }
+    }
+}
+
+void BatchFormatter::Finish()
+{
+    // we may get here from an event processed while the dialog is updated, so delay its deletion
+    if (m_progress) {
+        m_progress->Destroy();
+        m_progress = nullptr;
+    }
+    m_running = false;
+
+    if (!m_silent) {
+        wxString msg;
+        if (m_cancelled) {
+            msg << _("Formatting cancelled. Formatted ") << (m_done - m_failed) << _(" files");
+        } else {
+            msg << _("Successfully formatted ") << (m_done - m_failed) << _(" files");
+        }
+        if (m_skipped) {
+            msg << ", " << m_skipped << _(" unchanged files skipped");
+        }
+        if (m_failed) {
+            msg << ", " << m_failed << _(" failed");
+        }
+        clGetManager()->SetStatusMessage(msg, 3);
+    }
+
+    m_queue.clear();
+    m_next = 0;
+    if (m_done > m_failed) {
+        EventNotifier::Get()->PostReloadExternallyModifiedEvent(false);
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef BATCHFORMATTER_HPP
+#define BATCHFORMATTER_HPP
+
+#include "cl_command_event.h"
+#include "wxStringHash.h"
+
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <wx/event.h>
+#include <wx/string.h>
+
+class CodeFormatterManager;
+class wxProgressDialog;
+
+/// Formats a list of files in the background.
+/// Up to `GetMaxJobs()` formatter processes run at the same time. Files whose content did not change since they were
+/// last formatted by us (with the same formatter command) are skipped. When all the files are processed (or the user
+/// cancels), a single "reload externally modified files" event is posted
+class BatchFormatter : public wxEvtHandler
+{
+    CodeFormatterManager& m_manager;
+    wxEvtHandler* m_owner = nullptr;
+
+    // file -> hash of its content (combined with the formatter command) as it was after we formatted it
+    std::unordered_map<wxString, size_t> m_hashes;
+    // files being formatted -> hash of their formatter command
+    std::unordered_map<wxString, size_t> m_inFlight;
+    std::vector<wxString> m_queue;
+    size_t m_next = 0;
+
+    wxProgressDialog* m_progress = nullptr;
+    bool m_running = false;
+    bool m_cancelled = false;
+    bool m_silent = true;
+    size_t m_done = 0;
+    size_t m_failed = 0;
+    size_t m_skipped = 0;
+
+    // hashes the files to find the modified ones, joined before `this` is destroyed
+    std::thread m_scanThread;
+    std::atomic_bool m_scanCancelled{ false };
+
+protected:
+    void OnScanCompleted(const std::vector<wxString>& files, size_t skipped);
+    void OnFormatCompleted(clSourceFormatEvent& event);
+    void OnInplaceFormatCompleted(clSourceFormatEvent& event);
+    void OnFormatFailed(clSourceFormatEvent& event);
+
+    /// start formatters until `GetMaxJobs()` are running, finish the batch when nothing is left to do
+    void ProcessQueue();
+    /// `filepath` is done (successfully or not), update the progress and continue with the queue.
+    /// Set `cache_hash` to false if the file content on the disk is not final yet
+    void FileCompleted(const wxString& filepath, bool success, bool cache_hash = true);
+    void UpdateProgress();
+    void Finish();
+
+public:
+    /// `owner` receives the "format completed" events of files that are opened in an editor
+    BatchFormatter(CodeFormatterManager& manager, wxEvtHandler* owner);
+    ~BatchFormatter() override;
+
+    /// start formatting `files`. Return false if a batch is already running
+    bool Start(const std::vector<wxString>& files, bool silent);
+    bool IsRunning() const { return m_running; }
+
+    /// forget the hashes of the formatted files, next batch formats all the files again.
+    /// Call this when the formatters configuration may have changed
+    void ClearCache() { m_hashes.clear(); }
+
+    /// the number of formatter processes running at the same time
+    static size_t GetMaxJobs();
+};
+
+#endif // BATCHFORMATTER_HPP
@@ -44,10 +44,14 @@ void FormatterPage::Load(std::shared_ptr<GenericFormatter> formatter)
     AddHeader(m_cur_formatter->GetShortDescription());
     AddProperty(_("Enabled"), m_cur_formatter->IsEnabled(), UPDATE_BOOL_CB(SetEnabled));
     AddProperty(_("Format on save?"), m_cur_formatter->IsFormatOnSave(), UPDATE_BOOL_CB(SetFormatOnSave));
+    AddProperty(_("Format on save: modified lines only"),
+                m_cur_formatter->IsFormatModifiedLinesOnly(),
+                UPDATE_BOOL_CB(SetFormatModifiedLinesOnly));
     AddProperty(_("Inplace edit"), m_cur_formatter->IsInplaceFormatter(), UPDATE_BOOL_CB(SetInplaceFormatter));
     AddProperty(_("Working directory"), m_cur_formatter->GetWorkingDirectory(), UPDATE_TEXT_CB(SetWorkingDirectory));
     AddPropertyLanguagePicker(_("Supported languages"), m_cur_formatter->GetLanguages(), UPDATE_LANGS_CB());
     AddProperty(_("Command"), m_cur_formatter->GetCommandWithComments(), UPDATE_TEXT_CB(SetCommandFromString));
+    AddProperty(_("Line range argument"), m_cur_formatter->GetLinesArgument(), UPDATE_TEXT_CB(SetLinesArgument));
 }
 
 void FormatterPage::Clear()
@@ -105,8 +105,9 @@ bool GenericFormatter::SyncFormat(const wxString& cmd, const wxString& wd, bool
 
 /**
  * @brief format source file using background thread, when the formatting is done, fire an event to the sink object
+ * @return false if the formatter process could not be started
  */
-void GenericFormatter::AsyncFormat(const wxString& cmd, const wxString& wd, const wxString& filepath,
+bool GenericFormatter::AsyncFormat(const wxString& cmd, const wxString& wd, const wxString& filepath,
                                    bool inplace_formatter, wxEvtHandler* sink)
 {
     clDirChanger cd{ wd };
@@ -116,15 +117,27 @@ void GenericFormatter::AsyncFormat(const wxString& cmd, const wxString& wd, cons
     EnvSetter setter{ envlist.get() };
 
     long pid = wxNOT_FOUND;
-    if (ProcUtils::ShellExecAsync(cmd, &pid, this)) {
-        m_pid_commands.insert({ pid, CommandMetadata{ cmd, filepath, sink } });
+    if (!ProcUtils::ShellExecAsync(cmd, &pid, this)) {
+        clWARNING() << "Failed to execute formatter:" << cmd << endl;
+        return false;
     }
+    m_pid_commands.insert({ pid, CommandMetadata{ cmd, filepath, sink } });
+    return true;
 }
 
-bool GenericFormatter::DoFormatFile(const wxString& filepath, wxEvtHandler* sink, wxString* output)
+bool GenericFormatter::DoFormatFile(const wxString& filepath, wxEvtHandler* sink, wxString* output,
+                                    const LineRanges* ranges)
 {
     // Create a copy
     wxString cmd = GetCommandAsString();
+    if (ranges) {
+        for (const auto& [first, last] : ranges->GetRanges()) {
+            wxString arg = m_linesArgument;
+            arg.Replace("$(FirstLine)", wxString() << first);
+            arg.Replace("$(LastLine)", wxString() << last);
+            cmd << " " << arg;
+        }
+    }
 
     cmd = replace_macros(cmd, filepath);
     wxString wd = replace_macros(GetWorkingDirectory(), filepath);
@@ -132,8 +145,7 @@ bool GenericFormatter::DoFormatFile(const wxString& filepath, wxEvtHandler* sink
     wxBusyCursor bc;
     if (sink) {
         clDEBUG() << "Formatting file (async):" << filepath << "Working dir:" << wd << "Calling:" << cmd << endl;
-        AsyncFormat(cmd, wd, filepath, IsInplaceFormatter(), sink);
-        return true;
+        return AsyncFormat(cmd, wd, filepath, IsInplaceFormatter(), sink);
     } else {
         clDEBUG() << "Formatting file (sync):" << filepath << "Working dir:" << wd << "Calling:" << cmd << endl;
         return SyncFormat(cmd, wd, IsInplaceFormatter(), output);
@@ -175,6 +187,24 @@ bool GenericFormatter::FormatFile(const wxString& filepath, wxEvtHandler* sink)
     return DoFormatFile(filepath, sink, nullptr);
 }
 
+bool GenericFormatter::FormatFileLines(const wxString& filepath, const LineRanges& ranges, wxEvtHandler* sink)
+{
+    if (!CanFormatLines() || ranges.IsEmpty()) {
+        return false;
+    }
+    return DoFormatFile(filepath, sink, nullptr, &ranges);
+}
+
+wxString GenericFormatter::GetDefaultLinesArgument(const wxString& name)
+{
+    if (name == "clang-format") {
+        return "--lines=$(FirstLine):$(LastLine)";
+    } else if (name == "black") {
+        return "--line-ranges=$(FirstLine)-$(LastLine)";
+    }
+    return wxEmptyString;
+}
+
 bool GenericFormatter::FormatString(const wxString& content, const wxString& fullpath, wxString* output)
 {
     auto file_type = FileExtManager::GetType(fullpath);
@@ -209,6 +239,12 @@ void GenericFormatter::FromJSON(const JSONItem& json)
     SourceFormatterBase::FromJSON(json);
     m_command = json["command"].toArrayString();
     m_workingDirectory = json["working_directory"].toString();
+    if (json.hasNamedObject("lines_argument")) {
+        m_linesArgument = json["lines_argument"].toString();
+    } else {
+        // configuration saved before line ranges were supported
+        m_linesArgument = GetDefaultLinesArgument(m_name);
+    }
 }
 
 JSONItem GenericFormatter::ToJSON() const
@@ -216,6 +252,7 @@ JSONItem GenericFormatter::ToJSON() const
     auto json = SourceFormatterBase::ToJSON();
     json.addProperty("command", m_command);
     json.addProperty("working_directory", m_workingDirectory);
+    json.addProperty("lines_argument", m_linesArgument);
     return json;
 }
 
@@ -251,6 +288,12 @@ void GenericFormatter::OnAsyncShellProcessTerminated(clShellProcessEvent& event)
         wxString errmsg;
         errmsg << wxT("\u26A0") << _(" format error. Process exit code: ") << event.GetExitCode();
         clGetManager()->SetStatusMessage(errmsg, 3);
+
+        if (command_data.m_sink) {
+            clSourceFormatEvent format_failed_event{ wxEVT_FORMAT_FAILED };
+            format_failed_event.SetFileName(command_data.m_filepath);
+            command_data.m_sink->QueueEvent(format_failed_event.Clone());
+        }
         return;
     }
 
@@ -1,6 +1,7 @@
 #ifndef GENERICFORMATTER_HPP
 #define GENERICFORMATTER_HPP
 
+#include "LineRanges.hpp"
 #include "SourceFormatterBase.hpp"
 #include "clCodeLiteRemoteProcess.hpp"
 #include "cl_remote_executor.hpp"
@@ -30,6 +31,8 @@ class GenericFormatter : public SourceFormatterBase
 {
     wxArrayString m_command;
     wxString m_workingDirectory;
+    // passed once per line range, e.g. `--lines=$(FirstLine):$(LastLine)`. Empty if line ranges are not supported
+    wxString m_linesArgument;
     std::unordered_map<long, CommandMetadata> m_pid_commands;
     std::vector<std::pair<wxString, wxEvtHandler*>> m_inFlightFiles;
 
@@ -39,8 +42,9 @@ class GenericFormatter : public SourceFormatterBase
     wxString m_remote_wd;
 
 protected:
-    bool DoFormatFile(const wxString& filepath, wxEvtHandler* sink, wxString* output);
-    void AsyncFormat(const wxString& cmd, const wxString& wd, const wxString& filepath, bool inplace_formatter,
+    bool DoFormatFile(const wxString& filepath, wxEvtHandler* sink, wxString* output,
+                      const LineRanges* ranges = nullptr);
+    bool AsyncFormat(const wxString& cmd, const wxString& wd, const wxString& filepath, bool inplace_formatter,
                      wxEvtHandler* sink);
     bool SyncFormat(const wxString& cmd, const wxString& wd, bool inplace_formatter, wxString* output);
     void OnAsyncShellProcessTerminated(clShellProcessEvent& event);
@@ -62,6 +66,16 @@ public:
     bool FormatRemoteFile(const wxString& filepath, wxEvtHandler* sink) override;
     bool FormatString(const wxString& content, const wxString& fullpath, wxString* output) override;
 
+    /// format only `ranges` of `filepath`. The formatter must support line ranges
+    bool FormatFileLines(const wxString& filepath, const LineRanges& ranges, wxEvtHandler* sink);
+    bool CanFormatLines() const { return !m_linesArgument.empty(); }
+
+    void SetLinesArgument(const wxString& linesArgument) { this->m_linesArgument = linesArgument; }
+    const wxString& GetLinesArgument() const { return m_linesArgument; }
+
+    /// the line range argument of the known formatters, by formatter name
+    static wxString GetDefaultLinesArgument(const wxString& name);
+
     bool CanHandleRemoteFile() const { return !m_remote_command.empty(); }
     void SetRemoteCommand(const wxString& cmd, const wxString& remote_wd, const clEnvList_t& env);
 
@@ -5,6 +5,7 @@
 
 wxDEFINE_EVENT(wxEVT_FORMAT_COMPELTED, clSourceFormatEvent);
 wxDEFINE_EVENT(wxEVT_FORMAT_INPLACE_COMPELTED, clSourceFormatEvent);
+wxDEFINE_EVENT(wxEVT_FORMAT_FAILED, clSourceFormatEvent);
 
 void SourceFormatterBase::FromJSON(const JSONItem& json)
 {
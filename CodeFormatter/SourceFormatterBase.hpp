@@ -26,6 +26,9 @@ enum class FormatterFlags {
 
     // trigger a formatting after saving the file
     FORMAT_ON_SAVE = (1 << 3),
+
+    // when formatting on save, format only the modified lines (if the formatter supports line ranges)
+    FORMAT_MODIFIED_LINES = (1 << 4),
 };
 
 #define __HAS_FLAG(flags, bit) (flags & (size_t)bit)
@@ -34,6 +37,8 @@ enum class FormatterFlags {
 
 wxDECLARE_EVENT(wxEVT_FORMAT_COMPELTED, clSourceFormatEvent);
 wxDECLARE_EVENT(wxEVT_FORMAT_INPLACE_COMPELTED, clSourceFormatEvent);
+// fired to the sink of an async format when the formatter could not be started or exited with an error
+wxDECLARE_EVENT(wxEVT_FORMAT_FAILED, clSourceFormatEvent);
 
 class SourceFormatterBase : public wxEvtHandler
 {
@@ -76,6 +81,9 @@ public:
     bool IsFormatOnSave() const { return HasFlag(FormatterFlags::FORMAT_ON_SAVE); }
     void SetFormatOnSave(bool b) { SetFlag(FormatterFlags::FORMAT_ON_SAVE, b); }
 
+    bool IsFormatModifiedLinesOnly() const { return HasFlag(FormatterFlags::FORMAT_MODIFIED_LINES); }
+    void SetFormatModifiedLinesOnly(bool b) { SetFlag(FormatterFlags::FORMAT_MODIFIED_LINES, b); }
+
     void SetInplaceFormatter(bool b) { SetFlag(FormatterFlags::INPLACE_EDIT, b); }
     bool IsInplaceFormatter() const { return HasFlag(FormatterFlags::INPLACE_EDIT); }
 
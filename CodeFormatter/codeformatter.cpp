@@ -102,6 +102,42 @@ void inc_save_count(const wxString& filepath)
         ignore_map[filepath] = 1;
     }
 }
+
+/// return true if `filepath` is a configuration file of one of the formatters
+bool is_formatter_config_file(const CodeFormatterManager& manager, const wxString& filepath)
+{
+    // the files that the formatters look for next to the formatted files
+    static const wxStringSet_t known_names = { ".clang-format",
+                                               "_clang-format",
+                                               ".editorconfig",
+                                               "rustfmt.toml",
+                                               ".rustfmt.toml",
+                                               ".cmake-format",
+                                               ".cmake-format.py",
+                                               ".cmake-format.yaml",
+                                               ".cmake-format.json",
+                                               ".php-cs-fixer.php",
+                                               ".php-cs-fixer.dist.php",
+                                               "pyproject.toml",
+                                               ".prettierrc" };
+
+    wxString fullname = wxFileName(filepath).GetFullName();
+    if (known_names.count(fullname)) {
+        return true;
+    }
+
+    // the configuration files set by the user
+    wxArrayString names;
+    manager.GetAllNames(&names);
+    for (const wxString& name : names) {
+        auto formatter = manager.GetFormatterByName(name);
+        if (formatter && !formatter->GetConfigFilepath().empty() &&
+            wxFileName(formatter->GetConfigFilepath()).GetFullName() == fullname) {
+            return true;
+        }
+    }
+    return false;
+}
 } // namespace
 
 // Allocate the code formatter on the heap, it will be freed by
@@ -122,6 +158,7 @@ CL_PLUGIN_API int GetPluginInterfaceVersion() { return PLUGIN_INTERFACE_VERSION;
 
 CodeFormatter::CodeFormatter(IManager* manager)
     : IPlugin(manager)
+    , m_batchFormatter(m_manager, this)
 {
     m_manager.Load();
     m_remoteHelper.reset(new CodeLiteRemoteHelper);
@@ -218,7 +255,7 @@ std::shared_ptr<GenericFormatter> CodeFormatter::FindFormatter(const wxString& f
     return nullptr;
 }
 
-bool CodeFormatter::DoFormatEditor(IEditor* editor)
+bool CodeFormatter::DoFormatEditor(IEditor* editor, bool modified_lines_only)
 {
     // sanity
     CHECK_PTR_RET_FALSE(editor);
@@ -248,13 +285,44 @@ bool CodeFormatter::DoFormatEditor(IEditor* editor)
         inc_save_count(file_path);
     }
 
-    bool res = is_remote ? f->FormatRemoteFile(file_path, this) : f->FormatFile(file_path, this);
+    bool res = false;
+    if (is_remote) {
+        res = f->FormatRemoteFile(file_path, this);
+    } else if (modified_lines_only && f->CanFormatLines()) {
+        res = DoFormatModifiedLines(editor, f);
+    } else {
+        res = f->FormatFile(file_path, this);
+    }
+
     if (res) {
         editor->ClearModifiedLines();
     }
     return res;
 }
 
+bool CodeFormatter::DoFormatModifiedLines(IEditor* editor, std::shared_ptr<GenericFormatter> formatter)
+{
+    wxString file_path = editor->GetRemotePathOrLocal();
+
+    // prefer the editor tracker, it knows about changes that are not committed yet.
+    // Fallback to git when the editor has nothing (e.g. the file was modified outside of the editor)
+    LineRanges ranges = LineRanges::FromLines(editor->GetModifiedLines());
+    if (ranges.IsEmpty()) {
+        if (!LineRanges::FromGitDiff(file_path, &ranges)) {
+            clDEBUG() << "Could not find the modified lines of:" << file_path << ". Formatting the entire file" << endl;
+            return formatter->FormatFile(file_path, this);
+        }
+
+        if (ranges.IsEmpty()) {
+            clDEBUG() << "No modified lines in:" << file_path << endl;
+            return true;
+        }
+    }
+
+    clDEBUG() << "Formatting" << ranges.GetRanges().size() << "line ranges of:" << file_path << endl;
+    return formatter->FormatFileLines(file_path, ranges, this);
+}
+
 bool CodeFormatter::DoFormatString(const wxString& content, const wxString& fileName, wxString* output)
 {
     if (content.empty()) {
@@ -292,6 +360,7 @@ void CodeFormatter::OnSettings(wxCommandEvent& e)
     if (dlg.ShowModal() == wxID_OK) {
         // save the changes to the file system
         m_manager.Save();
+        m_batchFormatter.ClearCache();
     } else {
         // reload all changes from the file system
         m_manager.Load();
@@ -430,21 +499,10 @@ void CodeFormatter::BatchFormat(const std::vector<wxString>& files, bool silent)
         }
     }
 
-    for (size_t i = 0; i < files.size(); ++i) {
-        wxString msg;
-        msg << "Formatting file: " << (i + 1) << "/" << files.size() << " " << files[i];
-        if (!silent) {
-            clGetManager()->SetStatusMessage(msg, 1);
-            wxSafeYield();
-        }
-        DoFormatFile(files[i], false);
-    }
-
-    if (!silent) {
-        clGetManager()->SetStatusMessage(wxString() << _("Successfully formatted ") << files.size() << _(" files"), 3);
-        wxSafeYield();
+    if (!m_batchFormatter.Start(files, silent) && !silent) {
+        ::wxMessageBox(_("Source code formatting is already in progress"), _("Source Code Formatter"),
+                       wxOK | wxICON_WARNING | wxCENTER);
     }
-    EventNotifier::Get()->PostReloadExternallyModifiedEvent(false);
 }
 
 void CodeFormatter::OnScanFilesCompleted(const std::vector<wxString>& files) { BatchFormat(files, false); }
@@ -512,7 +570,13 @@ void CodeFormatter::OnFileSaved(clCommandEvent& e)
 
     // Check that we can handle this file
     auto f = FindFormatter(e.GetFileName());
-    CHECK_PTR_RET(f);
+    if (!f) {
+        if (is_formatter_config_file(m_manager, filepath)) {
+            // files formatted with the old configuration must not be skipped by the next batch
+            m_batchFormatter.ClearCache();
+        }
+        return;
+    }
 
     // Find the editor and format it
     auto editor = clGetManager()->FindEditor(filepath);
@@ -528,7 +592,7 @@ void CodeFormatter::OnFileSaved(clCommandEvent& e)
         return;
     }
 
-    if (!DoFormatEditor(editor)) {
+    if (!DoFormatEditor(editor, f->IsFormatModifiedLinesOnly())) {
         return;
     }
 }
@@ -553,6 +617,8 @@ void CodeFormatter::OnFormatCompleted(clSourceFormatEvent& event)
             editor->Save();
             inc_save_count(filepath);
         }
+        // the text was replaced by the formatter output, don't report all the lines as modified
+        editor->ClearModifiedLines();
     } else {
         // no editor is opened, update the file content
         if (wxFileExists(filepath)) {
@@ -25,6 +25,7 @@
 #ifndef CODEFORMATTER_H
 #define CODEFORMATTER_H
 
+#include "BatchFormatter.hpp"
 #include "CodeFormatterManager.hpp"
 #include "CodeLiteRemoteHelper.hpp"
 #include "cl_command_event.h"
@@ -36,6 +37,7 @@
 class CodeFormatter : public IPlugin
 {
     CodeFormatterManager m_manager;
+    BatchFormatter m_batchFormatter;
     std::shared_ptr<CodeLiteRemoteHelper> m_remoteHelper;
 
 protected:
@@ -46,7 +48,8 @@ private:
                                                     const wxString& content = wxEmptyString) const;
     bool DoFormatFile(const wxString& fileName, bool is_remote_format);
     bool DoFormatString(const wxString& content, const wxString& fileName, wxString* output);
-    bool DoFormatEditor(IEditor* editor);
+    bool DoFormatEditor(IEditor* editor, bool modified_lines_only = false);
+    bool DoFormatModifiedLines(IEditor* editor, std::shared_ptr<GenericFormatter> formatter);
     void OnScanFilesCompleted(const std::vector<wxString>& files);
     void OnWorkspaceLoaded(clWorkspaceEvent& e);
     void OnWorkspaceClosed(clWorkspaceEvent& e);
@@ -58,7 +61,7 @@ private:
 
 public:
     /**
-     * @brief format list of files
+     * @brief format list of files in the background. Files that were not modified since the last batch are skipped
      */
     void BatchFormat(const std::vector<wxString>& files, bool silent = true);
     void OnContextMenu(clContextMenuEvent& event);
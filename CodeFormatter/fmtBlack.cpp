@@ -14,5 +14,6 @@ fmtBlack::fmtBlack()
     // local command
     const auto black_exe = ThePlatform->WhichWithVersion("black", { 20, 19, 18, 17, 16, 15, 14, 13, 12 });
     SetCommand({ black_exe.value_or("black"), "--line-length", "80", R"#("$(CurrentFileRelPath)")#" });
+    SetLinesArgument(GetDefaultLinesArgument(GetName()));
     SetEnabled(black_exe.has_value());
 }
@@ -21,5 +21,6 @@ fmtClangFormat::fmtClangFormat()
 
     const auto clang_format_exe = ThePlatform->WhichWithVersion("clang-format", kClangFormatVersions);
     SetCommand({clang_format_exe.value_or("clang-format"), R"#("$(CurrentFileRelPath)")#"});
+    SetLinesArgument(GetDefaultLinesArgument(GetName()));
     SetEnabled(clang_format_exe.has_value());
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include "clTrace.hpp"
 #include "file_logger.h"
 
 #include <wx/stopwatch.h>
@@ -10,11 +11,18 @@ public:
         : m_label(label)
         , m_logLevel(log_level)
     {
+        if (clTrace::IsEnabled()) {
+            m_traceName = clTrace::Intern(label);
+            m_traceStart = clTrace::Now();
+        }
         m_sw.Start();
     }
 
     ~BlockTimer()
     {
+        if (m_traceName) {
+            clTrace::Record(m_traceName, m_traceStart, clTrace::Now());
+        }
         if (FileLogger::CanLog(m_logLevel)) {
             FileLogger(m_logLevel) << FileLogger::Prefix(m_logLevel) << "(" << m_label << ")"
                                    << " duration:" << m_sw.TimeInMicro() << "microseconds" << endl;
@@ -25,4 +33,6 @@ private:
     wxStopWatch m_sw;
     wxString m_label;
     FileLogger::LogLevel m_logLevel{FileLogger::Dbg};
+    const char* m_traceName = nullptr;
+    uint64_t m_traceStart = 0;
 };
\ No newline at end of file
@@ -35,6 +35,23 @@ wxArrayString to_wx_array_string(const std::vector<wxString>& v)
     return a;
 }
 
+/// convert a scanned variable into a CxxCodeCompletion::__local
+template <typename Local> Local to_local(CxxVariable::Ptr_t var)
+{
+    Local local;
+    wxString assignment_expr_raw = var->GetDefaultValue();
+    // strip it from any keywords etc and only keep interesting parts
+
+    local.set_assignment_raw(assignment_expr_raw);
+    local.set_assignment(assignment_expr_raw);
+    local.set_type_name(var->GetTypeAsString());
+    local.set_is_auto(var->IsAuto());
+    local.set_name(var->GetName());
+    local.set_pattern(var->ToString(CxxVariable::kToString_Name | CxxVariable::kToString_DefaultValue));
+    local.set_line_number(var->GetLineNumber());
+    return local;
+}
+
 } // namespace
 
 #define RECURSE_GUARD_RETURN_NULLPTR() \
@@ -74,6 +91,19 @@ void CxxCodeCompletion::determine_current_scope()
         return;
     }
 
+    // check the cache first
+    auto analysis = get_file_analysis();
+    auto iter = analysis->scope_by_line.find(m_line_number);
+    if(iter != analysis->scope_by_line.end()) {
+        m_current_function_key = iter->second;
+        if(!m_current_function_key.empty()) {
+            const auto& function_analysis = analysis->functions[m_current_function_key];
+            m_current_function_tag = function_analysis.function_tag;
+            m_current_container_tag = function_analysis.container_tag;
+        }
+        return;
+    }
+
     m_current_function_tag = m_lookup->GetScope(m_filename, m_line_number + 1);
     if(m_current_function_tag && m_current_function_tag->IsMethod()) {
         std::vector<TagEntryPtr> tmp_tags;
@@ -82,6 +112,113 @@ void CxxCodeCompletion::determine_current_scope()
             m_current_container_tag = std::move(tmp_tags[0]);
         }
     }
+
+    m_current_function_key.clear();
+    if(m_current_function_tag) {
+        m_current_function_key << m_current_function_tag->GetPath() << ":" << m_current_function_tag->GetLine();
+        auto& function_analysis = analysis->functions[m_current_function_key];
+        function_analysis.function_tag = m_current_function_tag;
+        function_analysis.container_tag = m_current_container_tag;
+    }
+    analysis->scope_by_line.insert({ m_line_number, m_current_function_key });
+}
+
+CxxCodeCompletion::__file_analysis* CxxCodeCompletion::get_file_analysis() const
+{
+    if(m_filename.empty()) {
+        return nullptr;
+    }
+
+    // keep the cache size under control
+    if(m_files_analysis.size() > 100 && m_files_analysis.count(m_filename) == 0) {
+        m_files_analysis.clear();
+    }
+    return &m_files_analysis[m_filename];
+}
+
+CxxCodeCompletion::__function_analysis* CxxCodeCompletion::get_function_analysis() const
+{
+    if(m_current_function_key.empty()) {
+        return nullptr;
+    }
+
+    auto analysis = get_file_analysis();
+    if(!analysis) {
+        return nullptr;
+    }
+    auto iter = analysis->functions.find(m_current_function_key);
+    return iter == analysis->functions.end() ? nullptr : &iter->second;
+}
+
+void CxxCodeCompletion::set_tags_generation(size_t generation)
+{
+    if(generation == m_tags_generation) {
+        return;
+    }
+    m_tags_generation = generation;
+    m_files_analysis.clear();
+    m_current_function_key.clear();
+}
+
+std::vector<TagEntryPtr> CxxCodeCompletion::get_function_parameters() const
+{
+    std::vector<TagEntryPtr> parameters;
+    if(!m_current_function_tag || !m_current_function_tag->IsFunction()) {
+        return parameters;
+    }
+
+    // load the parameters and the lambdas from the database (once per function)
+    __function_analysis tmp;
+    __function_analysis* function_analysis = get_function_analysis();
+    if(!function_analysis) {
+        function_analysis = &tmp;
+    }
+
+    if(!function_analysis->parameters_loaded) {
+        std::vector<TagEntryPtr> all_lambdas;
+        m_lookup->GetParameters(m_current_function_tag->GetPath(), function_analysis->parameters);
+        m_lookup->GetLambdas(m_current_function_tag->GetPath(), all_lambdas);
+        for(auto lambda : all_lambdas) {
+            std::vector<TagEntryPtr> lambda_parameters;
+            m_lookup->GetParameters(lambda->GetPath(), lambda_parameters);
+            function_analysis->lambdas.push_back({ lambda->GetLine(), std::move(lambda_parameters) });
+        }
+        function_analysis->parameters_loaded = true;
+    }
+
+    parameters = function_analysis->parameters;
+
+    // read all lambdas parameters
+    std::unordered_map<wxString, TagEntryPtr> lambda_parameters_map;
+    std::unordered_map<wxString, TagEntryPtr> function_parameters_map;
+
+    for(auto param : parameters) {
+        function_parameters_map.insert({ param->GetName(), param });
+    }
+
+    for(const auto& [lambda_line, lambda_parameters] : function_analysis->lambdas) {
+        if((lambda_line - 1) <= m_line_number) {
+            // add this lambda parameters
+            for(auto param : lambda_parameters) {
+                // if a function parameter with this name already exists, skip it
+                if(function_parameters_map.count(param->GetName())) {
+                    continue;
+                }
+
+                // if we already encountered a lambda parameter with this name, replace it
+                if(lambda_parameters_map.count(param->GetName())) {
+                    lambda_parameters_map.erase(param->GetName());
+                }
+                lambda_parameters_map.insert({ param->GetName(), param });
+            }
+        }
+    }
+
+    // all the lambda parameters to the list of parameters
+    for(const auto& vt : lambda_parameters_map) {
+        parameters.emplace_back(vt.second);
+    }
+    return parameters;
 }
 
 TagEntryPtr CxxCodeCompletion::code_complete(const wxString& expression, const std::vector<wxString>& visible_scopes,
@@ -156,78 +293,58 @@ size_t CxxCodeCompletion::parse_locals(const wxString& text, std::unordered_map<
     return locals->size();
 }
 
-void CxxCodeCompletion::shrink_scope(const wxString& text, std::unordered_map<wxString, __local>* locals,
-                                     FileScope* file_tags) const
+void CxxCodeCompletion::scan_variables(const wxString& text, std::unordered_map<wxString, __local>* locals) const
 {
-    // parse local variables
     CxxVariableScanner scanner(text, eCxxStandard::kCxx11, get_tokens_map(), false);
     CxxVariable::Vec_t variables = scanner.GetVariables(false);
-    locals->reserve(variables.size());
-
-    std::vector<TagEntryPtr> parameters;
-    if(m_current_function_tag && m_current_function_tag->IsFunction()) {
-        std::vector<TagEntryPtr> all_lambdas;
-        std::vector<TagEntryPtr> lambdas;
-        // get the current function parameters
-        m_lookup->GetParameters(m_current_function_tag->GetPath(), parameters);
-        m_lookup->GetLambdas(m_current_function_tag->GetPath(), all_lambdas);
-
-        // read all lambdas parameters
-        std::unordered_map<wxString, TagEntryPtr> lambda_parameters_map;
-        std::unordered_map<wxString, TagEntryPtr> function_parameters_map;
-
-        for(auto param : parameters) {
-            function_parameters_map.insert({ param->GetName(), param });
-        }
-
-        for(auto lambda : all_lambdas) {
-            if((lambda->GetLine() - 1) <= m_line_number) {
-                // load this lambda parameters and add them
-                std::vector<TagEntryPtr> lambda_parameters;
-                m_lookup->GetParameters(lambda->GetPath(), lambda_parameters);
-                for(auto param : lambda_parameters) {
-                    // if a function parameter with this name already exists, skip it
-                    if(function_parameters_map.count(param->GetName())) {
-                        continue;
-                    }
-
-                    // if we already encountered a lambda parameter with this name, replace it
-                    if(lambda_parameters_map.count(param->GetName())) {
-                        lambda_parameters_map.erase(param->GetName());
-                    }
-                    lambda_parameters_map.insert({ param->GetName(), param });
-                }
-            }
-        }
-
-        // all the lambda parameters to the list of parameters
-        for(const auto& vt : lambda_parameters_map) {
-            parameters.emplace_back(vt.second);
-        }
+    locals->reserve(locals->size() + variables.size());
+    for(auto var : variables) {
+        locals->insert({ var->GetName(), to_local<__local>(var) });
     }
+}
+
+void CxxCodeCompletion::shrink_scope(const wxString& text, std::unordered_map<wxString, __local>* locals,
+                                     FileScope* file_tags) const
+{
+    // parse local variables
+    scan_variables(text, locals);
 
     if(file_tags) {
         // set the function parameters (this includes any lambda parameters)
-        file_tags->set_function_parameters(parameters);
+        file_tags->set_function_parameters(get_function_parameters());
     }
 
     // we also include the anonymous entries for this scope
-    const wxArrayString kinds =
-        StdToWX::ToArrayString({ "class", "struct", "namespace", "member", "function", "variable", "enum", "macro" });
-    std::vector<TagEntryPtr> anonymous_tags;
-    get_anonymous_tags(wxEmptyString, kinds, anonymous_tags);
+    // they are loaded and parsed once per file
+    __file_analysis tmp;
+    __file_analysis* analysis = get_file_analysis();
+    if(!analysis) {
+        analysis = &tmp;
+    }
+
+    if(!analysis->file_tags_loaded) {
+        const wxArrayString kinds = StdToWX::ToArrayString(
+            { "class", "struct", "namespace", "member", "function", "variable", "enum", "macro" });
+        get_anonymous_tags(wxEmptyString, kinds, analysis->anonymous_tags);
+
+        // create a local variable from the anonymous tags
+        for(auto tag : analysis->anonymous_tags) {
+            if(tag->GetKind() == "variable") {
+                CxxVariableScanner scanner(normalize_pattern(tag), eCxxStandard::kCxx11, m_macros_table_map, false);
+                for(auto var : scanner.GetVariables(false)) {
+                    analysis->anonymous_locals.push_back(to_local<__local>(var));
+                }
+            }
+        }
+        analysis->file_tags_loaded = true;
+    }
 
     wxStringSet_t unique_scopes;
-    // create a local variable from the anonymous tags
-    for(auto tag : anonymous_tags) {
+    for(auto tag : analysis->anonymous_tags) {
         if(tag->GetScope().StartsWith("__anon")) {
             unique_scopes.insert(tag->GetScope());
         }
-        if(tag->GetKind() == "variable") {
-            CxxVariableScanner scanner(normalize_pattern(tag), eCxxStandard::kCxx11, m_macros_table_map, false);
-            auto _variables = scanner.GetVariables(false);
-            variables.insert(variables.end(), _variables.begin(), _variables.end());
-        } else if(file_tags && tag->GetKind() == "member") {
+        if(file_tags && tag->GetKind() == "member") {
             file_tags->add_static_member(tag);
         }
     }
@@ -236,19 +353,8 @@ void CxxCodeCompletion::shrink_scope(const wxString& text, std::unordered_map<wx
         file_tags->set_file_scopes(unique_scopes);
     }
 
-    for(auto var : variables) {
-        __local local;
-        wxString assignment_expr_raw = var->GetDefaultValue();
-        // strip it from any keywords etc and only keep interesting parts
-
-        local.set_assignment_raw(assignment_expr_raw);
-        local.set_assignment(assignment_expr_raw);
-        local.set_type_name(var->GetTypeAsString());
-        local.set_is_auto(var->IsAuto());
-        local.set_name(var->GetName());
-        local.set_pattern(var->ToString(CxxVariable::kToString_Name | CxxVariable::kToString_DefaultValue));
-        local.set_line_number(var->GetLineNumber());
-        locals->insert({ var->GetName(), local });
+    for(const auto& local : analysis->anonymous_locals) {
+        locals->insert({ local.name(), local });
     }
 }
 
@@ -741,6 +847,8 @@ void CxxCodeCompletion::reset()
     m_recurse_protector = 0;
     m_current_function_tag = nullptr;
     m_current_container_tag = nullptr;
+    m_current_function_key.clear();
+    m_files_analysis.clear();
 }
 
 namespace
@@ -1016,9 +1124,43 @@ void CxxCodeCompletion::set_text(const wxString& text, const wxString& filename,
     m_line_number = current_line;
     m_current_container_tag = nullptr;
     m_current_function_tag = nullptr;
+    m_current_function_key.clear();
 
     determine_current_scope();
-    shrink_scope(text, &m_locals, &m_file_only_tags);
+
+    // the text is the current function up to the cursor. The locals of the lines above the current line are
+    // kept per function, so typing on the current line only scans that line. A current line that opens or
+    // closes a block changes the visible scopes, the whole text is scanned
+    auto function_analysis = get_function_analysis();
+    int body_end = text.Find('\n', true);
+    wxString current_line = text.Mid(body_end + 1);
+    if(!function_analysis || body_end == wxNOT_FOUND || current_line.find_first_of("{}") != wxString::npos) {
+        shrink_scope(text, &m_locals, &m_file_only_tags);
+        return;
+    }
+
+    wxString body = text.Mid(0, body_end + 1);
+    size_t body_hash = std::hash<wxString>{}(body);
+    if(function_analysis->has_locals && function_analysis->body_hash == body_hash) {
+        ++m_locals_cache_hits;
+        m_locals = function_analysis->locals;
+        m_file_only_tags = function_analysis->file_tags;
+    } else {
+        shrink_scope(body, &m_locals, &m_file_only_tags);
+        function_analysis->has_locals = true;
+        function_analysis->body_hash = body_hash;
+        function_analysis->locals = m_locals;
+        function_analysis->file_tags = m_file_only_tags;
+    }
+
+    // the variables declared on the current line hide the ones above it
+    std::unordered_map<wxString, __local> line_locals;
+    scan_variables(current_line, &line_locals);
+    int line_offset = body.Freq('\n');
+    for(auto& [name, local] : line_locals) {
+        local.set_line_number(local.line_number() + line_offset);
+        m_locals[name] = std::move(local);
+    }
 }
 
 namespace
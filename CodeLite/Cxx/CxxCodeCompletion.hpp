@@ -143,6 +143,30 @@ private:
         void set_line_number(int l) { _line_numner = l; }
     };
 
+    /// the analysis of a single function. The parameters are loaded from the database once, the
+    /// locals are re-scanned only when the lines of the function above the current line change
+    struct __function_analysis {
+        TagEntryPtr function_tag;
+        TagEntryPtr container_tag;
+        bool parameters_loaded = false;
+        std::vector<TagEntryPtr> parameters;
+        std::vector<std::pair<int, std::vector<TagEntryPtr>>> lambdas; // lambda line + its parameters
+        bool has_locals = false;
+        size_t body_hash = 0; // the function lines above the current line
+        std::unordered_map<wxString, __local> locals;
+        FileScope file_tags;
+    };
+
+    /// cached analysis of a file. Everything loaded from the tags database is kept until the
+    /// database is updated (see `set_tags_generation()`)
+    struct __file_analysis {
+        std::unordered_map<int, wxString> scope_by_line; // line -> function key (empty for no function)
+        std::unordered_map<wxString, __function_analysis> functions;
+        bool file_tags_loaded = false;
+        std::vector<TagEntryPtr> anonymous_tags;
+        std::vector<__local> anonymous_locals;
+    };
+
 private:
     ITagsStoragePtr m_lookup;
     std::unordered_map<wxString, CxxCodeCompletion::__local> m_locals;
@@ -159,6 +183,10 @@ private:
     TemplateManager::ptr_t m_template_manager;
     bool m_first_time = true;
     wxString m_codelite_indexer;
+    mutable std::unordered_map<wxString, __file_analysis> m_files_analysis;
+    wxString m_current_function_key;
+    size_t m_tags_generation = 0;
+    size_t m_locals_cache_hits = 0;
 
 private:
     /**
@@ -184,7 +212,22 @@ private:
                                     const std::vector<wxString>& kinds);
 
     wxString typedef_from_tag(TagEntryPtr tag) const;
+
+    /**
+     * @brief return the cached analysis of the current file and function (nullptr if not available)
+     */
+    __file_analysis* get_file_analysis() const;
+    __function_analysis* get_function_analysis() const;
+
+    /**
+     * @brief load the current function parameters, including the parameters of the lambdas placed
+     * before the current line
+     */
+    std::vector<TagEntryPtr> get_function_parameters() const;
+
     void shrink_scope(const wxString& text, std::unordered_map<wxString, __local>* locals, FileScope* file_tags) const;
+    /// add the variables declared in `text` to `locals`
+    void scan_variables(const wxString& text, std::unordered_map<wxString, __local>* locals) const;
     TagEntryPtr
     resolve_expression(CxxExpression& curexp, TagEntryPtr parent, const std::vector<wxString>& visible_scopes);
     TagEntryPtr resolve_compound_expression(std::vector<CxxExpression>& expression,
@@ -276,6 +319,8 @@ public:
     wxString get_return_value(TagEntryPtr tag) const;
 
     TagEntryPtr get_current_function_tag() const { return m_current_function_tag; }
+    /// number of `set_text()` calls that re-used the locals of the current function
+    size_t get_locals_cache_hits() const { return m_locals_cache_hits; }
     TagEntryPtr get_current_scope_tag() const { return m_current_container_tag; }
 
     /**
@@ -312,6 +357,12 @@ public:
      */
     void set_text(const wxString& text, const wxString& filename, int current_line);
 
+    /**
+     * @brief notify the completer about the tags database version. When the version
+     * changes, the cached files analysis is discarded
+     */
+    void set_tags_generation(size_t generation);
+
     /**
      * @brief parse an expression and resolve it into a TagEntry. If the expression does not end with
      * an operand, return the remainder
@@ -0,0 +1,26 @@
+#include "CancelRequestNotification.hpp"
+
+namespace LSP
+{
+struct CancelParams : public Params {
+    int m_id = wxNOT_FOUND;
+
+    JSONItem ToJSON(const wxString& name) const override
+    {
+        JSONItem json = JSONItem::createObject(name);
+        json.addProperty("id", m_id);
+        return json;
+    }
+
+    void FromJSON(const JSONItem& json) override { m_id = json["id"].toInt(wxNOT_FOUND); };
+};
+
+CancelRequestNotification::CancelRequestNotification(int id)
+{
+    SetMethod("$/cancelRequest");
+    CancelParams* params = new CancelParams();
+    params->m_id = id;
+    m_params.reset(params);
+}
+
+} // namespace LSP
@@ -0,0 +1,21 @@
+#ifndef CANCELREQUESTNOTIFICATION_HPP
+#define CANCELREQUESTNOTIFICATION_HPP
+
+#include "LSP/Notification.h"
+
+namespace LSP
+{
+
+/**
+ * @brief `$/cancelRequest` - tell the server that we are no longer interested in the response of request `id`
+ */
+class WXDLLIMPEXP_CL CancelRequestNotification : public Notification
+{
+public:
+    explicit CancelRequestNotification(int id);
+    virtual ~CancelRequestNotification() = default;
+};
+
+} // namespace LSP
+
+#endif // CANCELREQUESTNOTIFICATION_HPP
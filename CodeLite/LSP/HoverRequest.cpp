@@ -9,6 +9,11 @@ LSP::HoverRequest::HoverRequest(const wxString& filename, size_t line, size_t co
     m_params->As<TextDocumentPositionParams>()->SetPosition(Position(line, column));
 }
 
+wxString LSP::HoverRequest::GetSupersedeKey() const
+{
+    return GetMethod() + "|" + m_params->As<TextDocumentPositionParams>()->GetTextDocument().GetPath();
+}
+
 void LSP::HoverRequest::OnResponse(const LSP::ResponseMessage& response, wxEvtHandler* owner)
 {
     if(!response.Has("result")) {
@@ -43,6 +43,13 @@ public:
         return true;
     }
 
+    /**
+     * @brief requests sharing the same (non empty) key supersede each other: once a newer request with the
+     * same key is queued, the older one is cancelled and its response is dropped. By default, requests are
+     * never superseded
+     */
+    virtual wxString GetSupersedeKey() const { return wxEmptyString; }
+
     /**
      * @brief this method will get called by the protocol for handling the response.
      * Override it in the various requests
@@ -17,6 +17,7 @@ public:
     ~SemanticTokensRequest() override = default;
 
     void OnResponse(const LSP::ResponseMessage& response, wxEvtHandler* owner) override;
+    wxString GetSupersedeKey() const override { return GetMethod() + "|" + m_filename; }
 };
 } // namespace LSP
 
@@ -20,6 +20,7 @@ public:
     void OnResponse(const LSP::ResponseMessage& response, wxEvtHandler* owner);
     bool IsPositionDependantRequest() const { return true; }
     bool IsValidAt(const wxString& filename, size_t line, size_t col) const;
+    wxString GetSupersedeKey() const override { return GetMethod() + "|" + m_filename; }
 };
 };     // namespace LSP
 #endif // SIGNATUREHELPREQUEST_H
@@ -0,0 +1,122 @@
+#include "LineRanges.hpp"
+
+#include "StringUtils.h"
+#include "file_logger.h"
+#include "procutils.h"
+
+#include <algorithm>
+#include <wx/filename.h>
+#include <wx/tokenzr.h>
+
+namespace
+{
+/// parse "c" or "c,d" into a range of lines, return false if the hunk contains no new lines
+bool parse_hunk_range(const wxString& spec, size_t* first, size_t* last)
+{
+    unsigned long start = 0;
+    unsigned long count = 1;
+    wxString start_str = spec.BeforeFirst(',');
+    if (!start_str.ToCULong(&start)) {
+        return false;
+    }
+
+    if (spec.Contains(",") && !spec.AfterFirst(',').ToCULong(&count)) {
+        return false;
+    }
+
+    if (count == 0) {
+        // lines were only deleted: `start` is the line before the deletion, format it so the code around the
+        // deleted block is fixed too
+        if (start == 0) {
+            return false;
+        }
+        count = 1;
+    }
+    *first = start;
+    *last = start + count - 1;
+    return true;
+}
+} // namespace
+
+void LineRanges::Add(size_t first, size_t last)
+{
+    if (first > last) {
+        std::swap(first, last);
+    }
+
+    // find the first range that may overlap (or touch) the new one
+    auto iter = std::lower_bound(m_ranges.begin(), m_ranges.end(), first, [](const Range& range, size_t line) {
+        return range.second + 1 < line;
+    });
+
+    // merge all the ranges overlapping [first, last]
+    auto end = iter;
+    while (end != m_ranges.end() && end->first <= last + 1) {
+        first = std::min(first, end->first);
+        last = std::max(last, end->second);
+        ++end;
+    }
+    iter = m_ranges.erase(iter, end);
+    m_ranges.insert(iter, { first, last });
+}
+
+LineRanges LineRanges::FromLines(const std::vector<int>& lines)
+{
+    LineRanges ranges;
+    for (int line : lines) {
+        if (line >= 0) {
+            ranges.Add(line + 1, line + 1);
+        }
+    }
+    return ranges;
+}
+
+LineRanges LineRanges::FromUnifiedDiff(const wxString& diff)
+{
+    LineRanges ranges;
+    wxArrayString lines = wxStringTokenize(diff, "\n", wxTOKEN_STRTOK);
+    for (const wxString& line : lines) {
+        if (!line.StartsWith("@@ ")) {
+            continue;
+        }
+
+        // @@ -a,b +c,d @@ optional context
+        wxString new_side = line.AfterFirst('+').BeforeFirst(' ');
+        size_t first = 0;
+        size_t last = 0;
+        if (parse_hunk_range(new_side, &first, &last)) {
+            ranges.Add(first, last);
+        }
+    }
+    return ranges;
+}
+
+bool LineRanges::FromGitDiff(const wxString& filepath, LineRanges* ranges)
+{
+    wxFileName fn{ filepath };
+    wxString git_dir = StringUtils::WrapWithDoubleQuotes(fn.GetPath());
+    wxString name = StringUtils::WrapWithDoubleQuotes(fn.GetFullName());
+
+    wxString command;
+    command << "git -C " << git_dir << " diff --no-color --no-ext-diff -U0 HEAD -- " << name;
+
+    wxString output;
+    if (ProcUtils::ShellExecSync(command, &output) != 0) {
+        clDEBUG() << "Could not get git diff for file:" << filepath << ":" << output << endl;
+        return false;
+    }
+
+    if (output.empty()) {
+        // an untracked file has no diff either, but all of its lines are new
+        command.clear();
+        command << "git -C " << git_dir << " ls-files --error-unmatch -- " << name;
+        if (ProcUtils::ShellExecSync(command, &output) != 0) {
+            return false;
+        }
+        *ranges = LineRanges{};
+        return true;
+    }
+
+    *ranges = FromUnifiedDiff(output);
+    return true;
+}
@@ -0,0 +1,44 @@
+#ifndef LINERANGES_HPP
+#define LINERANGES_HPP
+
+#include "codelite_exports.h"
+
+#include <utility>
+#include <vector>
+#include <wx/string.h>
+
+/// A sorted list of non overlapping line ranges. Lines are 1 based and the ranges are inclusive, which is what
+/// formatters expect (e.g. `clang-format --lines=first:last`)
+class WXDLLIMPEXP_CL LineRanges
+{
+public:
+    using Range = std::pair<size_t, size_t>;
+
+private:
+    std::vector<Range> m_ranges;
+
+public:
+    LineRanges() = default;
+    ~LineRanges() = default;
+
+    /// add [first, last], merging it with overlapping or adjacent ranges
+    void Add(size_t first, size_t last);
+
+    bool IsEmpty() const { return m_ranges.empty(); }
+    const std::vector<Range>& GetRanges() const { return m_ranges; }
+
+    /// build the ranges from a list of 0 based line numbers (e.g. the editor modified lines)
+    static LineRanges FromLines(const std::vector<int>& lines);
+
+    /// parse the "+" side of the hunk headers of a unified diff (`@@ -a,b +c,d @@`)
+    static LineRanges FromUnifiedDiff(const wxString& diff);
+
+    /**
+     * @brief the lines of `filepath` that differ from git HEAD
+     * @return false if the ranges could not be determined (git is not installed, the file is not tracked, ...).
+     * On success, `ranges` may be empty if the file is not modified
+     */
+    static bool FromGitDiff(const wxString& filepath, LineRanges* ranges);
+};
+
+#endif // LINERANGES_HPP
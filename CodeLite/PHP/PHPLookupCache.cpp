@@ -0,0 +1,191 @@
+#include "PHPLookupCache.h"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+namespace
+{
+// the journal keeps the last N modifications. A cache that fell behind is cleared
+constexpr size_t MAX_JOURNAL_SIZE = 4096;
+
+// do not let the cache grow without limits
+constexpr size_t MAX_ENTRIES = 20000;
+
+struct JournalEntry {
+    size_t version = 0;
+    wxString filename; // empty means "everything"
+};
+
+std::mutex journalLock;
+std::deque<JournalEntry> journal;
+std::atomic_size_t journalVersion{ 0 };
+
+void AddJournalEntry(const wxString& filename)
+{
+    std::lock_guard<std::mutex> lk{ journalLock };
+    size_t version = journalVersion.load() + 1;
+    journal.push_back({ version, filename });
+    if (journal.size() > MAX_JOURNAL_SIZE) {
+        journal.pop_front();
+    }
+    journalVersion.store(version);
+}
+} // namespace
+
+PHPLookupCache::PHPLookupCache()
+    : m_journalVersion(journalVersion.load())
+{
+}
+
+void PHPLookupCache::FileChanged(const wxString& filename) { AddJournalEntry(filename); }
+
+void PHPLookupCache::DatabaseChanged() { AddJournalEntry(wxEmptyString); }
+
+void PHPLookupCache::Sync()
+{
+    if (m_journalVersion == journalVersion.load()) {
+        // nothing has changed
+        return;
+    }
+
+    std::vector<wxString> files;
+    bool clearAll = false;
+    {
+        std::lock_guard<std::mutex> lk{ journalLock };
+        if (journal.empty() || journal.front().version > m_journalVersion + 1) {
+            // we missed some modifications
+            clearAll = true;
+        } else {
+            for (const auto& entry : journal) {
+                if (entry.version <= m_journalVersion) {
+                    continue;
+                }
+                if (entry.filename.empty()) {
+                    clearAll = true;
+                    break;
+                }
+                files.push_back(entry.filename);
+            }
+        }
+        m_journalVersion = journalVersion.load();
+    }
+
+    if (clearAll) {
+        Clear();
+        return;
+    }
+
+    // entries that depend on unknown files are no longer valid
+    std::vector<wxString> keys{ m_anyFileKeys.begin(), m_anyFileKeys.end() };
+    for (const wxString& key : keys) {
+        DoRemove(key);
+    }
+
+    for (const wxString& filename : files) {
+        DoInvalidateFile(filename);
+    }
+}
+
+void PHPLookupCache::DoInvalidateFile(const wxString& filename)
+{
+    auto iter = m_fileToKeys.find(filename);
+    if (iter == m_fileToKeys.end()) {
+        return;
+    }
+
+    // DoRemove modifies m_fileToKeys, work on a copy
+    std::unordered_set<wxString> keys;
+    keys.swap(iter->second);
+    m_fileToKeys.erase(iter);
+    for (const wxString& key : keys) {
+        DoRemove(key);
+    }
+}
+
+void PHPLookupCache::DoRemove(const wxString& key)
+{
+    auto iter = m_entries.find(key);
+    if (iter == m_entries.end()) {
+        return;
+    }
+
+    for (const wxString& filename : iter->second.files) {
+        auto fileIter = m_fileToKeys.find(filename);
+        if (fileIter != m_fileToKeys.end()) {
+            fileIter->second.erase(key);
+            if (fileIter->second.empty()) {
+                m_fileToKeys.erase(fileIter);
+            }
+        }
+    }
+    m_anyFileKeys.erase(key);
+    m_entries.erase(iter);
+}
+
+bool PHPLookupCache::Get(const wxString& key, PHPEntityBase::List_t& matches)
+{
+    auto iter = m_entries.find(key);
+    if (iter == m_entries.end()) {
+        ++m_misses;
+        return false;
+    }
+    ++m_hits;
+    matches = iter->second.matches;
+    return true;
+}
+
+bool PHPLookupCache::Get(const wxString& key, PHPEntityBase::Ptr_t& match)
+{
+    PHPEntityBase::List_t matches;
+    if (!Get(key, matches)) {
+        return false;
+    }
+    match = matches.empty() ? PHPEntityBase::Ptr_t(nullptr) : matches.front();
+    return true;
+}
+
+void PHPLookupCache::Put(const wxString& key,
+                         const PHPEntityBase::List_t& matches,
+                         const std::unordered_set<wxString>& files,
+                         bool anyFile)
+{
+    if (m_entries.size() >= MAX_ENTRIES) {
+        Clear();
+    }
+
+    DoRemove(key);
+    Entry& entry = m_entries[key];
+    entry.matches = matches;
+    entry.files = files;
+    entry.anyFile = anyFile || matches.empty();
+    for (const auto& match : matches) {
+        entry.files.insert(match->GetFilename().GetFullPath());
+    }
+
+    for (const wxString& filename : entry.files) {
+        m_fileToKeys[filename].insert(key);
+    }
+    if (entry.anyFile) {
+        m_anyFileKeys.insert(key);
+    }
+}
+
+void PHPLookupCache::Put(const wxString& key,
+                         PHPEntityBase::Ptr_t match,
+                         const std::unordered_set<wxString>& files,
+                         bool anyFile)
+{
+    PHPEntityBase::List_t matches;
+    if (match) {
+        matches.push_back(match);
+    }
+    Put(key, matches, files, anyFile);
+}
+
+void PHPLookupCache::Clear()
+{
+    m_entries.clear();
+    m_fileToKeys.clear();
+    m_anyFileKeys.clear();
+}
@@ -0,0 +1,88 @@
+#ifndef PHPLOOKUPCACHE_H
+#define PHPLOOKUPCACHE_H
+
+#include "PHPEntityBase.h"
+#include "codelite_exports.h"
+#include "wxStringHash.h"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <wx/string.h>
+
+/**
+ * @class PHPLookupCache
+ * @brief an in-memory cache for the PHPLookupTable queries used by the code completion
+ * (FindClass, FindMemberOf and FindChildren).
+ *
+ * Every entry records the files it was built from. Since the database is updated by a different
+ * PHPLookupTable instance (the parser thread), the updated files are published into a process wide
+ * journal which each cache replays before it is used, dropping only the entries of the modified files
+ */
+class WXDLLIMPEXP_CL PHPLookupCache
+{
+    struct Entry {
+        PHPEntityBase::List_t matches;
+        std::unordered_set<wxString> files;
+        // the entry depends on files we can't know about (e.g. a namespace content, or an empty result)
+        bool anyFile = false;
+    };
+
+    std::unordered_map<wxString, Entry> m_entries;
+    std::unordered_map<wxString, std::unordered_set<wxString>> m_fileToKeys;
+    std::unordered_set<wxString> m_anyFileKeys;
+    size_t m_journalVersion = 0;
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+
+private:
+    void DoRemove(const wxString& key);
+    void DoInvalidateFile(const wxString& filename);
+
+public:
+    PHPLookupCache();
+    ~PHPLookupCache() = default;
+
+    /**
+     * @brief publish a file modification to all the caches in this process
+     */
+    static void FileChanged(const wxString& filename);
+
+    /**
+     * @brief publish a modification of the entire database (e.g. the database was cleared)
+     */
+    static void DatabaseChanged();
+
+    /**
+     * @brief apply the modifications published since the last call
+     */
+    void Sync();
+
+    /**
+     * @brief find a cached result
+     */
+    bool Get(const wxString& key, PHPEntityBase::List_t& matches);
+    bool Get(const wxString& key, PHPEntityBase::Ptr_t& match);
+
+    /**
+     * @brief cache a result. `files` are the files that the result depends on. When `anyFile` is true
+     * the entry is dropped on every modification
+     */
+    void Put(const wxString& key,
+             const PHPEntityBase::List_t& matches,
+             const std::unordered_set<wxString>& files,
+             bool anyFile = false);
+    void Put(const wxString& key,
+             PHPEntityBase::Ptr_t match,
+             const std::unordered_set<wxString>& files,
+             bool anyFile = false);
+
+    /**
+     * @brief drop all the cached entries
+     */
+    void Clear();
+
+    size_t GetHits() const { return m_hits; }
+    size_t GetMisses() const { return m_misses; }
+};
+
+#endif // PHPLOOKUPCACHE_H
@@ -5,6 +5,7 @@
 #include "PHPEntityFunctionAlias.h"
 #include "PHPEntityNamespace.h"
 #include "PHPEntityVariable.h"
+#include "clFileContentCache.hpp"
 #include "clFilesCollector.h"
 #include "event_notifier.h"
 #include "file_logger.h"
@@ -12,6 +13,12 @@
 #include "fileutils.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <wx/filename.h>
 #include <wx/log.h>
 #include <wx/stopwatch.h>
@@ -23,6 +30,15 @@ wxDEFINE_EVENT(wxPHP_PARSE_PROGRESS, clParseEvent);
 
 static wxString PHP_SCHEMA_VERSION = "9.3.0.1";
 
+namespace
+{
+// maximum number of parsed files waiting to be stored in the database
+constexpr size_t MAX_PENDING_PARSED_FILES = 64;
+
+// when a transaction modifies more files than this, invalidate the caches entirely
+constexpr size_t MAX_PUBLISHED_FILES = 1000;
+} // namespace
+
 //------------------------------------------------
 // Metadata table
 //------------------------------------------------
@@ -170,30 +186,43 @@ PHPLookupTable::~PHPLookupTable() { Close(); }
 
 PHPEntityBase::Ptr_t PHPLookupTable::FindMemberOf(wxLongLong parentDbId, const wxString& exactName, size_t flags)
 {
+    m_cache.Sync();
+    wxString key;
+    key << "member:" << parentDbId.ToString() << ":" << flags << ":" << exactName;
+
+    PHPEntityBase::Ptr_t match(NULL);
+    if(m_cache.Get(key, match)) {
+        return match;
+    }
+
     // find the entity
+    std::unordered_set<wxString> files;
+    bool anyFile = false;
     PHPEntityBase::Ptr_t scope = DoFindScope(parentDbId);
     if(scope && scope->Cast<PHPEntityClass>()) {
         std::vector<wxLongLong> parents;
         std::set<wxLongLong> parentsVisited;
 
-        DoGetInheritanceParentIDs(scope, parents, parentsVisited, flags & kLookupFlags_Parent);
+        DoGetInheritanceParentIDs(scope, parents, parentsVisited, flags & kLookupFlags_Parent, &files);
         // std::reverse(parents.begin(), parents.end());
 
         // Parents should now contain an ordered list of all the inheritance
         for(size_t i = 0; i < parents.size(); ++i) {
-            PHPEntityBase::Ptr_t match = DoFindMemberOf(parents.at(i), exactName);
+            match = DoFindMemberOf(parents.at(i), exactName);
             if(match) {
                 PHPEntityBase::List_t matches;
                 matches.push_back(match);
                 DoFixVarsDocComment(matches, parentDbId);
-                return match;
+                break;
             }
         }
     } else {
-        // namespace
-        return DoFindMemberOf(parentDbId, exactName, true);
+        // namespace, its members can come from any file
+        match = DoFindMemberOf(parentDbId, exactName, true);
+        anyFile = true;
     }
-    return PHPEntityBase::Ptr_t(NULL);
+    m_cache.Put(key, match, files, anyFile);
+    return match;
 }
 
 PHPEntityBase::Ptr_t PHPLookupTable::FindScope(const wxString& fullname)
@@ -220,6 +249,7 @@ void PHPLookupTable::Open(const wxFileName& dbfile)
         m_db.Open(dbfile.GetFullPath());
         m_db.SetBusyTimeout(10); // Don't lock when we cant access to the database
         m_filename = dbfile;
+        m_cache.Clear();
         CreateSchema();
 
     } catch (const wxSQLite3Exception& e) {
@@ -388,12 +418,16 @@ void PHPLookupTable::UpdateSourceFile(PHPSourceFile& source, bool autoCommit)
             }
         }
 
-        if(autoCommit)
+        if(autoCommit) {
             m_db.Commit();
+            DoPublishChangedFiles();
+        }
 
     } catch (const wxSQLite3Exception& e) {
-        if(autoCommit)
+        if(autoCommit) {
             m_db.Rollback();
+            DoPublishChangedFiles();
+        }
         clWARNING() << "PHPLookupTable::SaveSourceFile" << e.GetMessage() << endl;
     }
 }
@@ -504,18 +538,23 @@ PHPEntityBase::Ptr_t PHPLookupTable::DoFindMemberOf(wxLongLong parentDbId, const
 }
 
 void PHPLookupTable::DoGetInheritanceParentIDs(PHPEntityBase::Ptr_t cls, std::vector<wxLongLong>& parents,
-                                               std::set<wxLongLong>& parentsVisited, bool excludeSelf)
+                                               std::set<wxLongLong>& parentsVisited, bool excludeSelf,
+                                               std::unordered_set<wxString>* files)
 {
     if(!excludeSelf) {
         parents.push_back(cls->GetDbId());
     }
 
+    if(files) {
+        files->insert(cls->GetFilename().GetFullPath());
+    }
+
     parentsVisited.insert(cls->GetDbId());
     wxArrayString parentsArr = cls->Cast<PHPEntityClass>()->GetInheritanceArray();
     for(size_t i = 0; i < parentsArr.GetCount(); ++i) {
         PHPEntityBase::Ptr_t parent = FindClass(parentsArr.Item(i));
         if(parent && !parentsVisited.count(parent->GetDbId())) {
-            DoGetInheritanceParentIDs(parent, parents, parentsVisited, false);
+            DoGetInheritanceParentIDs(parent, parents, parentsVisited, false, files);
         }
     }
 }
@@ -564,7 +603,17 @@ PHPEntityBase::Ptr_t PHPLookupTable::DoFindScope(const wxString& fullname, ePhpS
 
 PHPEntityBase::Ptr_t PHPLookupTable::FindClass(const wxString& fullname)
 {
-    return DoFindScope(fullname, kPhpScopeTypeClass);
+    m_cache.Sync();
+    wxString key;
+    key << "class:" << fullname;
+
+    PHPEntityBase::Ptr_t match(NULL);
+    if(m_cache.Get(key, match)) {
+        return match;
+    }
+    match = DoFindScope(fullname, kPhpScopeTypeClass);
+    m_cache.Put(key, match, {});
+    return match;
 }
 
 PHPEntityBase::Ptr_t PHPLookupTable::DoFindScope(wxLongLong id, ePhpScopeType scopeType)
@@ -605,13 +654,23 @@ PHPEntityBase::Ptr_t PHPLookupTable::DoFindScope(wxLongLong id, ePhpScopeType sc
 
 PHPEntityBase::List_t PHPLookupTable::FindChildren(wxLongLong parentId, size_t flags, const wxString& nameHint)
 {
+    m_cache.Sync();
+    wxString key;
+    key << "children:" << parentId.ToString() << ":" << flags << ":" << nameHint;
+
     PHPEntityBase::List_t matches, matchesNoAbstracts;
+    if(m_cache.Get(key, matches)) {
+        return matches;
+    }
+
+    std::unordered_set<wxString> files;
+    bool anyFile = false;
     PHPEntityBase::Ptr_t scope = DoFindScope(parentId);
     if(scope && scope->Is(kEntityTypeClass)) {
         std::vector<wxLongLong> parents;
         std::set<wxLongLong> parentsVisited;
 
-        DoGetInheritanceParentIDs(scope, parents, parentsVisited, flags & kLookupFlags_Parent);
+        DoGetInheritanceParentIDs(scope, parents, parentsVisited, flags & kLookupFlags_Parent, &files);
         // Reverse the order of the parents
         std::reverse(parents.begin(), parents.end());
 
@@ -629,8 +688,11 @@ PHPEntityBase::List_t PHPLookupTable::FindChildren(wxLongLong parentId, size_t f
             matches.swap(matchesNoAbstracts);
         }
     } else if(scope && scope->Is(kEntityTypeNamespace)) {
+        // the namespace children can come from any file
         DoFindChildren(matches, parentId, flags | kLookupFlags_NameHintIsScope, nameHint);
+        anyFile = true;
     }
+    m_cache.Put(key, matches, files, anyFile);
     return matches;
 }
 
@@ -763,6 +825,7 @@ void PHPLookupTable::LoadFromTableByNameHint(PHPEntityBase::List_t& matches, con
 
 void PHPLookupTable::DeleteFileEntries(const wxFileName& filename, bool autoCommit)
 {
+    m_changedFiles.push_back(filename.GetFullPath());
     try {
         if(autoCommit)
             m_db.Begin();
@@ -817,11 +880,15 @@ void PHPLookupTable::DeleteFileEntries(const wxFileName& filename, bool autoComm
             st.ExecuteUpdate();
         }
 
-        if(autoCommit)
+        if(autoCommit) {
             m_db.Commit();
+            DoPublishChangedFiles();
+        }
     } catch (const wxSQLite3Exception& e) {
-        if(autoCommit)
+        if(autoCommit) {
             m_db.Rollback();
+            DoPublishChangedFiles();
+        }
         clWARNING() << "PHPLookupTable::DeleteFileEntries" << e.GetMessage() << endl;
     }
 }
@@ -833,7 +900,17 @@ void PHPLookupTable::Close()
             m_db.Close();
         }
         m_filename.Clear();
-        m_allClasses.clear();
+        {
+            std::unique_lock<std::shared_mutex> lk{ m_allClassesLock };
+            m_allClasses.clear();
+            m_newClasses.clear();
+        }
+
+        if(m_cache.GetHits() || m_cache.GetMisses()) {
+            clDEBUG() << "PHP lookup cache:" << m_cache.GetHits() << "hits," << m_cache.GetMisses() << "misses"
+                      << clEndl;
+        }
+        m_cache.Clear();
 
     } catch (const wxSQLite3Exception& e) {
         clWARNING() << "PHPLookupTable::Close" << e.GetMessage() << endl;
@@ -1028,6 +1105,7 @@ void PHPLookupTable::ClearAll(bool autoCommit)
             m_db.Rollback();
         clWARNING() << "PHPLookupTable::ClearAll" << e.GetMessage() << endl;
     }
+    PHPLookupCache::DatabaseChanged();
 }
 
 PHPEntityBase::Ptr_t PHPLookupTable::FindFunction(const wxString& fullname)
@@ -1154,6 +1232,7 @@ void PHPLookupTable::ResetDatabase()
             // ??
         }
     }
+    PHPLookupCache::DatabaseChanged();
     Open(curfile);
 }
 
@@ -1306,18 +1385,42 @@ void PHPLookupTable::DoFixVarsDocComment(PHPEntityBase::List_t& matches, wxLongL
 
 void PHPLookupTable::UpdateClassCache(const wxString& classname)
 {
-    if(m_allClasses.count(classname) == 0) {
+    std::unique_lock<std::shared_mutex> lk{ m_allClassesLock };
+    if(m_classCacheFrozen) {
+        m_newClasses.insert(classname);
+    } else {
         m_allClasses.insert(classname);
     }
 }
 
-bool PHPLookupTable::ClassExists(const wxString& classname) const { return m_allClasses.count(classname) != 0; }
+void PHPLookupTable::DoFreezeClassCache()
+{
+    std::unique_lock<std::shared_mutex> lk{ m_allClassesLock };
+    m_classCacheFrozen = true;
+}
+
+void PHPLookupTable::DoThawClassCache()
+{
+    std::unique_lock<std::shared_mutex> lk{ m_allClassesLock };
+    m_classCacheFrozen = false;
+    m_allClasses.insert(m_newClasses.begin(), m_newClasses.end());
+    m_newClasses.clear();
+}
+
+bool PHPLookupTable::ClassExists(const wxString& classname) const
+{
+    std::shared_lock<std::shared_mutex> lk{ m_allClassesLock };
+    return m_allClasses.count(classname) != 0;
+}
 
 void PHPLookupTable::RebuildClassCache()
 {
     // locate the scope
     clDEBUG() << "Rebuilding PHP class cache..." << clEndl;
-    m_allClasses.clear();
+    {
+        std::unique_lock<std::shared_mutex> lk{ m_allClassesLock };
+        m_allClasses.clear();
+    }
     size_t count = 0;
     try {
         wxString sql;
@@ -1359,3 +1462,193 @@ size_t PHPLookupTable::FindFunctionsByFile(const wxFileName& filename, PHPEntity
     }
     return functions.size();
 }
+
+void PHPLookupTable::DoPublishChangedFiles()
+{
+    if(m_changedFiles.size() > MAX_PUBLISHED_FILES) {
+        PHPLookupCache::DatabaseChanged();
+    } else {
+        for(const wxString& filename : m_changedFiles) {
+            PHPLookupCache::FileChanged(filename);
+        }
+    }
+    m_changedFiles.clear();
+}
+
+void PHPLookupTable::DoRecreateSymbolsDatabase(const wxArrayString& files, eUpdateMode updateMode,
+                                               const std::function<bool()>& goingDown, bool parseFuncBodies)
+{
+    {
+        clParseEvent event(wxPHP_PARSE_STARTED);
+        event.SetTotalFiles(files.GetCount());
+        event.SetCurfileIndex(0);
+        EventNotifier::Get()->AddPendingEvent(event);
+    }
+
+    wxStopWatch sw;
+    sw.Start();
+
+    // Step 1: select the files that need to be parsed. This is done on this thread
+    // since the database connection can not be shared with the parsing threads
+    wxArrayString filesToParse;
+    filesToParse.reserve(files.GetCount());
+    for(size_t i = 0; i < files.GetCount(); ++i) {
+        if(goingDown()) {
+            break;
+        }
+
+        wxFileName fnFile(files.Item(i));
+
+        // Parse only valid PHP files
+        if(FileExtManager::GetType(fnFile.GetFullName()) != FileExtManager::TypePhp) {
+            continue;
+        }
+
+        // Ensure that the file exists
+        if(!fnFile.Exists()) {
+            continue;
+        }
+
+        if(updateMode == kUpdateMode_Fast) {
+            // Check to see if we need to re-parse this file
+            time_t lastModifiedOnDisk = fnFile.GetModificationTime().GetTicks();
+            wxLongLong lastModifiedInDB = GetFileLastParsedTimestamp(fnFile);
+            if(lastModifiedOnDisk <= lastModifiedInDB.ToLong()) {
+                continue;
+            }
+        }
+        filesToParse.Add(files.Item(i));
+    }
+
+    // Step 2: parse the files using a pool of threads. The parsed files are stored
+    // from this thread, using a single transaction.
+    // While parsing, types are resolved against the classes known before the parsing started: the classes
+    // stored meanwhile are only added to the class cache once all the workers are done, so the result does not
+    // depend on which files were stored first
+    size_t workersCount = std::max(1u, std::thread::hardware_concurrency());
+    workersCount = std::min(workersCount, std::max((size_t)1, filesToParse.size()));
+
+    std::atomic_size_t nextFile{ 0 };
+    std::atomic_bool stopParsing{ false };
+    std::mutex queueLock;
+    std::condition_variable queueNotEmpty;
+    std::condition_variable queueNotFull;
+    std::deque<std::unique_ptr<PHPSourceFile>> parsedQueue;
+    size_t workersDone = 0;
+
+    auto parse_files = [&]() {
+        while(!stopParsing.load()) {
+            size_t index = nextFile.fetch_add(1);
+            if(index >= filesToParse.size()) {
+                break;
+            }
+
+            // For performance reaons, load the file into memory and then parse it
+            wxFileName fnSourceFile(filesToParse.Item(index));
+            auto content = clFileContentCache::Get().Read(fnSourceFile.GetFullPath(), wxFONTENCODING_ISO8859_1);
+            if(!content) {
+                clWARNING() << "PHP: Failed to read file:" << fnSourceFile << "for parsing" << clEndl;
+                continue;
+            }
+
+            std::unique_ptr<PHPSourceFile> sourceFile(new PHPSourceFile(*content, this));
+            sourceFile->SetFilename(fnSourceFile);
+            sourceFile->SetParseFunctionBody(parseFuncBodies);
+            sourceFile->Parse();
+
+            std::unique_lock<std::mutex> lk{ queueLock };
+            queueNotFull.wait(lk, [&]() { return stopParsing.load() || parsedQueue.size() < MAX_PENDING_PARSED_FILES; });
+            if(stopParsing.load()) {
+                break;
+            }
+            parsedQueue.push_back(std::move(sourceFile));
+            queueNotEmpty.notify_one();
+        }
+
+        std::unique_lock<std::mutex> lk{ queueLock };
+        ++workersDone;
+        queueNotEmpty.notify_one();
+    };
+
+    std::vector<std::thread> workers;
+    auto stop_workers = [&]() {
+        {
+            std::unique_lock<std::mutex> lk{ queueLock };
+            stopParsing.store(true);
+        }
+        queueNotFull.notify_all();
+        for(auto& worker : workers) {
+            worker.join();
+        }
+        workers.clear();
+        DoThawClassCache();
+    };
+
+    try {
+        m_db.Begin();
+        DoFreezeClassCache();
+        for(size_t i = 0; i < workersCount; ++i) {
+            workers.emplace_back(parse_files);
+        }
+
+        size_t filesSkipped = files.GetCount() - filesToParse.size();
+        size_t filesStored = 0;
+        while(true) {
+            std::unique_ptr<PHPSourceFile> sourceFile;
+            {
+                std::unique_lock<std::mutex> lk{ queueLock };
+                queueNotEmpty.wait(lk, [&]() { return !parsedQueue.empty() || workersDone == workersCount; });
+                if(parsedQueue.empty()) {
+                    // all the workers are done
+                    break;
+                }
+                sourceFile = std::move(parsedQueue.front());
+                parsedQueue.pop_front();
+            }
+            queueNotFull.notify_one();
+
+            if(goingDown()) {
+                break;
+            }
+
+            {
+                clParseEvent event(wxPHP_PARSE_PROGRESS);
+                event.SetTotalFiles(files.GetCount());
+                event.SetCurfileIndex(filesSkipped + filesStored);
+                event.SetFileName(sourceFile->GetFilename().GetFullPath());
+                EventNotifier::Get()->AddPendingEvent(event);
+            }
+            UpdateSourceFile(*sourceFile, false);
+            ++filesStored;
+        }
+        stop_workers();
+        m_db.Commit();
+        DoPublishChangedFiles();
+
+        long elapsedMs = sw.Time();
+        LOG_IF_TRACE
+        {
+            clDEBUG1() << _("PHP: parsed ") << filesStored << "/" << files.GetCount() << " files in " << elapsedMs
+                       << " milliseconds using" << workersCount << "threads" << clEndl;
+            clFileContentCache::Get().LogStats("PHP:");
+        }
+
+    } catch (const wxSQLite3Exception& e) {
+        stop_workers();
+        try {
+            m_db.Rollback();
+
+        } catch (...) {
+        }
+        DoPublishChangedFiles();
+        clWARNING() << "PHPLookupTable::UpdateSourceFiles:" << e.GetMessage() << clEndl;
+    }
+
+    {
+        // always make sure that the end event is sent
+        clParseEvent event(wxPHP_PARSE_ENDED);
+        event.SetTotalFiles(files.GetCount());
+        event.SetCurfileIndex(files.GetCount());
+        EventNotifier::Get()->AddPendingEvent(event);
+    }
+}
@@ -27,6 +27,7 @@
 #define PHPLOOKUPTABLE_H
 
 #include "PHPEntityBase.h"
+#include "PHPLookupCache.h"
 #include "PHPSourceFile.h"
 #include "cl_command_event.h"
 #include "codelite_exports.h"
@@ -36,7 +37,9 @@
 #include "fileutils.h"
 #include "wxStringHash.h"
 
+#include <functional>
 #include <set>
+#include <shared_mutex>
 #include <unordered_set>
 #include <vector>
 #include <wx/longlong.h>
@@ -65,6 +68,14 @@ class WXDLLIMPEXP_CL PHPLookupTable
     wxFileName m_filename;
     size_t m_sizeLimit;
     std::unordered_set<wxString> m_allClasses;
+    // while the parsing threads run, the class cache is frozen and the stored classes are kept here
+    std::unordered_set<wxString> m_newClasses;
+    bool m_classCacheFrozen = false;
+    // the class cache is accessed by the parsing threads
+    mutable std::shared_mutex m_allClassesLock;
+    PHPLookupCache m_cache;
+    // files modified by the current transaction, published to the caches once committed
+    std::vector<wxString> m_changedFiles;
 
 public:
     enum eLookupFlags {
@@ -99,9 +110,27 @@ private:
     PHPEntityBase::Ptr_t DoFindMemberOf(wxLongLong parentDbId, const wxString& exactName,
                                         bool parentIsNamespace = false);
 
+    /// override the type of the variables in `matches` with their PHPDoc. Modifies the entities in place, so it
+    /// must only be called on entities just loaded from the database, before they are cached
     void DoFixVarsDocComment(PHPEntityBase::List_t& matches, wxLongLong parentId);
+    /// freeze the class cache so the types resolved by the parsing threads do not depend on the order the files are
+    /// stored. The classes stored while the cache is frozen are added when it is thawed
+    void DoFreezeClassCache();
+    void DoThawClassCache();
     void DoGetInheritanceParentIDs(PHPEntityBase::Ptr_t cls, std::vector<wxLongLong>& parents,
-                                   std::set<wxLongLong>& parentsVisited, bool excludeSelf);
+                                   std::set<wxLongLong>& parentsVisited, bool excludeSelf,
+                                   std::unordered_set<wxString>* files = nullptr);
+
+    /**
+     * @brief notify the lookup caches about the files modified by the last transaction
+     */
+    void DoPublishChangedFiles();
+
+    /**
+     * @brief parse the files using a pool of threads and store them using a single transaction
+     */
+    void DoRecreateSymbolsDatabase(const wxArrayString& files, eUpdateMode updateMode,
+                                   const std::function<bool()>& goingDown, bool parseFuncBodies);
 
     /**
      * @brief find namespace by fullname. If it does not exist, add it and return a pointer to it
@@ -298,107 +327,7 @@ template <typename GoindDownFunc>
 void PHPLookupTable::RecreateSymbolsDatabase(const wxArrayString& files, eUpdateMode updateMode,
                                              GoindDownFunc pFuncGoingDown, bool parseFuncBodies)
 {
-    try {
-
-        {
-            clParseEvent event(wxPHP_PARSE_STARTED);
-            event.SetTotalFiles(files.GetCount());
-            event.SetCurfileIndex(0);
-            EventNotifier::Get()->AddPendingEvent(event);
-        }
-
-        wxStopWatch sw;
-        sw.Start();
-
-        m_allClasses.clear(); // clear the cache
-        m_db.Begin();
-        for(size_t i = 0; i < files.GetCount(); ++i) {
-            if(pFuncGoingDown()) {
-                break;
-            }
-            {
-                clParseEvent event(wxPHP_PARSE_PROGRESS);
-                event.SetTotalFiles(files.GetCount());
-                event.SetCurfileIndex(i);
-                event.SetFileName(files.Item(i));
-                EventNotifier::Get()->AddPendingEvent(event);
-            }
-
-            wxFileName fnFile(files.Item(i));
-            bool reParseNeeded(true);
-
-            if(updateMode == kUpdateMode_Fast) {
-                // Check to see if we need to re-parse this file
-                // and store it to the database
-
-                if(!fnFile.Exists()) {
-                    reParseNeeded = false;
-                } else {
-                    time_t lastModifiedOnDisk = fnFile.GetModificationTime().GetTicks();
-                    wxLongLong lastModifiedInDB = GetFileLastParsedTimestamp(fnFile);
-                    if(lastModifiedOnDisk <= lastModifiedInDB.ToLong()) {
-                        reParseNeeded = false;
-                    }
-                }
-            }
-
-            // Ensure that the file exists
-            if(!fnFile.Exists()) {
-                reParseNeeded = false;
-            }
-
-            // Parse only valid PHP files
-            if(FileExtManager::GetType(fnFile.GetFullName()) != FileExtManager::TypePhp) {
-                reParseNeeded = false;
-            }
-
-            if(reParseNeeded) {
-                // For performance reaons, load the file into memory and then parse it
-                wxFileName fnSourceFile(files.Item(i));
-                wxString content;
-                if(!FileUtils::ReadFileContent(fnSourceFile, content, wxConvISO8859_1)) {
-                    clWARNING() << "PHP: Failed to read file:" << fnSourceFile << "for parsing" << clEndl;
-                    continue;
-                }
-                PHPSourceFile sourceFile(content, this);
-                sourceFile.SetFilename(fnSourceFile);
-                sourceFile.SetParseFunctionBody(parseFuncBodies);
-                sourceFile.Parse();
-                UpdateSourceFile(sourceFile, false);
-            }
-        }
-        m_db.Commit();
-        long elapsedMs = sw.Time();
-
-        LOG_IF_TRACE
-        {
-            clDEBUG1() << _("PHP: parsed ") << files.GetCount() << " in " << elapsedMs << " milliseconds" << clEndl;
-        }
-
-        {
-            clParseEvent event(wxPHP_PARSE_ENDED);
-            event.SetTotalFiles(files.GetCount());
-            event.SetCurfileIndex(files.GetCount());
-            EventNotifier::Get()->AddPendingEvent(event);
-        }
-
-    } catch (const wxSQLite3Exception& e) {
-        try {
-            m_db.Rollback();
-
-        } catch (...) {
-        }
-
-        {
-            // always make sure that the end event is sent
-            clParseEvent event(wxPHP_PARSE_ENDED);
-            event.SetTotalFiles(files.GetCount());
-            event.SetCurfileIndex(files.GetCount());
-            EventNotifier::Get()->AddPendingEvent(event);
-        }
-
-        clWARNING() << "PHPLookupTable::UpdateSourceFiles:" << e.GetMessage() << clEndl;
-    }
+    DoRecreateSymbolsDatabase(files, updateMode, std::function<bool()>(pFuncGoingDown), parseFuncBodies);
 }
 
 #endif // PHPLOOKUPTABLE_H
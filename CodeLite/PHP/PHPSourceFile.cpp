@@ -8,7 +8,7 @@
 #include "PHPLookupTable.h"
 #include "PHPScannerTokens.h"
 #include "PHPSourceFile.h"
-#include "fileutils.h"
+#include "clFileContentCache.hpp"
 #include <unordered_set>
 #include <wx/arrstr.h>
 #include <wx/ffile.h>
@@ -45,9 +45,9 @@ PHPSourceFile::PHPSourceFile(const wxFileName& filename, PHPLookupTable* lookup)
     // Filename is kept in absolute path
     m_filename.MakeAbsolute();
 
-    wxString content;
-    if(FileUtils::ReadFileContent(filename, content, wxConvISO8859_1)) {
-        m_text.swap(content);
+    auto content = clFileContentCache::Get().Read(m_filename.GetFullPath(), wxFONTENCODING_ISO8859_1);
+    if(content) {
+        m_text = *content;
     }
     m_scanner = ::phpLexerNew(m_text, kPhpLexerOpt_ReturnComments);
 }
@@ -1434,7 +1434,7 @@ void PHPSourceFile::OnEnumCase(const phpLexerToken& tok)
 
 phpLexerToken& PHPSourceFile::GetPreviousToken()
 {
-    static phpLexerToken NullToken;
+    thread_local phpLexerToken NullToken;
     if(m_lookBackTokens.size() >= 2) {
         // The last token in the list is the current one. We want the previous one
         return m_lookBackTokens.at(m_lookBackTokens.size() - 2);
@@ -1491,31 +1491,31 @@ wxString PHPSourceFile::DoMakeIdentifierAbsolute(const wxString& type, bool exac
         return m_converter->MakeIdentifierAbsolute(type);
     }
 
-    static std::unordered_set<std::string> phpKeywords;
-    if(phpKeywords.empty()) {
+    // initialized once, in a thread safe manner (files are parsed by multiple threads)
+    static const std::unordered_set<std::string> phpKeywords = {
         // List taken from https://www.php.net/manual/en/language.types.intro.php
         // Native types
-        phpKeywords.insert("bool");
-        phpKeywords.insert("int");
-        phpKeywords.insert("float");
-        phpKeywords.insert("string");
-        phpKeywords.insert("array");
-        phpKeywords.insert("object");
-        phpKeywords.insert("iterable");
-        phpKeywords.insert("callable");
-        phpKeywords.insert("null");
-        phpKeywords.insert("mixed");
-        phpKeywords.insert("void");
+        "bool",
+        "int",
+        "float",
+        "string",
+        "array",
+        "object",
+        "iterable",
+        "callable",
+        "null",
+        "mixed",
+        "void",
         // Types that are common in documentation
-        phpKeywords.insert("boolean");
-        phpKeywords.insert("integer");
-        phpKeywords.insert("double");
-        phpKeywords.insert("real");
-        phpKeywords.insert("binery");
-        phpKeywords.insert("resource");
-        phpKeywords.insert("number");
-        phpKeywords.insert("callback");
-    }
+        "boolean",
+        "integer",
+        "double",
+        "real",
+        "binery",
+        "resource",
+        "number",
+        "callback"
+    };
     wxString typeWithNS(type);
     typeWithNS.Trim().Trim(false);
 
@@ -0,0 +1,223 @@
+#include "clFileContentCache.hpp"
+
+#include "clFileSystemEvent.h"
+#include "cl_command_event.h"
+#include "codelite_events.h"
+#include "event_notifier.h"
+#include "file_logger.h"
+#include "fileutils.h"
+
+#include <wx/filefn.h>
+#include <wx/strconv.h>
+
+namespace
+{
+constexpr size_t DEFAULT_MAX_BYTES = 128 * 1024 * 1024;
+// a single file may not take more than this part of the cache
+constexpr size_t MAX_ENTRY_FRACTION = 8;
+
+/// read the size and modification time of the file with a single stat() call
+bool get_file_stat(const wxString& filepath, time_t* mtime, wxFileOffset* size)
+{
+    wxStructStat st;
+    if (wxStat(filepath, &st) != 0) {
+        return false;
+    }
+    *mtime = st.st_mtime;
+    *size = st.st_size;
+    return true;
+}
+
+bool read_file(const wxString& filepath, wxFontEncoding encoding, wxString& content)
+{
+    switch (encoding) {
+    case wxFONTENCODING_UTF8:
+        return FileUtils::ReadFileContent(filepath, content, wxConvUTF8);
+    case wxFONTENCODING_ISO8859_1:
+        return FileUtils::ReadFileContent(filepath, content, wxConvISO8859_1);
+    default:
+        return FileUtils::ReadFileContent(filepath, content, wxCSConv(encoding));
+    }
+}
+} // namespace
+
+clFileContentCache::clFileContentCache()
+    : m_maxBytes(DEFAULT_MAX_BYTES)
+{
+}
+
+clFileContentCache::~clFileContentCache()
+{
+    if (m_eventsConnected) {
+        EventNotifier::Get()->Unbind(wxEVT_FILE_SAVED, &clFileContentCache::OnFileSaved, this);
+        EventNotifier::Get()->Unbind(wxEVT_FILE_MODIFIED_EXTERNALLY, &clFileContentCache::OnFileSystemEvent, this);
+        EventNotifier::Get()->Unbind(wxEVT_FILE_DELETED, &clFileContentCache::OnFileSystemEvent, this);
+        EventNotifier::Get()->Unbind(wxEVT_FILE_RENAMED, &clFileContentCache::OnFileSystemEvent, this);
+        EventNotifier::Get()->Unbind(
+            wxEVT_FILES_MODIFIED_REPLACE_IN_FILES, &clFileContentCache::OnFileSystemEvent, this);
+    }
+}
+
+clFileContentCache& clFileContentCache::Get()
+{
+    // files are read by worker threads which may still run during static destruction, so never destroy the cache
+    static clFileContentCache* cache = new clFileContentCache();
+    return *cache;
+}
+
+void clFileContentCache::ConnectEvents()
+{
+    if (m_eventsConnected) {
+        return;
+    }
+    m_eventsConnected = true;
+    EventNotifier::Get()->Bind(wxEVT_FILE_SAVED, &clFileContentCache::OnFileSaved, this);
+    EventNotifier::Get()->Bind(wxEVT_FILE_MODIFIED_EXTERNALLY, &clFileContentCache::OnFileSystemEvent, this);
+    EventNotifier::Get()->Bind(wxEVT_FILE_DELETED, &clFileContentCache::OnFileSystemEvent, this);
+    EventNotifier::Get()->Bind(wxEVT_FILE_RENAMED, &clFileContentCache::OnFileSystemEvent, this);
+    EventNotifier::Get()->Bind(wxEVT_FILES_MODIFIED_REPLACE_IN_FILES, &clFileContentCache::OnFileSystemEvent, this);
+}
+
+clFileContentCache::Content_t clFileContentCache::Read(const wxString& filepath, wxFontEncoding encoding)
+{
+    time_t mtime = 0;
+    wxFileOffset size = 0;
+    if (!get_file_stat(filepath, &mtime, &size)) {
+        Invalidate(filepath);
+        return nullptr;
+    }
+
+    {
+        std::lock_guard lock{ m_mutex };
+        auto iter = m_entries.find(filepath);
+        if (iter != m_entries.end()) {
+            Entry& entry = iter->second;
+            if (entry.mtime == mtime && entry.size == size && entry.encoding == encoding) {
+                m_lru.splice(m_lru.begin(), m_lru, entry.lru);
+                ++m_hits;
+                return entry.content;
+            }
+            DoRemove(iter);
+        }
+    }
+    ++m_misses;
+
+    // read and decode without holding the lock
+    wxString content;
+    if (!read_file(filepath, encoding, content)) {
+        return nullptr;
+    }
+
+    Entry entry;
+    entry.content = std::make_shared<const wxString>(std::move(content));
+    entry.bytes = entry.content->length() * sizeof(wxStringCharType);
+    entry.mtime = mtime;
+    entry.size = size;
+    entry.encoding = encoding;
+
+    // the modification time has a one second resolution: a file modified again within the same second would keep
+    // its time (and possibly its size), so don't cache files that were modified that recently
+    if (mtime + 1 >= time(nullptr)) {
+        return entry.content;
+    }
+
+    Content_t result = entry.content;
+    DoInsert(filepath, std::move(entry));
+    return result;
+}
+
+void clFileContentCache::DoInsert(const wxString& filepath, Entry&& entry)
+{
+    std::lock_guard lock{ m_mutex };
+    if (entry.bytes > m_maxBytes / MAX_ENTRY_FRACTION) {
+        return;
+    }
+
+    // another thread may have read the same file meanwhile
+    auto iter = m_entries.find(filepath);
+    if (iter != m_entries.end()) {
+        DoRemove(iter);
+    }
+
+    m_lru.push_front(filepath);
+    entry.lru = m_lru.begin();
+    m_bytes += entry.bytes;
+    m_entries.insert({ filepath, std::move(entry) });
+
+    // evict the least recently used files
+    while (m_bytes > m_maxBytes && !m_lru.empty()) {
+        DoRemove(m_entries.find(m_lru.back()));
+    }
+}
+
+void clFileContentCache::DoRemove(std::unordered_map<wxString, Entry>::iterator iter)
+{
+    m_bytes -= iter->second.bytes;
+    m_lru.erase(iter->second.lru);
+    m_entries.erase(iter);
+}
+
+void clFileContentCache::Invalidate(const wxString& filepath)
+{
+    std::lock_guard lock{ m_mutex };
+    auto iter = m_entries.find(filepath);
+    if (iter != m_entries.end()) {
+        DoRemove(iter);
+    }
+}
+
+void clFileContentCache::Clear()
+{
+    std::lock_guard lock{ m_mutex };
+    m_entries.clear();
+    m_lru.clear();
+    m_bytes = 0;
+}
+
+void clFileContentCache::SetMaxSize(size_t bytes)
+{
+    std::lock_guard lock{ m_mutex };
+    m_maxBytes = bytes;
+    while (m_bytes > m_maxBytes && !m_lru.empty()) {
+        DoRemove(m_entries.find(m_lru.back()));
+    }
+}
+
+size_t clFileContentCache::GetMaxSize() const
+{
+    std::lock_guard lock{ m_mutex };
+    return m_maxBytes;
+}
+
+void clFileContentCache::LogStats(const wxString& context) const
+{
+    size_t hits = GetHits();
+    size_t lookups = hits + GetMisses();
+    size_t files = 0;
+    size_t bytes = 0;
+    {
+        std::lock_guard lock{ m_mutex };
+        files = m_entries.size();
+        bytes = m_bytes;
+    }
+
+    clDEBUG() << context << "file content cache:" << hits << "hits out of" << lookups << "lookups ("
+              << (lookups ? (hits * 100 / lookups) : 0) << "%)," << files << "files," << (bytes / 1024) << "KB"
+              << endl;
+}
+
+void clFileContentCache::OnFileSaved(clCommandEvent& event)
+{
+    event.Skip();
+    Invalidate(event.GetFileName());
+}
+
+void clFileContentCache::OnFileSystemEvent(clFileSystemEvent& event)
+{
+    event.Skip();
+    Invalidate(event.GetPath());
+    Invalidate(event.GetNewpath());
+    for (const wxString& path : event.GetPaths()) {
+        Invalidate(path);
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef CLFILECONTENTCACHE_HPP
+#define CLFILECONTENTCACHE_HPP
+
+#include "codelite_exports.h"
+#include "wxStringHash.h"
+
+#include <atomic>
+#include <ctime>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <wx/event.h>
+#include <wx/filefn.h>
+#include <wx/fontenc.h>
+#include <wx/string.h>
+
+class clCommandEvent;
+class clFileSystemEvent;
+
+/// A process-wide, size bounded cache of decoded file contents.
+/// Entries are validated against the file size and modification time on every lookup, so a file modified on the
+/// disk is never returned from the cache. The contents are immutable and shared: holding a `Content_t` keeps it
+/// alive even if the entry is evicted meanwhile. Safe to use from any thread
+class WXDLLIMPEXP_CL clFileContentCache : public wxEvtHandler
+{
+public:
+    using Content_t = std::shared_ptr<const wxString>;
+
+private:
+    struct Entry {
+        Content_t content;
+        time_t mtime = 0;
+        wxFileOffset size = 0;
+        wxFontEncoding encoding = wxFONTENCODING_UTF8;
+        size_t bytes = 0;
+        std::list<wxString>::iterator lru;
+    };
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<wxString, Entry> m_entries;
+    std::list<wxString> m_lru; // most recently used first
+    size_t m_bytes = 0;
+    size_t m_maxBytes;
+    std::atomic_size_t m_hits{ 0 };
+    std::atomic_size_t m_misses{ 0 };
+    bool m_eventsConnected = false;
+
+private:
+    clFileContentCache();
+    ~clFileContentCache() override;
+
+    void DoRemove(std::unordered_map<wxString, Entry>::iterator iter);
+    void DoInsert(const wxString& filepath, Entry&& entry);
+    void OnFileSaved(clCommandEvent& event);
+    void OnFileSystemEvent(clFileSystemEvent& event);
+
+public:
+    static clFileContentCache& Get();
+
+    /**
+     * @brief return the content of `filepath` decoded with `encoding`. The file is read from the disk only if it is
+     * not cached or if it was modified since it was cached
+     * @return nullptr if the file could not be read
+     */
+    Content_t Read(const wxString& filepath, wxFontEncoding encoding = wxFONTENCODING_UTF8);
+
+    /// drop `filepath` from the cache
+    void Invalidate(const wxString& filepath);
+    void Clear();
+
+    /// the maximum size of the cached contents, in bytes
+    void SetMaxSize(size_t bytes);
+    size_t GetMaxSize() const;
+
+    size_t GetHits() const { return m_hits.load(); }
+    size_t GetMisses() const { return m_misses.load(); }
+
+    /// write the hit rate and the cache size to the log, `context` is used as a prefix
+    void LogStats(const wxString& context) const;
+
+    /// invalidate the entries of files that are saved, renamed, deleted or modified by CodeLite.
+    /// Call once, from the main thread
+    void ConnectEvents();
+};
+
+#endif // CLFILECONTENTCACHE_HPP
@@ -0,0 +1,215 @@
+#include "clPathStore.hpp"
+
+#include <cstring>
+#include <string>
+
+namespace
+{
+constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+#ifdef __WXMSW__
+constexpr char PATH_SEPARATOR = '\\';
+bool is_separator(char ch) { return ch == '\\' || ch == '/'; }
+#else
+constexpr char PATH_SEPARATOR = '/';
+bool is_separator(char ch) { return ch == '/'; }
+#endif
+
+uint64_t make_key(clPathStore::Id parent, clPathStore::Id name) { return (uint64_t(parent) << 32) | name; }
+
+/// the approximate size of an unordered_map with `map.size()` entries
+template <typename Map> size_t hash_map_size(const Map& map)
+{
+    // each entry is a node holding the value and a "next" pointer, plus the bucket array
+    return map.size() * (sizeof(typename Map::value_type) + 2 * sizeof(void*)) + map.bucket_count() * sizeof(void*);
+}
+
+/// call `on_dir` for each directory component of `path`, then return the file name
+template <typename Callback> std::string_view split_path(std::string_view path, Callback&& on_dir)
+{
+    size_t start = 0;
+    for (size_t i = 0; i < path.size(); ++i) {
+        if (is_separator(path[i])) {
+            if (!on_dir(path.substr(start, i - start))) {
+                return {};
+            }
+            start = i + 1;
+        }
+    }
+    return path.substr(start);
+}
+} // namespace
+
+std::string_view clPathStore::StoreName(std::string_view name)
+{
+    char* dest = nullptr;
+    if (name.size() > BLOCK_SIZE / 4) {
+        // a large name gets its own block, so the free space of the current block remains usable
+        m_largeBlocks.push_back(std::make_unique<char[]>(name.size()));
+        dest = m_largeBlocks.back().get();
+        m_arenaSize += name.size();
+    } else {
+        if (m_blocks.empty() || m_blockUsed + name.size() > BLOCK_SIZE) {
+            m_blocks.push_back(std::make_unique<char[]>(BLOCK_SIZE));
+            m_blockUsed = 0;
+            m_arenaSize += BLOCK_SIZE;
+        }
+        dest = m_blocks.back().get() + m_blockUsed;
+        m_blockUsed += name.size();
+    }
+
+    if (!name.empty()) {
+        std::memcpy(dest, name.data(), name.size());
+    }
+    return std::string_view(dest, name.size());
+}
+
+clPathStore::Id clPathStore::InternName(std::string_view name)
+{
+    auto iter = m_nameIds.find(name);
+    if (iter != m_nameIds.end()) {
+        return iter->second;
+    }
+
+    std::string_view stored = StoreName(name);
+    Id id = (Id)m_names.size();
+    m_names.push_back(stored);
+    m_nameIds.insert({ stored, id });
+    return id;
+}
+
+clPathStore::Id clPathStore::InternDir(Id parent, Id name)
+{
+    auto [iter, inserted] = m_dirIds.insert({ make_key(parent, name), (Id)m_dirs.size() });
+    if (inserted) {
+        m_dirs.push_back({ parent, name });
+    }
+    return iter->second;
+}
+
+clPathStore::Id clPathStore::Add(const wxString& fullpath)
+{
+    std::string path = fullpath.ToStdString(wxConvUTF8);
+    Id dir = npos;
+    std::string_view filename = split_path(path, [&](std::string_view component) {
+        dir = InternDir(dir, InternName(component));
+        return true;
+    });
+
+    Id name = InternName(filename);
+    auto [iter, inserted] = m_fileIds.insert({ make_key(dir, name), (Id)m_files.size() });
+    if (inserted) {
+        m_files.push_back({ dir, name });
+    }
+    return iter->second;
+}
+
+std::optional<clPathStore::Id> clPathStore::FindEntry(const wxString& fullpath) const
+{
+    std::string path = fullpath.ToStdString(wxConvUTF8);
+    Id dir = npos;
+    bool found = true;
+    std::string_view filename = split_path(path, [&](std::string_view component) {
+        auto name = m_nameIds.find(component);
+        if (name == m_nameIds.end()) {
+            found = false;
+            return false;
+        }
+        auto iter = m_dirIds.find(make_key(dir, name->second));
+        if (iter == m_dirIds.end()) {
+            found = false;
+            return false;
+        }
+        dir = iter->second;
+        return true;
+    });
+
+    if (!found) {
+        return std::nullopt;
+    }
+
+    auto name = m_nameIds.find(filename);
+    if (name == m_nameIds.end()) {
+        return std::nullopt;
+    }
+    auto iter = m_fileIds.find(make_key(dir, name->second));
+    if (iter == m_fileIds.end()) {
+        return std::nullopt;
+    }
+    return iter->second;
+}
+
+clPathStore::Id clPathStore::Find(const wxString& fullpath) const
+{
+    auto id = FindEntry(fullpath);
+    return id.has_value() ? *id : npos;
+}
+
+void clPathStore::AppendPath(std::string& path, Id dir) const
+{
+    // collect the directories from the innermost one
+    std::vector<std::string_view> components;
+    for (; dir != npos; dir = m_dirs[dir].parent) {
+        components.push_back(m_names[m_dirs[dir].name]);
+    }
+
+    for (auto iter = components.rbegin(); iter != components.rend(); ++iter) {
+        if (iter != components.rbegin()) {
+            path += PATH_SEPARATOR;
+        }
+        path.append(iter->data(), iter->size());
+    }
+}
+
+wxString clPathStore::GetFullPath(Id id) const
+{
+    const Entry& file = m_files[id];
+    std::string path;
+    if (file.parent != npos) {
+        AppendPath(path, file.parent);
+        path += PATH_SEPARATOR;
+    }
+    std::string_view name = m_names[file.name];
+    path.append(name.data(), name.size());
+    return wxString::FromUTF8(path.data(), path.size());
+}
+
+wxString clPathStore::GetFullName(Id id) const
+{
+    std::string_view name = m_names[m_files[id].name];
+    return wxString::FromUTF8(name.data(), name.size());
+}
+
+wxString clPathStore::GetPath(Id id) const
+{
+    std::string path;
+    AppendPath(path, m_files[id].parent);
+    return wxString::FromUTF8(path.data(), path.size());
+}
+
+void clPathStore::Reserve(size_t count)
+{
+    m_files.reserve(count);
+    m_fileIds.reserve(count);
+}
+
+void clPathStore::Clear()
+{
+    m_fileIds.clear();
+    m_files.clear();
+    m_dirIds.clear();
+    m_dirs.clear();
+    m_nameIds.clear();
+    m_names.clear();
+    m_blocks.clear();
+    m_largeBlocks.clear();
+    m_blockUsed = 0;
+    m_arenaSize = 0;
+}
+
+size_t clPathStore::GetMemoryUsage() const
+{
+    return m_arenaSize + m_names.capacity() * sizeof(std::string_view) + m_dirs.capacity() * sizeof(Entry) +
+           m_files.capacity() * sizeof(Entry) + hash_map_size(m_nameIds) + hash_map_size(m_dirIds) +
+           hash_map_size(m_fileIds) + (m_blocks.capacity() + m_largeBlocks.capacity()) * sizeof(void*);
+}
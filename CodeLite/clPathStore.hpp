@@ -0,0 +1,109 @@
+#ifndef CLPATHSTORE_HPP
+#define CLPATHSTORE_HPP
+
+#include "codelite_exports.h"
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <wx/string.h>
+
+/// A compact set of file paths. Every directory is stored once, as its parent directory and its name, and the names
+/// of the directories and files are interned as UTF-8 in an arena. A path takes 8 bytes plus its hash entry, the full
+/// path is built on demand. Each path gets a 32 bit id, the ids are given in insertion order and never change.
+/// Not thread safe
+class WXDLLIMPEXP_CL clPathStore
+{
+public:
+    using Id = uint32_t;
+    static constexpr Id npos = std::numeric_limits<Id>::max();
+
+    /// iterates over the full paths, in insertion order
+    class const_iterator
+    {
+        const clPathStore* m_store = nullptr;
+        Id m_id = 0;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = wxString;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = wxString;
+
+        const_iterator(const clPathStore* store, Id id)
+            : m_store(store)
+            , m_id(id)
+        {
+        }
+
+        wxString operator*() const { return m_store->GetFullPath(m_id); }
+        Id GetId() const { return m_id; }
+        const_iterator& operator++()
+        {
+            ++m_id;
+            return *this;
+        }
+        bool operator==(const const_iterator& other) const { return m_id == other.m_id; }
+        bool operator!=(const const_iterator& other) const { return m_id != other.m_id; }
+    };
+
+private:
+    struct Entry {
+        Id parent = npos; // the directory containing this entry, npos for a top level entry
+        Id name = npos;
+    };
+
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    std::vector<std::unique_ptr<char[]>> m_largeBlocks; // one per name too large for a block
+    size_t m_blockUsed = 0;
+    size_t m_arenaSize = 0;
+    std::vector<std::string_view> m_names; // views in m_blocks
+    std::unordered_map<std::string_view, Id> m_nameIds;
+
+    std::vector<Entry> m_dirs;
+    std::unordered_map<uint64_t, Id> m_dirIds; // (parent, name) -> directory
+    std::vector<Entry> m_files;
+    std::unordered_map<uint64_t, Id> m_fileIds; // (directory, name) -> file
+
+    std::string_view StoreName(std::string_view name);
+    Id InternName(std::string_view name);
+    Id InternDir(Id parent, Id name);
+    std::optional<Id> FindEntry(const wxString& fullpath) const;
+    void AppendPath(std::string& path, Id dir) const;
+
+public:
+    clPathStore() = default;
+    ~clPathStore() = default;
+
+    /// add a path, return its id. If the path already exists, its id is returned
+    Id Add(const wxString& fullpath);
+
+    /// return the id of `fullpath`, or npos if it does not exist
+    Id Find(const wxString& fullpath) const;
+    bool Contains(const wxString& fullpath) const { return Find(fullpath) != npos; }
+
+    wxString GetFullPath(Id id) const;
+    /// the file name, without the directory
+    wxString GetFullName(Id id) const;
+    /// the directory, without a trailing separator
+    wxString GetPath(Id id) const;
+
+    size_t GetCount() const { return m_files.size(); }
+    bool IsEmpty() const { return m_files.empty(); }
+    void Reserve(size_t count);
+    void Clear();
+
+    /// an estimate of the memory used by the store, in bytes
+    size_t GetMemoryUsage() const;
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, (Id)m_files.size()); }
+};
+
+#endif // CLPATHSTORE_HPP
@@ -0,0 +1,53 @@
+#include "clStartupReport.hpp"
+
+#include "file_logger.h"
+
+#include <mutex>
+#include <vector>
+
+namespace
+{
+// initialised with the other globals of the library, close enough to the process start
+const auto PROCESS_START = std::chrono::steady_clock::now();
+
+struct Phase {
+    const char* name = nullptr;
+    std::chrono::steady_clock::duration duration{};
+};
+
+std::mutex phases_mutex;
+std::vector<Phase> phases;
+bool finished = false;
+
+long long to_ms(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+}
+} // namespace
+
+void clStartupReport::AddPhase(const char* name, std::chrono::steady_clock::duration duration)
+{
+    std::lock_guard<std::mutex> lock(phases_mutex);
+    if (!finished) {
+        phases.push_back({ name, duration });
+    }
+}
+
+void clStartupReport::Finish()
+{
+    std::vector<Phase> report;
+    {
+        std::lock_guard<std::mutex> lock(phases_mutex);
+        if (finished) {
+            return;
+        }
+        finished = true;
+        report.swap(phases);
+    }
+
+    // phases may be nested, so their durations do not add up to the total
+    clSYSTEM() << "Startup completed in" << to_ms(std::chrono::steady_clock::now() - PROCESS_START) << "ms" << endl;
+    for (const auto& phase : report) {
+        clSYSTEM() << "  " << phase.name << ":" << to_ms(phase.duration) << "ms" << endl;
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef CLSTARTUPREPORT_HPP
+#define CLSTARTUPREPORT_HPP
+
+#include "codelite_exports.h"
+
+#include <chrono>
+
+/// Durations of the startup phases of the IDE. The phases are written to the log once the startup completed, so a
+/// phase that becomes slower is easy to spot
+class WXDLLIMPEXP_CL clStartupReport
+{
+public:
+    /// record a phase. Ignored once the report was written
+    static void AddPhase(const char* name, std::chrono::steady_clock::duration duration);
+
+    /// write the report to the log
+    static void Finish();
+};
+
+/// Record the lifetime of this object as a startup phase named `name` (a string literal)
+class clStartupPhase final
+{
+    const char* m_name = nullptr;
+    std::chrono::steady_clock::time_point m_start;
+
+public:
+    explicit clStartupPhase(const char* name)
+        : m_name(name)
+        , m_start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~clStartupPhase() { clStartupReport::AddPhase(m_name, std::chrono::steady_clock::now() - m_start); }
+
+    clStartupPhase(const clStartupPhase&) = delete;
+    clStartupPhase& operator=(const clStartupPhase&) = delete;
+};
+
+#define CL_STARTUP_PHASE_CONCAT_IMPL(a, b) a##b
+#define CL_STARTUP_PHASE_CONCAT(a, b) CL_STARTUP_PHASE_CONCAT_IMPL(a, b)
+#define CL_STARTUP_PHASE(name) clStartupPhase CL_STARTUP_PHASE_CONCAT(__cl_startup_phase_, __LINE__)(name)
+
+#endif // CLSTARTUPREPORT_HPP
@@ -0,0 +1,266 @@
+#include "clTrace.hpp"
+
+#include "file_logger.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <wx/ffile.h>
+#include <wx/thread.h>
+#include <wx/utils.h>
+
+std::atomic_bool clTrace::ms_enabled{ false };
+
+namespace
+{
+// zones kept per thread, older zones are overwritten
+constexpr size_t MAX_EVENTS_PER_THREAD = 64 * 1024;
+// the zones of finished threads can be exported, but short lived threads must not pile up forever
+constexpr size_t MAX_FINISHED_THREADS = 64;
+
+struct TraceEvent {
+    const char* name = nullptr;
+    uint64_t start = 0;
+    uint64_t duration = 0;
+    bool async = false;
+};
+
+struct ThreadBuffer {
+    std::mutex mutex; // only contended while exporting
+    std::vector<TraceEvent> events;
+    size_t next = 0; // the oldest event, once the buffer is full
+    uint32_t tid = 0;
+    wxString name;
+    std::atomic_bool finished{ false };
+
+    void Add(const TraceEvent& event)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (events.size() < MAX_EVENTS_PER_THREAD) {
+            events.push_back(event);
+        } else {
+            events[next] = event;
+            next = (next + 1) % MAX_EVENTS_PER_THREAD;
+        }
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.clear();
+        events.shrink_to_fit();
+        next = 0;
+    }
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    uint32_t next_tid = 1;
+    std::unordered_set<std::string> names;
+};
+
+Registry& get_registry()
+{
+    // leaked: threads may record zones while the process exits
+    static Registry* registry = new Registry();
+    return *registry;
+}
+
+/// marks the buffer of the thread as finished when the thread exits
+struct ThreadBufferHolder {
+    std::shared_ptr<ThreadBuffer> buffer;
+    ~ThreadBufferHolder()
+    {
+        if (buffer) {
+            buffer->finished = true;
+        }
+    }
+};
+
+thread_local ThreadBufferHolder t_holder;
+
+ThreadBuffer& get_thread_buffer()
+{
+    if (t_holder.buffer) {
+        return *t_holder.buffer;
+    }
+
+    auto buffer = std::make_shared<ThreadBuffer>();
+    bool is_main = wxThread::IsMain();
+
+    Registry& registry = get_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    buffer->tid = registry.next_tid++;
+    buffer->name = is_main ? wxString("Main thread") : wxString::Format("Thread %u", buffer->tid);
+
+    // forget the oldest finished threads
+    size_t finished = std::count_if(registry.buffers.begin(), registry.buffers.end(),
+                                    [](const std::shared_ptr<ThreadBuffer>& b) { return b->finished.load(); });
+    for (auto iter = registry.buffers.begin(); finished > MAX_FINISHED_THREADS && iter != registry.buffers.end();) {
+        if ((*iter)->finished) {
+            iter = registry.buffers.erase(iter);
+            --finished;
+        } else {
+            ++iter;
+        }
+    }
+
+    registry.buffers.push_back(buffer);
+    t_holder.buffer = buffer;
+    return *buffer;
+}
+
+void append_json_string(std::string& out, const char* str)
+{
+    out += '"';
+    for (const char* p = str; *p; ++p) {
+        unsigned char ch = *p;
+        if (ch == '"' || ch == '\\') {
+            out += '\\';
+            out += ch;
+        } else if (ch < 0x20) {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", ch);
+            out += buf;
+        } else {
+            out += ch;
+        }
+    }
+    out += '"';
+}
+} // namespace
+
+void clTrace::Enable(bool enable)
+{
+    if (enable == IsEnabled()) {
+        return;
+    }
+
+    if (enable) {
+        Clear();
+    }
+    ms_enabled.store(enable);
+    clSYSTEM() << "Tracing is" << (enable ? "enabled" : "disabled") << endl;
+}
+
+void clTrace::Record(const char* name, uint64_t start, uint64_t end)
+{
+    get_thread_buffer().Add({ name, start, end > start ? end - start : 0, false });
+}
+
+void clTrace::RecordAsync(const char* name, uint64_t start, uint64_t end)
+{
+    get_thread_buffer().Add({ name, start, end > start ? end - start : 0, true });
+}
+
+const char* clTrace::Intern(const wxString& name)
+{
+    Registry& registry = get_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.names.insert(name.ToStdString(wxConvUTF8)).first->c_str();
+}
+
+size_t clTrace::GetCount()
+{
+    Registry& registry = get_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    size_t count = 0;
+    for (const auto& buffer : registry.buffers) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        count += buffer->events.size();
+    }
+    return count;
+}
+
+void clTrace::Clear()
+{
+    Registry& registry = get_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.buffers.erase(std::remove_if(registry.buffers.begin(), registry.buffers.end(),
+                                          [](const std::shared_ptr<ThreadBuffer>& b) { return b->finished.load(); }),
+                           registry.buffers.end());
+    for (const auto& buffer : registry.buffers) {
+        buffer->Clear();
+    }
+}
+
+bool clTrace::Export(const wxString& filepath)
+{
+    // copy the events, so the threads are not blocked while we format them
+    std::vector<std::pair<uint32_t, wxString>> threads;
+    std::vector<std::pair<uint32_t, std::vector<TraceEvent>>> events;
+    uint64_t first_timestamp = UINT64_MAX;
+    {
+        Registry& registry = get_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const auto& buffer : registry.buffers) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            if (buffer->events.empty()) {
+                continue;
+            }
+            threads.push_back({ buffer->tid, buffer->name });
+            events.push_back({ buffer->tid, buffer->events });
+            for (const auto& event : buffer->events) {
+                first_timestamp = std::min(first_timestamp, event.start);
+            }
+        }
+    }
+
+    const std::string pid = std::to_string(wxGetProcessId());
+    std::string json;
+    json.reserve(4096 + GetCount() * 100);
+    json += "{\"traceEvents\":[\n";
+
+    bool first = true;
+    auto begin_event = [&]() {
+        if (!first) {
+            json += ",\n";
+        }
+        first = false;
+    };
+
+    for (const auto& [tid, name] : threads) {
+        begin_event();
+        json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":" + std::to_string(tid) +
+                ",\"args\":{\"name\":";
+        append_json_string(json, name.ToStdString(wxConvUTF8).c_str());
+        json += "}}";
+    }
+
+    size_t async_id = 0;
+    for (const auto& [tid, thread_events] : events) {
+        const std::string thread_fields = ",\"pid\":" + pid + ",\"tid\":" + std::to_string(tid);
+        for (const auto& event : thread_events) {
+            uint64_t ts = event.start - first_timestamp;
+            begin_event();
+            json += "{\"name\":";
+            append_json_string(json, event.name);
+            if (event.async) {
+                // async events are matched by their id and may overlap
+                const std::string id = std::to_string(++async_id);
+                json += ",\"cat\":\"async\",\"ph\":\"b\",\"id\":" + id + ",\"ts\":" + std::to_string(ts) +
+                        thread_fields + "},\n{\"name\":";
+                append_json_string(json, event.name);
+                json += ",\"cat\":\"async\",\"ph\":\"e\",\"id\":" + id + ",\"ts\":" +
+                        std::to_string(ts + event.duration) + thread_fields + "}";
+            } else {
+                json += ",\"cat\":\"codelite\",\"ph\":\"X\",\"ts\":" + std::to_string(ts) +
+                        ",\"dur\":" + std::to_string(event.duration) + thread_fields + "}";
+            }
+        }
+    }
+    json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    wxFFile fp(filepath, "wb");
+    if (!fp.IsOpened() || !fp.Write(json.c_str(), json.size())) {
+        clWARNING() << "Failed to write trace file:" << filepath << endl;
+        return false;
+    }
+    clSYSTEM() << "Trace written to:" << filepath << endl;
+    return true;
+}
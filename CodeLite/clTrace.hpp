@@ -0,0 +1,85 @@
+#ifndef CLTRACE_HPP
+#define CLTRACE_HPP
+
+#include "codelite_exports.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <wx/string.h>
+
+/// Low overhead tracing of scoped zones, exported in the Chrome trace event format (chrome://tracing, Perfetto).
+/// Each thread records its zones into its own ring buffer, so only the most recent zones are kept. When tracing is
+/// disabled, a zone costs a single branch on an atomic flag.
+/// Zone names are not copied: pass string literals, or strings returned by `Intern()`
+class WXDLLIMPEXP_CL clTrace
+{
+    static std::atomic_bool ms_enabled;
+
+public:
+    static bool IsEnabled() { return ms_enabled.load(std::memory_order_relaxed); }
+
+    /// start (after dropping the previously recorded zones) or stop recording
+    static void Enable(bool enable);
+
+    /// the current time in microseconds, the time base of the recorded zones
+    static uint64_t Now() { return ToTimestamp(std::chrono::steady_clock::now()); }
+    static uint64_t ToTimestamp(std::chrono::steady_clock::time_point time)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+    }
+
+    /// record a zone of the calling thread. Zones of a thread must be properly nested
+    static void Record(const char* name, uint64_t start, uint64_t end);
+
+    /// record an operation that may overlap with other zones of the calling thread, e.g. a request waiting for its
+    /// reply
+    static void RecordAsync(const char* name, uint64_t start, uint64_t end);
+
+    /// return a copy of `name` that lives until the process exits. Equal names return the same pointer
+    static const char* Intern(const wxString& name);
+
+    /// number of zones kept in the ring buffers
+    static size_t GetCount();
+
+    /// drop all the recorded zones
+    static void Clear();
+
+    /// write the recorded zones to `filepath` as a Chrome trace event JSON file
+    static bool Export(const wxString& filepath);
+};
+
+/// Record the lifetime of this object as a zone named `name`
+class clTraceZone final
+{
+    const char* m_name = nullptr;
+    uint64_t m_start = 0;
+
+public:
+    explicit clTraceZone(const char* name)
+    {
+        if (clTrace::IsEnabled()) {
+            m_name = name;
+            m_start = clTrace::Now();
+        }
+    }
+
+    ~clTraceZone()
+    {
+        if (m_name) {
+            clTrace::Record(m_name, m_start, clTrace::Now());
+        }
+    }
+
+    clTraceZone(const clTraceZone&) = delete;
+    clTraceZone& operator=(const clTraceZone&) = delete;
+};
+
+#define CL_TRACE_CONCAT_IMPL(a, b) a##b
+#define CL_TRACE_CONCAT(a, b) CL_TRACE_CONCAT_IMPL(a, b)
+
+/// record the rest of the current scope as a zone named `name` (a string literal)
+#define CL_TRACE_ZONE(name) clTraceZone CL_TRACE_CONCAT(__cl_trace_zone_, __LINE__)(name)
+#define CL_TRACE_FUNCTION() CL_TRACE_ZONE(__FUNCTION__)
+
+#endif // CLTRACE_HPP
@@ -33,6 +33,7 @@
 #include "macros.h"
 #include "pptable.h"
 #include "precompiled_header.h"
+#include "tag_entry_pool.h"
 #include "tokenizer.h"
 #include "wxStringHash.h"
 
@@ -41,14 +42,14 @@
 
 TagEntry::TagEntry()
     : m_path(wxEmptyString)
-    , m_file(wxEmptyString)
+    , m_file(&TagStringPool::Intern(wxEmptyString))
     , m_lineNumber(-1)
     , m_pattern(wxEmptyString)
-    , m_kind("<unknown>")
+    , m_kind(&TagStringPool::Intern("<unknown>"))
     , m_parent(wxEmptyString)
     , m_name(wxEmptyString)
     , m_id(wxNOT_FOUND)
-    , m_scope(wxEmptyString)
+    , m_scope(&TagStringPool::Intern(wxEmptyString))
     , m_flags(0)
 {
 }
@@ -58,8 +59,9 @@ TagEntry::TagEntry(const TagEntry& rhs) { *this = rhs; }
 TagEntry& TagEntry::operator=(const TagEntry& rhs)
 {
     m_id = rhs.m_id;
-    m_file = rhs.m_file.c_str();
-    m_kind = rhs.m_kind.c_str();
+    // interned strings are immutable and shared, copy the pointers
+    m_file = rhs.m_file;
+    m_kind = rhs.m_kind;
     m_parent = rhs.m_parent.c_str();
     m_pattern = rhs.m_pattern.c_str();
     m_lineNumber = rhs.m_lineNumber;
@@ -68,7 +70,7 @@ TagEntry& TagEntry::operator=(const TagEntry& rhs)
 #if wxUSE_GUI
     m_hti = rhs.m_hti;
 #endif
-    m_scope = rhs.m_scope.c_str();
+    m_scope = rhs.m_scope;
     m_flags = rhs.m_flags;
 
     // loop over the map and copy item by item
@@ -85,6 +87,7 @@ TagEntry& TagEntry::operator=(const TagEntry& rhs)
 bool TagEntry::operator==(const TagEntry& rhs) const
 {
     // Note: tree item id is not used in this function!
+    // file, kind and scope are interned: comparing their addresses is enough
     bool res = m_scope == rhs.m_scope && m_file == rhs.m_file && m_kind == rhs.m_kind && m_parent == rhs.m_parent &&
                m_pattern == rhs.m_pattern && m_name == rhs.m_name && m_path == rhs.m_path &&
                m_lineNumber == rhs.m_lineNumber && GetInheritsAsString() == rhs.GetInheritsAsString() &&
@@ -222,12 +225,9 @@ bool TagEntry::IsClassTemplate() const
 
 wxString TagEntry::GetScopeName() const { return GetScope(); }
 
-wxString TagEntry::GetKind() const
-{
-    wxString kind(m_kind);
-    kind.Trim();
-    return kind;
-}
+void TagEntry::SetFile(const wxString& file) { m_file = &TagStringPool::Intern(file); }
+
+void TagEntry::SetScope(const wxString& scope) { m_scope = &TagStringPool::Intern(scope); }
 
 const bool TagEntry::IsContainer() const
 {
@@ -657,11 +657,14 @@ std::unordered_map<wxString, eTagKind> g_kind_table = {
 void TagEntry::SetKind(const wxString& kind)
 {
     // set the string kind
-    m_kind = kind;
+    wxString trimmed_kind = kind;
+    trimmed_kind.Trim();
+    m_kind = &TagStringPool::Intern(trimmed_kind);
     // turn on bits
     m_tag_kind = eTagKind::TAG_KIND_UNKNOWN;
-    if(g_kind_table.count(m_kind)) {
-        m_tag_kind = g_kind_table[m_kind];
+    auto iter = g_kind_table.find(*m_kind);
+    if(iter != g_kind_table.end()) {
+        m_tag_kind = iter->second;
     }
 }
 
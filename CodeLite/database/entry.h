@@ -110,19 +110,19 @@ private:
     };
 
 private:
-    wxString m_path;    ///< Tag full path
-    wxString m_file;    ///< File this tag is found
-    int m_lineNumber;   ///< Line number
-    wxString m_pattern; ///< A pattern that can be used to locate the tag in the file
-    wxString m_kind;    ///< Member, function, class, typedef etc.
-    wxString m_parent;  ///< Direct parent
+    wxString m_path;          ///< Tag full path
+    const wxString* m_file;   ///< File this tag is found (interned, see TagStringPool)
+    int m_lineNumber;         ///< Line number
+    wxString m_pattern;       ///< A pattern that can be used to locate the tag in the file
+    const wxString* m_kind;   ///< Member, function, class, typedef etc. (interned)
+    wxString m_parent;        ///< Direct parent
 #if wxUSE_GUI
     wxTreeItemId m_hti; ///< Handle to tree item, not persistent item
 #endif
     wxString m_name;           ///< Tag name (short name, excluding any scope names)
     wxStringMap_t m_extFields; ///< Additional extension fields
     long m_id;
-    wxString m_scope;
+    const wxString* m_scope; ///< interned
     size_t m_flags;     // This member is not saved into the database
     wxString m_comment; // This member is not saved into the database
     wxString m_template_definition;
@@ -311,8 +311,8 @@ public:
     const wxString& GetPath() const { return m_path; }
     void SetPath(const wxString& path) { m_path = path; }
 
-    const wxString& GetFile() const { return m_file; }
-    void SetFile(const wxString& file) { m_file = file; }
+    const wxString& GetFile() const { return *m_file; }
+    void SetFile(const wxString& file);
 
     int GetLine() const { return m_lineNumber; }
     void SetLine(int line) { m_lineNumber = line; }
@@ -325,7 +325,7 @@ public:
 
     void SetPattern(const wxString& pattern) { m_pattern = pattern; }
 
-    wxString GetKind() const;
+    const wxString& GetKind() const { return *m_kind; }
     void SetKind(const wxString& kind);
 
     const wxString& GetParent() const { return m_parent; }
@@ -352,8 +352,8 @@ public:
     void SetMacrodef(const wxString& value);
     void SetTemplateDefinition(const wxString& def) { set_extra_field("template", def); }
 
-    const wxString& GetScope() const { return m_scope; }
-    void SetScope(const wxString& scope) { m_scope = scope; }
+    const wxString& GetScope() const { return *m_scope; }
+    void SetScope(const wxString& scope);
 
     /**
      * \return Scope name of the tag.
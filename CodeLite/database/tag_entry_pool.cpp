@@ -0,0 +1,151 @@
+#include "tag_entry_pool.h"
+
+#include "entry.h"
+#include "wxStringHash.h"
+
+#include <algorithm>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+struct StringPool {
+    std::shared_mutex lock;
+    // node based: references to its elements remain valid when the set grows
+    std::unordered_set<wxString> strings;
+};
+
+/// tags may be created during static initialisation, so construct the pool on first use. It is never destroyed:
+/// tags may also outlive static destruction
+StringPool& GetStringPool()
+{
+    static StringPool* pool = new StringPool();
+    return *pool;
+}
+
+/// allocates from a TagEntryArena and keeps it alive. Used with std::allocate_shared so both the tag and its
+/// control block live in the arena
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+    TagEntryArena::Ptr_t arena;
+
+    explicit ArenaAllocator(TagEntryArena::Ptr_t a)
+        : arena(std::move(a))
+    {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other)
+        : arena(other.arena)
+    {
+    }
+
+    T* allocate(size_t n) { return static_cast<T*>(arena->AllocateBytes(n * sizeof(T), alignof(T))); }
+    void deallocate(T* p, size_t n)
+    {
+        // released all at once, with the arena
+        wxUnusedVar(p);
+        wxUnusedVar(n);
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const
+    {
+        return arena == other.arena;
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const
+    {
+        return arena != other.arena;
+    }
+};
+
+// the per-thread cache of the pooled strings is dropped when it grows past this size
+constexpr size_t MAX_THREAD_CACHE_SIZE = 4096;
+
+// the size of a tag and its control block, rounded up. Only used to size the arena blocks
+constexpr size_t ESTIMATED_TAG_SIZE = sizeof(TagEntry) + 64;
+constexpr size_t MIN_BLOCK_SIZE = 4 * 1024;
+constexpr size_t MAX_BLOCK_SIZE = 1024 * 1024;
+} // namespace
+
+const wxString& TagStringPool::Intern(const wxString& str)
+{
+    static const wxString empty_string;
+    if (str.empty()) {
+        return empty_string;
+    }
+
+    // a parser sets the same file, kinds and scopes over and over: look them up in a cache of this thread first,
+    // so the pool lock is only taken for the strings that this thread did not see yet. The cache points into the
+    // pool, so equal strings still share the same address across threads
+    thread_local std::unordered_map<wxString, const wxString*> thread_cache;
+    auto cache_iter = thread_cache.find(str);
+    if (cache_iter != thread_cache.end()) {
+        return *cache_iter->second;
+    }
+
+    const wxString* pooled = nullptr;
+    auto& pool = GetStringPool();
+    {
+        std::shared_lock lock{pool.lock};
+        auto iter = pool.strings.find(str);
+        if (iter != pool.strings.end()) {
+            pooled = &(*iter);
+        }
+    }
+
+    if (!pooled) {
+        std::unique_lock lock{pool.lock};
+        // force our own copy of the string, see TagEntry::operator=
+        pooled = &(*pool.strings.insert(wxString(str.c_str())).first);
+    }
+
+    if (thread_cache.size() >= MAX_THREAD_CACHE_SIZE) {
+        thread_cache.clear();
+    }
+    thread_cache.insert({ *pooled, pooled });
+    return *pooled;
+}
+
+size_t TagStringPool::GetCount()
+{
+    auto& pool = GetStringPool();
+    std::shared_lock lock{pool.lock};
+    return pool.strings.size();
+}
+
+TagEntryArena::Ptr_t TagEntryArena::Create(size_t expected_count)
+{
+    size_t block_size = std::clamp(expected_count * ESTIMATED_TAG_SIZE, MIN_BLOCK_SIZE, MAX_BLOCK_SIZE);
+    return std::make_shared<TagEntryArena>(block_size);
+}
+
+TagEntryArena::TagEntryArena(size_t block_size)
+    : m_blockSize(block_size / 2) // doubled when the first block is allocated
+    , m_offset(m_blockSize)       // force a new block on the first allocation
+{
+}
+
+void* TagEntryArena::AllocateBytes(size_t bytes, size_t alignment)
+{
+    std::lock_guard lock{m_lock};
+    size_t aligned_offset = (m_offset + alignment - 1) & ~(alignment - 1);
+    if (m_blocks.empty() || aligned_offset + bytes > m_blockSize) {
+        // small queries stay small, large ones quickly reach the maximum block size
+        m_blockSize = std::max(std::min(m_blockSize * 2, MAX_BLOCK_SIZE), bytes);
+        m_blocks.emplace_back(new char[m_blockSize]);
+        m_capacity += m_blockSize;
+        aligned_offset = 0;
+    }
+    m_offset = aligned_offset + bytes;
+    return m_blocks.back().get() + aligned_offset;
+}
+
+TagEntryPtr TagEntryArena::Allocate()
+{
+    return std::allocate_shared<TagEntry>(ArenaAllocator<TagEntry>(shared_from_this()));
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "codelite_exports.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <wx/string.h>
+
+class TagEntry;
+using TagEntryPtr = std::shared_ptr<TagEntry>;
+
+/**
+ * @brief process wide pool of the strings that are repeated across many tags (file, kind and scope).
+ * A tag keeps a pointer into the pool instead of its own copy. Each thread keeps a small cache of the strings it
+ * interned, so a parser setting the same values over and over does not contend on the pool lock
+ */
+class WXDLLIMPEXP_CL TagStringPool
+{
+public:
+    /**
+     * @brief return the pooled copy of `str`. The reference remains valid for the lifetime of the process and
+     * two equal strings always return the same reference, so interned strings can be compared by address
+     */
+    static const wxString& Intern(const wxString& str);
+
+    /**
+     * @brief number of distinct strings in the pool
+     */
+    static size_t GetCount();
+};
+
+/**
+ * @brief a bump allocator for the tags of a single query. Fetching a large scope creates thousands of tags at
+ * once: allocating them (and their shared_ptr control blocks) from a few large blocks instead of one heap
+ * allocation per tag is faster and keeps them close in memory.
+ *
+ * Every tag allocated from the arena holds a reference to it: the memory is released once the last tag is gone.
+ * A single tag that is kept (e.g. in a cache) pins all the memory of the arena, so only use it for temporary
+ * results and copy the tags that survive
+ */
+class WXDLLIMPEXP_CL TagEntryArena : public std::enable_shared_from_this<TagEntryArena>
+{
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    size_t m_blockSize = 0; // size of the current block. Each new block is twice as large as the previous one
+    size_t m_offset = 0;
+    size_t m_capacity = 0;
+    std::mutex m_lock;
+
+public:
+    using Ptr_t = std::shared_ptr<TagEntryArena>;
+
+    /**
+     * @brief create an arena whose first block fits `expected_count` tags. The arena grows as needed
+     */
+    static Ptr_t Create(size_t expected_count = 16);
+
+    explicit TagEntryArena(size_t block_size);
+    ~TagEntryArena() = default;
+
+    /**
+     * @brief allocate a default constructed tag from this arena
+     */
+    TagEntryPtr Allocate();
+
+    /**
+     * @brief raw allocation, used by the arena allocator
+     */
+    void* AllocateBytes(size_t bytes, size_t alignment);
+
+    /**
+     * @brief total number of bytes reserved by this arena
+     */
+    size_t GetCapacity() const { return m_capacity; }
+};
@@ -474,9 +474,10 @@ void TagsStorageSQLite::PPTokenFromSQlite3ResultSet(wxSQLite3ResultSet& rs, PPTo
     token.args = wxStringTokenize(sig, wxT(","), wxTOKEN_STRTOK);
 }
 
-TagEntry* TagsStorageSQLite::FromSQLite3ResultSet(wxSQLite3ResultSet& rs)
+namespace
+{
+void fill_tag_from_result_set(wxSQLite3ResultSet& rs, TagEntry* entry)
 {
-    TagEntry* entry = new TagEntry();
     entry->SetId(rs.GetInt(0));
     entry->SetName(rs.GetString(1));
     entry->SetFile(rs.GetString(2));
@@ -493,6 +494,20 @@ TagEntry* TagsStorageSQLite::FromSQLite3ResultSet(wxSQLite3ResultSet& rs)
     entry->SetTemplateDefinition(rs.GetString(13));
     entry->SetTagProperties(rs.GetString(14));
     entry->SetMacrodef(rs.GetString(15));
+}
+} // namespace
+
+TagEntry* TagsStorageSQLite::FromSQLite3ResultSet(wxSQLite3ResultSet& rs)
+{
+    TagEntry* entry = new TagEntry();
+    fill_tag_from_result_set(rs, entry);
+    return entry;
+}
+
+TagEntryPtr TagsStorageSQLite::FromSQLite3ResultSet(wxSQLite3ResultSet& rs, TagEntryArena::Ptr_t arena)
+{
+    TagEntryPtr entry = arena->Allocate();
+    fill_tag_from_result_set(rs, entry.get());
     return entry;
 }
 
@@ -531,6 +546,26 @@ void TagsStorageSQLite::DoFetchTags(const wxString& sql, std::vector<TagEntryPtr
     }
 }
 
+void TagsStorageSQLite::DoFetchTemporaryTags(const wxString& sql, TagEntryArena::Ptr_t arena,
+                                             std::vector<TagEntryPtr>& tags)
+{
+    LOG_IF_TRACE { clDEBUG1() << "Fetching from disk:" << sql << clEndl; }
+    try {
+        wxSQLite3ResultSet ex_rs;
+        ex_rs = Query(sql);
+        while(ex_rs.NextRow()) {
+            tags.push_back(FromSQLite3ResultSet(ex_rs, arena));
+        }
+        ex_rs.Finalize();
+    } catch (const wxSQLite3Exception& e) {
+        LOG_IF_DEBUG
+        {
+            clDEBUG() << "SQLite exception!" << endl;
+            clDEBUG() << e.GetMessage() << endl;
+        }
+    }
+}
+
 void TagsStorageSQLite::DoFetchTags(const wxString& sql, std::vector<TagEntryPtr>& tags, const wxArrayString& kinds)
 {
     if(GetUseCache() && m_cache.Get(sql, kinds, tags))
@@ -659,13 +694,14 @@ void TagsStorageSQLite::GetTagsByNameAndParent(const wxString& name, const wxStr
     wxString sql;
     sql << wxT("select * from tags where name='") << name << wxT("' LIMIT ") << GetSingleSearchLimit();
 
+    // most of the candidates are dropped: allocate them together and copy the ones we keep
     std::vector<TagEntryPtr> tmpResults;
-    DoFetchTags(sql, tmpResults);
+    DoFetchTemporaryTags(sql, TagEntryArena::Create(), tmpResults);
 
     // Filter by parent
     for(size_t i = 0; i < tmpResults.size(); i++) {
         if(tmpResults.at(i)->GetParent() == parent) {
-            tags.push_back(tmpResults.at(i));
+            tags.push_back(std::make_shared<TagEntry>(*tmpResults.at(i)));
         }
     }
 }
@@ -29,6 +29,7 @@
 #include "entry.h"
 #include "fileentry.h"
 #include "istorage.h"
+#include "tag_entry_pool.h"
 #include "tag_tree.h"
 #include "wxStringHash.h"
 
@@ -151,12 +152,22 @@ private:
      */
     void DoFetchTags(const wxString& sql, std::vector<TagEntryPtr>& tags, const wxArrayString& kinds);
 
+    /**
+     * @brief fetch tags that are only used while the caller filters them, allocated from `arena`.
+     * The result is not cached. Every tag holds the whole arena: copy the tags that are kept
+     */
+    void DoFetchTemporaryTags(const wxString& sql, TagEntryArena::Ptr_t arena, std::vector<TagEntryPtr>& tags);
+
     void DoAddNamePartToQuery(wxString& sql, const wxString& name, bool partial, bool prependAnd);
     void DoAddLimitPartToQuery(wxString& sql, const std::vector<TagEntryPtr>& tags);
     int DoInsertTagEntry(const TagEntry& tag);
 
 public:
     static TagEntry* FromSQLite3ResultSet(wxSQLite3ResultSet& rs);
+    /**
+     * @brief same as above, but allocate the tag from `arena`
+     */
+    static TagEntryPtr FromSQLite3ResultSet(wxSQLite3ResultSet& rs, TagEntryArena::Ptr_t arena);
     static void PPTokenFromSQlite3ResultSet(wxSQLite3ResultSet& rs, PPToken& token);
 
 public:
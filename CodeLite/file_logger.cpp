@@ -27,8 +27,20 @@
 
 #include "cl_standard_paths.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <exception>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <wx/crt.h>
+#include <wx/filefn.h>
 #include <wx/filename.h>
 #include <wx/log.h>
 #include <wx/stdpaths.h>
@@ -40,6 +52,335 @@ wxString FileLogger::m_logfile;
 std::unordered_map<wxThreadIdType, wxString> FileLogger::m_threads;
 wxCriticalSection FileLogger::m_cs;
 
+namespace
+{
+// how often the background writer drains the per-thread buffers
+constexpr std::chrono::milliseconds ASYNC_FLUSH_INTERVAL{200};
+// a thread that accumulated this many bytes wakes up the writer instead of waiting for the next interval
+constexpr size_t ASYNC_WAKEUP_THRESHOLD = 64 * 1024;
+// once the log file grows beyond this size, it is renamed to "<name>.1" and a new file is started
+constexpr long ASYNC_MAX_FILE_SIZE = 20 * 1024 * 1024;
+
+/// A lock made of a lock-free atomic flag, so that a signal handler can try it without calling into the C library
+class SpinLock
+{
+    std::atomic_flag m_flag = ATOMIC_FLAG_INIT;
+
+public:
+    void lock()
+    {
+        while (m_flag.test_and_set(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+    bool try_lock() { return !m_flag.test_and_set(std::memory_order_acquire); }
+    void unlock() { m_flag.clear(std::memory_order_release); }
+};
+
+/// Pending log lines of a single thread. Only the owner thread appends to it and only the writer thread takes
+/// its content, so the lock is practically never contended
+struct ThreadLogBuffer {
+    SpinLock lock;
+    std::string data;
+};
+
+/// Drains the per-thread buffers on a background thread and writes them in batches into a log file that is kept
+/// open for the lifetime of the writer
+class AsyncLogWriter
+{
+    SpinLock m_buffersLock;
+    std::vector<std::shared_ptr<ThreadLogBuffer>> m_buffers;
+
+    std::mutex m_wakeupLock;
+    std::condition_variable m_wakeup;
+    std::atomic_bool m_wakeupRequested{false};
+    std::atomic_bool m_running{false};
+    std::thread m_thread;
+
+    std::mutex m_fileLock; // protects the members below
+    wxString m_path;
+    FILE* m_fp = nullptr;
+    long m_fileSize = 0;
+    std::atomic_int m_crashFd{-1}; // opened in advance for CrashFlush(), which can not open files
+
+public:
+    static AsyncLogWriter& Get()
+    {
+        // intentionally leaked: log lines may be written from static destructors
+        static AsyncLogWriter* writer = new AsyncLogWriter();
+        return *writer;
+    }
+
+    bool IsRunning() const { return m_running.load(std::memory_order_relaxed); }
+
+    void Start(const wxString& path)
+    {
+        {
+            std::lock_guard lock{m_fileLock};
+            if (m_path != path) {
+                // (re)open the file on the next write
+                CloseFile();
+                m_path = path;
+                OpenCrashFile();
+            }
+        }
+
+        if (m_running.exchange(true)) {
+            return;
+        }
+        m_thread = std::thread([this]() { Run(); });
+    }
+
+    void Stop()
+    {
+        if (!m_running.exchange(false)) {
+            return;
+        }
+        m_wakeup.notify_one();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+
+        // anything that was added while the thread was going down
+        Drain();
+        std::lock_guard lock{m_fileLock};
+        CloseFile();
+        CloseCrashFile();
+    }
+
+    void Append(const std::string& line)
+    {
+        auto& buffer = GetThreadBuffer();
+        size_t pending = 0;
+        {
+            std::lock_guard lock{buffer->lock};
+            buffer->data.append(line);
+            pending = buffer->data.size();
+        }
+
+        if (pending >= ASYNC_WAKEUP_THRESHOLD && !m_wakeupRequested.exchange(true)) {
+            m_wakeup.notify_one();
+        }
+    }
+
+    /// Called from a signal handler, so only async-signal-safe calls are allowed: the pending lines are written
+    /// straight from the buffers with write(2), to the file opened by Start(). Locks are only tried, a crashing
+    /// thread might be the one holding them
+    void CrashFlush()
+    {
+        int fd = m_crashFd.load();
+        if (fd < 0 || !m_buffersLock.try_lock()) {
+            return;
+        }
+
+        for (auto& buffer : m_buffers) {
+            if (!buffer->lock.try_lock()) {
+                continue;
+            }
+            const char* data = buffer->data.data();
+            size_t remaining = buffer->data.length();
+            while (remaining > 0) {
+                auto written = wxWrite(fd, data, remaining);
+                if (written <= 0) {
+                    break;
+                }
+                data += written;
+                remaining -= written;
+            }
+            buffer->data.clear(); // keeps the capacity, does not free
+            buffer->lock.unlock();
+        }
+        m_buffersLock.unlock();
+    }
+
+private:
+    std::shared_ptr<ThreadLogBuffer>& GetThreadBuffer()
+    {
+        thread_local std::shared_ptr<ThreadLogBuffer> buffer;
+        if (!buffer) {
+            buffer = std::make_shared<ThreadLogBuffer>();
+            std::lock_guard lock{m_buffersLock};
+            m_buffers.push_back(buffer);
+        }
+        return buffer;
+    }
+
+    void Run()
+    {
+        while (IsRunning()) {
+            {
+                std::unique_lock lock{m_wakeupLock};
+                m_wakeup.wait_for(lock, ASYNC_FLUSH_INTERVAL, [this]() { return !IsRunning() || m_wakeupRequested; });
+            }
+            m_wakeupRequested.store(false);
+            Drain();
+        }
+    }
+
+    void Drain()
+    {
+        std::vector<std::shared_ptr<ThreadLogBuffer>> buffers;
+        {
+            std::lock_guard lock{m_buffersLock};
+            buffers = m_buffers;
+        }
+
+        std::string batch;
+        for (auto& buffer : buffers) {
+            std::lock_guard lock{buffer->lock};
+            if (batch.empty()) {
+                batch.swap(buffer->data);
+            } else {
+                batch.append(buffer->data);
+                buffer->data.clear();
+            }
+        }
+        buffers.clear();
+
+        {
+            // forget about buffers owned by threads that exited: the list holds their last reference
+            std::lock_guard lock{m_buffersLock};
+            m_buffers.erase(std::remove_if(m_buffers.begin(),
+                                           m_buffers.end(),
+                                           [](const std::shared_ptr<ThreadLogBuffer>& buffer) {
+                                               return buffer.use_count() == 1 && buffer->data.empty();
+                                           }),
+                            m_buffers.end());
+        }
+
+        if (!batch.empty()) {
+            Write(batch);
+        }
+    }
+
+    void Write(const std::string& batch)
+    {
+        std::lock_guard lock{m_fileLock};
+        if (!m_fp && !OpenFile()) {
+            return;
+        }
+
+        fwrite(batch.c_str(), 1, batch.length(), m_fp);
+        fflush(m_fp);
+        m_fileSize += batch.length();
+
+        if (m_fileSize > ASYNC_MAX_FILE_SIZE) {
+            // rotate: keep a single backup of the previous content
+            CloseFile();
+            ::wxRenameFile(m_path, m_path + ".1", true);
+            OpenCrashFile();
+        }
+    }
+
+    /// called with m_fileLock held
+    void OpenCrashFile()
+    {
+        int fd = m_path.empty() ? -1 : wxOpen(m_path, O_WRONLY | O_APPEND | O_CREAT, wxS_DEFAULT);
+        fd = m_crashFd.exchange(fd);
+        if (fd >= 0) {
+            wxClose(fd);
+        }
+    }
+
+    void CloseCrashFile()
+    {
+        int fd = m_crashFd.exchange(-1);
+        if (fd >= 0) {
+            wxClose(fd);
+        }
+    }
+
+    bool OpenFile()
+    {
+        if (m_path.empty()) {
+            return false;
+        }
+        m_fp = wxFopen(m_path, "ab");
+        if (!m_fp) {
+            return false;
+        }
+        fseek(m_fp, 0, SEEK_END);
+        m_fileSize = ftell(m_fp);
+        return true;
+    }
+
+    void CloseFile()
+    {
+        if (m_fp) {
+            fclose(m_fp);
+            m_fp = nullptr;
+        }
+        m_fileSize = 0;
+    }
+};
+
+using signal_handler_t = void (*)(int);
+signal_handler_t prev_sigsegv_handler = SIG_DFL;
+signal_handler_t prev_sigabrt_handler = SIG_DFL;
+signal_handler_t prev_sigfpe_handler = SIG_DFL;
+signal_handler_t prev_sigill_handler = SIG_DFL;
+std::terminate_handler prev_terminate_handler = nullptr;
+// set before the handlers are installed: the signal handler can not run the initialization of a local static
+AsyncLogWriter* crash_writer = nullptr;
+
+void restore_and_raise(int signo, signal_handler_t prev_handler)
+{
+    std::signal(signo, prev_handler == SIG_ERR ? SIG_DFL : prev_handler);
+    std::raise(signo);
+}
+
+void on_crash_signal(int signo)
+{
+    crash_writer->CrashFlush();
+    switch (signo) {
+    case SIGSEGV:
+        restore_and_raise(signo, prev_sigsegv_handler);
+        break;
+    case SIGABRT:
+        restore_and_raise(signo, prev_sigabrt_handler);
+        break;
+    case SIGFPE:
+        restore_and_raise(signo, prev_sigfpe_handler);
+        break;
+    case SIGILL:
+        restore_and_raise(signo, prev_sigill_handler);
+        break;
+    default:
+        break;
+    }
+}
+
+void on_terminate()
+{
+    AsyncLogWriter::Get().CrashFlush();
+    if (prev_terminate_handler) {
+        prev_terminate_handler();
+    }
+    std::abort();
+}
+
+/// make sure that pending log lines reach the file when the process exits
+void install_exit_handler()
+{
+    static std::once_flag once;
+    std::call_once(once, []() { std::atexit([]() { FileLogger::Shutdown(); }); });
+}
+
+/// make sure that pending log lines reach the file when the process crashes
+void install_crash_handlers()
+{
+    static std::once_flag once;
+    std::call_once(once, []() {
+        crash_writer = &AsyncLogWriter::Get();
+        prev_terminate_handler = std::set_terminate(on_terminate);
+        prev_sigsegv_handler = std::signal(SIGSEGV, on_crash_signal);
+        prev_sigabrt_handler = std::signal(SIGABRT, on_crash_signal);
+        prev_sigfpe_handler = std::signal(SIGFPE, on_crash_signal);
+        prev_sigill_handler = std::signal(SIGILL, on_crash_signal);
+    });
+}
+} // namespace
+
 FileLogger::FileLogger(int verbosity, const char* filename, int line_number)
     : m_logEntryVerbosity(verbosity)
     , m_fp(nullptr)
@@ -126,16 +467,27 @@ void FileLogger::SetGlobalLogVerbosity(const wxString& verbosity)
     SetGlobalLogVerbosity(GetVerbosityAsNumber(verbosity));
 }
 
-void FileLogger::OpenLog(const wxString& fullName, int verbosity)
+void FileLogger::OpenLog(const wxString& fullName, int verbosity, bool async)
 {
     m_logfile.Clear();
     wxFileName logfile{ clStandardPaths::Get().GetUserDataDir(), fullName };
     logfile.AppendDir("logs");
     logfile.Mkdir(wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
     m_logfile = logfile.GetFullPath();
+
+    if (async) {
+        install_exit_handler();
+        AsyncLogWriter::Get().Start(m_logfile);
+    } else {
+        AsyncLogWriter::Get().Stop();
+    }
     SetGlobalLogVerbosity(verbosity);
 }
 
+void FileLogger::Shutdown() { AsyncLogWriter::Get().Stop(); }
+
+void FileLogger::InstallCrashHandlers() { install_crash_handlers(); }
+
 void FileLogger::AddLogLine(const wxArrayString& arr, int verbosity)
 {
     for (size_t i = 0; i < arr.GetCount(); ++i) {
@@ -149,6 +501,14 @@ void FileLogger::Flush()
     if (m_buffer.IsEmpty()) {
         return;
     }
+
+    auto& writer = AsyncLogWriter::Get();
+    if (writer.IsRunning()) {
+        writer.Append((m_buffer + wxT("\n")).ToStdString(wxConvUTF8));
+        m_buffer.Clear();
+        return;
+    }
+
     wxFFile fp(m_logfile, "a+");
     if (fp.IsOpened()) {
         fp.Write(m_buffer + wxT("\n"), wxConvUTF8);
@@ -95,8 +95,24 @@ public:
 
     /**
      * @brief open the log file
+     * @param async when true, log lines are collected in per-thread buffers and written in batches by a background
+     * thread that keeps the file open and rotates it by size. Otherwise, every flush opens, appends and closes the
+     * file on the calling thread
      */
-    static void OpenLog(const wxString& fullName, int verbosity);
+    static void OpenLog(const wxString& fullName, int verbosity, bool async = false);
+
+    /**
+     * @brief install SIGSEGV/SIGABRT/SIGFPE/SIGILL and std::terminate handlers that write the pending log lines of
+     * the async writer before chaining to the previous handlers. Meant for the main executable only: a library must
+     * not replace the process signal handlers
+     */
+    static void InstallCrashHandlers();
+
+    /**
+     * @brief write all pending log lines and stop the background writer (if any). Called automatically on exit,
+     * log lines printed afterwards are written synchronously
+     */
+    static void Shutdown();
 
     FileLogger& operator<<(FileLoggerFunction f)
     {
@@ -90,10 +90,13 @@
 
 #else 
 
+    // without the xml profiler, functions are recorded as zones when tracing is enabled (see clTrace.hpp)
+    #include "clTrace.hpp"
+
 	#define PERF_START(func_name)
 	#define PERF_END()
 	#define PERF_OUTPUT(path)
-	#define PERF_FUNCTION()
+	#define PERF_FUNCTION()   CL_TRACE_FUNCTION()
     #define PERF_REPEAT(nm,n)
     #define PERF_BLOCK(nm)
     
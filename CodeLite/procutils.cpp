@@ -42,6 +42,7 @@
 
 #include <memory>
 #include <stdio.h>
+#include <string>
 #include <wx/tokenzr.h>
 #ifdef __WXMSW__
 #include <wx/msw/private.h>
@@ -501,6 +502,94 @@ void ProcUtils::SafeExecuteCommand(const wxString& command, wxArrayString& outpu
 #endif
 }
 
+void ProcUtils::SafeExecuteCommandWithCallback(const wxString& command,
+                                               std::function<bool(const wxString&)> callback)
+{
+    // empty lines are skipped, as SafeExecuteCommand() does
+    auto call = [&callback](wxString& line) -> bool {
+        if (line.EndsWith("\r")) {
+            line.RemoveLast();
+        }
+        return !line.empty() && callback(line);
+    };
+
+#ifdef __WXMSW__
+    wxString errMsg;
+    LOG_IF_TRACE { clDEBUG1() << "executing process:" << command << endl; }
+    std::unique_ptr<WinProcess> proc{ WinProcess::Execute(command, errMsg) };
+    if (!proc) {
+        return;
+    }
+
+    // pass the complete lines of `buff` to the callback
+    wxString buff;
+    auto consume = [&]() -> bool {
+        size_t start = 0;
+        for (size_t where = buff.find('\n'); where != wxString::npos; where = buff.find('\n', start)) {
+            wxString line = buff.Mid(start, where - start);
+            start = where + 1;
+            if (call(line)) {
+                return true;
+            }
+        }
+        buff.Remove(0, start);
+        return false;
+    };
+
+    bool stop = false;
+    wxString tmpbuf;
+    while (!stop && proc->IsAlive()) {
+        tmpbuf.Clear();
+        if (proc->Read(tmpbuf)) {
+            buff << tmpbuf;
+            stop = consume();
+        } else {
+            wxThread::Sleep(1);
+        }
+    }
+
+    if (!stop) {
+        // Read any unread output
+        tmpbuf.Clear();
+        while (proc->Read(tmpbuf) && !tmpbuf.IsEmpty()) {
+            buff << tmpbuf;
+            tmpbuf.Clear();
+        }
+        buff << "\n";
+        consume();
+    }
+    // kills the process if the callback stopped early
+    proc->Cleanup();
+#else
+    FILE* fp = popen(command.mb_str(wxConvUTF8), "r");
+    if (!fp) {
+        return;
+    }
+
+    // lines longer than the chunk are read in several calls
+    char chunk[4096];
+    std::string line;
+    bool stop = false;
+    while (!stop && fgets(chunk, sizeof(chunk), fp)) {
+        line.append(chunk);
+        if (line.back() != '\n') {
+            continue;
+        }
+        line.pop_back();
+        wxString str(line.c_str(), wxConvUTF8);
+        line.clear();
+        stop = call(str);
+    }
+
+    if (!stop && !line.empty()) {
+        wxString str(line.c_str(), wxConvUTF8);
+        call(str);
+    }
+    // once the pipe is closed, the process gets SIGPIPE if it still writes
+    pclose(fp);
+#endif
+}
+
 wxString ProcUtils::SafeExecuteCommand(const wxString& command)
 {
     wxString strOut;
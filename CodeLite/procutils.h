@@ -26,6 +26,7 @@
 
 #include "codelite_exports.h"
 
+#include <functional>
 #include <map>
 #include <set>
 #include <vector>
@@ -118,6 +119,13 @@ public:
      */
     static wxString SafeExecuteCommand(const wxString& command);
 
+    /**
+     * @brief execute a command and call `callback` for each line of its output as soon as it is read, until the
+     * callback returns true. Like SafeExecuteCommand(), this function is safe to be called from a secondary thread
+     */
+    static void SafeExecuteCommandWithCallback(const wxString& command,
+                                               std::function<bool(const wxString&)> callback);
+
     /**
      * @brief execute command and execute the callback on each line until the callback returns true
      */
@@ -24,14 +24,20 @@
 //////////////////////////////////////////////////////////////////////////////
 #include "search_thread.h"
 
+#include "Platform/Platform.hpp"
+#include "clFileContentCache.hpp"
 #include "clFilesCollector.h"
+#include "clTrace.hpp"
 #include "clWildMatch.hpp"
 #include "StringUtils.h"
 #include "file_logger.h"
 #include "fileutils.h"
 #include "macros.h"
+#include "procutils.h"
 
+#include <algorithm>
 #include <set>
+#include <unordered_map>
 #include <wx/event.h>
 #include <wx/fontmap.h>
 #include <wx/stopwatch.h>
@@ -64,6 +70,78 @@ bool is_word_char(wxChar ch) { return ch == '_' || wxIsalnum(ch); }
 constexpr long MIN_SEND_INTERVAL_MS = 1;
 size_t send_count = 0;
 
+wxString shell_quote(const wxString& str)
+{
+#ifdef __WXMSW__
+    wxString quoted = str;
+    quoted.Replace("\"", "\\\"");
+    // backslashes before the closing quote would escape it
+    size_t backslashes = 0;
+    for (size_t i = quoted.length(); i > 0 && quoted[i - 1] == '\\'; --i) {
+        ++backslashes;
+    }
+    quoted.Append('\\', backslashes);
+    return "\"" + quoted + "\"";
+#else
+    wxString quoted = str;
+    quoted.Replace("'", "'\\''");
+    return "'" + quoted + "'";
+#endif
+}
+
+/// the ripgrep globs for the files mask, with the semantic of clFileExtensionMatcher: a file matches if its name
+/// ends with one of the masks, without the "*". An empty array means that all the files match
+wxArrayString to_ripgrep_globs(const wxString& mask)
+{
+    wxArrayString globs;
+    wxArrayString masks = ::wxStringTokenize(mask, ";,", wxTOKEN_STRTOK);
+    for (wxString& m : masks) {
+        m.Replace("*", wxEmptyString);
+        m.Trim().Trim(false);
+        if (m.empty()) {
+            return {};
+        }
+        globs.Add("*" + m);
+    }
+    return globs;
+}
+
+/// filters the directories that SearchThread::GetFiles() does not traverse, since ripgrep can not match a path the
+/// same way. The result is cached per directory
+class ExcludedDirs
+{
+    clPathExcluder m_excluder;
+    bool m_empty = true;
+    std::unordered_map<wxString, bool> m_cache;
+
+public:
+    explicit ExcludedDirs(const wxArrayString& patterns)
+        : m_excluder(patterns)
+        , m_empty(patterns.empty())
+    {
+    }
+
+    /// return true if `dir`, or one of its parents below the root directory, is excluded
+    bool IsExcluded(const wxString& dir, size_t root_len)
+    {
+        if (m_empty || dir.length() <= root_len) {
+            return false;
+        }
+
+        auto iter = m_cache.find(dir);
+        if (iter != m_cache.end()) {
+            return iter->second;
+        }
+
+        bool excluded = m_excluder.is_exclude_path(dir);
+        if (!excluded) {
+            size_t where = dir.find_last_of(wxFileName::GetPathSeparators());
+            excluded = where != wxString::npos && IsExcluded(dir.Mid(0, where), root_len);
+        }
+        m_cache.insert({ dir, excluded });
+        return excluded;
+    }
+};
 } // namespace
 
 const wxString& SearchData::GetExtensions() const { return m_validExt; }
@@ -128,10 +206,12 @@ void SearchThread::PerformSearch(const SearchData& data) { Add(new SearchData(da
 void SearchThread::ProcessRequest(ThreadRequest* req)
 {
     FileLogger::RegisterThread(wxThread::GetCurrentId(), "Search Thread");
+    CL_TRACE_ZONE("Find in files");
     wxStopWatch sw;
     m_summary = SearchSummary();
     DoSearchFiles(req);
     m_summary.SetElapsedTime(sw.Time());
+    clFileContentCache::Get().LogStats("Search:");
 
     SearchData* sd = (SearchData*)req;
     m_summary.SetFindWhat(sd->GetFindString());
@@ -217,8 +297,11 @@ void SearchThread::DoSearchFiles(ThreadRequest* req)
     }
 
     StopSearch(false);
+    bool use_ripgrep = CanSearchWithRipgrep(data);
     wxArrayString fileList;
-    GetFiles(data, fileList);
+    if (!use_ripgrep) {
+        GetFiles(data, fileList);
+    }
 
     wxStopWatch sw;
 
@@ -234,6 +317,11 @@ void SearchThread::DoSearchFiles(ThreadRequest* req)
         }
     }
 
+    if (use_ripgrep) {
+        DoSearchFilesWithRipgrep(data);
+        return;
+    }
+
     for (size_t i = 0; i < fileList.Count(); i++) {
         m_summary.SetNumFileScanned((int)i + 1);
 
@@ -248,6 +336,188 @@ void SearchThread::DoSearchFiles(ThreadRequest* req)
     }
 }
 
+bool SearchThread::CanSearchWithRipgrep(const SearchData* data)
+{
+    // ripgrep regular expressions are not the ones of wxRegEx, and the replace needs the captures of each match.
+    // A list of files may not fit in a command line
+    if (!data->IsUseRipgrep() || data->IsRegularExpression() || data->GetRootDirs().empty() ||
+        !data->GetFiles().empty()) {
+        return false;
+    }
+
+    // the pipe filters are applied to the whole line
+    if (data->IsEnablePipeSupport() && data->GetFindString().Contains("|")) {
+        return false;
+    }
+
+    // ripgrep reads UTF-8 (and UTF-16 with a BOM) only
+#if wxUSE_GUI
+    if (!data->GetEncoding().empty()) {
+        wxFontEncoding enc = wxFontMapper::GetEncodingFromName(data->GetEncoding());
+        if (enc != wxFONTENCODING_UTF8 && enc != wxFONTENCODING_SYSTEM && enc != wxFONTENCODING_DEFAULT) {
+            return false;
+        }
+    }
+#endif
+
+    if (!m_ripgrepLocated) {
+        m_ripgrepLocated = true;
+        m_ripgrep = ThePlatform->Which("rg").value_or(wxEmptyString);
+        if (m_ripgrep.empty()) {
+            clDEBUG() << "Search: ripgrep is not installed, using the built-in search" << endl;
+        } else {
+            clDEBUG() << "Search: using ripgrep:" << m_ripgrep << endl;
+        }
+    }
+    return !m_ripgrep.empty();
+}
+
+void SearchThread::DoSearchFilesWithRipgrep(const SearchData* data)
+{
+    wxString command;
+    command << shell_quote(m_ripgrep) << " --json --no-config --no-messages --fixed-strings";
+    command << (data->IsMatchCase() ? " --case-sensitive" : " --ignore-case");
+    if (data->IsMatchWholeWord()) {
+        command << " --word-regexp";
+    }
+    if (!(data->GetFileScannerFlags() & clFilesScanner::SF_EXCLUDE_HIDDEN_DIRS)) {
+        command << " --hidden";
+    }
+    if (!(data->GetFileScannerFlags() & clFilesScanner::SF_DONT_FOLLOW_SYMLINKS)) {
+        command << " --follow";
+    }
+    for (const wxString& glob : to_ripgrep_globs(data->GetExtensions())) {
+        command << " --glob " << shell_quote(glob);
+    }
+    // a plain exclude pattern matches any directory whose name contains it, let ripgrep skip these directories.
+    // The other patterns are checked for each file below
+    for (const wxString& pattern : data->GetExcludePatterns()) {
+        if (!pattern.empty() && !::wxIsWild(pattern) && pattern.find_first_of("/\\[]{}") == wxString::npos) {
+            command << " --glob " << shell_quote("!*" + pattern + "*/");
+        }
+    }
+    command << " --regexp " << shell_quote(data->GetFindString()) << " --";
+    for (const wxString& root : data->GetRootDirs()) {
+        command << " " << shell_quote(root);
+    }
+    clDEBUG() << "Search:" << command << endl;
+
+    ExcludedDirs excluded_dirs{ data->GetExcludePatterns() };
+    wxStringSet_t visited_files;
+    wxString filename;
+    bool skip_file = false;
+    bool cancelled = false;
+
+    // ripgrep searches the files in parallel and reports them in a different order on each run. Keep the matches
+    // of each file together and report them sorted by file name once ripgrep is done, like GetFiles() does
+    std::vector<std::pair<wxString, SearchResultList>> files_results;
+
+    auto on_match = [&](const JSONItem& match) {
+        wxString line = match.namedObject("lines").namedObject("text").toString();
+        if (line.empty()) {
+            // not valid UTF-8, ripgrep sent the line as base64 "bytes"
+            return;
+        }
+        while (line.EndsWith("\n") || line.EndsWith("\r")) {
+            line.RemoveLast();
+        }
+
+        // ripgrep reports byte offsets in the UTF-8 line
+        const wxScopedCharBuffer utf8 = line.ToUTF8();
+        int line_number = match.namedObject("line_number").toInt();
+        size_t line_offset = match.namedObject("absolute_offset").toSize_t();
+        wxString pattern = line.length() > 500 ? line.Mid(0, 500) : line;
+
+        JSONItem submatches = match.namedObject("submatches");
+        int count = submatches.arraySize();
+        for (int i = 0; i < count; ++i) {
+            JSONItem submatch = submatches.arrayItem(i);
+            size_t start = submatch.namedObject("start").toSize_t();
+            size_t end = submatch.namedObject("end").toSize_t();
+            if (start > end || end > utf8.length()) {
+                continue;
+            }
+
+            SearchResult result;
+            result.SetPosition((int)(line_offset + start));
+            result.SetColumnInChars((int)wxString::FromUTF8(utf8.data(), start).length());
+            result.SetColumn((int)start);
+            result.SetLineNumber(line_number);
+            result.SetPattern(pattern);
+            result.SetFileName(filename);
+            result.SetLenInChars((int)wxString::FromUTF8(utf8.data() + start, end - start).length());
+            result.SetLen((int)(end - start));
+            result.SetFindWhat(data->GetFindString());
+            result.SetFlags(data->m_flags);
+
+            files_results.back().second.push_back(result);
+            m_summary.SetNumMatchesFound(m_summary.GetNumMatchesFound() + 1);
+        }
+    };
+
+    auto on_line = [&](const wxString& output) -> bool {
+        if (TestStopSearch()) {
+            cancelled = true;
+            return true;
+        }
+
+        JSON root(output);
+        if (!root.isOk()) {
+            return false;
+        }
+
+        JSONItem message = root.toElement();
+        wxString type = message.namedObject("type").toString();
+        JSONItem item = message.namedObject("data");
+        if (type == "begin") {
+            filename = item.namedObject("path").namedObject("text").toString();
+            // the same file may be found from two root directories
+            skip_file = filename.empty() || !visited_files.insert(filename).second;
+            if (!skip_file) {
+                wxString dir = wxFileName(filename).GetPath();
+                for (const wxString& root_dir : data->GetRootDirs()) {
+                    if (filename.StartsWith(root_dir)) {
+                        skip_file = excluded_dirs.IsExcluded(dir, root_dir.length());
+                        break;
+                    }
+                }
+            }
+
+            if (!skip_file) {
+                files_results.push_back({ filename, {} });
+            }
+
+        } else if (type == "match") {
+            if (!skip_file) {
+                on_match(item);
+            }
+
+        } else if (type == "summary") {
+            m_summary.SetNumFileScanned(item.namedObject("stats").namedObject("searches").toInt());
+        }
+        return false;
+    };
+
+    ProcUtils::SafeExecuteCommandWithCallback(command, on_line);
+
+    std::sort(files_results.begin(), files_results.end(), [](const auto& a, const auto& b) {
+        int cmp = a.first.CmpNoCase(b.first);
+        return cmp != 0 ? cmp < 0 : a.first < b.first;
+    });
+    for (auto& [file, results] : files_results) {
+        if (results.empty()) {
+            continue;
+        }
+        m_results.swap(results);
+        SendEvent(wxEVT_SEARCH_THREAD_MATCHFOUND, data->GetOwner());
+    }
+
+    if (cancelled) {
+        SendEvent(wxEVT_SEARCH_THREAD_SEARCHCANCELED, data->GetOwner());
+        StopSearch(false);
+    }
+}
+
 bool SearchThread::TestStopSearch()
 {
     bool stop = false;
@@ -277,28 +547,23 @@ void SearchThread::DoSearchFile(const wxString& fileName, const SearchData* data
         return;
     }
 
-    size_t size = FileUtils::GetFileSize(fileName);
-    if (size == 0) {
-        return;
-    }
-    wxString fileData;
-    fileData.Alloc(size);
-
 #if wxUSE_GUI
     // support for other encoding
     wxFontEncoding enc = wxFontMapper::GetEncodingFromName(data->GetEncoding().c_str());
-    wxCSConv fontEncConv(enc);
-    if (!FileUtils::ReadFileContent(fileName, fileData, fontEncConv)) {
+#else
+    wxFontEncoding enc = wxFONTENCODING_SYSTEM;
+#endif
+    // repeated searches on the same files are served from the cache
+    auto fileData = clFileContentCache::Get().Read(fileName, enc);
+    if (!fileData) {
         m_summary.GetFailedFiles().Add(fileName);
         return;
     }
-#else
-    if (!FileUtils::ReadFileContent(fileName, fileData, wxConvLibc)) {
-        m_summary.GetFailedFiles().Add(fileName);
+
+    if (fileData->empty()) {
         return;
     }
-#endif
-    wxArrayString lines = ::wxStringTokenize(fileData, wxT("\n"), wxTOKEN_RET_EMPTY_ALL);
+    wxArrayString lines = ::wxStringTokenize(*fileData, wxT("\n"), wxTOKEN_RET_EMPTY_ALL);
 
     int lineOffset = 0;
     if (data->IsRegularExpression()) {
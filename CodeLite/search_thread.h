@@ -62,6 +62,7 @@ enum {
     wxSD_COLOUR_COMMENTS = 0x00000100,
     wxSD_WILDCARD = 0x00000200,
     wxSD_ENABLE_PIPE_SUPPORT = 0x00000400,
+    wxSD_USE_RIPGREP = 0x00000800,
 };
 
 class WXDLLIMPEXP_CL SearchData : public ThreadRequest
@@ -116,6 +117,9 @@ public:
     bool IsMatchCase() const { return m_flags & wxSD_MATCHCASE ? true : false; }
     bool IsEnablePipeSupport() const { return m_flags & wxSD_ENABLE_PIPE_SUPPORT; }
     void SetEnablePipeSupport(bool b) { SetOption(wxSD_ENABLE_PIPE_SUPPORT, b); }
+    /// search with ripgrep when it is installed and can handle the search, see SearchThread::CanSearchWithRipgrep()
+    bool IsUseRipgrep() const { return m_flags & wxSD_USE_RIPGREP; }
+    void SetUseRipgrep(bool b) { SetOption(wxSD_USE_RIPGREP, b); }
     bool IsMatchWholeWord() const { return m_flags & wxSD_MATCHWHOLEWORD ? true : false; }
     bool IsRegularExpression() const { return m_flags & wxSD_REGULAREXPRESSION ? true : false; }
     const wxArrayString& GetRootDirs() const { return m_rootDirs; }
@@ -352,6 +356,8 @@ class WXDLLIMPEXP_CL SearchThread : public WorkerThread
     bool m_matchCase;
     wxCriticalSection m_cs;
     wxStopWatch m_stopWatch;
+    wxString m_ripgrep;
+    bool m_ripgrepLocated = false;
 
 public:
     /**
@@ -398,6 +404,17 @@ private:
      */
     void DoSearchFiles(ThreadRequest* data);
 
+    /**
+     * @brief return true if the search can be done by ripgrep: the user enabled it, ripgrep is installed and the
+     * search only needs features that ripgrep implements the same way
+     */
+    bool CanSearchWithRipgrep(const SearchData* data);
+
+    /**
+     * @brief search the root directories with `rg --json` and report the matches sorted by file name
+     */
+    void DoSearchFilesWithRipgrep(const SearchData* data);
+
     // Perform search on a single file
     void DoSearchFile(const wxString& fileName, const SearchData* data);
 
@@ -28,11 +28,11 @@
 #include "DbViewerPanel.h"
 #include "Keyboard/clKeyboardManager.h"
 #include "bitmap_loader.h"
-#include "clStatusBarMessage.h"
 #include "cl_aui_tool_stickness.h"
 #include "cl_defs.h"
 #include "db_explorer_settings.h"
 #include "editor_config.h"
+#include "file_logger.h"
 #include "globals.h"
 #include "imanager.h"
 #include "lexer_configuration.h"
@@ -57,6 +57,15 @@
 
 const wxEventType wxEVT_EXECUTE_SQL = XRCID("wxEVT_EXECUTE_SQL");
 
+namespace
+{
+// the rows are posted to the table in pages, or more often while they are slow to come
+constexpr size_t ROWS_PER_POST = 500;
+constexpr auto POST_INTERVAL = std::chrono::milliseconds(100);
+// all the fetched rows are kept in memory, stop before they exhaust it
+constexpr size_t MAX_ROWS = 500000;
+} // namespace
+
 BEGIN_EVENT_TABLE(SQLCommandPanel, _SqlCommandPanel)
 EVT_COMMAND(wxID_ANY, wxEVT_EXECUTE_SQL, SQLCommandPanel::OnExecuteSQL)
 END_EVENT_TABLE()
@@ -103,15 +112,26 @@ SQLCommandPanel::SQLCommandPanel(wxWindow* parent, IDbAdapter* dbAdapter, const
     auto images = m_toolbar->GetBitmapsCreateIfNeeded();
     m_toolbar->AddTool(wxID_OPEN, _("Load SQL Script"), images->Add("file_open"));
     m_toolbar->AddTool(wxID_EXECUTE, _("Execute SQL"), images->Add("execute"));
+    m_toolbar->AddTool(wxID_STOP, _("Stop"), images->Add("execute_stop"));
     m_toolbar->Realize();
     GetSizer()->Insert(0, m_toolbar, 0, wxEXPAND);
 
     // Bind events
     m_toolbar->Bind(wxEVT_TOOL, &SQLCommandPanel::OnExecuteClick, this, wxID_EXECUTE);
     m_toolbar->Bind(wxEVT_TOOL, &SQLCommandPanel::OnLoadClick, this, wxID_OPEN);
+    m_toolbar->Bind(wxEVT_TOOL, &SQLCommandPanel::OnStopClick, this, wxID_STOP);
+    m_toolbar->Bind(
+        wxEVT_UPDATE_UI, [this](wxUpdateUIEvent& event) { event.Enable(!m_queryRunning); }, wxID_EXECUTE);
+    m_toolbar->Bind(
+        wxEVT_UPDATE_UI, [this](wxUpdateUIEvent& event) { event.Enable(m_queryRunning && !m_cancelQuery); },
+        wxID_STOP);
 }
 
-SQLCommandPanel::~SQLCommandPanel() { wxDELETE(m_pDbAdapter); }
+SQLCommandPanel::~SQLCommandPanel()
+{
+    StopQuery();
+    wxDELETE(m_pDbAdapter);
+}
 
 void SQLCommandPanel::OnExecuteClick(wxCommandEvent& event) { ExecuteSql(); }
 
@@ -125,155 +145,269 @@ void SQLCommandPanel::OnScintilaKeyDown(wxKeyEvent& event)
 
 void SQLCommandPanel::ExecuteSql()
 {
-    clStatusBarMessage message(_("Executing SQL..."));
-
-    clWindowUpdateLocker locker(this);
-    std::set<int> textCols;
-    std::set<int> blobCols;
-    DatabaseLayerPtr m_pDbLayer = m_pDbAdapter->GetDatabaseLayer(m_dbName);
-    if(m_pDbLayer->IsOpen()) {
-        // build string of SQL statements with comments removed
-        wxArrayString sqls = ParseSql();
-        wxString sqlStmt = "";
-        for(size_t i = 0; i < sqls.GetCount(); i++) {
-            sqlStmt += sqls[i];
-        }
+    if(m_queryRunning) {
+        return;
+    }
 
-        // save the history
-        SaveSqlHistory(sqls);
-
-        if(!sqls.IsEmpty()) {
-            try {
-                m_colsMetaData.clear();
-                if(!m_pDbAdapter->GetUseDb(m_dbName).IsEmpty())
-                    m_pDbLayer->RunQuery(m_pDbAdapter->GetUseDb(m_dbName));
-                // run query
-                DatabaseResultSet* pResultSet = m_pDbLayer->RunQueryWithResults(sqlStmt);
-
-                m_table->ClearAll();
-                if(!pResultSet) {
-                    wxMessageBox(_("Unknown SQL error."), _("DB Error"), wxOK | wxICON_ERROR);
-                    return;
-                }
+    DatabaseLayerPtr dbLayer = m_pDbAdapter->GetDatabaseLayer(m_dbName);
+    if(!dbLayer || !dbLayer->IsOpen()) {
+        wxMessageBox(_("Cant connect!"));
+        return;
+    }
 
-                int cols = pResultSet->GetMetaData()->GetColumnCount();
-                m_colsMetaData.resize(cols);
+    // build string of SQL statements with comments removed
+    wxArrayString sqls = ParseSql();
+    wxString sqlStmt = "";
+    for(size_t i = 0; i < sqls.GetCount(); i++) {
+        sqlStmt += sqls[i];
+    }
 
-                // create table header
-                wxArrayString columns;
-                for(int i = 1; i <= pResultSet->GetMetaData()->GetColumnCount(); i++) {
-                    columns.Add(pResultSet->GetMetaData()->GetColumnName(i));
-                    m_colsMetaData.at(i - 1) = ColumnInfo(pResultSet->GetMetaData()->GetColumnType(i),
-                                                          pResultSet->GetMetaData()->GetColumnName(i));
-                }
-                m_table->SetColumns(columns);
+    // save the history
+    SaveSqlHistory(sqls);
+    if(sqls.IsEmpty()) {
+        return;
+    }
 
-                // fill table data
-                std::vector<wxArrayString> data;
-                while(pResultSet->Next()) {
-                    data.push_back(wxArrayString());
-                    wxArrayString& row = data.back();
-                    wxString value;
-                    for(int i = 1; i <= pResultSet->GetMetaData()->GetColumnCount(); i++) {
+    // the previous query completed, but its thread may not have been joined yet
+    StopQuery();
+    m_colsMetaData.clear();
+    m_table->ClearAll();
+
+    m_cancelQuery = false;
+    m_queryRunning = true;
+    m_queryStart = std::chrono::steady_clock::now();
+    ++m_queryId;
+    clGetManager()->SetStatusMessage(_("Executing SQL..."), 0);
+
+    // the thread owns the connection: each call to GetDatabaseLayer() opens a new one
+    m_queryThread = std::thread(&SQLCommandPanel::QueryThreadMain, this, m_queryId, dbLayer,
+                                m_pDbAdapter->GetUseDb(m_dbName), sqlStmt,
+                                m_pDbAdapter->GetAdapterType() == IDbAdapter::atSQLITE);
+}
 
-                        switch(pResultSet->GetMetaData()->GetColumnType(i)) {
-                        case ResultSetMetaData::COLUMN_INTEGER:
-                            if(m_pDbAdapter->GetAdapterType() == IDbAdapter::atSQLITE) {
-                                value = pResultSet->GetResultString(i);
+void SQLCommandPanel::QueryThreadMain(size_t queryId, DatabaseLayerPtr dbLayer, const wxString& useDb,
+                                      const wxString& sql, bool isSqlite)
+{
+    using clock = std::chrono::steady_clock;
 
-                            } else {
-                                value = wxString::Format(wxT("%i"), pResultSet->GetResultInt(i));
-                            }
-                            break;
+    SqlQueryStats stats;
+    std::vector<wxArrayString> page;
+    try {
+        if(!useDb.IsEmpty()) {
+            dbLayer->RunQuery(useDb);
+        }
 
-                        case ResultSetMetaData::COLUMN_STRING:
-                            value = pResultSet->GetResultString(i);
-                            break;
+        // run query
+        auto fetchStart = clock::now();
+        DatabaseResultSet* pResultSet = dbLayer->RunQueryWithResults(sql);
+        stats.fetchTime += clock::now() - fetchStart;
+        if(!pResultSet) {
+            stats.error = _("Unknown SQL error.");
+
+        } else {
+            ResultSetMetaData* metaData = pResultSet->GetMetaData();
+            int cols = metaData->GetColumnCount();
+
+            // create table header
+            ColumnInfo::Vector_t columns;
+            columns.reserve(cols);
+            for(int i = 1; i <= cols; i++) {
+                columns.push_back(ColumnInfo(metaData->GetColumnType(i), metaData->GetColumnName(i)));
+            }
+            CallAfter(&SQLCommandPanel::OnQueryColumns, queryId, columns);
+
+            std::set<int> textCols;
+            std::set<int> blobCols;
+            auto lastPost = clock::now();
+            while(!m_cancelQuery) {
+                fetchStart = clock::now();
+                if(!pResultSet->Next()) {
+                    stats.fetchTime += clock::now() - fetchStart;
+                    break;
+                }
+                auto formatStart = clock::now();
+                stats.fetchTime += formatStart - fetchStart;
+                if(stats.rows >= MAX_ROWS) {
+                    stats.truncated = true;
+                    break;
+                }
+
+                wxArrayString row;
+                row.Alloc(cols);
+                wxString value;
+                for(int i = 1; i <= cols; i++) {
 
-                        case ResultSetMetaData::COLUMN_UNKNOWN:
+                    switch(columns[i - 1].GetType()) {
+                    case ResultSetMetaData::COLUMN_INTEGER:
+                        if(isSqlite) {
                             value = pResultSet->GetResultString(i);
-                            break;
 
-                        case ResultSetMetaData::COLUMN_BLOB: {
-                            if(textCols.find(i) != textCols.end()) {
-                                // this column should be displayed as TEXT rather than BLOB
-                                value = pResultSet->GetResultString(i);
+                        } else {
+                            value = wxString::Format(wxT("%i"), pResultSet->GetResultInt(i));
+                        }
+                        break;
+
+                    case ResultSetMetaData::COLUMN_STRING:
+                        value = pResultSet->GetResultString(i);
+                        break;
 
-                            } else if(blobCols.find(i) != blobCols.end()) {
-                                // this column should be displayed as BLOB
+                    case ResultSetMetaData::COLUMN_UNKNOWN:
+                        value = pResultSet->GetResultString(i);
+                        break;
+
+                    case ResultSetMetaData::COLUMN_BLOB: {
+                        if(textCols.find(i) != textCols.end()) {
+                            // this column should be displayed as TEXT rather than BLOB
+                            value = pResultSet->GetResultString(i);
+
+                        } else if(blobCols.find(i) != blobCols.end()) {
+                            // this column should be displayed as BLOB
+                            wxMemoryBuffer buffer;
+                            pResultSet->GetResultBlob(i, buffer);
+                            value = wxString::Format(wxT("BLOB (Size:%u)"), buffer.GetDataLen());
+
+                        } else {
+                            // first time
+                            wxString strCol = pResultSet->GetResultString(i);
+                            if(IsBlobColumn(strCol)) {
+                                blobCols.insert(i);
                                 wxMemoryBuffer buffer;
                                 pResultSet->GetResultBlob(i, buffer);
                                 value = wxString::Format(wxT("BLOB (Size:%u)"), buffer.GetDataLen());
 
                             } else {
-                                // first time
-                                wxString strCol = pResultSet->GetResultString(i);
-                                if(IsBlobColumn(strCol)) {
-                                    blobCols.insert(i);
-                                    wxMemoryBuffer buffer;
-                                    pResultSet->GetResultBlob(i, buffer);
-                                    value = wxString::Format(wxT("BLOB (Size:%u)"), buffer.GetDataLen());
-
-                                } else {
-                                    textCols.insert(i);
-                                    value = strCol;
-                                }
+                                textCols.insert(i);
+                                value = strCol;
                             }
-                            break;
                         }
-                        case ResultSetMetaData::COLUMN_BOOL:
-                            value = wxString::Format(wxT("%b"), pResultSet->GetResultBool(i));
-                            break;
-
-                        case ResultSetMetaData::COLUMN_DATE: {
-                            wxDateTime dt = pResultSet->GetResultDate(i);
-                            if(dt.IsValid()) {
-                                value = dt.Format();
-                            } else {
-                                value.Clear();
-                            }
-                        } break;
+                        break;
+                    }
+                    case ResultSetMetaData::COLUMN_BOOL:
+                        value = wxString::Format(wxT("%b"), pResultSet->GetResultBool(i));
+                        break;
+
+                    case ResultSetMetaData::COLUMN_DATE: {
+                        wxDateTime dt = pResultSet->GetResultDate(i);
+                        if(dt.IsValid()) {
+                            value = dt.Format();
+                        } else {
+                            value.Clear();
+                        }
+                    } break;
 
-                        case ResultSetMetaData::COLUMN_DOUBLE:
-                            value = wxString::Format(wxT("%f"), pResultSet->GetResultDouble(i));
-                            break;
+                    case ResultSetMetaData::COLUMN_DOUBLE:
+                        value = wxString::Format(wxT("%f"), pResultSet->GetResultDouble(i));
+                        break;
 
-                        case ResultSetMetaData::COLUMN_NULL:
-                            value = wxT("NULL");
-                            break;
+                    case ResultSetMetaData::COLUMN_NULL:
+                        value = wxT("NULL");
+                        break;
 
-                        default:
-                            value = pResultSet->GetResultString(i);
-                            break;
-                        }
-                        row.Add(value);
+                    default:
+                        value = pResultSet->GetResultString(i);
+                        break;
                     }
+                    row.Add(value);
                 }
-                m_pDbLayer->CloseResultSet(pResultSet);
-
-                // Populate the data
-                m_table->SetData(data);
-                GetSizer()->Layout();
-                Layout();
-
-            } catch (const DatabaseLayerException& e) {
-                // for some reason an exception is thrown even if the error code is 0...
-                if(e.GetErrorCode() != 0) {
-                    wxString errorMessage =
-                        wxString::Format(_("Error (%d): %s"), e.GetErrorCode(), e.GetErrorMessage().c_str());
-                    wxMessageDialog dlg(this, errorMessage, _("DB Error"), wxOK | wxCENTER | wxICON_ERROR);
-                    dlg.ShowModal();
+                page.push_back(std::move(row));
+                ++stats.rows;
+
+                auto now = clock::now();
+                stats.formatTime += now - formatStart;
+                if(page.size() >= ROWS_PER_POST || now - lastPost >= POST_INTERVAL) {
+                    CallAfter(&SQLCommandPanel::OnQueryRows, queryId, page);
+                    page.clear();
+                    lastPost = now;
                 }
-
-            } catch (...) {
-                wxMessageDialog dlg(this, _("Unknown error."), _("DB Error"), wxOK | wxCENTER | wxICON_ERROR);
-                dlg.ShowModal();
             }
+            stats.cancelled = m_cancelQuery;
+            dbLayer->CloseResultSet(pResultSet);
         }
 
-    } else {
-        wxMessageBox(_("Cant connect!"));
+    } catch (const DatabaseLayerException& e) {
+        // for some reason an exception is thrown even if the error code is 0...
+        if(e.GetErrorCode() != 0) {
+            stats.error = wxString::Format(_("Error (%d): %s"), e.GetErrorCode(), e.GetErrorMessage().c_str());
+        }
+
+    } catch (...) {
+        stats.error = _("Unknown error.");
+    }
+
+    if(!page.empty()) {
+        CallAfter(&SQLCommandPanel::OnQueryRows, queryId, page);
+    }
+    CallAfter(&SQLCommandPanel::OnQueryCompleted, queryId, stats);
+}
+
+void SQLCommandPanel::StopQuery()
+{
+    m_cancelQuery = true;
+    if(m_queryThread.joinable()) {
+        m_queryThread.join();
+    }
+    m_queryRunning = false;
+}
+
+void SQLCommandPanel::OnQueryColumns(size_t queryId, const ColumnInfo::Vector_t& columns)
+{
+    if(queryId != m_queryId) {
+        return;
+    }
+
+    m_colsMetaData = columns;
+    wxArrayString names;
+    for(const auto& column : columns) {
+        names.Add(column.GetName());
     }
+    m_table->SetColumns(names);
+}
+
+void SQLCommandPanel::OnQueryRows(size_t queryId, const std::vector<wxArrayString>& rows)
+{
+    if(queryId != m_queryId) {
+        return;
+    }
+    m_table->AppendData(rows);
+}
+
+void SQLCommandPanel::OnQueryCompleted(size_t queryId, const SqlQueryStats& stats)
+{
+    if(queryId != m_queryId) {
+        return;
+    }
+
+    // this is the last event posted by the thread
+    StopQuery();
+    GetSizer()->Layout();
+    Layout();
+
+    auto to_ms = [](std::chrono::steady_clock::duration d) {
+        return (long long)std::chrono::duration_cast<std::chrono::milliseconds>(d).count();
+    };
+    wxString message;
+    message << _("SQL: ") << stats.rows << _(" rows in ") << to_ms(std::chrono::steady_clock::now() - m_queryStart)
+            << _("ms (fetch: ") << to_ms(stats.fetchTime) << _("ms, format: ") << to_ms(stats.formatTime)
+            << _("ms)");
+    if(stats.cancelled) {
+        message << _(" - cancelled");
+    } else if(stats.truncated) {
+        message << _(" - truncated");
+    }
+    clGetManager()->SetStatusMessage(message, 10);
+    clDEBUG() << "DatabaseExplorer:" << message << endl;
+
+    if(!stats.error.IsEmpty()) {
+        wxMessageDialog dlg(this, stats.error, _("DB Error"), wxOK | wxCENTER | wxICON_ERROR);
+        dlg.ShowModal();
+    }
+}
+
+void SQLCommandPanel::OnStopClick(wxCommandEvent& event)
+{
+    wxUnusedVar(event);
+    // the thread notices it between two rows and reports the rows fetched so far
+    m_cancelQuery = true;
 }
 
 void SQLCommandPanel::OnLoadClick(wxCommandEvent& event)
@@ -31,7 +31,10 @@
 #include "clEditorEditEventsHandler.h"
 #include "clToolBar.h"
 
+#include <atomic>
+#include <chrono>
 #include <map>
+#include <thread>
 #include <wx/aui/auibar.h>
 #include <wx/dblayer/include/DatabaseErrorCodes.h>
 #include <wx/dblayer/include/DatabaseLayer.h>
@@ -67,6 +70,17 @@ public:
     int GetType() const { return m_type; }
 };
 
+// ----------------------------------------------------------------
+/// Reported by the query thread once the query completed, failed or was cancelled
+struct SqlQueryStats {
+    size_t rows = 0;
+    std::chrono::steady_clock::duration fetchTime{};  // executing the query and moving to the next rows
+    std::chrono::steady_clock::duration formatTime{}; // converting the cells to strings
+    bool cancelled = false;
+    bool truncated = false; // stopped after the maximum number of rows
+    wxString error;         // empty on success
+};
+
 // ----------------------------------------------------------------
 class SQLCommandPanel : public _SqlCommandPanel
 {
@@ -85,8 +99,22 @@ protected:
     clEditEventsHandler::Ptr_t m_editHelper;
     clToolBarGeneric* m_toolbar;
 
+    // queries run on a worker thread, the rows are streamed to the table page by page
+    std::thread m_queryThread;
+    std::atomic_bool m_cancelQuery{ false };
+    bool m_queryRunning = false;
+    size_t m_queryId = 0; // events posted by an older query are ignored
+    std::chrono::steady_clock::time_point m_queryStart;
+
 protected:
-    bool IsBlobColumn(const wxString& str);
+    static bool IsBlobColumn(const wxString& str);
+    void QueryThreadMain(size_t queryId, DatabaseLayerPtr dbLayer, const wxString& useDb, const wxString& sql,
+                         bool isSqlite);
+    void StopQuery();
+    void OnQueryColumns(size_t queryId, const ColumnInfo::Vector_t& columns);
+    void OnQueryRows(size_t queryId, const std::vector<wxArrayString>& rows);
+    void OnQueryCompleted(size_t queryId, const SqlQueryStats& stats);
+    void OnStopClick(wxCommandEvent& event);
     wxArrayString ParseSql() const;
     void SaveSqlHistory(wxArrayString sqls);
 
@@ -566,6 +566,10 @@ public:
     /// Clear modified line state
     virtual void ClearModifiedLines() = 0;
 
+    /// Return the (0 based, sorted) lines modified since the last call to ClearModifiedLines(), at their current
+    /// position in the document. The list is empty while a ClearModifiedLines() request is pending
+    virtual std::vector<int> GetModifiedLines() const = 0;
+
     /**
      * @brief return a string representing all the classes coloured by this editor
      */
@@ -629,6 +633,12 @@ public:
      */
     virtual SFTPClientData* GetRemoteData() const = 0;
 
+    /**
+     * @brief return true if this editor was opened in "large file" mode. In this mode
+     * lexing, folding, word highlighting and LSP are disabled for the editor
+     */
+    virtual bool IsLargeFileMode() const = 0;
+
     /**
      * @brief set semantic tokens for this editor
      */
@@ -3,6 +3,7 @@
 #include "StringUtils.h"
 #include "build_settings_config.h"
 #include "clStrings.h"
+#include "clTrace.hpp"
 #include "editor_config.h"
 #include "event_notifier.h"
 #include "file_logger.h"
@@ -134,6 +135,7 @@ void BuildTab::OnBuildEnded(clBuildEvent& e)
 
 void BuildTab::ProcessBuffer(bool last_line)
 {
+    CL_TRACE_ZONE("Process build output");
     auto remainder = m_viewStc->Add(m_buffer, last_line);
     m_viewStc->ScrollToEnd();
 
@@ -31,4 +31,8 @@ EditorOptionsGeneralEdit::EditorOptionsGeneralEdit(wxWindow* parent, OptionsConf
     AddProperty(_("Enable zoom with mouse scroll"), m_options->IsMouseZoomEnabled(),
                 UPDATE_BOOL_CB(SetMouseZoomEnabled));
     AddProperty(_("Indent line comments"), m_options->GetIndentedComments(), UPDATE_BOOL_CB(SetIndentedComments));
+
+    AddHeader(_("Large files"));
+    AddProperty(_("Large file mode threshold (MB), 0 disables it"),
+                m_options->GetLargeFileThresholdMB(), UPDATE_INT_CB(SetLargeFileThresholdMB));
 }
@@ -0,0 +1,406 @@
+#include "ReplaceInFilesEngine.h"
+
+#include "cl_standard_paths.h"
+#include "file_logger.h"
+#include "fileutils.h"
+#include "globals.h"
+
+#include <algorithm>
+#include <memory>
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <wx/stopwatch.h>
+#include <wx/strconv.h>
+
+#ifndef __WXMSW__
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// replacing is mostly I/O bound, more threads just compete for the disk
+constexpr unsigned MAX_THREADS = 8;
+
+bool get_file_info(const wxString& path, wxFileOffset& size, time_t& mtime)
+{
+    wxStructStat st;
+    if (wxStat(path, &st) != 0) {
+        return false;
+    }
+    size = st.st_size;
+    mtime = st.st_mtime;
+    return true;
+}
+
+bool read_bytes(const wxString& path, std::string& data)
+{
+    wxFile fp(path, wxFile::read);
+    if (!fp.IsOpened()) {
+        return false;
+    }
+    wxFileOffset len = fp.Length();
+    if (len < 0) {
+        return false;
+    }
+    data.resize((size_t)len);
+    return len == 0 || fp.Read(&data[0], (size_t)len) == (ssize_t)len;
+}
+
+/// replace the content of `path` (a resolved path) with `data`. The data is written to a temporary file next to
+/// `path`, that gets the permissions and the owner of `path` before it is renamed over it
+bool write_bytes(const wxString& path, const std::string& data)
+{
+    wxStructStat st;
+    bool has_info = wxStat(path, &st) == 0;
+
+#ifndef __WXMSW__
+    if (has_info && st.st_nlink > 1) {
+        // a rename would detach the file from its other hard links
+        wxFile fp(path, wxFile::write);
+        bool ok = fp.IsOpened() && fp.Write(data.data(), data.size()) == data.size();
+        return fp.Close() && ok;
+    }
+#endif
+
+    // a unique name in the same directory, so the rename stays on the same file system and a temporary file left
+    // behind by a crash does not block the later writes
+    wxFile fp;
+    wxString tmp = wxFileName::CreateTempFileName(path + ".cltmp", &fp);
+    if (tmp.empty()) {
+        return false;
+    }
+    bool ok = fp.Write(data.data(), data.size()) == data.size();
+    if (!fp.Close() || !ok) {
+        ::wxRemoveFile(tmp);
+        return false;
+    }
+
+#ifndef __WXMSW__
+    if (has_info) {
+        const wxCharBuffer tmp_name = tmp.mb_str(wxConvUTF8);
+        ::chmod(tmp_name.data(), st.st_mode & 07777);
+        // only allowed when the user owns the file, or is privileged
+        int rc = ::chown(tmp_name.data(), st.st_uid, st.st_gid);
+        wxUnusedVar(rc);
+    }
+#endif
+
+    if (!::wxRenameFile(tmp, path, true)) {
+        ::wxRemoveFile(tmp);
+        return false;
+    }
+    return true;
+}
+
+bool has_changes(const ReplaceInFilesEngine::File& file)
+{
+    return std::any_of(file.replacements.begin(), file.replacements.end(),
+                       [](const ReplaceInFilesEngine::Replacement& r) { return r.applied; });
+}
+} // namespace
+
+ReplaceInFilesEngine::~ReplaceInFilesEngine() { Stop(); }
+
+void ReplaceInFilesEngine::RunParallel(size_t count,
+                                       std::function<void(size_t index)>&& task,
+                                       std::function<void()>&& on_done)
+{
+    Join();
+    ++m_generation;
+    m_stop = false;
+    m_next = 0;
+    m_completed = 0;
+    m_total = count;
+    m_onDone = std::move(on_done);
+
+    unsigned threads = std::clamp(std::thread::hardware_concurrency(), 2u, MAX_THREADS);
+    threads = std::max(1u, (unsigned)std::min<size_t>(threads, count));
+    m_activeWorkers = threads;
+
+    auto shared_task = std::make_shared<std::function<void(size_t)>>(std::move(task));
+    size_t generation = m_generation;
+    for (unsigned i = 0; i < threads; ++i) {
+        m_threads.emplace_back([this, shared_task, count, generation]() {
+            for (size_t index = m_next++; index < count && !m_stop; index = m_next++) {
+                (*shared_task)(index);
+                ++m_completed;
+            }
+            if (--m_activeWorkers == 0) {
+                CallAfter(&ReplaceInFilesEngine::OnTasksDone, generation);
+            }
+        });
+    }
+}
+
+void ReplaceInFilesEngine::Join()
+{
+    for (auto& thr : m_threads) {
+        thr.join();
+    }
+    m_threads.clear();
+}
+
+void ReplaceInFilesEngine::OnTasksDone(size_t generation)
+{
+    if (generation != m_generation) {
+        // a pass that was stopped
+        return;
+    }
+    Join();
+    auto on_done = std::move(m_onDone);
+    m_onDone = nullptr;
+    if (on_done) {
+        on_done();
+    }
+}
+
+void ReplaceInFilesEngine::Stop()
+{
+    m_stop = true;
+    Join();
+    ++m_generation;
+    m_onDone = nullptr;
+    if (m_writing) {
+        Rollback();
+        m_writing = false;
+    }
+}
+
+void ReplaceInFilesEngine::Plan(std::vector<File>&& files, wxFontEncoding encoding, PlanCallback_t&& callback)
+{
+    Stop();
+    m_canUndo = false;
+    m_files = std::move(files);
+    m_encoding = encoding;
+    for (auto& file : m_files) {
+        std::sort(file.replacements.begin(), file.replacements.end(),
+                  [](const Replacement& a, const Replacement& b) {
+                      return a.line < b.line || (a.line == b.line && a.column < b.column);
+                  });
+    }
+
+    auto sw = std::make_shared<wxStopWatch>();
+    RunParallel(
+        m_files.size(), [this](size_t index) { PlanFile(m_files[index]); },
+        [this, sw, callback = std::move(callback)]() {
+            Summary summary;
+            summary.cancelled = m_stop;
+            for (const auto& file : m_files) {
+                size_t applied = std::count_if(file.replacements.begin(), file.replacements.end(),
+                                               [](const Replacement& r) { return r.applied; });
+                summary.replacements += applied;
+                summary.skipped += file.replacements.size() - applied;
+                summary.files += applied ? 1 : 0;
+            }
+            clDEBUG() << "Replace: planned" << summary.replacements << "replacements in" << summary.files << "files,"
+                      << summary.skipped << "skipped (" << sw->Time() << "ms)" << endl;
+            callback(summary);
+        });
+}
+
+void ReplaceInFilesEngine::PlanFile(File& file)
+{
+    wxString content;
+    if (!ReadFileWithConversion(file.path, content, m_encoding)) {
+        clWARNING() << "Replace: failed to read file" << file.path << endl;
+        return;
+    }
+
+    // the columns of the matches are in bytes, as in the UTF-8 lines of the editor
+    const std::string original = content.ToStdString(wxConvUTF8);
+    std::string& result = file.content;
+    result.reserve(original.size());
+
+    size_t copied = 0;
+    size_t line_start = 0;
+    int line = 1;
+    for (auto& replacement : file.replacements) {
+        while (line < replacement.line && line_start != std::string::npos) {
+            line_start = original.find('\n', line_start);
+            if (line_start != std::string::npos) {
+                ++line_start;
+                ++line;
+            }
+        }
+        if (line_start == std::string::npos) {
+            break;
+        }
+
+        // the file may have been modified since the search. The whole match must be the expected text
+        const std::string find_what = replacement.findWhat.ToStdString(wxConvUTF8);
+        size_t pos = line_start + replacement.column;
+        if (find_what.size() != (size_t)replacement.len || pos < copied || pos > original.size() ||
+            original.compare(pos, find_what.size(), find_what) != 0) {
+            continue;
+        }
+
+        result.append(original, copied, pos - copied);
+        result.append(replacement.replaceWith.ToStdString(wxConvUTF8));
+        copied = pos + find_what.size();
+        replacement.applied = true;
+    }
+    result.append(original, copied, std::string::npos);
+    file.planned = true;
+
+    if (!has_changes(file)) {
+        result.clear();
+        result.shrink_to_fit();
+    }
+}
+
+void ReplaceInFilesEngine::CreateJournal()
+{
+    wxFileName dir(clStandardPaths::Get().GetUserDataDir(), "");
+    dir.AppendDir("replace-journal");
+    // only the last replace can be undone
+    if (dir.DirExists()) {
+        dir.Rmdir(wxPATH_RMDIR_RECURSIVE);
+    }
+    dir.Mkdir(wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+    m_journal = dir.GetPath();
+
+    for (size_t i = 0; i < m_files.size(); ++i) {
+        File& file = m_files[i];
+        if (has_changes(file)) {
+            file.backup = wxFileName(m_journal, wxString() << i << ".bak").GetFullPath();
+        }
+    }
+}
+
+void ReplaceInFilesEngine::Write(WriteCallback_t&& callback)
+{
+    Join();
+    m_canUndo = false;
+    CreateJournal();
+    m_writing = true;
+
+    auto sw = std::make_shared<wxStopWatch>();
+    RunParallel(
+        m_files.size(),
+        [this](size_t index) {
+            File& file = m_files[index];
+            if (has_changes(file) && !WriteFile(file)) {
+                clWARNING() << "Replace: failed to write file" << file.path << endl;
+            }
+        },
+        [this, sw, callback = std::move(callback)]() {
+            m_writing = false;
+            bool cancelled = m_stop;
+            if (cancelled) {
+                Rollback();
+            }
+
+            size_t written = 0;
+            for (auto& file : m_files) {
+                written += file.written ? 1 : 0;
+                file.content.clear();
+                file.content.shrink_to_fit();
+            }
+            m_canUndo = written > 0;
+            clDEBUG() << "Replace: wrote" << written << "files (" << sw->Time() << "ms)"
+                      << (cancelled ? ", cancelled" : "") << endl;
+            callback(cancelled);
+        });
+}
+
+bool ReplaceInFilesEngine::WriteFile(File& file)
+{
+    // write through a symbolic link, so the link is kept and its target modified
+    file.target = FileUtils::RealPath(file.path, true);
+    if (!::wxCopyFile(file.target, file.backup, true)) {
+        return false;
+    }
+
+    if (m_encoding == wxFONTENCODING_UTF8) {
+        if (!write_bytes(file.target, file.content)) {
+            return false;
+        }
+    } else {
+        wxCSConv conv(m_encoding);
+        const wxCharBuffer encoded = wxString::FromUTF8(file.content.data(), file.content.size()).mb_str(conv);
+        if ((!encoded.data() || encoded.length() == 0) && !file.content.empty()) {
+            // not representable in the encoding
+            return false;
+        }
+        if (!write_bytes(file.target, std::string(encoded.data(), encoded.length()))) {
+            return false;
+        }
+    }
+    file.written = true;
+    get_file_info(file.target, file.size, file.mtime);
+    return true;
+}
+
+bool ReplaceInFilesEngine::RestoreFile(const File& file)
+{
+    std::string data;
+    return read_bytes(file.backup, data) && write_bytes(file.target, data);
+}
+
+void ReplaceInFilesEngine::Rollback()
+{
+    size_t restored = 0;
+    for (auto& file : m_files) {
+        if (!file.written) {
+            continue;
+        }
+        if (RestoreFile(file)) {
+            file.written = false;
+            ++restored;
+        } else {
+            clWARNING() << "Replace: failed to restore file" << file.path << "from" << file.backup << endl;
+        }
+    }
+    clDEBUG() << "Replace: rolled back" << restored << "files" << endl;
+}
+
+void ReplaceInFilesEngine::Undo(UndoCallback_t&& callback)
+{
+    Join();
+    m_canUndo = false;
+
+    // 1: restored, 0: skipped, the files that were not written are ignored
+    auto status = std::make_shared<std::vector<char>>(m_files.size(), 0);
+    RunParallel(
+        m_files.size(),
+        [this, status](size_t index) {
+            const File& file = m_files[index];
+            if (!file.written) {
+                return;
+            }
+
+            // do not override the changes that were made since the replace
+            wxFileOffset size = 0;
+            time_t mtime = 0;
+            if (!get_file_info(file.target, size, mtime) || size != file.size || mtime != file.mtime) {
+                return;
+            }
+            (*status)[index] = RestoreFile(file) ? 1 : 0;
+        },
+        [this, status, callback = std::move(callback)]() {
+            wxArrayString restored;
+            wxArrayString skipped;
+            for (size_t i = 0; i < m_files.size(); ++i) {
+                File& file = m_files[i];
+                if (!file.written) {
+                    continue;
+                }
+                if ((*status)[i]) {
+                    restored.Add(file.path);
+                } else {
+                    skipped.Add(file.path);
+                }
+                file.written = false;
+            }
+            clDEBUG() << "Replace: undo restored" << restored.size() << "files," << skipped.size() << "skipped"
+                      << endl;
+            callback(restored, skipped);
+        });
+}
+
+void ReplaceInFilesEngine::Discard()
+{
+    Stop();
+    m_files.clear();
+}
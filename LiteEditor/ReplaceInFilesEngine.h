@@ -0,0 +1,119 @@
+#ifndef REPLACEINFILESENGINE_H
+#define REPLACEINFILESENGINE_H
+
+#include <atomic>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <wx/arrstr.h>
+#include <wx/event.h>
+#include <wx/filefn.h>
+#include <wx/fontenc.h>
+#include <wx/string.h>
+
+/// Applies the matches of a "Replace in files" to the files on disk.
+/// The replace runs in two passes, both spread over a pool of worker threads: Plan() reads the files and applies the
+/// replacements in memory, Write() writes the planned files. A file is written to a temporary file that is renamed
+/// over the original (a file with hard links is overwritten in place), after its original content was copied to an
+/// undo journal. A cancelled replace is rolled back from the journal, and the last completed replace can be undone.
+/// The journal is only known to the running session: a replace interrupted by a crash is not rolled back on restart
+/// The callbacks are called on the main thread
+class ReplaceInFilesEngine : public wxEvtHandler
+{
+public:
+    struct Replacement {
+        int id = 0;     // the caller's identifier of the match
+        int line = 0;   // 1 based
+        int column = 0; // in bytes, from the start of the line
+        int len = 0;    // of the match, in bytes
+        wxString findWhat;
+        wxString replaceWith;
+        bool applied = false; // the text at this location was `findWhat` when the file was planned
+    };
+
+    struct File {
+        wxString path;
+        std::vector<Replacement> replacements;
+        bool written = false;
+        wxString backup; // the original content, in the journal
+
+    private:
+        friend class ReplaceInFilesEngine;
+        bool planned = false;
+        std::string content; // the content to write, in UTF-8
+        wxString target;     // `path` with its symbolic links resolved, the file that is written
+        time_t mtime = 0;    // the file once written, to detect later changes before an undo
+        wxFileOffset size = 0;
+    };
+
+    struct Summary {
+        size_t files = 0;        // files with at least one replacement to apply
+        size_t replacements = 0; // replacements to apply
+        size_t skipped = 0;      // matches whose text changed since the search, or in files that can not be read
+        bool cancelled = false;  // the files were not all planned
+    };
+
+    using PlanCallback_t = std::function<void(const Summary& summary)>;
+    using WriteCallback_t = std::function<void(bool cancelled)>;
+    using UndoCallback_t = std::function<void(const wxArrayString& restored, const wxArrayString& skipped)>;
+
+private:
+    std::vector<File> m_files;
+    wxFontEncoding m_encoding = wxFONTENCODING_UTF8;
+    wxString m_journal;
+    bool m_canUndo = false;
+
+    std::vector<std::thread> m_threads;
+    std::atomic_bool m_stop{ false };
+    std::atomic_size_t m_next{ 0 };
+    std::atomic_size_t m_completed{ 0 };
+    std::atomic_size_t m_activeWorkers{ 0 };
+    size_t m_total = 0;
+    size_t m_generation = 0; // identifies the running pass
+    bool m_writing = false;
+    std::function<void()> m_onDone;
+
+    /// run `task` for the indexes [0, count) on the worker threads, then call `on_done` on the main thread
+    void RunParallel(size_t count, std::function<void(size_t index)>&& task, std::function<void()>&& on_done);
+    void Join();
+    void OnTasksDone(size_t generation);
+
+    void PlanFile(File& file);
+    bool WriteFile(File& file);
+    bool RestoreFile(const File& file);
+    void Rollback();
+    void CreateJournal();
+
+public:
+    ReplaceInFilesEngine() = default;
+    ~ReplaceInFilesEngine() override;
+
+    /// read the files and apply their replacements in memory. Nothing is written, the previous replace can no longer
+    /// be undone
+    void Plan(std::vector<File>&& files, wxFontEncoding encoding, PlanCallback_t&& callback);
+
+    /// write the planned files. If the replace is cancelled, the files already written are restored
+    void Write(WriteCallback_t&& callback);
+
+    /// restore the files of the last replace, unless they were modified since
+    void Undo(UndoCallback_t&& callback);
+
+    /// drop the planned files
+    void Discard();
+
+    /// cancel the running pass, its callback is still called
+    void Cancel() { m_stop = true; }
+
+    /// cancel the running pass and wait for the worker threads. No callback is called afterwards
+    void Stop();
+
+    bool IsRunning() const { return !m_threads.empty(); }
+    bool CanUndo() const { return m_canUndo && !IsRunning(); }
+    size_t GetCompleted() const { return m_completed; }
+    size_t GetTotal() const { return m_total; }
+    const std::vector<File>& GetFiles() const { return m_files; }
+};
+
+#endif // REPLACEINFILESENGINE_H
@@ -0,0 +1,79 @@
+#include "WordOccurrenceIndex.hpp"
+
+#include <algorithm>
+#include <string_view>
+
+namespace
+{
+/// valid word char [a-zA-Z0-9_], same as StringFindReplacer
+inline bool IsWordChar(char ch)
+{
+    return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '_';
+}
+
+// the buffer is scanned in chunks of this many bytes, cancellation is checked before each chunk
+constexpr size_t SCAN_CHUNK_SIZE = 256 * 1024;
+} // namespace
+
+void WordOccurrenceIndex::Reset(const wxString& word, size_t version)
+{
+    m_word = word;
+    m_version = version;
+    m_wordLength = 0;
+    m_positions.clear();
+    m_ready = false;
+}
+
+void WordOccurrenceIndex::Clear() { Reset(wxEmptyString, 0); }
+
+void WordOccurrenceIndex::SetPositions(std::vector<int>&& positions, int wordLength)
+{
+    m_positions = std::move(positions);
+    m_wordLength = wordLength;
+    m_ready = true;
+}
+
+std::vector<int> WordOccurrenceIndex::GetPositionsInRange(int from, int to) const
+{
+    std::vector<int> result;
+    if (!m_ready || from >= to) {
+        return result;
+    }
+    auto first = std::lower_bound(m_positions.begin(), m_positions.end(), from);
+    auto last = std::lower_bound(first, m_positions.end(), to);
+    result.insert(result.end(), first, last);
+    return result;
+}
+
+bool WordOccurrenceIndex::Scan(const std::string& buffer,
+                               const std::string& word,
+                               const std::atomic_bool& cancelled,
+                               std::vector<int>* positions)
+{
+    positions->clear();
+    if (word.empty() || buffer.length() < word.length()) {
+        return true;
+    }
+
+    const std::string_view text{ buffer };
+    for (size_t chunk_start = 0; chunk_start < text.length(); chunk_start += SCAN_CHUNK_SIZE) {
+        if (cancelled.load()) {
+            return false;
+        }
+
+        // the chunk holds the matches that start in it, they may end in the next chunk
+        size_t chunk_end = std::min(chunk_start + SCAN_CHUNK_SIZE, text.length());
+        const std::string_view chunk = text.substr(chunk_start, chunk_end - chunk_start + word.length() - 1);
+        for (size_t offset = chunk.find(word); offset != std::string_view::npos;
+             offset = chunk.find(word, offset + 1)) {
+            size_t pos = chunk_start + offset;
+            size_t end_pos = pos + word.length();
+            bool word_start = (pos == 0) || !IsWordChar(text[pos - 1]);
+            bool word_end = (end_pos >= text.length()) || !IsWordChar(text[end_pos]);
+            if (word_start && word_end) {
+                positions->push_back(static_cast<int>(pos));
+            }
+        }
+    }
+    return !cancelled.load();
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <wx/string.h>
+
+/**
+ * @brief an index of all the whole word, case sensitive occurrences of a word in an editor.
+ * The index is built by a background thread from a snapshot of the editor buffer and remains
+ * valid for as long as the document version does not change
+ */
+class WordOccurrenceIndex
+{
+    wxString m_word;
+    size_t m_version = 0;
+    int m_wordLength = 0;
+    std::vector<int> m_positions;
+    bool m_ready = false;
+
+public:
+    WordOccurrenceIndex() = default;
+    ~WordOccurrenceIndex() = default;
+
+    /**
+     * @brief start a new index for `word` at the given document version. The index is not
+     * ready until `SetPositions()` is called
+     */
+    void Reset(const wxString& word, size_t version);
+
+    /**
+     * @brief clear the index
+     */
+    void Clear();
+
+    /**
+     * @brief set the scan results and mark the index as ready
+     */
+    void SetPositions(std::vector<int>&& positions, int wordLength);
+
+    /**
+     * @brief does this index belong to `word` at `version`? (it might still be building)
+     */
+    bool IsFor(const wxString& word, size_t version) const
+    {
+        return !m_word.empty() && m_version == version && m_word == word;
+    }
+
+    bool IsReady() const { return m_ready; }
+    size_t GetCount() const { return m_positions.size(); }
+    int GetWordLength() const { return m_wordLength; }
+    const wxString& GetWord() const { return m_word; }
+
+    /**
+     * @brief return the start positions of all the occurrences in the range [from, to)
+     */
+    std::vector<int> GetPositionsInRange(int from, int to) const;
+
+    /**
+     * @brief scan a UTF-8 buffer (as stored by the editor) and collect the byte position of every
+     * whole word match of `word`. This method is safe to call from a background thread
+     * @return false if the scan was cancelled
+     */
+    static bool Scan(const std::string& buffer,
+                     const std::string& word,
+                     const std::atomic_bool& cancelled,
+                     std::vector<int>* positions);
+};
@@ -40,6 +40,7 @@
 #include "SideBar.hpp"
 #include "SocketAPI/clSocketClient.h"
 #include "autoversion.h"
+#include "clStartupReport.hpp"
 #include "clSystemSettings.h"
 #include "cl_config.h"
 #include "conffilelocator.h"
@@ -520,7 +521,8 @@ bool CodeLiteApp::OnInit()
 
     // Set the global log file verbosity. NB Doing this earlier seems to break wxGTK debug output when debugging
     // CodeLite itself :/
-    FileLogger::OpenLog("codelite.log", clConfig::Get().Read(kConfigLogVerbosity, FileLogger::Error));
+    FileLogger::OpenLog("codelite.log", clConfig::Get().Read(kConfigLogVerbosity, FileLogger::Error), true);
+    FileLogger::InstallCrashHandlers();
     clDEBUG() << "Starting codelite..." << endl;
 
     // Copy gdb pretty printers from the installation folder to a writeable location
@@ -776,10 +778,16 @@ bool CodeLiteApp::OnInit()
     FileUtils::RealPathSetModeResolveSymlinks(clConfig::Get().Read(kRealPathResolveSymlinks, true));
 
     // Make sure that the colours and fonts manager is instantiated
-    ColoursAndFontsManager::Get().Load();
+    {
+        CL_STARTUP_PHASE("Load lexers");
+        ColoursAndFontsManager::Get().Load();
+    }
 
     // Create the main application window
-    clMainFrame::Initialize((m_parser.GetParamCount() == 0) && !IsStartedInDebuggerMode());
+    {
+        CL_STARTUP_PHASE("Create the main frame");
+        clMainFrame::Initialize((m_parser.GetParamCount() == 0) && !IsStartedInDebuggerMode());
+    }
     m_pMainFrame = clMainFrame::Get();
     m_pMainFrame->Show(TRUE);
     SetTopWindow(m_pMainFrame);
@@ -44,6 +44,7 @@
 #include "clSFTPManager.hpp"
 #include "clSTCHelper.hpp"
 #include "clSTCLineKeeper.h"
+#include "clTrace.hpp"
 #include "clWorkspaceManager.h"
 #include "cl_command_event.h"
 #include "cl_editor_tip_window.h"
@@ -76,6 +77,8 @@
 #include "wxCodeCompletionBoxManager.h"
 
 #include <algorithm>
+#include <string>
+#include <vector>
 #include <wx/dataobj.h>
 #include <wx/display.h>
 #include <wx/filedlg.h>
@@ -437,6 +440,54 @@ int GetWorkspaceIndentWidth()
     }
     return clWorkspaceManager::Get().GetWorkspace()->GetIndentWidth();
 }
+
+// Large file mode: the first chunk is kept small so the first screen is displayed as soon as possible
+constexpr size_t LARGE_FILE_FIRST_CHUNK_SIZE = 256 * 1024;
+constexpr size_t LARGE_FILE_CHUNK_SIZE = 4 * 1024 * 1024;
+
+/// Return the number of bytes from `buffer` that can be safely decoded: we cut at the last
+/// new line. If there is no new line, make sure we don't split a UTF-8 sequence
+size_t FindLargeFileChunkBoundary(const std::string& buffer)
+{
+    size_t where = buffer.rfind('\n');
+    if (where != std::string::npos) {
+        return where + 1;
+    }
+
+    size_t len = buffer.length();
+    while (len > 0 && (static_cast<unsigned char>(buffer[len - 1]) & 0xC0) == 0x80) {
+        --len;
+    }
+
+    if (len == 0 || static_cast<unsigned char>(buffer[len - 1]) < 0x80) {
+        // no lead byte or the buffer ends with an ASCII char
+        return buffer.length();
+    }
+    // cut before the lead byte of the (possibly incomplete) last sequence
+    return len - 1;
+}
+
+wxString DecodeLargeFileChunk(const char* buffer, size_t len, wxFontEncoding encoding)
+{
+    wxString text;
+    // first try the user defined encoding (except for UTF8: the UTF8 builtin appears to be faster)
+    if (encoding != wxFONTENCODING_UTF8) {
+        wxCSConv fontEncConv(encoding);
+        if (fontEncConv.IsOk()) {
+            text = wxString(buffer, fontEncConv, len);
+        }
+    }
+
+    if (text.empty()) {
+        text = wxString(buffer, wxConvUTF8, len);
+    }
+
+    if (text.empty()) {
+        // local 8 bit data
+        text = wxString(buffer, wxConvISO8859_1, len);
+    }
+    return text;
+}
 } // namespace
 
 //=====================================================================
@@ -562,6 +613,9 @@ clEditor::clEditor(wxWindow* parent)
 
 clEditor::~clEditor()
 {
+    DoCancelLargeFileLoad();
+    DoCancelWordIndexer();
+
     // Report file-close event
     if (GetFileName().IsOk() && GetFileName().FileExists()) {
         clCommandEvent eventClose(wxEVT_FILE_CLOSED);
@@ -620,6 +674,10 @@ void clEditor::SetSyntaxHighlight(const wxString& lexerName)
     m_context->ApplySettings();
 
     SetCurrentLineMarginStyle(GetCtrl());
+    if (m_largeFileMode) {
+        DoApplyLargeFileMode();
+        return;
+    }
     CallAfter(&clEditor::UpdateColours);
 }
 
@@ -632,7 +690,9 @@ void clEditor::SetSyntaxHighlight(bool bUpdateColors)
 
     m_context->SetActive();
     m_context->ApplySettings();
-    if (bUpdateColors) {
+    if (m_largeFileMode) {
+        DoApplyLargeFileMode();
+    } else if (bUpdateColors) {
         UpdateColours();
     }
     SetCurrentLineMarginStyle(GetCtrl());
@@ -1136,6 +1196,10 @@ void clEditor::SetProperties()
     CmdKeyAssign(wxSTC_KEY_RIGHT, wxSTC_KEYMOD_META, wxSTC_CMD_WORDPARTRIGHT);
 #endif
     SetCurrentLineMarginStyle(GetCtrl());
+
+    if (m_largeFileMode) {
+        DoApplyLargeFileMode();
+    }
 }
 
 void clEditor::OnSavePoint(wxStyledTextEvent& event)
@@ -3032,6 +3096,7 @@ void clEditor::OpenFile()
 {
     wxBusyCursor bc;
     wxWindowUpdateLocker locker(this);
+    DoCancelLargeFileLoad();
     SetReloadingFile(true);
 
     DoCancelCalltip();
@@ -3043,6 +3108,16 @@ void clEditor::OpenFile()
         return;
     }
 
+    if (IsLargeFile() && DoOpenLargeFile()) {
+        return;
+    }
+
+    if (m_largeFileMode) {
+        // the file is no longer considered "large", restore the normal editor settings
+        m_largeFileMode = false;
+        SetSyntaxHighlight(false);
+    }
+
     // State locker (on dtor it restores: bookmarks, current line, breakpoints and folds)
     clEditorStateLocker stateLocker(GetCtrl());
 
@@ -3091,6 +3166,188 @@ void clEditor::OpenFile()
     CallAfter(&clEditor::SetProperties);
 }
 
+bool clEditor::IsLargeFile() const
+{
+    int threshold_mb = EditorConfigST::Get()->GetOptions()->GetLargeFileThresholdMB();
+    if (threshold_mb <= 0 || IsRemoteFile()) {
+        return false;
+    }
+    return m_fileName.GetSize() > (wxULongLong(threshold_mb) * 1024 * 1024);
+}
+
+bool clEditor::DoOpenLargeFile()
+{
+    wxString filepath = m_fileName.GetFullPath();
+    FILE* fp = wxFopen(filepath, "rb");
+    if (!fp) {
+        return false;
+    }
+
+    // Large file mode supports plain files and UTF-8 BOM files. Other BOMs (UTF-16/32) are
+    // loaded using the normal code path
+    char bom_buffer[4] = { 0, 0, 0, 0 };
+    size_t bom_len = fread(bom_buffer, sizeof(char), sizeof(bom_buffer), fp);
+    fclose(fp);
+
+    m_fileBom.Clear();
+    size_t skip_bytes = 0;
+    wxFontEncoding encoding = GetOptions()->GetFileFontEncoding();
+    if (bom_len == sizeof(bom_buffer)) {
+        wxFontEncoding bom_encoding = BOM::Encoding(bom_buffer);
+        if (bom_encoding == wxFONTENCODING_UTF8) {
+            skip_bytes = 3;
+            m_fileBom.SetData(bom_buffer, skip_bytes);
+            encoding = wxFONTENCODING_UTF8;
+        } else if (bom_encoding != wxFONTENCODING_SYSTEM) {
+            return false;
+        }
+    }
+
+    clSYSTEM() << "Opening file" << filepath << "in large file mode" << endl;
+    m_largeFileMode = true;
+    DoApplyLargeFileMode();
+
+    // we don't want the loading process in the undo history
+    SetUndoCollection(false);
+    ClearAll();
+    m_modifiedLines.clear();
+    SetReadOnly(true);
+    m_mgr->GetStatusBar()->SetMessage(_("Loading file..."));
+
+    m_largeFileLoadCancelled.store(false);
+    size_t generation = ++m_largeFileLoadGeneration;
+    size_t total_bytes = static_cast<size_t>(m_fileName.GetSize().GetValue());
+    m_largeFileLoader = new std::thread([this,
+                                         filepath = filepath.Clone(),
+                                         encoding,
+                                         skip_bytes,
+                                         total_bytes,
+                                         generation]() {
+        FILE* fp = wxFopen(filepath, "rb");
+        if (!fp) {
+            CallAfter([this, generation]() {
+                if (generation == m_largeFileLoadGeneration) {
+                    OnLargeFileLoaded(false);
+                }
+            });
+            return;
+        }
+
+        fseek(fp, skip_bytes, SEEK_SET);
+
+        std::vector<char> chunk(LARGE_FILE_CHUNK_SIZE);
+        std::string pending;
+        size_t bytes_read = skip_bytes;
+        size_t chunk_size = LARGE_FILE_FIRST_CHUNK_SIZE;
+        bool eof = false;
+        while (!eof && !m_largeFileLoadCancelled.load()) {
+            size_t count = fread(chunk.data(), sizeof(char), chunk_size, fp);
+            eof = (count < chunk_size);
+            bytes_read += count;
+            pending.append(chunk.data(), count);
+
+            size_t boundary = eof ? pending.length() : FindLargeFileChunkBoundary(pending);
+            if (boundary == 0) {
+                continue;
+            }
+
+            wxString text = DecodeLargeFileChunk(pending.data(), boundary, encoding);
+            pending.erase(0, boundary);
+            CallAfter([this, text = std::move(text), bytes_read, total_bytes, generation]() {
+                if (generation == m_largeFileLoadGeneration) {
+                    OnLargeFileChunk(text, bytes_read, total_bytes);
+                }
+            });
+            chunk_size = LARGE_FILE_CHUNK_SIZE;
+        }
+        fclose(fp);
+
+        bool success = !m_largeFileLoadCancelled.load();
+        CallAfter([this, success, generation]() {
+            if (generation == m_largeFileLoadGeneration) {
+                OnLargeFileLoaded(success);
+            }
+        });
+    });
+    return true;
+}
+
+void clEditor::DoApplyLargeFileMode()
+{
+    // no lexing, no folding and no word highlighting for large files
+    SetLexer(wxSTC_LEX_NULL);
+    ClearDocumentStyle();
+    SetProperty(wxT("fold"), wxT("0"));
+    SetMarginWidth(FOLD_MARGIN_ID, 0);
+    SetWrapMode(wxSTC_WRAP_NONE);
+
+    if (m_highlightedWordInfo.IsHasMarkers()) {
+        SetIndicatorCurrent(INDICATOR_WORD_HIGHLIGHT);
+        IndicatorClearRange(0, GetLength());
+    }
+    m_highlightedWordInfo.Clear();
+}
+
+void clEditor::DoCancelLargeFileLoad()
+{
+    if (!m_largeFileLoader) {
+        return;
+    }
+
+    m_largeFileLoadCancelled.store(true);
+    m_largeFileLoader->join();
+    wxDELETE(m_largeFileLoader);
+
+    // discard any chunk that is still waiting in the event queue
+    ++m_largeFileLoadGeneration;
+    SetReadOnly(false);
+    SetUndoCollection(true);
+    SetReloadingFile(false);
+}
+
+void clEditor::OnLargeFileChunk(const wxString& text, size_t bytesRead, size_t totalBytes)
+{
+    SetReadOnly(false);
+    AppendText(text);
+    SetReadOnly(true);
+
+    int percent = totalBytes > 0 ? static_cast<int>((bytesRead * 100) / totalBytes) : 100;
+    m_mgr->GetStatusBar()->SetMessage(wxString::Format(_("Loading file... %d%%"), percent));
+}
+
+void clEditor::OnLargeFileLoaded(bool success)
+{
+    if (m_largeFileLoader) {
+        m_largeFileLoader->join();
+        wxDELETE(m_largeFileLoader);
+    }
+
+    SetReadOnly(false);
+    SetUndoCollection(true);
+    EmptyUndoBuffer();
+    GetCommandsProcessor().Reset();
+    SetSavePoint();
+    m_modifyTime = GetFileLastModifiedTime();
+
+    SetEOL();
+    UpdateLineNumberMarginWidth();
+
+    // mark read only files
+    clMainFrame::Get()->GetMainBook()->MarkEditorReadOnly(this);
+    SetReloadingFile(false);
+
+    if (!success) {
+        m_mgr->GetStatusBar()->SetMessage(_("Failed to load file"));
+        return;
+    }
+
+    // Notify that a file has been loaded into the editor
+    clCommandEvent fileLoadedEvent(wxEVT_FILE_LOADED);
+    fileLoadedEvent.SetFileName(FileUtils::RealPath(GetFileName().GetFullPath()));
+    EventNotifier::Get()->AddPendingEvent(fileLoadedEvent);
+    m_mgr->GetStatusBar()->SetMessage(_("Ready"));
+}
+
 void clEditor::SetEditorText(const wxString& text)
 {
     wxWindowUpdateLocker locker(this);
@@ -3938,7 +4195,11 @@ void clEditor::OnDbgCustomWatch(wxCommandEvent& event)
     }
 }
 
-void clEditor::UpdateColours() { Colourise(0, wxSTC_INVALID_POSITION); }
+void clEditor::UpdateColours()
+{
+    CL_TRACE_ZONE("Editor colouring");
+    Colourise(0, wxSTC_INVALID_POSITION);
+}
 
 int clEditor::SafeGetChar(int pos)
 {
@@ -3994,6 +4255,10 @@ int clEditor::GetCurrLineHeight()
 
 void clEditor::DoHighlightWord()
 {
+    if (m_largeFileMode) {
+        return;
+    }
+
     // Read the primary selected text
     int mainSelectionStart = GetSelectionNStart(GetMainSelection());
     int mainSelectionEnd = GetSelectionNEnd(GetMainSelection());
@@ -4005,7 +4270,16 @@ void clEditor::DoHighlightWord()
         return;
     }
 
-    // Search only the visible areas
+    if (!m_wordIndex.IsFor(word, m_modificationCount)) {
+        // new selection or the document was modified since the index was built
+        DoBuildWordIndex(word);
+
+    } else if (m_wordIndex.IsReady()) {
+        DoPaintWordIndexVisibleRange();
+        return;
+    }
+
+    // The index is not ready yet, search only the visible areas
     StringHighlighterJob j;
     int firstVisibleLine = GetFirstVisibleLine();
     int lastDocLine = LineFromPosition(GetLength());
@@ -4074,12 +4348,131 @@ void clEditor::HighlightWord(bool highlight)
 {
     if (highlight) {
         DoHighlightWord();
+        return;
+    }
 
-    } else if (m_highlightedWordInfo.IsHasMarkers()) {
+    // a running scan would paint its results once it completes
+    DoCancelWordIndexer();
+    m_wordIndex.Clear();
+    if (m_highlightedWordInfo.IsHasMarkers()) {
         SetIndicatorCurrent(INDICATOR_WORD_HIGHLIGHT);
         IndicatorClearRange(0, GetLength());
         m_highlightedWordInfo.Clear();
+        m_wordIndexPaintedRange = { wxNOT_FOUND, wxNOT_FOUND };
+    }
+}
+
+void clEditor::DoBuildWordIndex(const wxString& word)
+{
+    DoCancelWordIndexer();
+    m_wordIndex.Reset(word, m_modificationCount);
+    m_wordIndexPaintedRange = { wxNOT_FOUND, wxNOT_FOUND };
+
+    // Scintilla keeps the document as UTF-8, so byte offsets in the snapshot are editor positions.
+    // The worker owns the snapshot, it is released as soon as the scan is over
+    const char* buffer = GetCharacterPointer();
+    std::string snapshot(buffer ? buffer : "", buffer ? GetLength() : 0);
+
+    m_wordIndexerCancelled.store(false);
+    size_t generation = ++m_wordIndexGeneration;
+    m_wordIndexer = new std::thread(
+        [this, snapshot = std::move(snapshot), utf8_word = StringUtils::ToStdString(word), generation]() mutable {
+            std::vector<int> positions;
+            bool completed = WordOccurrenceIndex::Scan(snapshot, utf8_word, m_wordIndexerCancelled, &positions);
+            snapshot = std::string();
+            if (!completed) {
+                return;
+            }
+
+            int word_length = static_cast<int>(utf8_word.length());
+            CallAfter([this, positions, word_length, generation]() {
+                if (generation == m_wordIndexGeneration) {
+                    OnWordIndexReady(positions, word_length);
+                }
+            });
+        });
+}
+
+void clEditor::DoCancelWordIndexer()
+{
+    if (!m_wordIndexer) {
+        return;
     }
+
+    m_wordIndexerCancelled.store(true);
+    m_wordIndexer->join();
+    wxDELETE(m_wordIndexer);
+    ++m_wordIndexGeneration;
+}
+
+void clEditor::OnWordIndexReady(const std::vector<int>& positions, int wordLength)
+{
+    if (m_wordIndexer) {
+        m_wordIndexer->join();
+        wxDELETE(m_wordIndexer);
+    }
+
+    // the selection may have changed while the scan was running
+    int mainSelection = GetMainSelection();
+    wxString word = GetTextRange(GetSelectionNStart(mainSelection), GetSelectionNEnd(mainSelection));
+    if (!m_wordIndex.IsFor(word, m_modificationCount)) {
+        m_wordIndex.Clear();
+        return;
+    }
+
+    std::vector<int> index = positions;
+    m_wordIndex.SetPositions(std::move(index), wordLength);
+
+    // the indicators painted so far were placed by the visible area search, paint again using the index
+    SetIndicatorCurrent(INDICATOR_WORD_HIGHLIGHT);
+    IndicatorClearRange(0, GetLength());
+    m_wordIndexPaintedRange = { wxNOT_FOUND, wxNOT_FOUND };
+    DoPaintWordIndexVisibleRange();
+
+    m_mgr->GetStatusBar()->SetMessage(
+        wxString::Format(_("Found %d occurrences of '%s'"), (int)m_wordIndex.GetCount(), m_wordIndex.GetWord()));
+}
+
+void clEditor::DoPaintWordIndexVisibleRange()
+{
+    int firstVisibleLine = GetFirstVisibleLine();
+    int firstLine = DocLineFromVisible(firstVisibleLine);
+    int lastLine = DocLineFromVisible(firstVisibleLine + LinesOnScreen());
+    int from = PositionFromLine(firstLine);
+    int to = (lastLine + 1 < GetLineCount()) ? PositionFromLine(lastLine + 1) : GetLength();
+
+    SetIndicatorCurrent(INDICATOR_WORD_HIGHLIGHT);
+    int selStart = GetSelectionStart();
+    int wordLength = m_wordIndex.GetWordLength();
+    auto paint_range = [&](int start, int end) {
+        for (int pos : m_wordIndex.GetPositionsInRange(start, end)) {
+            // Don't highlight the current selection
+            if (pos != selStart) {
+                IndicatorFillRange(pos, wordLength);
+            }
+        }
+    };
+
+    auto& [painted_from, painted_to] = m_wordIndexPaintedRange;
+    if (painted_from != wxNOT_FOUND && from <= painted_to && to >= painted_from) {
+        // only paint the newly exposed lines
+        if (from < painted_from) {
+            paint_range(from, painted_from);
+        }
+        if (to > painted_to) {
+            paint_range(painted_to, to);
+        }
+        painted_from = std::min(from, painted_from);
+        painted_to = std::max(to, painted_to);
+    } else {
+        paint_range(from, to);
+        painted_from = from;
+        painted_to = to;
+    }
+
+    m_highlightedWordInfo.SetHasMarkers(true);
+    m_highlightedWordInfo.SetFirstOffset(PositionFromLine(firstVisibleLine));
+    m_highlightedWordInfo.SetWord(m_wordIndex.GetWord());
 }
 
 void clEditor::OnLeftDClick(wxStyledTextEvent& event)
@@ -4636,8 +5029,23 @@ void clEditor::OnChange(wxStyledTextEvent& event)
         if (!GetReloadingFile()) {
             // keep track of modified lines
             int curline = LineFromPosition(event.GetPosition());
-            if (numlines == 0) {
-                // probably only the current line was modified
+            if (numlines != 0) {
+                // the tracked lines below the change moved, the ones that were deleted are gone
+                std::unordered_map<size_t, eLineStatus> shifted;
+                shifted.reserve(m_modifiedLines.size());
+                for (const auto& [line_number, status] : m_modifiedLines) {
+                    int line = static_cast<int>(line_number);
+                    if (line <= curline) {
+                        shifted[line_number] = status;
+                    } else if (numlines > 0 || line > curline - numlines) {
+                        shifted[line + numlines] = status;
+                    }
+                }
+                m_modifiedLines.swap(shifted);
+            }
+
+            if (numlines <= 0) {
+                // only the current line was modified, or the lines that followed it were deleted
                 m_modifiedLines[curline] = LINE_MODIFIED;
             } else {
                 for (int i = 0; i <= numlines; i++) {
@@ -4916,6 +5324,7 @@ void clEditor::HighlightWord(StringHighlightOutput* highlightOutput)
 
     // clear the old markers
     IndicatorClearRange(0, GetLength());
+    m_wordIndexPaintedRange = { wxNOT_FOUND, wxNOT_FOUND };
     if (!highlightOutput->matches.empty()) {
         m_highlightedWordInfo.SetHasMarkers(true);
         int selStart = GetSelectionStart();
@@ -5736,6 +6145,12 @@ void clEditor::OpenURL(wxCommandEvent& event)
 
 void clEditor::ReloadFromDisk(bool keepUndoHistory)
 {
+    if (m_largeFileMode || IsLargeFile()) {
+        // large files are always re-loaded in the background, without undo history
+        OpenFile();
+        return;
+    }
+
     wxWindowUpdateLocker locker(GetParent());
     SetReloadingFile(true);
 
@@ -5994,6 +6409,7 @@ void clEditor::SetSemanticTokens(const wxString& classes,
                                  const wxString& methods,
                                  const wxString& others)
 {
+    CL_TRACE_ZONE("Editor semantic tokens");
     wxString flatStrClasses = classes;
     wxString flatStrLocals = variables;
     wxString flatStrOthers = others;
@@ -6171,6 +6587,22 @@ void clEditor::ClearModifiedLines()
     m_clearModifiedLines = true;
 }
 
+std::vector<int> clEditor::GetModifiedLines() const
+{
+    std::vector<int> lines;
+    if (m_clearModifiedLines) {
+        // a clear is pending: we can't tell the lines modified before the request from the ones modified after it
+        return lines;
+    }
+
+    lines.reserve(m_modifiedLines.size());
+    for (const auto& [line_number, status] : m_modifiedLines) {
+        lines.push_back(static_cast<int>(line_number));
+    }
+    std::sort(lines.begin(), lines.end());
+    return lines;
+}
+
 void clEditor::OnModifiedExternally(clFileSystemEvent& event)
 {
     event.Skip();
@@ -27,6 +27,7 @@
 #include "Debugger/debuggermanager.h"
 #include "LSP/CompletionItem.h"
 #include "SFTPClientData.hpp"
+#include "WordOccurrenceIndex.hpp"
 #include "bookmark_manager.h"
 #include "browse_record.h"
 #include "buildtabsettingsdata.h"
@@ -42,9 +43,13 @@
 #include "plugin.h"
 #include "stringhighlighterjob.h"
 
+#include <atomic>
 #include <cstdint>
 #include <limits>
 #include <map>
+#include <memory>
+#include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 #include <wx/bitmap.h>
@@ -253,6 +258,9 @@ public:
     /// Clear the modified lines tracker
     void ClearModifiedLines() override;
 
+    /// Return the lines marked in the modified lines tracker
+    std::vector<int> GetModifiedLines() const override;
+
     /**
      * @brief CodeLite preferences updated
      */
@@ -1012,7 +1020,30 @@ public:
      */
     SFTPClientData* GetRemoteData() const override;
 
+    /**
+     * @brief return true if this editor was opened in "large file" mode
+     */
+    bool IsLargeFileMode() const override { return m_largeFileMode; }
+
+    /**
+     * @brief return true while a large file is still being loaded in the background
+     */
+    bool IsLargeFileLoading() const { return m_largeFileLoader != nullptr; }
+
 private:
+    /**
+     * @brief open the file in "large file" mode: the content is read and decoded
+     * by a background thread and appended to the editor in chunks. Lexing, folding and
+     * word highlighting are disabled for this editor
+     * @return false if the file can not be opened in this mode, it should be loaded normally
+     */
+    bool DoOpenLargeFile();
+    void DoApplyLargeFileMode();
+    void DoCancelLargeFileLoad();
+    void OnLargeFileChunk(const wxString& text, size_t bytesRead, size_t totalBytes);
+    void OnLargeFileLoaded(bool success);
+    bool IsLargeFile() const;
+
     void DrawLineNumbers(bool force);
     void UpdateLineNumberMarginWidth();
     void DoUpdateTLWTitle(bool raise);
@@ -1042,6 +1073,17 @@ private:
     void BraceMatch(bool bSelRegion);
     void BraceMatch(long pos);
     void DoHighlightWord();
+    /**
+     * @brief build the document-wide occurrence index for `word` in the background
+     */
+    void DoBuildWordIndex(const wxString& word);
+    void DoCancelWordIndexer();
+    void OnWordIndexReady(const std::vector<int>& positions, int wordLength);
+    /**
+     * @brief paint the word highlight indicators using the occurrence index. Only lines that
+     * were not painted by a previous call are processed
+     */
+    void DoPaintWordIndexVisibleRange();
     bool IsOpenBrace(int position);
     bool IsCloseBrace(int position);
     size_t GetCodeNavModifier();
@@ -1180,4 +1222,13 @@ private:
     BuildTabSettingsData m_buildOptions;
     bool m_hasBraceHighlight = false;
     clIdleEventThrottler m_event_throttler{250};
+    bool m_largeFileMode = false;
+    std::thread* m_largeFileLoader = nullptr;
+    std::atomic_bool m_largeFileLoadCancelled{false};
+    size_t m_largeFileLoadGeneration = 0;
+    WordOccurrenceIndex m_wordIndex;
+    std::thread* m_wordIndexer = nullptr;
+    std::atomic_bool m_wordIndexerCancelled{false};
+    size_t m_wordIndexGeneration = 0;
+    std::pair<int, int> m_wordIndexPaintedRange{wxNOT_FOUND, wxNOT_FOUND};
 };
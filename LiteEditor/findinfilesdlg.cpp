@@ -29,6 +29,7 @@
 #include "StringUtils.h"
 #include "clFilesCollector.h"
 #include "clWorkspaceManager.h"
+#include "cl_config.h"
 #include "dirpicker.h"
 #include "event_notifier.h"
 #include "findresultstab.h"
@@ -239,6 +240,7 @@ SearchData FindInFilesDialog::DoGetSearchData()
     data.SetSkipStrings(flags & wxFRD_SKIP_STRINGS);
     data.SetColourComments(flags & wxFRD_COLOUR_COMMENTS);
     data.SetEnablePipeSupport(flags & wxFRD_ENABLE_PIPE_SUPPORT);
+    data.SetUseRipgrep(clConfig::Get().Read("FindInFiles/UseRipgrep", true));
 
     size_t search_flags = clFilesScanner::SF_DEFAULT;
     if (m_checkBoxFollowSymlinks->IsChecked()) {
@@ -55,12 +55,15 @@
 #include "clBootstrapWizard.h"
 #include "clCustomiseToolBarDlg.h"
 #include "clEditorBar.h"
+#include "clFileContentCache.hpp"
 #include "clGotoAnythingManager.h"
 #include "clInfoBar.h"
 #include "clLocaleManager.hpp"
 #include "clSTCHelper.hpp"
 #include "clSingleChoiceDialog.h"
 #include "clToolBarButtonBase.h"
+#include "clStartupReport.hpp"
+#include "clTrace.hpp"
 #include "clWorkspaceManager.h"
 #include "cl_aui_dock_art.h"
 #include "cl_command_event.h"
@@ -620,6 +623,10 @@ EVT_MENU(wxID_ABOUT, clMainFrame::OnAbout)
 EVT_MENU(XRCID("wxID_REPORT_BUG"), clMainFrame::OnReportIssue)
 EVT_MENU(XRCID("check_for_update"), clMainFrame::OnCheckForUpdate)
 EVT_MENU(XRCID("run_setup_wizard"), clMainFrame::OnRunSetupWizard)
+EVT_MENU(XRCID("record_trace"), clMainFrame::OnRecordTrace)
+EVT_UPDATE_UI(XRCID("record_trace"), clMainFrame::OnRecordTraceUI)
+EVT_MENU(XRCID("export_trace"), clMainFrame::OnExportTrace)
+EVT_UPDATE_UI(XRCID("export_trace"), clMainFrame::OnExportTraceUI)
 
 //-----------------------------------------------------------------
 // Toolbar
@@ -775,10 +782,14 @@ clMainFrame::clMainFrame(
     }
 
     // Initialise the bitmaps once.
-    clBitmaps::Initialise(this);
+    {
+        CL_STARTUP_PHASE("Load bitmaps");
+        clBitmaps::Initialise(this);
+    }
 
     // construct the UI
     m_frameGeneralInfo = inf;
+    CL_STARTUP_PHASE("Construct the UI");
     Construct();
 }
 
@@ -949,6 +960,7 @@ void clMainFrame::Construct()
     EventNotifier::Get()->Bind(wxEVT_BUILD_PROCESS_ENDED, &clMainFrame::OnBuildEnded, this);
     EventNotifier::Get()->Bind(wxEVT_WORKSPACE_LOADED, &clMainFrame::OnWorkspaceLoaded, this);
     EventNotifier::Get()->Bind(wxEVT_WORKSPACE_CLOSED, &clMainFrame::OnWorkspaceClosed, this);
+    clFileContentCache::Get().ConnectEvents();
     EventNotifier::Get()->Connect(
         wxEVT_CL_THEME_CHANGED, wxCommandEventHandler(clMainFrame::OnThemeChanged), NULL, this);
     EventNotifier::Get()->Connect(
@@ -1741,6 +1753,9 @@ void clMainFrame::Bootstrap()
 
     // and finally, find the best window to give focus to
     codelite_initialised = true;
+
+    // not reported when the setup wizard was shown, the startup would include the time spent in the wizard
+    clStartupReport::Finish();
 }
 
 void clMainFrame::OnQuit(wxCommandEvent& WXUNUSED(event)) { Close(); }
@@ -3489,7 +3504,10 @@ void clMainFrame::CompleteInitialization()
     }
 
     // Load the plugins
-    PluginManager::Get()->Load();
+    {
+        CL_STARTUP_PHASE("Load plugins");
+        PluginManager::Get()->Load();
+    }
     m_pluginsToolbar->Realize();
 
     // Initialise the ChatAI
@@ -3502,7 +3520,10 @@ void clMainFrame::CompleteInitialization()
 #else
     DebuggerMgr::Get().Initialize(this, EnvironmentConfig::Instance(), ManagerST::Get()->GetInstallDir());
 #endif
-    DebuggerMgr::Get().LoadDebuggers(ManagerST::Get());
+    {
+        CL_STARTUP_PHASE("Load debuggers");
+        DebuggerMgr::Get().LoadDebuggers(ManagerST::Get());
+    }
 
     // Connect some system events
     m_mgr.Connect(wxEVT_AUI_PANE_CLOSE, wxAuiManagerEventHandler(clMainFrame::OnDockablePaneClosed), NULL, this);
@@ -6097,6 +6118,28 @@ void clMainFrame::OnReportIssue(wxCommandEvent& event)
     ::wxLaunchDefaultBrowser("https://github.com/eranif/codelite/issues");
 }
 
+void clMainFrame::OnRecordTrace(wxCommandEvent& event) { clTrace::Enable(event.IsChecked()); }
+
+void clMainFrame::OnRecordTraceUI(wxUpdateUIEvent& event) { event.Check(clTrace::IsEnabled()); }
+
+void clMainFrame::OnExportTrace(wxCommandEvent& event)
+{
+    wxUnusedVar(event);
+    wxString path = ::wxFileSelector(_("Export Performance Trace"), "", "codelite-trace.json", "json",
+                                     "JSON files (*.json)|*.json", wxFD_SAVE | wxFD_OVERWRITE_PROMPT, this);
+    if (path.IsEmpty()) {
+        return;
+    }
+
+    if (!clTrace::Export(path)) {
+        ::wxMessageBox(_("Failed to write the trace file:\n") + path, "CodeLite", wxICON_ERROR | wxOK | wxCENTER);
+        return;
+    }
+    GetStatusBar()->SetMessage(_("Trace written. Open it with chrome://tracing or ui.perfetto.dev"), 5);
+}
+
+void clMainFrame::OnExportTraceUI(wxUpdateUIEvent& event) { event.Enable(clTrace::GetCount() > 0); }
+
 void clMainFrame::DoShowMenuBar(bool show) { wxUnusedVar(show); }
 
 void clMainFrame::OnSysColoursChanged(clCommandEvent& event)
@@ -479,6 +479,10 @@ protected:
     void OnFunctionCalltip(wxCommandEvent& event);
     void OnAbout(wxCommandEvent& event);
     void OnReportIssue(wxCommandEvent& event);
+    void OnRecordTrace(wxCommandEvent& event);
+    void OnRecordTraceUI(wxUpdateUIEvent& event);
+    void OnExportTrace(wxCommandEvent& event);
+    void OnExportTraceUI(wxUpdateUIEvent& event);
     void OnCheckForUpdate(wxCommandEvent& e);
     void OnRunSetupWizard(wxCommandEvent& e);
     void OnFileNew(wxCommandEvent& event);
@@ -49,6 +49,7 @@
 #include "clRemoteHost.hpp"
 #include "clSFTPManager.hpp"
 #include "clStrings.h"
+#include "clTrace.hpp"
 #include "clWorkspaceManager.h"
 #include "clWorkspaceView.h"
 #include "cl_command_event.h"
@@ -390,6 +391,7 @@ void Manager::CreateWorkspace(const wxString& name, const wxString& path)
 
 void Manager::OpenWorkspace(const wxString& path)
 {
+    CL_TRACE_ZONE("Open workspace");
     wxLogNull noLog;
     CloseWorkspace();
 
@@ -439,6 +441,7 @@ void Manager::ReloadWorkspace()
 
 void Manager::DoSetupWorkspace(const wxString& path)
 {
+    CL_TRACE_ZONE("Setup workspace");
     wxString errMsg;
     wxBusyCursor cursor;
     AddToRecentlyOpenedWorkspaces(path);
@@ -863,12 +866,12 @@ void Manager::GetWorkspaceFiles(wxArrayString& files)
 
     if (clFileSystemWorkspace::Get().IsOpen()) {
         const auto& V = clFileSystemWorkspace::Get().GetFiles();
-        if (V.empty()) {
+        if (V.IsEmpty()) {
             return;
         }
-        files.Alloc(V.size());
-        for (const auto& f : V) {
-            files.Add(f.GetFullPath());
+        files.Alloc(V.GetSize());
+        for (const wxString& f : V) {
+            files.Add(f);
         }
         return;
     } else {
@@ -889,12 +892,14 @@ void Manager::GetWorkspaceFiles(std::vector<wxFileName>& files, bool absPath)
 {
     if (clFileSystemWorkspace::Get().IsOpen()) {
         const auto& V = clFileSystemWorkspace::Get().GetFiles();
-        if (V.empty()) {
+        if (V.IsEmpty()) {
             return;
         }
-        files.reserve(V.size());
+        files.reserve(V.GetSize());
         if (absPath) {
-            files.insert(files.end(), V.begin(), V.end());
+            for (const wxString& f : V) {
+                files.emplace_back(f);
+            }
         } else {
             const wxFileName& fnWorkspace = clFileSystemWorkspace::Get().GetFileName();
             wxString path = fnWorkspace.GetPath();
@@ -35,6 +35,7 @@
 #include "clEditorBar.h"
 #include "clInfoBar.h"
 #include "clStrings.h"
+#include "clWorkspaceEvent.hpp"
 #include "cl_config.h"
 #include "cl_standard_paths.h"
 #include "ctags_manager.h"
@@ -108,6 +109,11 @@ void PluginManager::UnLoad()
     }
     m_plugins.clear();
     m_dl.clear();
+
+    EventNotifier::Get()->Unbind(wxEVT_FILE_LOADED, &PluginManager::OnFileLoaded, this);
+    EventNotifier::Get()->Unbind(wxEVT_WORKSPACE_LOADED, &PluginManager::OnWorkspaceLoaded, this);
+    m_deferredPlugins.clear();
+    m_loadTimes.clear();
 }
 
 PluginManager::PluginManager()
@@ -156,6 +162,32 @@ void PluginManager::Load()
         allowedPlugins = app->GetAllowedPlugins();
     }
 
+    auto can_load = [&](const PluginInfo& info) -> bool {
+        wxString pname = info.GetName();
+        pname.MakeLower().Trim().Trim(false);
+
+        // Check the policy
+        if (pp == CodeLiteApp::PP_FromList && allowedPlugins.Index(pname) == wxNOT_FOUND) {
+            // Policy is set to 'from list' and this plugin does not match any plugins from
+            // the list, don't allow it to be loaded
+            return false;
+        }
+
+        // If the plugin does not exist in the m_pluginsData, assume its the first time we see it
+        bool firstTimeLoading = (m_pluginsData.GetPlugins().count(info.GetName()) == 0);
+        if (firstTimeLoading && info.HasFlag(PluginInfo::kDisabledByDefault)) {
+            m_pluginsData.DisablePlugin(info.GetName());
+            return false;
+        }
+
+        // Can we load it?
+        if (!m_pluginsData.CanLoad(info)) {
+            clDEBUG() << "Plugin:" << info.GetName() << " is not enabled" << endl;
+            return false;
+        }
+        return true;
+    };
+
     wxString pluginsDir = clStandardPaths::Get().GetPluginsDirectory();
     if (wxDir::Exists(pluginsDir)) {
         // get list of dlls
@@ -167,105 +199,27 @@ void PluginManager::Load()
         for (size_t i = 0; i < files.GetCount(); i++) {
 
             wxString fileName(files.Item(i));
-#ifdef __WXGTK__
             wxFileName fnDLL(fileName);
+#ifdef __WXGTK__
             if (fnDLL.GetFullName().StartsWith("lib")) {
                 // don't attempt to load a library
                 continue;
             }
 #endif
 
-            clDynamicLibrary* dl = new clDynamicLibrary();
-            if (!dl->Load(fileName)) {
-                clERROR() << "Failed to load plugin's dll" << fileName << endl;
-                if (!dl->GetError().IsEmpty()) {
-                    clERROR() << dl->GetError() << endl;
-                }
-                wxDELETE(dl);
-                continue;
-            }
-
-            bool success(false);
-            GET_PLUGIN_INFO_FUNC pfnGetPluginInfo = (GET_PLUGIN_INFO_FUNC)dl->GetSymbol(wxT("GetPluginInfo"), &success);
-            if (!success) {
-                wxDELETE(dl);
-                continue;
-            }
-
-            // load the plugin version method
-            // if the methods does not exist, handle it as if it has value of 100 (lowest version API)
-            int interface_version(100);
-            GET_PLUGIN_INTERFACE_VERSION_FUNC pfnInterfaceVersion =
-                (GET_PLUGIN_INTERFACE_VERSION_FUNC)dl->GetSymbol(wxT("GetPluginInterfaceVersion"), &success);
-            if (success) {
-                interface_version = pfnInterfaceVersion();
-            } else {
-                clWARNING() << "Failed to find GetPluginInterfaceVersion() in dll" << fileName << endl;
-                if (!dl->GetError().IsEmpty()) {
-                    clWARNING() << dl->GetError() << endl;
-                }
-            }
-
-            if (interface_version != PLUGIN_INTERFACE_VERSION) {
-                clWARNING() << "Version interface mismatch error for plugin:" << fileName
-                            << ". Found:" << interface_version << "Expected:" << PLUGIN_INTERFACE_VERSION << endl;
-                wxDELETE(dl);
-                continue;
-            }
-
-            // Check if this dll can be loaded
-            PluginInfo* pluginInfo = pfnGetPluginInfo();
-
-            wxString pname = pluginInfo->GetName();
-            m_installedPlugins.insert({pname, *pluginInfo});
-
-            pname.MakeLower().Trim().Trim(false);
-
-            // Check the policy
-            if (pp == CodeLiteApp::PP_FromList && allowedPlugins.Index(pname) == wxNOT_FOUND) {
-                // Policy is set to 'from list' and this plugin does not match any plugins from
-                // the list, don't allow it to be loaded
-                wxDELETE(dl);
-                continue;
-            }
-
-            // If the plugin does not exist in the m_pluginsData, assume its the first time we see it
-            bool firstTimeLoading = (m_pluginsData.GetPlugins().count(pluginInfo->GetName()) == 0);
-            if (firstTimeLoading && pluginInfo->HasFlag(PluginInfo::kDisabledByDefault)) {
-                m_pluginsData.DisablePlugin(pluginInfo->GetName());
-                wxDELETE(dl);
-                continue;
-            }
-
-            // Can we load it?
-            if (!m_pluginsData.CanLoad(*pluginInfo)) {
-                clDEBUG() << "Plugin:" << pluginInfo->GetName() << " is not enabled" << endl;
-                wxDELETE(dl);
-                continue;
-            }
-
-            // try and load the plugin
-            GET_PLUGIN_CREATE_FUNC pfn = (GET_PLUGIN_CREATE_FUNC)dl->GetSymbol(wxT("CreatePlugin"), &success);
-            if (!success) {
-                clWARNING() << "Failed to find CreatePlugin() in dll:" << fileName << endl;
-                if (!dl->GetError().IsEmpty()) {
-                    clWARNING() << dl->GetError() << endl;
+            time_t modified = fnDLL.GetModificationTime().GetTicks();
+            const auto* manifest = m_pluginsData.GetManifest(fileName, modified);
+            if (manifest && manifest->info.HasFlag(PluginInfo::kLoadOnDemand)) {
+                // don't load the library until a file matching one of the plugin triggers is opened
+                const PluginInfo& info = manifest->info;
+                m_installedPlugins.insert({ info.GetName(), info });
+                if (can_load(info)) {
+                    clDEBUG() << "Plugin:" << info.GetName() << "will be loaded on demand" << endl;
+                    m_deferredPlugins.insert({ info.GetName(), { fileName, modified, info } });
                 }
-
-                m_pluginsData.DisablePlugin(pluginInfo->GetName());
                 continue;
             }
-
-            // Construct the plugin
-            IPlugin* plugin = pfn((IManager*)this);
-            clDEBUG() << "Loaded plugin:" << plugin->GetLongName() << endl;
-            m_plugins[plugin->GetShortName()] = plugin;
-
-            // Load the toolbar
-            plugin->CreateToolBar(clMainFrame::Get()->GetPluginsToolBar());
-
-            // Keep the dynamic load library
-            m_dl.push_back(dl);
+            LoadPluginLibrary(fileName, modified, can_load);
         }
         clMainFrame::Get()->GetDockingManager().Update();
 
@@ -283,6 +237,11 @@ void PluginManager::Load()
 
         // save the plugins data
         conf.WriteItem(&m_pluginsData);
+
+        if (!m_deferredPlugins.empty()) {
+            EventNotifier::Get()->Bind(wxEVT_FILE_LOADED, &PluginManager::OnFileLoaded, this);
+            EventNotifier::Get()->Bind(wxEVT_WORKSPACE_LOADED, &PluginManager::OnWorkspaceLoaded, this);
+        }
     }
 
     // Now that all the plugins are loaded, load from the configuration file
@@ -328,6 +287,154 @@ void PluginManager::Load()
     }
 }
 
+IPlugin* PluginManager::LoadPluginLibrary(const wxString& fileName,
+                                          time_t modified,
+                                          const std::function<bool(const PluginInfo&)>& canLoad)
+{
+    auto start = std::chrono::steady_clock::now();
+    clDynamicLibrary* dl = new clDynamicLibrary();
+    if (!dl->Load(fileName)) {
+        clERROR() << "Failed to load plugin's dll" << fileName << endl;
+        if (!dl->GetError().IsEmpty()) {
+            clERROR() << dl->GetError() << endl;
+        }
+        wxDELETE(dl);
+        return nullptr;
+    }
+
+    bool success(false);
+    GET_PLUGIN_INFO_FUNC pfnGetPluginInfo = (GET_PLUGIN_INFO_FUNC)dl->GetSymbol(wxT("GetPluginInfo"), &success);
+    if (!success) {
+        wxDELETE(dl);
+        return nullptr;
+    }
+
+    // load the plugin version method
+    // if the methods does not exist, handle it as if it has value of 100 (lowest version API)
+    int interface_version(100);
+    GET_PLUGIN_INTERFACE_VERSION_FUNC pfnInterfaceVersion =
+        (GET_PLUGIN_INTERFACE_VERSION_FUNC)dl->GetSymbol(wxT("GetPluginInterfaceVersion"), &success);
+    if (success) {
+        interface_version = pfnInterfaceVersion();
+    } else {
+        clWARNING() << "Failed to find GetPluginInterfaceVersion() in dll" << fileName << endl;
+        if (!dl->GetError().IsEmpty()) {
+            clWARNING() << dl->GetError() << endl;
+        }
+    }
+
+    if (interface_version != PLUGIN_INTERFACE_VERSION) {
+        clWARNING() << "Version interface mismatch error for plugin:" << fileName << ". Found:" << interface_version
+                    << "Expected:" << PLUGIN_INTERFACE_VERSION << endl;
+        wxDELETE(dl);
+        return nullptr;
+    }
+
+    // Check if this dll can be loaded
+    PluginInfo* pluginInfo = pfnGetPluginInfo();
+    m_installedPlugins.insert({ pluginInfo->GetName(), *pluginInfo });
+
+    // remember the plugins that can be loaded on demand, so their library is not loaded on the next startup
+    if (pluginInfo->HasFlag(PluginInfo::kLoadOnDemand)) {
+        m_pluginsData.SetManifest(fileName, { modified, interface_version, *pluginInfo });
+    } else {
+        m_pluginsData.RemoveManifest(fileName);
+    }
+
+    if (canLoad && !canLoad(*pluginInfo)) {
+        wxDELETE(dl);
+        return nullptr;
+    }
+
+    // try and load the plugin
+    GET_PLUGIN_CREATE_FUNC pfn = (GET_PLUGIN_CREATE_FUNC)dl->GetSymbol(wxT("CreatePlugin"), &success);
+    if (!success) {
+        clWARNING() << "Failed to find CreatePlugin() in dll:" << fileName << endl;
+        if (!dl->GetError().IsEmpty()) {
+            clWARNING() << dl->GetError() << endl;
+        }
+
+        m_pluginsData.DisablePlugin(pluginInfo->GetName());
+        return nullptr;
+    }
+
+    // Construct the plugin
+    IPlugin* plugin = pfn((IManager*)this);
+    m_plugins[plugin->GetShortName()] = plugin;
+
+    // Load the toolbar
+    plugin->CreateToolBar(clMainFrame::Get()->GetPluginsToolBar());
+
+    // Keep the dynamic load library
+    m_dl.push_back(dl);
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    m_loadTimes[pluginInfo->GetName()] = elapsed;
+    clDEBUG() << "Loaded plugin:" << plugin->GetLongName() << "in" << elapsed.count() << "ms" << endl;
+    return plugin;
+}
+
+void PluginManager::ActivateDeferredPlugins(const wxString& filepath)
+{
+    std::vector<DeferredPlugin> triggered;
+    for (auto iter = m_deferredPlugins.begin(); iter != m_deferredPlugins.end();) {
+        if (iter->second.info.IsTriggeredBy(filepath)) {
+            triggered.push_back(std::move(iter->second));
+            iter = m_deferredPlugins.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+
+    if (triggered.empty()) {
+        return;
+    }
+
+    wxMenu* pluginsMenu = NULL;
+    wxMenuItem* menuitem = clMainFrame::Get()->GetMainMenuBar()->FindItem(XRCID("manage_plugins"), &pluginsMenu);
+    for (const auto& deferred : triggered) {
+        clDEBUG() << "Activating plugin:" << deferred.info.GetName() << "for file:" << filepath << endl;
+        IPlugin* plugin = LoadPluginLibrary(deferred.library, deferred.modified, nullptr);
+        if (plugin && pluginsMenu && menuitem) {
+            plugin->SetPluginsMenu(pluginsMenu);
+            plugin->CreatePluginMenu(pluginsMenu);
+        }
+    }
+
+    // the plugins added their buttons to the toolbar, which was already realized at startup
+    clMainFrame::Get()->GetPluginsToolBar()->Realize();
+    clMainFrame::Get()->GetPluginsToolBar()->Refresh();
+    clMainFrame::Get()->GetDockingManager().Update();
+
+    // loading the libraries refreshed their manifests
+    clConfig conf("plugins.conf");
+    conf.WriteItem(&m_pluginsData);
+}
+
+void PluginManager::OnFileLoaded(clCommandEvent& event)
+{
+    event.Skip();
+    // activate the plugins once the event was processed: they bind their own handlers when constructed
+    wxString filepath = event.GetFileName();
+    EventNotifier::Get()->CallAfter([this, filepath]() { ActivateDeferredPlugins(filepath); });
+}
+
+void PluginManager::OnWorkspaceLoaded(clWorkspaceEvent& event)
+{
+    event.Skip();
+    wxString filepath = event.GetFileName();
+    EventNotifier::Get()->CallAfter([this, filepath]() { ActivateDeferredPlugins(filepath); });
+}
+
+std::optional<std::chrono::milliseconds> PluginManager::GetLoadTime(const wxString& name) const
+{
+    auto iter = m_loadTimes.find(name);
+    if (iter == m_loadTimes.end()) {
+        return std::nullopt;
+    }
+    return iter->second;
+}
+
 IEditor* PluginManager::GetActiveEditor()
 {
     if (clMainFrame::Get() && clMainFrame::Get()->GetMainBook()) {
@@ -34,8 +34,11 @@
 #include "plugindata.h"
 #include "project.h"
 
+#include <chrono>
+#include <functional>
 #include <list>
 #include <map>
+#include <optional>
 #include <set>
 #include <vector>
 #include <wx/string.h>
@@ -49,6 +52,7 @@ class BuildManager;
 class BitmapLoader;
 class clWorkspaceView;
 class clInfoBar;
+class clWorkspaceEvent;
 
 class PluginManager : public IManager
 {
@@ -61,10 +65,27 @@ class PluginManager : public IManager
     wxAuiManager* m_dockingManager;
     PluginInfo::PluginMap_t m_installedPlugins;
 
+    struct DeferredPlugin {
+        wxString library;
+        time_t modified = 0;
+        PluginInfo info;
+    };
+    std::map<wxString, DeferredPlugin> m_deferredPlugins;      // enabled plugins waiting for one of their triggers
+    std::map<wxString, std::chrono::milliseconds> m_loadTimes; // plugin name -> time spent loading and constructing it
+
 private:
     PluginManager();
     virtual ~PluginManager() = default;
 
+    /// load the plugin library and construct the plugin, if `canLoad` (when set) allows it
+    IPlugin* LoadPluginLibrary(const wxString& fileName,
+                               time_t modified,
+                               const std::function<bool(const PluginInfo&)>& canLoad);
+    /// load the deferred plugins triggered by `filepath`
+    void ActivateDeferredPlugins(const wxString& filepath);
+    void OnFileLoaded(clCommandEvent& event);
+    void OnWorkspaceLoaded(clWorkspaceEvent& event);
+
 public:
     static PluginManager* Get();
 
@@ -81,6 +102,14 @@ public:
      * \brief return a map of all loaded plugins
      */
     const PluginInfoArray& GetPluginsInfo() const { return m_pluginsData; }
+    /**
+     * \brief return the time it took to load the plugin `name`, or nullopt if it is not loaded
+     */
+    std::optional<std::chrono::milliseconds> GetLoadTime(const wxString& name) const;
+    /**
+     * \brief return true if the plugin `name` is enabled but waits for one of its triggers to be loaded
+     */
+    bool IsDeferred(const wxString& name) const { return m_deferredPlugins.count(name) != 0; }
     void SetDockingManager(wxAuiManager* dockingManager) { this->m_dockingManager = dockingManager; }
 
     //------------------------------------
@@ -108,8 +108,9 @@ void PluginMgrDlg::CreateInfoPage(unsigned int index)
     m_richTextCtrl->SetEditable(true);
     // get the plugin name
     wxString pluginName = m_dvListCtrl->GetItemText(m_dvListCtrl->RowToItem(index));
-    auto iter = PluginManager::Get()->GetInstalledPlugins().find(pluginName);
-    if(iter != plugins.GetPlugins().end()) {
+    const auto& installedPlugins = PluginManager::Get()->GetInstalledPlugins();
+    auto iter = installedPlugins.find(pluginName);
+    if(iter != installedPlugins.end()) {
         const PluginInfo& info = iter->second;
         m_richTextCtrl->BeginBold();
         m_richTextCtrl->WriteText(info.GetName());
@@ -124,6 +125,20 @@ void PluginMgrDlg::CreateInfoPage(unsigned int index)
 
         WritePropertyLine(_("Is Loaded?"), plugins.CanLoad(info) ? _("Yes") : _("No"));
         m_richTextCtrl->Newline();
+
+        if(info.HasFlag(PluginInfo::kLoadOnDemand)) {
+            WritePropertyLine(_("Loaded on demand for"), ::wxJoin(info.GetTriggers(), ' '));
+            m_richTextCtrl->Newline();
+        }
+
+        auto loadTime = PluginManager::Get()->GetLoadTime(info.GetName());
+        if(loadTime) {
+            WritePropertyLine(_("Load time"), wxString::Format("%lld ms", (long long)loadTime->count()));
+            m_richTextCtrl->Newline();
+        } else if(PluginManager::Get()->IsDeferred(info.GetName())) {
+            WritePropertyLine(_("Load time"), _("Not loaded yet"));
+            m_richTextCtrl->Newline();
+        }
         m_richTextCtrl->Newline();
 
         m_richTextCtrl->BeginBold();
@@ -38,6 +38,7 @@
 #include "macros.h"
 #include "manager.h"
 
+#include <algorithm>
 #include <vector>
 #include <wx/dcgraph.h>
 #include <wx/dcmemory.h>
@@ -72,6 +73,11 @@ ReplaceInFilesPanel::ReplaceInFilesPanel(wxWindow* parent, int id, const wxStrin
     button_replace->Bind(wxEVT_BUTTON, &ReplaceInFilesPanel::OnReplace, this);
     button_replace->Bind(wxEVT_UPDATE_UI, &ReplaceInFilesPanel::OnReplaceUI, this);
 
+    wxButton* button_undo = new wxButton(this, wxID_ANY, _("Undo Replace"));
+    horzSizer->Add(button_undo, 0, wxRIGHT | wxLEFT | wxALIGN_CENTER_VERTICAL, 5);
+    button_undo->Bind(wxEVT_BUTTON, &ReplaceInFilesPanel::OnUndoReplace, this);
+    button_undo->Bind(wxEVT_UPDATE_UI, &ReplaceInFilesPanel::OnUndoReplaceUI, this);
+
     wxBoxSizer* vertSizer = new wxBoxSizer(wxVERTICAL);
     vertSizer->Add(horzSizer, 0, wxEXPAND | wxTOP | wxBOTTOM);
 
@@ -89,12 +95,21 @@ ReplaceInFilesPanel::ReplaceInFilesPanel(wxWindow* parent, int id, const wxStrin
     m_progress->Hide();
     m_vSizer->Add(m_progress, wxSizerFlags().Expand().Border(wxALL, 5));
 
+    m_progressTimer.SetOwner(this);
+    Bind(wxEVT_TIMER, &ReplaceInFilesPanel::OnProgressTimer, this, m_progressTimer.GetId());
+
     mainSizer->Layout();
 }
 
 void ReplaceInFilesPanel::OnSearchStart(wxCommandEvent& e)
 {
     e.Skip();
+    // the matches of the replace in progress are about to be cleared
+    if (m_engine.IsRunning()) {
+        m_engine.Stop();
+        DoHideProgress();
+    }
+
     // set the "Replace With" field with the user value
     SearchData* data = (SearchData*)e.GetClientData();
     m_replaceWith->SetValue(data->GetReplaceWith());
@@ -155,65 +170,78 @@ void ReplaceInFilesPanel::OnMarkAll(wxCommandEvent& e)
     }
 }
 
-void ReplaceInFilesPanel::OnMarkAllUI(wxUpdateUIEvent& e) { e.Enable((m_sci->GetLength() > 0) && !m_searchInProgress); }
+void ReplaceInFilesPanel::OnMarkAllUI(wxUpdateUIEvent& e)
+{
+    e.Enable((m_sci->GetLength() > 0) && !m_searchInProgress && !m_engine.IsRunning());
+}
 void ReplaceInFilesPanel::OnUnmarkAll(wxCommandEvent& e) { m_sci->MarkerDeleteAll(0x7); }
 void ReplaceInFilesPanel::OnUnmarkAllUI(wxUpdateUIEvent& e)
 {
-    e.Enable((m_sci->GetLength() > 0) && !m_searchInProgress);
+    e.Enable((m_sci->GetLength() > 0) && !m_searchInProgress && !m_engine.IsRunning());
 }
 
-void ReplaceInFilesPanel::DoSaveResults(wxStyledTextCtrl* sci, MatchInfo_t::iterator begin, MatchInfo_t::iterator end)
+void ReplaceInFilesPanel::DoReplaceInEditor(wxStyledTextCtrl* sci,
+                                            MatchInfo_t::iterator begin,
+                                            MatchInfo_t::iterator end)
 {
-    if (!sci || begin == end)
-        return;
-    bool ok = true;
-    if (dynamic_cast<clEditor*>(sci) == NULL) {
-        // it's a temp editor, check if we have any changes to save
-        if (sci->GetModify() && !WriteFileWithBackup(begin->second.GetFileName(), sci->GetText(), false)) {
-            wxMessageBox(_("Failed to save file:\n") + begin->second.GetFileName(),
-                         _("CodeLite - Replace"),
-                         wxICON_ERROR | wxOK);
-            clDEBUG() << "Replace: Failed to write file" << begin->second.GetFileName();
-            ok = false;
+    // track offsets of pending substitutions caused by previous substitutions
+    long lastLine = 0;
+    long delta = 0, deltaInChars = 0;
+
+    for (MatchInfo_t::iterator i = begin; i != end; ++i) {
+        SearchResult& res = i->second;
+        if (res.GetLineNumber() == lastLine) {
+            // prior substitutions affected the location of this one
+            res.SetColumn(res.GetColumn() + delta);
+            res.SetColumnInChars(res.GetColumnInChars() + deltaInChars);
+        } else {
+            delta = deltaInChars = 0;
+        }
+        if ((m_sci->MarkerGet(i->first) & 1 << 0x7) == 0)
+            // not selected for application
+            continue;
+
+        wxString replaceText = DoGetReplaceWith(res);
+        int replaceLenInChars = (int)replaceText.Len();
+        int replaceLen = (int)StringUtils::UTF8Length(replaceText.ToStdWstring().c_str(), replaceLenInChars);
+
+        // extract originally matched text for safety check later
+        wxString text = res.GetPattern().Mid(res.GetColumnInChars() - deltaInChars, res.GetLenInChars());
+        if (text == replaceText)
+            continue; // no change needed
+
+        long pos = sci->PositionFromLine(res.GetLineNumber() - 1);
+        if (pos < 0) {
+            // invalid line number
+            m_sci->MarkerAdd(i->first, 0x8);
+            continue;
         }
+        pos += res.GetColumn();
 
-        if (sci && ok) {
-            // Keep the modified file name
-            m_filesModified.Add(begin->second.GetFileName());
+        sci->SetSelection(pos, pos + res.GetLen());
+        if (sci->GetSelectedText() != text) {
+            // couldn't locate the original match (file may have been modified)
+            m_sci->MarkerAdd(i->first, 0x8);
+            continue;
         }
+        sci->ReplaceSelection(replaceText);
 
-        delete sci;
+        delta += replaceLen - res.GetLen();
+        deltaInChars += replaceLenInChars - res.GetLenInChars();
+        lastLine = res.GetLineNumber();
+
+        res.SetPattern(m_sci->GetLine(i->first)); // includes prior updates to same line
+        res.SetLen(replaceLen);
+        res.SetLenInChars(replaceLenInChars);
     }
+
     for (; begin != end; begin++) {
         if ((m_sci->MarkerGet(begin->first) & 7 << 0x7) == 1 << 0x7) {
-            m_sci->MarkerAdd(begin->first, ok ? 0x9 : 0x8);
+            m_sci->MarkerAdd(begin->first, 0x9);
         }
     }
 }
 
-wxStyledTextCtrl* ReplaceInFilesPanel::DoGetEditor(const wxString& fileName)
-{
-    // look for open editor first
-    wxStyledTextCtrl* sci = clMainFrame::Get()->GetMainBook()->FindEditor(fileName);
-    if (sci) {
-        // FIXME: if editor is already modified, the found locations may not be accurate
-        return sci;
-    }
-
-    // not open for editing, so make our own temp editor
-    wxString content;
-    if (!ReadFileWithConversion(fileName, content)) {
-        wxMessageBox(_("Failed to open file:\n") + fileName, _("CodeLite - Replace"), wxICON_ERROR | wxOK);
-        clDEBUG() << "Replace: Failed to read file" << fileName;
-        return NULL;
-    }
-
-    sci = new wxStyledTextCtrl(this);
-    sci->Hide();
-    sci->SetText(content);
-    return sci;
-}
-
 wxString ReplaceInFilesPanel::DoGetReplaceWith(const SearchResult& res) const
 {
     wxString replaceWith = m_replaceWith->GetValue();
@@ -247,125 +275,238 @@ wxString ReplaceInFilesPanel::DoGetReplaceWith(const SearchResult& res) const
 
 void ReplaceInFilesPanel::OnReplace(wxCommandEvent& e)
 {
-    if (!m_progress->IsShown()) {
-        m_progress->Show();
-        GetSizer()->Layout();
+    if (m_engine.IsRunning()) {
+        return;
     }
 
     m_filesModified.clear();
-    // FIX bug#2770561
-    int lineNumber = 0;
-    clEditor* activeEditor = clMainFrame::Get()->GetMainBook()->GetActiveEditor();
-    if (activeEditor) {
-        lineNumber = activeEditor->GetCurrentLine();
-    }
+    m_editorFiles.clear();
+    m_editorReplacements = 0;
 
     if (m_replaceWith->FindString(m_replaceWith->GetValue(), true) == wxNOT_FOUND) {
         m_replaceWith->Append(m_replaceWith->GetValue());
     }
 
-    // Step 1: apply selected replacements
-
-    wxStyledTextCtrl* sci = NULL; // file that is being altered by replacements
-
-    wxString lastFile; // track offsets of pending substitutions caused by previous substitutions
-    long lastLine = 0;
-    long delta = 0, deltaInChars = 0;
-
-    // remembers first entry in the file being updated
+    // Step 1: plan the selected replacements. The files with unsaved changes are replaced in their editor, the other
+    // files are replaced on disk by the engine. Nothing is modified before the user confirmed the replace
+    std::vector<ReplaceInFilesEngine::File> files;
     MatchInfo_t::iterator firstInFile = m_matchInfo.begin();
+    while (firstInFile != m_matchInfo.end()) {
+        const wxString fileName = firstInFile->second.GetFileName();
+        MatchInfo_t::iterator endOfFile = firstInFile;
+        while (endOfFile != m_matchInfo.end() && endOfFile->second.GetFileName() == fileName) {
+            ++endOfFile;
+        }
 
-    m_progress->SetRange(m_matchInfo.size());
+        clEditor* editor = clMainFrame::Get()->GetMainBook()->FindEditor(fileName);
+        if (editor && editor->GetModify()) {
+            size_t count = 0;
+            for (MatchInfo_t::iterator i = firstInFile; i != endOfFile; ++i) {
+                if ((m_sci->MarkerGet(i->first) & 1 << 0x7) == 0)
+                    // not selected for application
+                    continue;
+
+                const SearchResult& res = i->second;
+                if (res.GetPattern().Mid(res.GetColumnInChars(), res.GetLenInChars()) != DoGetReplaceWith(res)) {
+                    ++count;
+                }
+            }
+            if (count) {
+                m_editorFiles.Add(fileName);
+                m_editorReplacements += count;
+            }
 
-    // Disable the 'buffer limit' feature during replace
-    clMainFrame::Get()->GetMainBook()->SetUseBuffereLimit(false);
-    MatchInfo_t::iterator i = firstInFile;
-    for (; i != m_matchInfo.end(); ++i) {
-        SearchResult& res = i->second;
-        m_progress->SetValue(m_progress->GetValue() + 1);
-        m_progress->Update();
-
-        if (res.GetFileName() != lastFile) {
-            // about to start a different file, save current results
-            DoSaveResults(sci, firstInFile, i);
-            firstInFile = i;
-            lastFile = res.GetFileName();
-            lastLine = 0;
-            sci = NULL;
+        } else {
+            ReplaceInFilesEngine::File file;
+            file.path = fileName;
+            for (MatchInfo_t::iterator i = firstInFile; i != endOfFile; ++i) {
+                if ((m_sci->MarkerGet(i->first) & 1 << 0x7) == 0)
+                    // not selected for application
+                    continue;
+
+                const SearchResult& res = i->second;
+                wxString replaceText = DoGetReplaceWith(res);
+                wxString text = res.GetPattern().Mid(res.GetColumnInChars(), res.GetLenInChars());
+                if ((int)text.length() != res.GetLenInChars()) {
+                    // the pattern is truncated, the whole match can not be verified
+                    m_sci->MarkerAdd(i->first, 0x8);
+                    continue;
+                }
+                if (text == replaceText)
+                    continue; // no change needed
+
+                ReplaceInFilesEngine::Replacement replacement;
+                replacement.id = i->first;
+                replacement.line = res.GetLineNumber();
+                replacement.column = res.GetColumn();
+                replacement.len = res.GetLen();
+                replacement.findWhat = text;
+                replacement.replaceWith = replaceText;
+                file.replacements.push_back(replacement);
+            }
+            if (!file.replacements.empty()) {
+                files.push_back(std::move(file));
+            }
         }
+        firstInFile = endOfFile;
+    }
 
-        if (res.GetLineNumber() == lastLine) {
-            // prior substitutions affected the location of this one
-            res.SetColumn(res.GetColumn() + delta);
-            res.SetColumnInChars(res.GetColumnInChars() + deltaInChars);
-        } else {
-            delta = deltaInChars = 0;
+    if (files.empty()) {
+        if (!m_editorFiles.IsEmpty() && DoConfirmReplace(m_editorFiles.size(), m_editorReplacements, 0)) {
+            DoReplaceInEditors();
         }
-        if ((m_sci->MarkerGet(i->first) & 1 << 0x7) == 0)
-            // not selected for application
-            continue;
+        m_editorFiles.clear();
+        DoFinishReplace();
+        return;
+    }
 
-        wxString replaceText = DoGetReplaceWith(res);
-        int replaceLenInChars = (int)replaceText.Len();
-        int replaceLen = (int)StringUtils::UTF8Length(replaceText.ToStdWstring().c_str(), replaceLenInChars);
+    DoShowProgress();
+    m_engine.Plan(std::move(files),
+                  EditorConfigST::Get()->GetOptions()->GetFileFontEncoding(),
+                  [this](const ReplaceInFilesEngine::Summary& summary) { OnReplacePlanned(summary); });
+}
 
-        // extract originally matched text for safety check later
-        wxString text = res.GetPattern().Mid(res.GetColumnInChars() - deltaInChars, res.GetLenInChars());
-        if (text == replaceText)
-            continue; // no change needed
+void ReplaceInFilesPanel::DoReplaceInEditors()
+{
+    // FIX bug#2770561
+    int lineNumber = 0;
+    clEditor* activeEditor = clMainFrame::Get()->GetMainBook()->GetActiveEditor();
+    if (activeEditor) {
+        lineNumber = activeEditor->GetCurrentLine();
+    }
 
-        // need an editor for this file (try only once per file though)
-        if (!sci && lastLine == 0) {
-            sci = DoGetEditor(res.GetFileName());
-            lastLine = res.GetLineNumber();
-        }
-        if (!sci) {
-            // couldn't open file
-            m_sci->MarkerAdd(i->first, 0x8);
-            continue;
+    MatchInfo_t::iterator firstInFile = m_matchInfo.begin();
+    while (firstInFile != m_matchInfo.end()) {
+        const wxString fileName = firstInFile->second.GetFileName();
+        MatchInfo_t::iterator endOfFile = firstInFile;
+        while (endOfFile != m_matchInfo.end() && endOfFile->second.GetFileName() == fileName) {
+            ++endOfFile;
         }
 
-        long pos = sci->PositionFromLine(res.GetLineNumber() - 1);
-        if (pos < 0) {
-            // invalid line number
-            m_sci->MarkerAdd(i->first, 0x8);
-            continue;
+        if (m_editorFiles.Index(fileName) != wxNOT_FOUND) {
+            clEditor* editor = clMainFrame::Get()->GetMainBook()->FindEditor(fileName);
+            if (editor) {
+                DoReplaceInEditor(editor, firstInFile, endOfFile);
+            } else {
+                // the editor was closed while the replace was planned
+                for (MatchInfo_t::iterator i = firstInFile; i != endOfFile; ++i) {
+                    if (m_sci->MarkerGet(i->first) & 1 << 0x7) {
+                        m_sci->MarkerAdd(i->first, 0x8);
+                    }
+                }
+            }
         }
-        pos += res.GetColumn();
+        firstInFile = endOfFile;
+    }
 
-        sci->SetSelection(pos, pos + res.GetLen());
-        if (sci->GetSelectedText() != text) {
-            // couldn't locate the original match (file may have been modified)
-            m_sci->MarkerAdd(i->first, 0x8);
-            continue;
-        }
-        sci->ReplaceSelection(replaceText);
+    // FIX bug#2770561
+    if (activeEditor) {
+        // restore the line
+        activeEditor->GotoLine(lineNumber);
+    }
+}
 
-        delta += replaceLen - res.GetLen();
-        deltaInChars += replaceLenInChars - res.GetLenInChars();
-        lastLine = res.GetLineNumber();
+bool ReplaceInFilesPanel::DoConfirmReplace(size_t files, size_t replacements, size_t skipped)
+{
+    // dry run summary
+    wxString message = wxString::Format(
+        _("Replace %lu matches in %lu files?"), (unsigned long)replacements, (unsigned long)files);
+    if (skipped) {
+        message << "\n"
+                << wxString::Format(_("%lu matches were modified since the search and will be skipped"),
+                                    (unsigned long)skipped);
+    }
+    return ::wxMessageBox(message, _("CodeLite - Replace"), wxYES_NO | wxCENTER | wxICON_QUESTION, this) == wxYES;
+}
 
-        res.SetPattern(m_sci->GetLine(i->first)); // includes prior updates to same line
-        res.SetLen(replaceLen);
-        res.SetLenInChars(replaceLenInChars);
+void ReplaceInFilesPanel::OnReplacePlanned(const ReplaceInFilesEngine::Summary& summary)
+{
+    if (summary.cancelled) {
+        m_engine.Discard();
+        m_editorFiles.clear();
+        DoFinishReplace();
+        return;
     }
 
-    // hide the progress bar
-    m_progress->SetValue(0);
-    m_progress->Hide();
-    GetSizer()->Layout();
+    if (summary.replacements + m_editorReplacements == 0) {
+        // all the matches were modified since the search
+        DoMarkEngineResults();
+        m_engine.Discard();
+        m_editorFiles.clear();
+        DoFinishReplace();
+        return;
+    }
 
-    DoSaveResults(sci, firstInFile, m_matchInfo.end());
+    if (!DoConfirmReplace(
+            summary.files + m_editorFiles.size(), summary.replacements + m_editorReplacements, summary.skipped)) {
+        m_engine.Discard();
+        m_editorFiles.clear();
+        DoFinishReplace();
+        return;
+    }
 
-    // Disable the 'buffer limit' feature during replace
-    clMainFrame::Get()->GetMainBook()->SetUseBuffereLimit(true);
+    DoReplaceInEditors();
+    m_editorFiles.clear();
+    if (summary.replacements == 0) {
+        // only the open editors had matches left to replace
+        DoMarkEngineResults();
+        m_engine.Discard();
+        DoFinishReplace();
+        return;
+    }
+    m_engine.Write([this](bool cancelled) { OnReplaceWritten(cancelled); });
+}
+
+void ReplaceInFilesPanel::OnReplaceWritten(bool cancelled)
+{
+    if (cancelled) {
+        clSYSTEM() << "Replace in files cancelled, the modified files were restored" << endl;
+    } else {
+        DoMarkEngineResults();
+    }
+
+    wxArrayString written;
+    for (const auto& file : m_engine.GetFiles()) {
+        if (file.written) {
+            written.Add(file.path);
+        }
+    }
+    m_filesModified.insert(m_filesModified.end(), written.begin(), written.end());
+
+    // reload the open editors once, now that all the files are written
+    DoReloadEditors(written);
+    DoFinishReplace();
+}
+
+void ReplaceInFilesPanel::DoMarkEngineResults()
+{
+    for (const auto& file : m_engine.GetFiles()) {
+        for (const auto& replacement : file.replacements) {
+            m_sci->MarkerAdd(replacement.id, file.written && replacement.applied ? 0x9 : 0x8);
+        }
+    }
+}
+
+void ReplaceInFilesPanel::DoReloadEditors(const wxArrayString& files)
+{
+    for (const wxString& file : files) {
+        clEditor* editor = clMainFrame::Get()->GetMainBook()->FindEditor(file);
+        if (editor && !editor->GetModify()) {
+            editor->ReloadFromDisk(true);
+        }
+    }
+}
+
+void ReplaceInFilesPanel::DoFinishReplace()
+{
+    DoHideProgress();
 
     // Step 2: Update the Replace pane
 
     std::set<wxString> updatedEditors;
-    delta = 0;    // offset from old line number to new
-    lastLine = 1; // points to the filename line
-    lastFile.Clear();
+    long delta = 0;    // offset from old line number to new
+    long lastLine = 1; // points to the filename line
+    wxString lastFile;
     m_sci->MarkerDeleteAll(0x7);
     m_sci->SetReadOnly(false);
     m_replaceWith->SetValue(wxEmptyString);
@@ -438,15 +579,6 @@ void ReplaceInFilesPanel::OnReplace(wxCommandEvent& e)
         }
     }
 
-    // FIX bug#2770561
-    if (activeEditor) {
-
-        clMainFrame::Get()->GetMainBook()->SelectPage(activeEditor);
-
-        // restore the line
-        activeEditor->GotoLine(lineNumber);
-    }
-
     if (!m_filesModified.IsEmpty()) {
         // Some files were modified directly on the file system, notify about it to the plugins
         clFileSystemEvent event(wxEVT_FILES_MODIFIED_REPLACE_IN_FILES);
@@ -456,11 +588,96 @@ void ReplaceInFilesPanel::OnReplace(wxCommandEvent& e)
     }
 }
 
-void ReplaceInFilesPanel::OnReplaceUI(wxUpdateUIEvent& e) { e.Enable((m_sci->GetLength() > 0) && !m_searchInProgress); }
+void ReplaceInFilesPanel::OnReplaceUI(wxUpdateUIEvent& e)
+{
+    e.Enable((m_sci->GetLength() > 0) && !m_searchInProgress && !m_engine.IsRunning());
+}
+
+void ReplaceInFilesPanel::OnUndoReplace(wxCommandEvent& e)
+{
+    if (!m_engine.CanUndo()) {
+        return;
+    }
+
+    if (::wxMessageBox(_("Restore the files modified by the last replace?"),
+                       _("CodeLite - Replace"),
+                       wxYES_NO | wxCENTER | wxICON_QUESTION,
+                       this) != wxYES) {
+        return;
+    }
+
+    DoShowProgress();
+    m_engine.Undo([this](const wxArrayString& restored, const wxArrayString& skipped) { OnUndoDone(restored, skipped); });
+}
+
+void ReplaceInFilesPanel::OnUndoDone(const wxArrayString& restored, const wxArrayString& skipped)
+{
+    DoHideProgress();
+    DoReloadEditors(restored);
+
+    if (!restored.IsEmpty()) {
+        clFileSystemEvent event(wxEVT_FILES_MODIFIED_REPLACE_IN_FILES);
+        event.SetStrings(restored);
+        EventNotifier::Get()->AddPendingEvent(event);
+    }
+
+    if (!skipped.IsEmpty()) {
+        wxString message;
+        message << _("The following files were modified since the replace and were not restored:") << "\n";
+        for (size_t i = 0; i < skipped.size() && i < 20; ++i) {
+            message << skipped.Item(i) << "\n";
+        }
+        if (skipped.size() > 20) {
+            message << "...\n";
+        }
+        ::wxMessageBox(message, _("CodeLite - Replace"), wxICON_WARNING | wxOK | wxCENTER, this);
+    }
+}
+
+void ReplaceInFilesPanel::OnUndoReplaceUI(wxUpdateUIEvent& e) { e.Enable(m_engine.CanUndo() && !m_searchInProgress); }
+
+void ReplaceInFilesPanel::OnStopSearch(wxCommandEvent& e)
+{
+    if (m_engine.IsRunning()) {
+        // the callback of the engine completes the replace
+        m_engine.Cancel();
+        return;
+    }
+    FindResultsTab::OnStopSearch(e);
+}
+
+void ReplaceInFilesPanel::OnStopSearchUI(wxUpdateUIEvent& e) { e.Enable(m_searchInProgress || m_engine.IsRunning()); }
+
+void ReplaceInFilesPanel::DoShowProgress()
+{
+    m_progress->SetValue(0);
+    if (!m_progress->IsShown()) {
+        m_progress->Show();
+        GetSizer()->Layout();
+    }
+    m_progressTimer.Start(100);
+}
+
+void ReplaceInFilesPanel::DoHideProgress()
+{
+    m_progressTimer.Stop();
+    m_progress->SetValue(0);
+    if (m_progress->IsShown()) {
+        m_progress->Hide();
+        GetSizer()->Layout();
+    }
+}
+
+void ReplaceInFilesPanel::OnProgressTimer(wxTimerEvent& e)
+{
+    size_t total = m_engine.GetTotal();
+    m_progress->SetRange(total ? (int)total : 1);
+    m_progress->SetValue((int)std::min(m_engine.GetCompleted(), total));
+}
 
 void ReplaceInFilesPanel::OnReplaceWithComboUI(wxUpdateUIEvent& e)
 {
-    e.Enable((m_sci->GetLength() > 0) && !m_searchInProgress);
+    e.Enable((m_sci->GetLength() > 0) && !m_searchInProgress && !m_engine.IsRunning());
 }
 
 void ReplaceInFilesPanel::OnHoldOpenUpdateUI(wxUpdateUIEvent& e)
@@ -25,10 +25,12 @@
 #ifndef __replaceinfilespanel__
 #define __replaceinfilespanel__
 
+#include "ReplaceInFilesEngine.h"
 #include "findresultstab.h"
 
 #include <wx/combobox.h>
 #include <wx/gauge.h>
+#include <wx/timer.h>
 
 class clThemedComboBox;
 class ReplaceInFilesPanel : public FindResultsTab
@@ -37,11 +39,27 @@ protected:
     wxComboBox* m_replaceWith;
     wxGauge* m_progress;
     wxArrayString m_filesModified;
+    wxArrayString m_editorFiles; // files with unsaved changes, replaced in their editor once the user confirmed
+    size_t m_editorReplacements = 0;
     bool m_bmpsForDarkTheme = false;
+    ReplaceInFilesEngine m_engine;
+    wxTimer m_progressTimer;
 
 protected:
-    void DoSaveResults(wxStyledTextCtrl* sci, MatchInfo_t::iterator begin, MatchInfo_t::iterator end);
-    wxStyledTextCtrl* DoGetEditor(const wxString& fileName);
+    /// replace the selected matches in an editor with unsaved changes
+    void DoReplaceInEditor(wxStyledTextCtrl* sci, MatchInfo_t::iterator begin, MatchInfo_t::iterator end);
+    /// replace the selected matches of `m_editorFiles` in their editor
+    void DoReplaceInEditors();
+    /// show the dry run summary, return true if the user confirmed the replace
+    bool DoConfirmReplace(size_t files, size_t replacements, size_t skipped);
+    void DoShowProgress();
+    void DoHideProgress();
+    /// mark the matches replaced on disk by the engine, or that it failed to replace
+    void DoMarkEngineResults();
+    /// reload the editors of `files` that have no unsaved changes
+    void DoReloadEditors(const wxArrayString& files);
+    /// remove the replaced matches from the view and notify about the modified files
+    void DoFinishReplace();
 
     /*
      * @brief get replacement text (regular expression backrefs applied)
@@ -57,10 +75,18 @@ protected:
     virtual void OnMarkAll(wxCommandEvent& e);
     virtual void OnUnmarkAll(wxCommandEvent& e);
     virtual void OnReplace(wxCommandEvent& e);
+    virtual void OnUndoReplace(wxCommandEvent& e);
+    virtual void OnStopSearch(wxCommandEvent& e);
+    void OnReplacePlanned(const ReplaceInFilesEngine::Summary& summary);
+    void OnReplaceWritten(bool cancelled);
+    void OnUndoDone(const wxArrayString& restored, const wxArrayString& skipped);
+    void OnProgressTimer(wxTimerEvent& e);
 
     virtual void OnMarkAllUI(wxUpdateUIEvent& e);
     virtual void OnUnmarkAllUI(wxUpdateUIEvent& e);
     virtual void OnReplaceUI(wxUpdateUIEvent& e);
+    virtual void OnUndoReplaceUI(wxUpdateUIEvent& e);
+    virtual void OnStopSearchUI(wxUpdateUIEvent& e);
     virtual void OnReplaceWithComboUI(wxUpdateUIEvent& e);
     virtual void OnHoldOpenUpdateUI(wxUpdateUIEvent& e);
     virtual void OnMouseDClick(wxStyledTextEvent& e);
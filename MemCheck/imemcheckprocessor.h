@@ -37,6 +37,8 @@
 
 #include "memcheckerror.h"
 
+#include <functional>
+
 class MemCheckSettings;
 
 /**
@@ -56,6 +58,7 @@ public:
     IMemCheckProcessor(MemCheckSettings* const settings)
         : m_settings(settings)
         , m_outputLogFileName(wxEmptyString)
+        , m_errorIndex()
         , m_errorList()
     {
     }
@@ -65,7 +68,18 @@ public:
 protected:
     MemCheckSettings* m_settings;
     wxString m_outputLogFileName;
+    MemCheckErrorIndex m_errorIndex; ///< declared before m_errorList, it owns strings used by the errors
     ErrorList m_errorList;
+    std::function<void()> m_errorsAddedCallback;
+
+    /**
+     * @brief Informs the UI that some errors were added to errorList while processing is still in progress.
+     */
+    void NotifyErrorsAdded()
+    {
+        if (m_errorsAddedCallback)
+            m_errorsAddedCallback();
+    }
 
 public:
     /**
@@ -74,6 +88,18 @@ public:
      */
     virtual ErrorList& GetErrors() { return m_errorList; };
 
+    /**
+     * @brief index of errorList, kept in sync by "Process"
+     * @return reference to index
+     */
+    virtual MemCheckErrorIndex& GetErrorIndex() { return m_errorIndex; };
+
+    /**
+     * @brief Sets function called periodically during "Process" when new errors are available.
+     * @param callback
+     */
+    void SetErrorsAddedCallback(const std::function<void()>& callback) { m_errorsAddedCallback = callback; }
+
     /**
      * @brief If tool uses temp file for error log, this function return its path.
      * @return log file name
@@ -95,6 +121,22 @@ public:
      * @brief Processes data from external tool (log file) to ErrorList.
      */
     virtual bool Process(const wxString& outputLogFileName = wxEmptyString) = 0;
+
+    /**
+     * @brief Prepares processing of the log while the tool is running. Must be called before GetExecutionCommand.
+     * @return false if the processor (or the system) doesn't support it, the log file is processed by "Process" then
+     */
+    virtual bool StartLive() { return false; }
+
+    /**
+     * @brief True between successful StartLive and StopLive
+     */
+    virtual bool IsLive() const { return false; }
+
+    /**
+     * @brief Tool has exited, processes the rest of its log
+     */
+    virtual void StopLive() {}
 };
 
 #endif //_IMEMCHECKPROCESSOR_H_
@@ -244,6 +244,7 @@ void MemCheckPlugin::ApplySettings(bool loadLastErrors)
 {
     wxDELETE(m_memcheckProcessor);
     m_memcheckProcessor = new ValgrindMemcheckProcessor(GetSettings());
+    m_memcheckProcessor->SetErrorsAddedCallback([this]() { m_outputView->UpdateErrors(); });
     if(loadLastErrors) {
         m_outputView->LoadErrors();
 
@@ -304,12 +305,24 @@ void MemCheckPlugin::CheckProject(const wxString& projectName)
     m_mgr->AppendOutputTabText(kOutputTab_Output, _("Launching MemCheck...\n"));
     m_mgr->AppendOutputTabText(kOutputTab_Output, wxString()
                                                       << _("Working directory is set to: ") << ::wxGetCwd() << "\n");
+    if(GetSettings()->GetValgrindSettings().GetLiveMode()) {
+        if(m_memcheckProcessor->StartLive()) {
+            // errors are shown as they are reported
+            m_outputView->LoadErrors();
+            SwitchToMyPage();
+        } else {
+            m_mgr->AppendOutputTabText(
+                kOutputTab_Output, _("MemCheck live mode is not available, errors are loaded when the program exits\n"));
+        }
+    }
+
     wxString cmd;
     wxString cmdArgs;
     m_memcheckProcessor->GetExecutionCommand(command, cmd, cmdArgs);
     m_mgr->AppendOutputTabText(kOutputTab_Output, wxString()
                                                       << _("MemCheck command: ") << command << " " << cmdArgs << "\n");
-    m_terminal.ExecuteConsole(cmd, true, cmdArgs, "", wxString::Format("MemCheck: %s", projectName));
+    if(!m_terminal.ExecuteConsole(cmd, true, cmdArgs, "", wxString::Format("MemCheck: %s", projectName)))
+        m_memcheckProcessor->StopLive();
 }
 
 void MemCheckPlugin::OnImportLog(wxCommandEvent& event)
@@ -360,6 +373,14 @@ void MemCheckPlugin::OnProcessOutput(clCommandEvent& event)
 void MemCheckPlugin::OnProcessTerminated(clCommandEvent& event)
 {
     m_mgr->AppendOutputTabText(kOutputTab_Output, _("\n-- MemCheck process completed\n"));
+    if(m_memcheckProcessor->IsLive()) {
+        // the log was already parsed while it was received
+        m_memcheckProcessor->StopLive();
+        m_outputView->LoadErrors();
+        SwitchToMyPage();
+        return;
+    }
+
     wxBusyInfo wait(BUSY_MESSAGE);
     m_mgr->GetTheApp()->Yield();
 
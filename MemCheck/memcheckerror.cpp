@@ -9,8 +9,22 @@
 
 #include "memcheckerror.h"
 
+namespace
+{
+const wxString EMPTY_STRING;
+}
+
+MemCheckErrorLocation::MemCheckErrorLocation()
+    : func(&EMPTY_STRING)
+    , file(&EMPTY_STRING)
+    , line(-1)
+    , obj(&EMPTY_STRING)
+{
+}
+
 bool MemCheckErrorLocation::operator==(const MemCheckErrorLocation & other) const
 {
+    // interned strings, equal content means equal pointers
     return func == other.func && file == other.file && line == other.line;
 }
 
@@ -21,19 +35,19 @@ bool MemCheckErrorLocation::operator!=(const MemCheckErrorLocation & other) cons
 
 const wxString MemCheckErrorLocation::toString() const
 {
-    return wxString::Format(wxT("%s\t%s\t%i\t%s"), func, file, line, obj);
+    return wxString::Format(wxT("%s\t%s\t%i\t%s"), *func, *file, line, *obj);
 }
 
 const wxString MemCheckErrorLocation::toText(const wxString & workspacePath) const
 {
-    return wxString::Format(wxT("%s   ( %s: %i )"), func, getFile(workspacePath), line);
+    return wxString::Format(wxT("%s   ( %s: %i )"), *func, getFile(workspacePath), line);
 }
 
 const wxString MemCheckErrorLocation::getFile(const wxString & workspacePath) const
 {
     wxString localPath;
-    if (workspacePath.IsEmpty() || !file.StartsWith(workspacePath, &localPath)) {
-        return file;
+    if (workspacePath.IsEmpty() || !file->StartsWith(workspacePath, &localPath)) {
+        return *file;
     } else {
         return localPath;
     }
@@ -42,8 +56,8 @@ const wxString MemCheckErrorLocation::getFile(const wxString & workspacePath) co
 const wxString MemCheckErrorLocation::getObj(const wxString & workspacePath) const
 {
     wxString localPath;
-    if (workspacePath.IsEmpty() || !obj.StartsWith(workspacePath, &localPath)) {
-        return obj;
+    if (workspacePath.IsEmpty() || !obj->StartsWith(workspacePath, &localPath)) {
+        return *obj;
     } else {
         return localPath;
     }
@@ -51,12 +65,12 @@ const wxString MemCheckErrorLocation::getObj(const wxString & workspacePath) con
 
 const bool MemCheckErrorLocation::isOutOfWorkspace(const wxString & workspacePath) const
 {
-    return !file.StartsWith(workspacePath);
+    return !file->StartsWith(workspacePath);
 }
 
 
 
-MemCheckError::MemCheckError(): suppressed(false) {}
+MemCheckError::MemCheckError(): type(TYPE_ERROR), suppressed(false) {}
 
 const wxString MemCheckError::toString() const
 {
@@ -113,7 +127,7 @@ const wxString MemCheckError::getSuppression()
 const bool MemCheckError::hasPath(const wxString& path) const
 {
     for (const auto& location : locations)
-        if (location.file.StartsWith(path))
+        if (location.file->StartsWith(path))
             return true;
     for (const auto& nestedError : nestedErrors)
         if (nestedError.hasPath(path))
@@ -123,6 +137,88 @@ const bool MemCheckError::hasPath(const wxString& path) const
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
+MemCheckErrorIndex::MemCheckErrorIndex()
+    : m_suppressedCount(0)
+{
+}
+
+const wxString* MemCheckErrorIndex::Intern(const wxString& str)
+{
+    if (str.IsEmpty())
+        return &EMPTY_STRING;
+    // node based container, pointers stay valid when it grows
+    return &*m_strings.insert(str).first;
+}
+
+void MemCheckErrorIndex::Add(MemCheckError& error)
+{
+    size_t position = m_errors.size();
+    m_errors.push_back(&error);
+    if (error.suppressed)
+        ++m_suppressedCount;
+    AddLocations(error, position);
+}
+
+void MemCheckErrorIndex::AddLocations(const MemCheckError& error, size_t position)
+{
+    for (const auto& location : error.locations) {
+        std::vector<size_t>& positions = m_fileErrors[location.file];
+        if (positions.empty() || positions.back() != position)
+            positions.push_back(position);
+    }
+    for (const auto& nestedError : error.nestedErrors)
+        AddLocations(nestedError, position);
+}
+
+void MemCheckErrorIndex::Clear()
+{
+    m_errors.clear();
+    m_fileErrors.clear();
+    m_strings.clear();
+    m_suppressedCount = 0;
+}
+
+void MemCheckErrorIndex::SetSuppressed(MemCheckError& error)
+{
+    if (!error.suppressed) {
+        error.suppressed = true;
+        ++m_suppressedCount;
+    }
+}
+
+size_t MemCheckErrorIndex::GetCount(bool omitSuppressed) const
+{
+    return omitSuppressed ? m_errors.size() - m_suppressedCount : m_errors.size();
+}
+
+void MemCheckErrorIndex::GetErrors(std::vector<MemCheckError*>& result, bool omitSuppressed) const
+{
+    result.reserve(result.size() + GetCount(omitSuppressed));
+    for (MemCheckError* error : m_errors)
+        if (!(omitSuppressed && error->suppressed))
+            result.push_back(error);
+}
+
+void MemCheckErrorIndex::GetErrorsByPath(std::vector<MemCheckError*>& result,
+                                         const wxString& path,
+                                         bool hasPath,
+                                         bool omitSuppressed) const
+{
+    // there are far less distinct files than errors, so test the files and mark their errors
+    std::vector<bool> inPath(m_errors.size(), false);
+    for (const auto& fileErrors : m_fileErrors)
+        if (fileErrors.first->StartsWith(path))
+            for (size_t position : fileErrors.second)
+                inPath[position] = true;
+
+    for (size_t position = 0; position < m_errors.size(); ++position) {
+        MemCheckError* error = m_errors[position];
+        if (inPath[position] == hasPath && !(omitSuppressed && error->suppressed))
+            result.push_back(error);
+    }
+}
+
+
 bool MemCheckIterTools::IterTool::isEqual(MemCheckError & lhs, MemCheckError & rhs) const
 {
     if (!(lhs.type == rhs.type && lhs.label == rhs.label))
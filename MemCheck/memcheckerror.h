@@ -40,8 +40,11 @@
 #include <wx/tokenzr.h>
 
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 #include "memcheckdefs.h"
+#include "wxStringHash.h"
 
 class MemCheckErrorLocation;
 class MemCheckError;
@@ -91,10 +94,15 @@ public:
 /**
  * @class MemCheckErrorLocation
  * @brief Represents on record from error stacktrace.
+ *
+ * Function, file and object names repeat in thousands of frames, so they point to strings interned by
+ * MemCheckErrorIndex instead of holding their own copies.
  */
 class MemCheckErrorLocation
 {
 public:
+    MemCheckErrorLocation();
+
     bool operator==(const MemCheckErrorLocation & other) const;
     bool operator!=(const MemCheckErrorLocation & other) const;
     
@@ -133,10 +141,10 @@ public:
      */
     const bool isOutOfWorkspace(const wxString & workspacePath) const;
 
-    wxString func;
-    wxString file;
+    const wxString* func; ///< interned, never NULL
+    const wxString* file; ///< interned, never NULL
     int line;
-    wxString obj;
+    const wxString* obj;  ///< interned, never NULL
 };
 
 
@@ -193,6 +201,79 @@ public:
 };
 
 
+/**
+ * @class MemCheckErrorIndex
+ * @brief Owns the strings shared by all locations and indexes the ErrorList by file and suppression state.
+ *
+ * The index is filled while the log is parsed, so filtering by path or hiding suppressed errors doesn't need to walk
+ * the whole ErrorList and all its locations again. Errors must be suppressed through SetSuppressed() to keep the
+ * counters valid.
+ */
+class MemCheckErrorIndex
+{
+    std::unordered_set<wxString> m_strings;
+    std::vector<MemCheckError*> m_errors;                                 ///< top level errors in log order
+    std::unordered_map<const wxString*, std::vector<size_t>> m_fileErrors; ///< file -> positions in m_errors
+    size_t m_suppressedCount;
+
+public:
+    MemCheckErrorIndex();
+
+    /**
+     * @brief Returns the shared copy of the string. It is valid until Clear() is called.
+     * @param str
+     * @return pointer to interned string, equal strings return the same pointer
+     */
+    const wxString* Intern(const wxString & str);
+
+    /**
+     * @brief Adds error (already stored in the ErrorList) to the index.
+     * @param error
+     */
+    void Add(MemCheckError & error);
+
+    /**
+     * @brief Forgets all errors and interned strings. Must be called when ErrorList is cleared.
+     */
+    void Clear();
+
+    /**
+     * @brief Marks error as suppressed
+     * @param error
+     */
+    void SetSuppressed(MemCheckError & error);
+
+    /**
+     * @brief Number of errors
+     * @param omitSuppressed do not count suppressed errors
+     * @return count
+     */
+    size_t GetCount(bool omitSuppressed) const;
+
+    /**
+     * @brief Collects errors in log order
+     * @param result
+     * @param omitSuppressed
+     */
+    void GetErrors(std::vector<MemCheckError*> & result, bool omitSuppressed) const;
+
+    /**
+     * @brief Collects errors according their file paths. Same as testing MemCheckError::hasPath() for each error.
+     * @param result
+     * @param path
+     * @param hasPath if true errors with a file in path are collected, if false errors without any file in path
+     * @param omitSuppressed
+     */
+    void GetErrorsByPath(std::vector<MemCheckError*> & result,
+                         const wxString & path,
+                         bool hasPath,
+                         bool omitSuppressed) const;
+
+private:
+    void AddLocations(const MemCheckError & error, size_t position);
+};
+
+
 /**
  * @brief flags to use with MemCheckIterTools
  */
@@ -107,6 +107,20 @@ void MemCheckOutputView::LoadErrors()
     ApplyFilterSupp(FILTER_CLEAR);
 }
 
+void MemCheckOutputView::UpdateErrors()
+{
+    if (m_totalErrorsView < m_plugin->GetSettings()->GetResultPageSize()) {
+        // first page is not full yet, show the new errors
+        LoadErrors();
+        return;
+    }
+
+    // user may already browse the results, only update the counters
+    ResetItemsView();
+    ResetItemsSupp();
+    UpdateStatusSupp();
+}
+
 void MemCheckOutputView::ResetItemsView()
 {
     ErrorList& errorList = m_plugin->GetProcessor()->GetErrors();
@@ -119,11 +133,16 @@ void MemCheckOutputView::ResetItemsView()
     if (m_plugin->GetSettings()->GetOmitSuppressed())
         flags |= MC_IT_OMIT_SUPPRESSED;
 
-    m_totalErrorsView = 0;
-    for (MemCheckIterTools::ErrorListIterator it = MemCheckIterTools::Factory(errorList, m_workspacePath, flags);
-         it != errorList.end();
-         ++it) {
-        ++m_totalErrorsView;
+    if (flags & MC_IT_OMIT_DUPLICATIONS) {
+        m_totalErrorsView = 0;
+        for (MemCheckIterTools::ErrorListIterator it = MemCheckIterTools::Factory(errorList, m_workspacePath, flags);
+             it != errorList.end();
+             ++it) {
+            ++m_totalErrorsView;
+        }
+    } else {
+        // other flags don't hide errors, only the suppressed ones which are counted by the index
+        m_totalErrorsView = m_plugin->GetProcessor()->GetErrorIndex().GetCount(flags & MC_IT_OMIT_SUPPRESSED);
     }
 
     if (m_totalErrorsView)
@@ -142,17 +161,8 @@ void MemCheckOutputView::ResetItemsView()
 
 void MemCheckOutputView::ResetItemsSupp()
 {
-    ErrorList& errorList = m_plugin->GetProcessor()->GetErrors();
-
-    size_t iterFlags = 0;
-    if (m_plugin->GetSettings()->GetOmitSuppressed())
-        iterFlags |= MC_IT_OMIT_SUPPRESSED;
-
-    m_totalErrorsSupp = 0;
-    for (MemCheckIterTools::ErrorListIterator it = MemCheckIterTools::Factory(errorList, wxEmptyString, iterFlags);
-         it != errorList.end();
-         ++it)
-        ++m_totalErrorsSupp;
+    m_totalErrorsSupp =
+        m_plugin->GetProcessor()->GetErrorIndex().GetCount(m_plugin->GetSettings()->GetOmitSuppressed());
 
     m_lastToolTipItem = wxNOT_FOUND;
 }
@@ -258,7 +268,7 @@ void MemCheckOutputView::AddTree(const wxDataViewItem& parentItem, MemCheckError
         cols.clear();
         cols.push_back(variantBitmap);
         cols.push_back(wxVariant(false));
-        cols.push_back(MemCheckDVCErrorsModel::CreateIconTextVariant(location.func, bmpLocation));
+        cols.push_back(MemCheckDVCErrorsModel::CreateIconTextVariant(*location.func, bmpLocation));
         cols.push_back(wxVariant(location.getFile(m_workspacePath)));
 
         wxString strLine;
@@ -268,7 +278,7 @@ void MemCheckOutputView::AddTree(const wxDataViewItem& parentItem, MemCheckError
         m_dataViewCtrlErrorsModel->AppendItem(
             errorItem,
             cols,
-            ((location.line > 0 && !location.file.IsEmpty()) ? new MemCheckErrorLocationReferrer(location) : NULL));
+            ((location.line > 0 && !location.file->IsEmpty()) ? new MemCheckErrorLocationReferrer(location) : NULL));
     }
 }
 
@@ -735,6 +745,7 @@ void MemCheckOutputView::UpdateStatusSupp()
 
 void MemCheckOutputView::SuppressErrors(unsigned int mode, wxDataViewItem* dvItem)
 {
+    MemCheckErrorIndex& errorIndex = m_plugin->GetProcessor()->GetErrorIndex();
     if (m_mgr->OpenFile(m_choiceSuppFile->GetStringSelection())) {
         IEditor* editor = m_mgr->GetActiveEditor();
         if (editor) {
@@ -751,7 +762,7 @@ void MemCheckOutputView::SuppressErrors(unsigned int mode, wxDataViewItem* dvIte
                 if (!errorRef)
                     break;
                 editor->AppendText(wxString::Format("\n%s", errorRef->Get().getSuppression()));
-                errorRef->Get().suppressed = true;
+                errorIndex.SetSuppressed(errorRef->Get());
             } break;
 
             case SUPPRESS_CHECKED: {
@@ -770,7 +781,7 @@ void MemCheckOutputView::SuppressErrors(unsigned int mode, wxDataViewItem* dvIte
                         errorRef =
                             dynamic_cast<MemCheckErrorReferrer*>(m_dataViewCtrlErrorsModel->GetClientObject(item));
                         editor->AppendText(wxString::Format("\n%s", errorRef->Get().getSuppression()));
-                        errorRef->Get().suppressed = true;
+                        errorIndex.SetSuppressed(errorRef->Get());
                     }
                 }
             } break;
@@ -778,7 +789,7 @@ void MemCheckOutputView::SuppressErrors(unsigned int mode, wxDataViewItem* dvIte
             case SUPPRESS_ALL:
                 for (size_t item = 0; item < m_filterResults.size(); ++item) {
                     editor->AppendText(wxString::Format("\n%s", m_filterResults[item]->getSuppression()));
-                    m_filterResults[item]->suppressed = true;
+                    errorIndex.SetSuppressed(*m_filterResults[item]);
                 }
                 break;
 
@@ -789,7 +800,7 @@ void MemCheckOutputView::SuppressErrors(unsigned int mode, wxDataViewItem* dvIte
                     if (item == -1)
                         break;
                     editor->AppendText(wxString::Format("\n%s", m_filterResults[item]->getSuppression()));
-                    m_filterResults[item]->suppressed = true;
+                    errorIndex.SetSuppressed(*m_filterResults[item]);
                 }
                 break;
             }
@@ -826,6 +837,7 @@ void MemCheckOutputView::ApplyFilterSupp(unsigned int mode)
 {
     // CL_DEBUG1(PLUGIN_PREFIX("MemCheckOutputView::ApplyFilterSupp()"));
     ErrorList& errorList = m_plugin->GetProcessor()->GetErrors();
+    MemCheckErrorIndex& errorIndex = m_plugin->GetProcessor()->GetErrorIndex();
 
     // change filter type
     if (mode == FILTER_STRING && m_searchCtrlFilter->GetValue().IsSameAs(wxT(FILTER_NONWORKSPACE_PLACEHOLDER)))
@@ -843,10 +855,7 @@ void MemCheckOutputView::ApplyFilterSupp(unsigned int mode)
     switch (mode) {
     case FILTER_CLEAR:
         m_searchCtrlFilter->Clear();
-        for (MemCheckIterTools::ErrorListIterator it = MemCheckIterTools::Factory(errorList, wxEmptyString, iterFlags);
-             it != errorList.end();
-             ++it)
-            m_filterResults.push_back(&*it);
+        errorIndex.GetErrors(m_filterResults, iterFlags & MC_IT_OMIT_SUPPRESSED);
         m_totalErrorsSupp = m_filterResults.size();
         m_checkBoxInvert->SetValue(false);
         m_checkBoxCase->SetValue(false);
@@ -857,12 +866,8 @@ void MemCheckOutputView::ApplyFilterSupp(unsigned int mode)
     case FILTER_WORKSPACE:
         m_searchCtrlFilter->SetValue(wxT(FILTER_NONWORKSPACE_PLACEHOLDER));
         m_searchCtrlFilter->SelectAll();
-        for (MemCheckIterTools::ErrorListIterator it = MemCheckIterTools::Factory(errorList, wxEmptyString, iterFlags);
-             it != errorList.end();
-             ++it) {
-            if (m_checkBoxInvert->IsChecked() == (*it).hasPath(m_workspacePath))
-                m_filterResults.push_back(&*it);
-        }
+        errorIndex.GetErrorsByPath(
+            m_filterResults, m_workspacePath, m_checkBoxInvert->IsChecked(), iterFlags & MC_IT_OMIT_SUPPRESSED);
         break;
 
     case FILTER_STRING:
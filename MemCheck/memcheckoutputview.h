@@ -160,7 +160,7 @@ protected:
     std::vector<MemCheckError *> m_filterResults; ///< Contetn of wxListCtrl.
     long m_lastToolTipItem; ///< On hover over wxListCtrl tooltip is shown. It is refreshed only if user hovers another item, not if moves by one pixel.
 
-    void ApplyFilterSupp(unsigned int mode); ///< Performs filtering errors. Searches in whole ErrorList structure. Mode is FILTER_CLEAR | FILTER_STRING | FILTER_WORKSPACE.
+    void ApplyFilterSupp(unsigned int mode); ///< Performs filtering errors. FILTER_STRING searches in whole ErrorList structure, FILTER_CLEAR and FILTER_WORKSPACE use MemCheckErrorIndex. Mode is FILTER_CLEAR | FILTER_STRING | FILTER_WORKSPACE.
     void UpdateStatusSupp(); ///< Shows number of error total / filtered /selected
     void ListCtrlErrorsShowTip(long item); ///< Sets proper tooltip for wxListCtrl. Item is index in m_filterResults.
 
@@ -171,6 +171,12 @@ public:
      * MemCheck plugin calls this method after test ends and after processor parses logfile into ErrorList.
      */
     void LoadErrors();
+    /**
+     * @brief Processor found new errors while it is still parsing the log
+     *
+     * Loads the errors while the first page is not complete, later only updates the number of errors and pages.
+     */
+    void UpdateErrors();
     /**
      * @brief clear the content
      */
@@ -16,7 +16,8 @@ ValgrindSettings::ValgrindSettings():clConfigItem(CONFIG_ITEM_NAME_VALGRIND),
     m_suppressionFileOption(VALGRIND_SUPPRESSION_FILE_OPTION),
     m_options(VALGRIND_OPTIONS),
     m_suppFileInPrivateFolder(VALGRIND_SUPP_FILE_IN_PRIVATE_FOLDER),
-    m_suppFiles()
+    m_suppFiles(),
+    m_liveMode(VALGRIND_LIVE_MODE)
 {
 }
 
@@ -32,6 +33,7 @@ void ValgrindSettings::FromJSON(const JSONItem & json)
     if (json.hasNamedObject("m_options")) m_options = json.namedObject("m_options").toString();
     if (json.hasNamedObject("m_suppFileInPrivateFolder")) m_suppFileInPrivateFolder = json.namedObject("m_suppFileInPrivateFolder").toBool();
     if (json.hasNamedObject("m_suppFiles")) m_suppFiles = json.namedObject("m_suppFiles").toArrayString();
+    if (json.hasNamedObject("m_liveMode")) m_liveMode = json.namedObject("m_liveMode").toBool();
 }
 
 JSONItem ValgrindSettings::ToJSON() const
@@ -46,6 +48,7 @@ JSONItem ValgrindSettings::ToJSON() const
     element.addProperty("m_options", m_options);
     element.addProperty("m_suppFileInPrivateFolder", m_suppFileInPrivateFolder);
     element.addProperty("m_suppFiles", m_suppFiles);
+    element.addProperty("m_liveMode", m_liveMode);
     return element;
 }
 
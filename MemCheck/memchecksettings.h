@@ -48,6 +48,8 @@
 #define VALGRIND_SUPPRESSION_FILE_OPTION "--suppressions"
 #define VALGRIND_OPTIONS "--leak-check=yes --track-origins=yes"
 #define VALGRIND_SUPP_FILE_IN_PRIVATE_FOLDER true
+#define VALGRIND_XML_SOCKET_OPTION "--xml-socket"
+#define VALGRIND_LIVE_MODE true
 
 #define CONFIG_ITEM_NAME_MEMCHECK "MemCheck"
 #define RESULT_PAGE_SIZE 50
@@ -81,6 +83,7 @@ private:
     wxString m_options;
     bool m_suppFileInPrivateFolder;
     wxArrayString m_suppFiles;
+    bool m_liveMode;
 
 public:
     void SetBinary(const wxString & binary) {
@@ -138,6 +141,15 @@ public:
     const wxArrayString& GetSuppFiles() const {
         return m_suppFiles;
     }
+    /**
+     * @brief Valgrind sends its xml log through a local socket and errors are shown while the program is running
+     */
+    void SetLiveMode(bool liveMode) {
+        m_liveMode = liveMode;
+    }
+    bool GetLiveMode() const {
+        return m_liveMode;
+    }
 };
 
 
@@ -32,6 +32,7 @@ MemCheckSettingsDialog::MemCheckSettingsDialog(wxWindow* parent, MemCheckSetting
     m_filePickerValgrindBinary->SetPath(m_settings->GetValgrindSettings().GetBinary());
     m_checkBoxOutputInPrivateFolder->SetValue(m_settings->GetValgrindSettings().GetOutputInPrivateFolder());
     m_filePickerValgrindOutputFile->SetPath(m_settings->GetValgrindSettings().GetOutputFile());
+    m_checkBoxLiveMode->SetValue(m_settings->GetValgrindSettings().GetLiveMode());
     m_textCtrlValgrindMandatoryOptions->ChangeValue(
         wxString::Format("%s %s=<file> %s=<file> ...",
                          m_settings->GetValgrindSettings().GetMandatoryOptions(),
@@ -71,6 +72,7 @@ void MemCheckSettingsDialog::OnOK(wxCommandEvent& event)
     m_settings->GetValgrindSettings().SetBinary(m_filePickerValgrindBinary->GetPath());
     m_settings->GetValgrindSettings().SetOutputInPrivateFolder(m_checkBoxOutputInPrivateFolder->GetValue());
     m_settings->GetValgrindSettings().SetOutputFile(m_filePickerValgrindOutputFile->GetPath());
+    m_settings->GetValgrindSettings().SetLiveMode(m_checkBoxLiveMode->GetValue());
     m_settings->GetValgrindSettings().SetOptions(m_textCtrlValgrindOptions->GetValue());
     m_settings->GetValgrindSettings().SetSuppFileInPrivateFolder(m_checkBoxSuppFileInPrivateFolder->GetValue());
     m_settings->GetValgrindSettings().SetSuppFiles(m_listBoxSuppFiles->GetStrings());
@@ -714,6 +714,12 @@ MemCheckSettingsDialogBase::MemCheckSettingsDialogBase(wxWindow* parent, wxWindo
     
     staticBoxSizer432->Add(m_filePickerValgrindOutputFile, 0, wxALL|wxEXPAND, WXC_FROM_DIP(5));
     
+    m_checkBoxLiveMode = new wxCheckBox(m_panel669, wxID_ANY, _("Show the errors while the program runs"), wxDefaultPosition, wxDLG_UNIT(m_panel669, wxSize(-1,-1)), 0);
+    m_checkBoxLiveMode->SetValue(true);
+    m_checkBoxLiveMode->SetToolTip(_("Read the output of Valgrind while the program runs, and show the errors as soon as they are reported.\nWhen unchecked, the output is processed once the program exits."));
+    
+    boxSizer673->Add(m_checkBoxLiveMode, 0, wxALL, WXC_FROM_DIP(5));
+    
     m_panel671 = new wxPanel(m_treebook251, wxID_ANY, wxDefaultPosition, wxDLG_UNIT(m_treebook251, wxSize(-1,-1)), wxTAB_TRAVERSAL);
     m_treebook251->InsertSubPage(1, m_panel671, _("Suppression"), false, wxNOT_FOUND);
     
@@ -253,6 +253,7 @@ protected:
     wxBitmapButton* m_bmpButton341;
     wxCheckBox* m_checkBoxOutputInPrivateFolder;
     wxFilePickerCtrl* m_filePickerValgrindOutputFile;
+    wxCheckBox* m_checkBoxLiveMode;
     wxPanel* m_panel671;
     wxCheckBox* m_checkBoxSuppFileInPrivateFolder;
     wxListBox* m_listBoxSuppFiles;
@@ -286,6 +287,7 @@ public:
     wxBitmapButton* GetBmpButton341() { return m_bmpButton341; }
     wxCheckBox* GetCheckBoxOutputInPrivateFolder() { return m_checkBoxOutputInPrivateFolder; }
     wxFilePickerCtrl* GetFilePickerValgrindOutputFile() { return m_filePickerValgrindOutputFile; }
+    wxCheckBox* GetCheckBoxLiveMode() { return m_checkBoxLiveMode; }
     wxPanel* GetPanel669() { return m_panel669; }
     wxCheckBox* GetCheckBoxSuppFileInPrivateFolder() { return m_checkBoxSuppFileInPrivateFolder; }
     wxListBox* GetListBoxSuppFiles() { return m_listBoxSuppFiles; }
@@ -0,0 +1,138 @@
+/**
+ * @file
+ * @copyright GNU General Public License v2
+ */
+
+#include "valgrindlivereader.h"
+
+#include "file_logger.h"
+
+#include <chrono>
+#include <vector>
+#include <wx/ffile.h>
+
+namespace
+{
+constexpr size_t READ_CHUNK_SIZE = 64 * 1024;
+constexpr long POLL_INTERVAL_MS = 100;
+constexpr auto POST_INTERVAL = std::chrono::milliseconds(250);
+// after Stop() the log is read until Valgrind closes the connection, but not forever
+constexpr auto DRAIN_TIMEOUT = std::chrono::seconds(2);
+} // namespace
+
+ValgrindLiveReader::ValgrindLiveReader(const wxString& logFileName, const DataCallback_t& callback)
+    : m_logFileName(logFileName)
+    , m_callback(callback)
+    , m_stop(false)
+    , m_posted(false)
+{
+}
+
+ValgrindLiveReader::~ValgrindLiveReader() { Stop(); }
+
+int ValgrindLiveReader::Start()
+{
+    int port = wxNOT_FOUND;
+    try {
+        port = m_server.Start("tcp://127.0.0.1:0");
+    } catch (const clSocketException& e) {
+        clWARNING() << "MemCheck: failed to create server for Valgrind's xml log:" << e.what() << endl;
+        return wxNOT_FOUND;
+    }
+
+    m_stop = false;
+    m_thread = std::thread(&ValgrindLiveReader::ReaderMain, this);
+    return port;
+}
+
+void ValgrindLiveReader::Stop()
+{
+    if (!m_thread.joinable())
+        return;
+
+    m_stop = true;
+    m_thread.join();
+    OnData();
+}
+
+void ValgrindLiveReader::ReaderMain()
+{
+    using clock = std::chrono::steady_clock;
+
+    wxFFile logFile;
+    if (!m_logFileName.IsEmpty() && !logFile.Open(m_logFileName, "wb"))
+        clWARNING() << "MemCheck: failed to open log file" << m_logFileName << endl;
+
+    try {
+        clSocketBase::Ptr_t connection;
+        while (!connection) {
+            if (m_server.SelectReadMS(POLL_INTERVAL_MS) == clSocketBase::kSuccess)
+                connection = m_server.WaitForNewConnection();
+            else if (m_stop)
+                return; // Valgrind never connected
+        }
+        clDEBUG() << "MemCheck: Valgrind connected to the xml socket" << endl;
+
+        std::vector<char> buffer(READ_CHUNK_SIZE);
+        auto lastPost = clock::now();
+        auto drainDeadline = clock::time_point::max();
+        while (true) {
+            if (m_stop && drainDeadline == clock::time_point::max())
+                drainDeadline = clock::now() + DRAIN_TIMEOUT;
+
+            if (connection->SelectReadMS(POLL_INTERVAL_MS) == clSocketBase::kTimeout) {
+                if (m_stop)
+                    break;
+                PostData();
+                lastPost = clock::now();
+                continue;
+            }
+
+            size_t count = 0;
+            if (connection->Read(buffer.data(), buffer.size(), count) != clSocketBase::kSuccess || count == 0)
+                continue;
+
+            if (logFile.IsOpened())
+                logFile.Write(buffer.data(), count);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_data.append(buffer.data(), count);
+            }
+
+            auto now = clock::now();
+            if (now >= drainDeadline) {
+                clWARNING() << "MemCheck: Valgrind is still sending its log, stop reading it" << endl;
+                break;
+            }
+            if (now - lastPost >= POST_INTERVAL) {
+                PostData();
+                lastPost = now;
+            }
+        }
+    } catch (const clSocketException& e) {
+        // Read() throws when Valgrind closes the connection, this is how the log normally ends
+        clDEBUG() << "MemCheck: xml socket closed:" << e.what() << endl;
+    }
+    PostData();
+}
+
+void ValgrindLiveReader::PostData()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_data.empty() || m_posted)
+        return;
+    m_posted = true;
+    CallAfter(&ValgrindLiveReader::OnData);
+}
+
+void ValgrindLiveReader::OnData()
+{
+    std::string data;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        data.swap(m_data);
+        m_posted = false;
+    }
+    if (!data.empty())
+        m_callback(data);
+}
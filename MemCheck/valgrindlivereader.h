@@ -0,0 +1,73 @@
+/**
+ * @file
+ * @copyright GNU General Public License v2
+ *
+ * @brief ValgrindLiveReader - receives Valgrind's xml log while the checked program is running.
+ */
+
+#ifndef _VALGRINDLIVEREADER_H_
+#define _VALGRINDLIVEREADER_H_
+
+#include "SocketAPI/clSocketServer.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <wx/event.h>
+
+/**
+ * @class ValgrindLiveReader
+ * @brief Local server for Valgrind's '--xml-socket' option.
+ *
+ * Valgrind connects to the server when the checked program starts. The log is read on a secondary thread, copied to
+ * a log file (so it can be imported later) and passed in chunks to the main thread. Chunks are delivered at most a few
+ * times per second, so a program reporting thousands of errors doesn't flood the UI with updates.
+ */
+class ValgrindLiveReader : public wxEvtHandler
+{
+public:
+    using DataCallback_t = std::function<void(const std::string&)>;
+
+    /**
+     * @brief ctor
+     * @param logFileName copy of the received log is written here
+     * @param callback called on the main thread with the received data
+     */
+    ValgrindLiveReader(const wxString& logFileName, const DataCallback_t& callback);
+    ~ValgrindLiveReader() override;
+
+    /**
+     * @brief Starts listening on a free local port and the reader thread
+     * @return the port for '--xml-socket' or wxNOT_FOUND if the server can't be created
+     */
+    int Start();
+
+    /**
+     * @brief Waits until the rest of the log is received (Valgrind already exited) and delivers it synchronously
+     */
+    void Stop();
+
+protected:
+    void ReaderMain();
+    void OnData();
+
+    /**
+     * @brief Called on the reader thread, queues OnData() if there is anything to deliver
+     */
+    void PostData();
+
+private:
+    wxString m_logFileName;
+    DataCallback_t m_callback;
+    clSocketServer m_server;
+    std::thread m_thread;
+    std::atomic_bool m_stop;
+
+    std::mutex m_mutex;
+    std::string m_data; ///< received, not delivered yet
+    bool m_posted;      ///< OnData() is queued
+};
+
+#endif // _VALGRINDLIVEREADER_H_
@@ -10,16 +10,34 @@
 #include "file_logger.h"
 #include "memcheckdefs.h"
 #include "memchecksettings.h"
+#include "valgrindlivereader.h"
+#include "valgrindxmlparser.h"
 #include "workspace.h"
 
+#include <vector>
+#include <wx/ffile.h>
 #include <wx/stdpaths.h>
+#include <wx/stopwatch.h>
 #include <wx/textfile.h>
 
+namespace
+{
+constexpr size_t READ_CHUNK_SIZE = 1024 * 1024;
+constexpr long NOTIFY_INTERVAL_MS = 500;
+} // namespace
+
 ValgrindMemcheckProcessor::ValgrindMemcheckProcessor(MemCheckSettings* const settings)
     : IMemCheckProcessor(settings)
 {
 }
 
+ValgrindMemcheckProcessor::~ValgrindMemcheckProcessor()
+{
+    // the UI may be already gone, don't announce the rest of the log
+    m_errorsAddedCallback = nullptr;
+    StopLive();
+}
+
 wxArrayString ValgrindMemcheckProcessor::GetSuppressionFiles()
 {
     wxArrayString suppFiles = m_settings->GetValgrindSettings().GetSuppFiles();
@@ -33,8 +51,7 @@ wxArrayString ValgrindMemcheckProcessor::GetSuppressionFiles()
     return suppFiles;
 }
 
-void ValgrindMemcheckProcessor::GetExecutionCommand(const wxString& originalCommand, wxString& command,
-                                                    wxString& command_args)
+void ValgrindMemcheckProcessor::UpdateOutputLogFileName()
 {
     m_outputLogFileName = m_settings->GetValgrindSettings().GetOutputFile();
     if(m_settings->GetValgrindSettings().GetOutputInPrivateFolder() && m_outputLogFileName.IsEmpty())
@@ -46,6 +63,21 @@ void ValgrindMemcheckProcessor::GetExecutionCommand(const wxString& originalComm
                 m_outputLogFileName =
                     wxFileName(clStandardPaths::Get().GetTempDir(), "valgrind.memcheck.log.xml").GetFullPath();
         }
+}
+
+void ValgrindMemcheckProcessor::GetExecutionCommand(const wxString& originalCommand, wxString& command,
+                                                    wxString& command_args)
+{
+    // in live mode the log file name is already used by the reader
+    if(!IsLive())
+        UpdateOutputLogFileName();
+
+    wxString output;
+    if(IsLive())
+        output = wxString::Format("%s=127.0.0.1:%d", VALGRIND_XML_SOCKET_OPTION, m_livePort);
+    else
+        output =
+            wxString::Format("%s=%s", m_settings->GetValgrindSettings().GetOutputFileOption(), m_outputLogFileName);
 
     wxString suppressions;
     for (const auto& suppressionFile : GetSuppressionFiles())
@@ -53,10 +85,8 @@ void ValgrindMemcheckProcessor::GetExecutionCommand(const wxString& originalComm
             wxString::Format(" %s=%s", m_settings->GetValgrindSettings().GetSuppressionFileOption(), suppressionFile));
 
     command = m_settings->GetValgrindSettings().GetBinary();
-    command_args = wxString::Format(
-        "%s %s %s %s %s", m_settings->GetValgrindSettings().GetMandatoryOptions(),
-        wxString::Format("%s=%s", m_settings->GetValgrindSettings().GetOutputFileOption(), m_outputLogFileName),
-        suppressions, m_settings->GetValgrindSettings().GetOptions(), originalCommand);
+    command_args = wxString::Format("%s %s %s %s %s", m_settings->GetValgrindSettings().GetMandatoryOptions(), output,
+                                    suppressions, m_settings->GetValgrindSettings().GetOptions(), originalCommand);
 }
 
 bool ValgrindMemcheckProcessor::Process(const wxString& outputLogFileName)
@@ -66,136 +96,102 @@ bool ValgrindMemcheckProcessor::Process(const wxString& outputLogFileName)
     if(!outputLogFileName.IsEmpty())
         m_outputLogFileName = outputLogFileName;
 
-    wxXmlDocument doc;
-    if(!doc.Load(m_outputLogFileName) || doc.GetRoot()->GetName() != wxT("valgrindoutput")) {
+    wxFFile file(m_outputLogFileName, "rb");
+    if(!file.IsOpened()) {
         return false;
     }
     m_errorList.clear();
-
-    int i = 0;
-    wxXmlNode* errorNode = doc.GetRoot()->GetChildren();
-    while(errorNode) {
-        if(errorNode->GetName() == wxT("error")) {
-            m_errorList.push_back(ProcessError(doc, errorNode));
-        }
-        errorNode = errorNode->GetNext();
-
-        if(i < 1000)
-            i++;
-        else {
-            i = 0;
+    m_errorIndex.Clear();
+
+    // the log is parsed as it is read, errors are available before the whole file is processed
+    ValgrindXmlParser parser(m_errorList, m_errorIndex);
+    std::vector<char> buffer(READ_CHUNK_SIZE);
+    size_t notifiedCount = 0;
+    wxStopWatch notifyTimer;
+    while(!file.Eof()) {
+        size_t count = file.Read(buffer.data(), buffer.size());
+        if(count == 0 || !parser.Feed(buffer.data(), count))
+            break;
+
+        if(notifyTimer.Time() >= NOTIFY_INTERVAL_MS) {
+            notifyTimer.Start();
+            if(parser.GetErrorsCount() != notifiedCount) {
+                notifiedCount = parser.GetErrorsCount();
+                NotifyErrorsAdded();
+            }
             // ATTN  m_mgr->GetTheApp()
             wxTheApp->Yield();
         }
     }
+
+    if(!parser.IsValid()) {
+        return false;
+    }
+    if(!parser.IsComplete()) {
+        // Valgrind was killed or is still running, show what we have
+        clWARNING() << "MemCheck: log file" << m_outputLogFileName << "is incomplete," << parser.GetErrorsCount()
+                    << "errors loaded" << endl;
+    }
     return true;
 }
 
-MemCheckError ValgrindMemcheckProcessor::ProcessError(wxXmlDocument& doc, wxXmlNode* errorNode)
+bool ValgrindMemcheckProcessor::StartLive()
 {
-    // CL_DEBUG1(PLUGIN_PREFIX("ValgrindMemcheckProcessor::ProcessError()"));
-
-    bool auxiliary = false;
-    MemCheckError result;
-    result.type = MemCheckError::TYPE_ERROR;
-    MemCheckError auxiliaryResult;
-
-    wxXmlNode* suberrorNode = errorNode->GetChildren();
-    while(suberrorNode) {
-
-        // retrieving error label
-        if(suberrorNode->GetName() == wxT("what")) {
-            result.label = suberrorNode->GetNodeContent();
-        } else if(suberrorNode->GetName() == wxT("xwhat")) {
-            wxXmlNode* child = suberrorNode->GetChildren();
-            while(child) {
-                if(child->GetName() == wxT("text")) {
-                    result.label = child->GetNodeContent();
-                    break;
-                }
-                child = child->GetNext();
-            }
-        } else if(suberrorNode->GetName() == wxT("auxwhat")) {
-            auxiliaryResult.label = suberrorNode->GetNodeContent();
-            auxiliaryResult.type = MemCheckError::TYPE_AUXILIARY;
-            auxiliary = true;
-        } else if(suberrorNode->GetName() == wxT("stack")) {
-            wxXmlNode* locationNode = suberrorNode->GetChildren();
-            while(locationNode) {
-                if(locationNode->GetName() == wxT("frame")) {
-                    if(auxiliary) {
-                        auxiliaryResult.locations.push_back(ProcessLocation(doc, locationNode));
-                    } else {
-                        result.locations.push_back(ProcessLocation(doc, locationNode));
-                    }
-                }
-                locationNode = locationNode->GetNext();
-            }
-        } else if(suberrorNode->GetName() == wxT("suppression")) {
-            wxXmlNode* child = suberrorNode->GetChildren();
-            while(child) {
-                if(child->GetName() == wxT("rawtext")) {
-                    result.suppression = child->GetNodeContent();
-                    break;
-                }
-                child = child->GetNext();
-            }
-        }
-        suberrorNode = suberrorNode->GetNext();
-    }
-
-    if(!result.suppression)
-        result.suppression = wxT("#Suppresion pattern not present in output log.\n#This plugin requires Valgrind to be "
-                                 "run with '--gen-suppressions=all' option");
-
-    if(auxiliary)
-        result.nestedErrors.push_back(auxiliaryResult);
-
-    // TODO ? add checout ?
-    // add check for empty locationArrays
-    //  CL_DEBUG1(PLUGIN_PREFIX("\t equal #0 and #1 = %s", (errorArray.Item(0) == errorArray.Item(1)?"true":"false") ));
-    //  CL_DEBUG1(PLUGIN_PREFIX("\t equal #1 and #2 = %s", (*(errorArray.Item(2)) ==
-    //  *(errorArray.Item(1))?"true":"false") )); CL_DEBUG1(PLUGIN_PREFIX("\t equal #2 and #3 = %s", (errorArray.Item(2)
-    //  == errorArray.Item(3)?"true":"false") ));
+    StopLive();
+    UpdateOutputLogFileName();
 
-    // check if required fields was found
-    //  CL_ERROR1(PLUGIN_PREFIX("Broken input, tag <what> or <xwhat> not found, can't continue!"));
-    //  CL_ERROR1(PLUGIN_PREFIX("Broken input, tag <stack> not found, can't continue!"));
-    return result;
+    m_errorList.clear();
+    m_errorIndex.Clear();
+    m_liveParser.reset(new ValgrindXmlParser(m_errorList, m_errorIndex));
+    // a bug hit in a loop would flood the view while the program is running
+    m_liveParser->SetDeduplicate(true);
+
+    m_liveReader.reset(
+        new ValgrindLiveReader(m_outputLogFileName, [this](const std::string& data) { OnLiveData(data); }));
+    m_livePort = m_liveReader->Start();
+    if(m_livePort == wxNOT_FOUND) {
+        m_liveReader.reset();
+        m_liveParser.reset();
+        return false;
+    }
+    clDEBUG() << "MemCheck: waiting for Valgrind's xml log on port" << m_livePort << endl;
+    return true;
 }
 
-MemCheckErrorLocation ValgrindMemcheckProcessor::ProcessLocation(wxXmlDocument& doc, wxXmlNode* locationNode)
+void ValgrindMemcheckProcessor::StopLive()
 {
-    // CL_DEBUG1(PLUGIN_PREFIX("ValgrindMemcheckProcessor::ProcessLocation()"));
-
-    MemCheckErrorLocation result;
-    result.line = -1;
-    wxString file;
-    wxString dir;
-
-    wxXmlNode* subframeNode = locationNode->GetChildren();
-    while(subframeNode) {
-
-        if(subframeNode->GetName() == wxT("ip")) {
-            // ignoring
-        } else if(subframeNode->GetName() == wxT("obj")) {
-            result.obj = subframeNode->GetNodeContent();
-        } else if(subframeNode->GetName() == wxT("fn")) {
-            result.func = subframeNode->GetNodeContent();
-        } else if(subframeNode->GetName() == wxT("dir")) {
-            dir = subframeNode->GetNodeContent();
-        } else if(subframeNode->GetName() == wxT("file")) {
-            file = subframeNode->GetNodeContent();
-        } else if(subframeNode->GetName() == wxT("line")) {
-            result.line = wxAtoi(subframeNode->GetNodeContent());
-        }
-        subframeNode = subframeNode->GetNext();
+    if(!m_liveReader)
+        return;
+
+    // delivers the rest of the log
+    m_liveReader->Stop();
+    m_liveReader.reset();
+    m_livePort = wxNOT_FOUND;
+    if(!m_liveParser)
+        return;
+
+    if(!m_liveParser->IsComplete()) {
+        // Valgrind was killed, show what we have
+        clWARNING() << "MemCheck: Valgrind's xml log is incomplete," << m_liveParser->GetErrorsCount()
+                    << "errors loaded" << endl;
     }
+    clDEBUG() << "MemCheck:" << m_liveParser->GetErrorsCount() << "errors received,"
+              << m_liveParser->GetDuplicatesCount() << "duplicates dropped" << endl;
+    m_liveParser.reset();
+}
 
-    if(!dir.IsEmpty() && !dir.EndsWith(wxT("/")))
-        dir.Append(wxT("/"));
-    result.file = dir + file;
-
-    // TODO ? add checkout ?
-    return result;
+void ValgrindMemcheckProcessor::OnLiveData(const std::string& data)
+{
+    if(!m_liveParser)
+        return;
+
+    size_t count = m_liveParser->GetErrorsCount();
+    if(!m_liveParser->Feed(data.c_str(), data.size())) {
+        // ignore the rest of the log
+        clWARNING() << "MemCheck: received data are not Valgrind's xml log" << endl;
+        m_liveParser.reset();
+        return;
+    }
+    if(m_liveParser->GetErrorsCount() != count)
+        NotifyErrorsAdded();
 }
@@ -34,7 +34,12 @@
 #define _VALGRINDPROCESSOR_H_
 
 #include "imemcheckprocessor.h"
-#include <wx/xml/xml.h>
+
+#include <memory>
+#include <string>
+
+class ValgrindLiveReader;
+class ValgrindXmlParser;
 
 /**
  * @class ValgrindMemcheckProcessor
@@ -50,6 +55,7 @@ public:
      * @param settings
      */
     ValgrindMemcheckProcessor(MemCheckSettings* const settings);
+    ~ValgrindMemcheckProcessor() override;
 
     /**
      * @brief interface implementation
@@ -65,7 +71,8 @@ public:
      * @param originalCommand
      * @return
      *
-     * Takes original command and prepend it with Valgrind command and its arguments.
+     * Takes original command and prepend it with Valgrind command and its arguments. In live mode Valgrind is told to
+     * send the log to the socket of ValgrindLiveReader, the reader writes it to the log file.
      */
     virtual void GetExecutionCommand(const wxString& originalCommand, wxString& command, wxString& command_args);
 
@@ -74,29 +81,32 @@ public:
      * @param outputLogFileName
      * @return
      *
-     * Loads Valgrind's xml log to wxXmlDocument, and goes trought nodes
+     * Reads Valgrind's xml log in chunks and feeds them to ValgrindXmlParser. Errors are available (and announced by
+     * NotifyErrorsAdded) while the file is being parsed.
      */
     virtual bool Process(const wxString& outputLogFileName = wxEmptyString);
 
-protected:
     /**
-     * @brief creates one MemCheckError object
-     * @param doc whole log document
-     * @param errorNode reference to current processed node in that doc file
-     * @return MemCheckError object
+     * @brief interface implementation
      *
-     * Auxiliary section is not in subnode. First part of the node describes particular error, second part describes
-     * auxiliary info. For auxiliary is created sub MemCheckError object.
+     * Clears the errors and starts ValgrindLiveReader. Received log is parsed on the main thread, duplicated errors
+     * (same kind and stack) are dropped.
      */
-    MemCheckError ProcessError(wxXmlDocument& doc, wxXmlNode* errorNode);
+    bool StartLive() override;
+    bool IsLive() const override { return m_liveReader != nullptr; }
+    void StopLive() override;
 
+protected:
     /**
-     * @brief creates one MemCheckErrorLocation object
-     * @param doc whole log document
-     * @param locationNode reference to current processed node in that doc file
-     * @return MemCheckErrorLocation object
+     * @brief Sets m_outputLogFileName according to settings and opened workspace
      */
-    MemCheckErrorLocation ProcessLocation(wxXmlDocument& doc, wxXmlNode* locationNode);
+    void UpdateOutputLogFileName();
+    void OnLiveData(const std::string& data);
+
+private:
+    std::unique_ptr<ValgrindXmlParser> m_liveParser;
+    std::unique_ptr<ValgrindLiveReader> m_liveReader;
+    int m_livePort = wxNOT_FOUND;
 };
 
 #endif // _VALGRINDPROCESSOR_H_
@@ -0,0 +1,273 @@
+/**
+ * @file
+ * @copyright GNU General Public License v2
+ */
+
+#include "valgrindxmlparser.h"
+
+#include <cstdlib>
+#include <functional>
+
+namespace
+{
+const char ROOT_ELEMENT[] = "valgrindoutput";
+
+void AppendUtf8(std::string& str, unsigned long code)
+{
+    if (code < 0x80) {
+        str += (char)code;
+    } else if (code < 0x800) {
+        str += (char)(0xC0 | (code >> 6));
+        str += (char)(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        str += (char)(0xE0 | (code >> 12));
+        str += (char)(0x80 | ((code >> 6) & 0x3F));
+        str += (char)(0x80 | (code & 0x3F));
+    } else if (code < 0x110000) {
+        str += (char)(0xF0 | (code >> 18));
+        str += (char)(0x80 | ((code >> 12) & 0x3F));
+        str += (char)(0x80 | ((code >> 6) & 0x3F));
+        str += (char)(0x80 | (code & 0x3F));
+    }
+}
+
+/// tag name without attributes, "/" of empty element and surrounding spaces
+std::string GetTagName(const std::string& tag, size_t start)
+{
+    const char* spaces = " \t\r\n";
+    size_t first = tag.find_first_not_of(spaces, start);
+    if (first == std::string::npos)
+        return std::string();
+    size_t last = tag.find_first_of(" \t\r\n/", first);
+    return tag.substr(first, last == std::string::npos ? std::string::npos : last - first);
+}
+
+size_t HashCombine(size_t seed, size_t value) { return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2)); }
+} // namespace
+
+ValgrindXmlParser::ValgrindXmlParser(ErrorList& errorList, MemCheckErrorIndex& errorIndex)
+    : m_errorList(errorList)
+    , m_errorIndex(errorIndex)
+    , m_valid(false)
+    , m_complete(false)
+    , m_errorsCount(0)
+    , m_deduplicate(false)
+    , m_duplicatesCount(0)
+    , m_inError(false)
+    , m_auxiliary(false)
+{
+}
+
+bool ValgrindXmlParser::Feed(const char* data, size_t length)
+{
+    m_buffer.append(data, length);
+
+    size_t pos = 0;
+    while (pos < m_buffer.size()) {
+        size_t tagStart = m_buffer.find('<', pos);
+        if (tagStart == std::string::npos) {
+            m_text.append(m_buffer, pos, std::string::npos);
+            pos = m_buffer.size();
+            break;
+        }
+        m_text.append(m_buffer, pos, tagStart - pos);
+        pos = tagStart;
+
+        size_t tagEnd = m_buffer.find('>', tagStart);
+        if (tagEnd == std::string::npos)
+            break; // wait for the rest of the tag
+
+        if (m_buffer.compare(tagStart, 4, "<!--") == 0) {
+            size_t commentEnd = m_buffer.find("-->", tagStart + 4);
+            if (commentEnd == std::string::npos)
+                break;
+            pos = commentEnd + 3;
+            continue;
+        }
+
+        if (m_buffer.compare(tagStart, 9, "<![CDATA[") == 0) {
+            size_t cdataEnd = m_buffer.find("]]>", tagStart + 9);
+            if (cdataEnd == std::string::npos)
+                break;
+            // m_text is decoded when the element ends, protect the ampersands
+            for (size_t i = tagStart + 9; i < cdataEnd; ++i) {
+                if (m_buffer[i] == '&')
+                    m_text.append("&amp;");
+                else
+                    m_text += m_buffer[i];
+            }
+            pos = cdataEnd + 3;
+            continue;
+        }
+
+        std::string tag = m_buffer.substr(tagStart + 1, tagEnd - tagStart - 1);
+        pos = tagEnd + 1;
+        if (tag.empty() || tag[0] == '?' || tag[0] == '!') {
+            continue; // xml declaration, doctype
+        } else if (tag[0] == '/') {
+            OnEndElement(GetTagName(tag, 1));
+        } else {
+            std::string name = GetTagName(tag, 0);
+            if (!OnStartElement(name))
+                return false;
+            if (tag[tag.size() - 1] == '/')
+                OnEndElement(name);
+        }
+    }
+
+    m_buffer.erase(0, pos);
+    return true;
+}
+
+bool ValgrindXmlParser::OnStartElement(const std::string& name)
+{
+    if (m_stack.empty()) {
+        if (m_complete || name != ROOT_ELEMENT)
+            return false;
+        m_valid = true;
+    } else if (m_stack.size() == 1 && name == "error") {
+        m_inError = true;
+        m_auxiliary = false;
+        m_error = MemCheckError();
+        m_error.type = MemCheckError::TYPE_ERROR;
+        m_kind.clear();
+        m_auxiliaryError = MemCheckError();
+    } else if (m_inError && name == "frame" && IsParent("stack", 0)) {
+        m_location = MemCheckErrorLocation();
+        m_dir.Clear();
+        m_file.Clear();
+    }
+
+    m_stack.push_back(name);
+    m_text.clear();
+    return true;
+}
+
+void ValgrindXmlParser::OnEndElement(const std::string& name)
+{
+    if (m_stack.empty())
+        return;
+
+    if (m_inError) {
+        if (IsParent("frame")) {
+            if (name == "obj") {
+                m_location.obj = m_errorIndex.Intern(GetText());
+            } else if (name == "fn") {
+                m_location.func = m_errorIndex.Intern(GetText());
+            } else if (name == "dir") {
+                m_dir = GetText();
+            } else if (name == "file") {
+                m_file = GetText();
+            } else if (name == "line") {
+                m_location.line = wxAtoi(GetText());
+            }
+        } else if (name == "frame" && IsParent("stack")) {
+            if (!m_dir.IsEmpty() && !m_dir.EndsWith(wxT("/")))
+                m_dir.Append(wxT("/"));
+            m_location.file = m_errorIndex.Intern(m_dir + m_file);
+            if (m_auxiliary)
+                m_auxiliaryError.locations.push_back(m_location);
+            else
+                m_error.locations.push_back(m_location);
+        } else if (name == "kind" && IsParent("error")) {
+            m_kind = m_text;
+        } else if (name == "what" && IsParent("error")) {
+            m_error.label = GetText();
+        } else if (name == "text" && IsParent("xwhat") && IsParent("error", 2)) {
+            m_error.label = GetText();
+        } else if (name == "auxwhat" && IsParent("error")) {
+            m_auxiliaryError.label = GetText();
+            m_auxiliaryError.type = MemCheckError::TYPE_AUXILIARY;
+            m_auxiliary = true;
+        } else if (name == "rawtext" && IsParent("suppression")) {
+            m_error.suppression = GetText();
+        } else if (name == "error" && m_stack.size() == 2) {
+            m_inError = false;
+            if (m_deduplicate && !m_fingerprints.insert(GetFingerprint()).second) {
+                ++m_duplicatesCount;
+            } else {
+                if (m_error.suppression.IsEmpty())
+                    m_error.suppression =
+                        wxT("#Suppresion pattern not present in output log.\n#This plugin requires Valgrind to be "
+                            "run with '--gen-suppressions=all' option");
+                if (m_auxiliary)
+                    m_error.nestedErrors.push_back(std::move(m_auxiliaryError));
+
+                m_errorList.push_back(std::move(m_error));
+                m_errorIndex.Add(m_errorList.back());
+                ++m_errorsCount;
+            }
+        }
+    }
+
+    m_stack.pop_back();
+    m_text.clear();
+    if (m_stack.empty())
+        m_complete = true;
+}
+
+bool ValgrindXmlParser::IsParent(const char* name, size_t depth) const
+{
+    return depth < m_stack.size() && m_stack[m_stack.size() - 1 - depth] == name;
+}
+
+ValgrindXmlParser::Fingerprint ValgrindXmlParser::GetFingerprint() const
+{
+    Fingerprint fingerprint;
+    fingerprint.kind = m_kind;
+    fingerprint.frames.reserve(m_error.locations.size());
+    for (const auto& location : m_error.locations) {
+        fingerprint.frames.emplace_back(location.func, location.file, location.line);
+    }
+    return fingerprint;
+}
+
+size_t ValgrindXmlParser::FingerprintHash::operator()(const Fingerprint& fingerprint) const
+{
+    // only picks the bucket, the fingerprints are compared in full
+    size_t hash = std::hash<std::string>{}(fingerprint.kind);
+    for (const auto& [func, file, line] : fingerprint.frames) {
+        hash = HashCombine(hash, std::hash<const wxString*>{}(func));
+        hash = HashCombine(hash, std::hash<const wxString*>{}(file));
+        hash = HashCombine(hash, std::hash<int>{}(line));
+    }
+    return hash;
+}
+
+wxString ValgrindXmlParser::GetText() const
+{
+    if (m_text.find('&') == std::string::npos)
+        return wxString::FromUTF8(m_text.c_str(), m_text.size());
+
+    std::string decoded;
+    decoded.reserve(m_text.size());
+    for (size_t i = 0; i < m_text.size(); ++i) {
+        size_t entityEnd = m_text[i] == '&' ? m_text.find(';', i) : std::string::npos;
+        if (entityEnd == std::string::npos) {
+            decoded += m_text[i];
+            continue;
+        }
+
+        std::string entity = m_text.substr(i + 1, entityEnd - i - 1);
+        if (entity == "lt")
+            decoded += '<';
+        else if (entity == "gt")
+            decoded += '>';
+        else if (entity == "amp")
+            decoded += '&';
+        else if (entity == "quot")
+            decoded += '"';
+        else if (entity == "apos")
+            decoded += '\'';
+        else if (entity.size() > 2 && entity[0] == '#' && (entity[1] == 'x' || entity[1] == 'X'))
+            AppendUtf8(decoded, strtoul(entity.c_str() + 2, NULL, 16));
+        else if (entity.size() > 1 && entity[0] == '#')
+            AppendUtf8(decoded, strtoul(entity.c_str() + 1, NULL, 10));
+        else {
+            decoded += m_text[i]; // not an entity, keep as is
+            continue;
+        }
+        i = entityEnd;
+    }
+    return wxString::FromUTF8(decoded.c_str(), decoded.size());
+}
@@ -0,0 +1,134 @@
+/**
+ * @file
+ * @copyright GNU General Public License v2
+ *
+ * @brief ValgrindXmlParser - incremental parser of Valgrind's xml output.
+ */
+
+#ifndef _VALGRINDXMLPARSER_H_
+#define _VALGRINDXMLPARSER_H_
+
+#include "memcheckerror.h"
+
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @class ValgrindXmlParser
+ * @brief Push parser for the xml written by Valgrind with '--xml=yes'.
+ *
+ * Log is fed in chunks of any size, errors are appended to ErrorList (and its index) as soon as their closing tag is
+ * read. No document tree is built, so memory depends on the number of errors, not on the size of the log. Valgrind
+ * writes a simple subset of xml (no CDATA, no DTD), only that subset is understood.
+ */
+class ValgrindXmlParser
+{
+public:
+    /**
+     * @brief ctor
+     * @param errorList parsed errors are appended here
+     * @param errorIndex parsed errors are added to this index, it also interns location strings
+     */
+    ValgrindXmlParser(ErrorList& errorList, MemCheckErrorIndex& errorIndex);
+
+    /**
+     * @brief Parses next part of the log. Incomplete tag at the end is kept until next call.
+     * @param data
+     * @param length
+     * @return false if data are not Valgrind's xml output
+     */
+    bool Feed(const char* data, size_t length);
+
+    /**
+     * @brief Root element <valgrindoutput> was found
+     */
+    bool IsValid() const { return m_valid; }
+
+    /**
+     * @brief Root element was closed, whole log was parsed
+     */
+    bool IsComplete() const { return m_complete; }
+
+    /**
+     * @brief Number of errors added since the parser was created
+     */
+    size_t GetErrorsCount() const { return m_errorsCount; }
+
+    /**
+     * @brief Drops errors of the same kind with the same stack trace as an error that was already added.
+     *
+     * Stack fingerprints are kept for the life of the parser, they depend on the strings interned by the index, so the
+     * index must not be cleared while the parser is used.
+     */
+    void SetDeduplicate(bool deduplicate) { m_deduplicate = deduplicate; }
+
+    /**
+     * @brief Number of errors dropped by deduplication
+     */
+    size_t GetDuplicatesCount() const { return m_duplicatesCount; }
+
+protected:
+    /**
+     * @brief Kind and stack of an error, the label is not used as it contains sizes and addresses.
+     * Frames hold the strings interned by the index (function, file) and the line, equal content means equal pointers
+     */
+    struct Fingerprint {
+        std::string kind;
+        std::vector<std::tuple<const wxString*, const wxString*, int>> frames;
+
+        bool operator==(const Fingerprint& other) const { return kind == other.kind && frames == other.frames; }
+    };
+
+    struct FingerprintHash {
+        size_t operator()(const Fingerprint& fingerprint) const;
+    };
+
+    /**
+     * @brief Handles opening tag
+     * @return false if the root element is not <valgrindoutput>
+     */
+    bool OnStartElement(const std::string& name);
+    void OnEndElement(const std::string& name);
+
+    /**
+     * @brief Checks element path, depth 0 is the current element
+     */
+    bool IsParent(const char* name, size_t depth = 1) const;
+
+    /**
+     * @brief Returns content of element being closed with resolved entities
+     */
+    wxString GetText() const;
+
+    /**
+     * @brief Fingerprint of the current error
+     */
+    Fingerprint GetFingerprint() const;
+
+private:
+    ErrorList& m_errorList;
+    MemCheckErrorIndex& m_errorIndex;
+
+    std::string m_buffer;             ///< unparsed data
+    std::string m_text;               ///< raw content of current element
+    std::vector<std::string> m_stack; ///< open elements
+    bool m_valid;
+    bool m_complete;
+    size_t m_errorsCount;
+    bool m_deduplicate;
+    size_t m_duplicatesCount;
+    std::unordered_set<Fingerprint, FingerprintHash> m_fingerprints;
+
+    bool m_inError;
+    bool m_auxiliary;
+    std::string m_kind;
+    MemCheckError m_error;
+    MemCheckError m_auxiliaryError;
+    MemCheckErrorLocation m_location;
+    wxString m_dir;
+    wxString m_file;
+};
+
+#endif // _VALGRINDXMLPARSER_H_
@@ -195,9 +195,8 @@ void AddLexerKeywords(LexerConf::Ptr_t lexer, int setIndex, const std::vector<wx
     lexer->SetKeyWords(curwords, setIndex);
 }
 
-void AddFileExtension(LexerConf::Ptr_t lexer, const wxString& extension)
+void AddFileExtension(wxString& spec, const wxString& extension)
 {
-    wxString spec = lexer->GetFileSpec();
     auto extensions = ::wxStringTokenize(spec, ";,", wxTOKEN_STRTOK);
     std::set<wxString> S{ extensions.begin(), extensions.end() };
     if (!S.insert(extension).second) {
@@ -205,14 +204,11 @@ void AddFileExtension(LexerConf::Ptr_t lexer, const wxString& extension)
         return;
     }
 
-    wxString as_str = StringUtils::Join(S, ";");
-    lexer->SetFileSpec(as_str);
+    spec = StringUtils::Join(S, ";");
 }
 
-void RemoveFileExtension(LexerConf::Ptr_t lexer, const wxString& extension)
+void RemoveFileExtension(wxString& spec, const wxString& extension)
 {
-    wxString spec = lexer->GetFileSpec();
-    wxString as_str;
     auto extensions = ::wxStringTokenize(spec, ";,", wxTOKEN_STRTOK);
     int where = extensions.Index(extension);
 
@@ -221,8 +217,121 @@ void RemoveFileExtension(LexerConf::Ptr_t lexer, const wxString& extension)
     }
 
     extensions.RemoveAt(where);
-    as_str = ::wxJoin(extensions, ';');
-    lexer->SetFileSpec(as_str);
+    spec = ::wxJoin(extensions, ';');
+}
+
+/// Return the file spec of a lexer, fixed for the lexers saved by older versions.
+/// This only depends on the lexer name, so the languages of a file can be found before their lexers are loaded
+wxString FixFileSpec(const wxString& name, const wxString& fileSpec)
+{
+    wxString spec = fileSpec;
+
+    // Fix C++ lexer
+    if (name == "c++") {
+        spec.Replace("*.javascript", wxEmptyString);
+        spec.Replace("*.js", wxEmptyString);
+        if (spec.IsEmpty() || !spec.Contains("*.cpp")) {
+            spec = "*.cxx;*.hpp;*.cc;*.h;*.c;*.cpp;*.l;*.y;*.c++;*.hh;*.ipp;*.hxx;*.h++;*.ino";
+        }
+        // Add Arduino sketches files as C++ (*.ino)
+        if (!spec.Contains(".ino")) {
+            spec << ";*.ino";
+        }
+    }
+
+    // Hack: fix Java lexer which is using the same
+    // file extensions as C++...
+    if (name == "java" && spec.Contains(".cpp")) {
+        spec = "*.java";
+    }
+
+    // Append *.sqlite to the SQL lexer if missing
+    if (name == "sql" && !spec.Contains(".sqlite")) {
+        spec << ";*.sqlite";
+    }
+
+    // Hack2: since we now provide our own PHP and javaScript lexer, remove the PHP/JS extensions from
+    // the HTML lexer
+    if (name == "html" && (spec.Contains(".php") || spec.Contains("*.js"))) {
+        spec = "*.htm;*.html;*.xhtml";
+    }
+
+    // Hack3: all the HTML support to PHP which have much more colour themes
+    if (name == "html" && spec.Contains(".html")) {
+        spec = "*.vbs;*.vbe;*.wsf;*.wsc;*.asp;*.aspx";
+    }
+
+    // Hack5: all the remove *.scss from the css lexer (it now has its own lexer)
+    if (name == "css" && spec.Contains(".scss")) {
+        spec = "*.css";
+    }
+
+    // Add *.less file extension to the css lexer
+    if (name == "css" && !spec.Contains(".less")) {
+        spec << ";*.less";
+    }
+
+    if (name == "php" && !spec.Contains(".html")) {
+        spec << ";*.html;*.htm;*.xhtml";
+    }
+
+    if (name == "php" && !spec.Contains(".php5")) {
+        spec << ";*.php5";
+    }
+
+    if (name == "php" && !spec.Contains(".ctp")) {
+        spec << ";*.ctp";
+    }
+
+    // Add wxcp file extension to the JavaScript lexer
+    if (name == "javascript") {
+        // remove the JSON file from the JavaScript
+        if (spec.Contains("*.json")) {
+            auto specs = ::wxStringTokenize(spec, ";,", wxTOKEN_STRTOK);
+            int where = specs.Index("*.json");
+            if (where != wxNOT_FOUND) {
+                specs.RemoveAt(where);
+            }
+            spec = wxJoin(specs, ';');
+        }
+        // wxCrafter files
+        AddFileExtension(spec, "*.wxcp");
+        AddFileExtension(spec, "*.qml");
+        AddFileExtension(spec, "*.ts");
+        AddFileExtension(spec, "*.tsx");
+    }
+
+    if (name == "text") {
+        spec.clear();
+    }
+
+    // make sure we include Rakefile as a Ruby file
+    if (name == "ruby" && !spec.Contains("Rakefile")) {
+        spec << ";Rakefile";
+    }
+
+    if (name == "makefile" && !spec.Contains("*akefile.am")) {
+        spec << ";*akefile.in;*akefile.am";
+    }
+
+    if (name == "properties") {
+        AddFileExtension(spec, "*.toml");
+    }
+
+    // .clangd is of type "yaml"
+    if (name == "yaml") {
+        AddFileExtension(spec, ".clangd");
+    }
+
+    if (name == "fortran") {
+        RemoveFileExtension(spec, "*f");
+        AddFileExtension(spec, "*.f");
+    }
+
+    if (name == "json") {
+        AddFileExtension(spec, "*.conf");
+    }
+    return spec;
 }
 } // namespace
 
@@ -276,6 +385,7 @@ void ColoursAndFontsManager::Load()
 wxArrayString ColoursAndFontsManager::GetAvailableThemesForLexer(const wxString& lexerName) const
 {
     const wxString lowerCaseName = lexerName.Lower();
+    LoadPendingLexers(lowerCaseName);
     if (m_lexersMap.count(lowerCaseName) == 0) {
         return {};
     }
@@ -296,6 +406,8 @@ wxArrayString ColoursAndFontsManager::GetAvailableThemesForLexer(const wxString&
 
 LexerConf::Ptr_t ColoursAndFontsManager::GetLexer(const wxString& lexerName, const wxString& theme) const
 {
+    LoadPendingLexers(lexerName.Lower());
+    LoadPendingLexers("text");
     auto iter = m_lexersMap.find(lexerName.Lower());
     if (iter == m_lexersMap.end()) {
         clWARNING() << "No lexer available for:" << lexerName << endl;
@@ -380,6 +492,7 @@ LexerConf::Ptr_t ColoursAndFontsManager::GetLexer(const wxString& lexerName, con
 
 void ColoursAndFontsManager::Save(const wxFileName& lexer_json)
 {
+    LoadAllPendingLexers();
     bool for_export = lexer_json.IsOk();
     JSON root(cJSON_Array);
     JSONItem element = root.toElement();
@@ -409,6 +522,7 @@ void ColoursAndFontsManager::Save(const wxFileName& lexer_json)
 
 wxArrayString ColoursAndFontsManager::GetAllLexersNames() const
 {
+    LoadAllPendingLexers();
     wxArrayString names;
     for (size_t i = 0; i < m_allLexers.size(); ++i) {
         LexerConf::Ptr_t lexer = m_allLexers.at(i);
@@ -437,6 +551,7 @@ LexerConf::Ptr_t ColoursAndFontsManager::GetLexerForFile(const wxString& filenam
     const wxString& theme_name = GetGlobalTheme();
 
     // Get list of all lexers - without the "text" lexer
+    LoadPendingLexersForFile(filename);
     ColoursAndFontsManager::Vec_t allLexersNoText;
     allLexersNoText.reserve(m_allLexers.size());
 
@@ -559,6 +674,8 @@ void ColoursAndFontsManager::Clear()
 {
     m_allLexers.clear();
     m_lexersMap.clear();
+    m_pendingLexers.clear();
+    m_pendingFiles.clear();
     m_initialized = false;
 }
 
@@ -692,6 +809,8 @@ void ColoursAndFontsManager::LoadLexersFromFile()
 
     m_allLexers.clear();
     m_lexersMap.clear();
+    m_pendingLexers.clear();
+    m_pendingFiles.clear();
 
     clSYSTEM() << "Loading lexers. System file:" << fnInstallLexers << endl;
     clSYSTEM() << "Loading lexers. Local file:" << fnUserLexers << endl;
@@ -768,19 +887,10 @@ void ColoursAndFontsManager::UpdateLexerColours(LexerConf::Ptr_t lexer, bool for
     if (force || m_lexersVersion < 3) {
         // remove the *.js;*.javascript from the C++ lexer
         if (lexer->GetName() == "c++") {
-            lexer->SetFileSpec("*.cxx;*.hpp;*.cc;*.h;*.c;*.cpp;*.l;*.y;*.c++;*.hh;*.ipp;*.hxx;*.h++");
+            lexer->SetFileSpec("*.cxx;*.hpp;*.cc;*.h;*.c;*.cpp;*.l;*.y;*.c++;*.hh;*.ipp;*.hxx;*.h++;*.ino");
         }
     }
 
-    if ((lexer->GetName() == "c++") && (lexer->GetFileSpec().IsEmpty() || !lexer->GetFileSpec().Contains("*.cpp"))) {
-        lexer->SetFileSpec("*.cxx;*.hpp;*.cc;*.h;*.c;*.cpp;*.l;*.y;*.c++;*.hh;*.ipp;*.hxx;*.h++;*.ino");
-    }
-
-    // Add Arduino sketches files as C++ (*.ino)
-    if (lexer->GetName() == "c++" && !lexer->GetFileSpec().Contains(".ino")) {
-        lexer->SetFileSpec(lexer->GetFileSpec() + ";*.ino");
-    }
-
     // Upgrade CSS colours
     if ((force || m_lexersVersion < 4) && lexer->GetName().Lower() == "css") {
         // adjust line numbers
@@ -846,20 +956,75 @@ void ColoursAndFontsManager::LoadJSON(const wxFileName& path)
 
     clDEBUG() << "==> Loading lexer  <==" << endl;
     clDEBUG() << "Parsing file:" << path << endl;
-    JSON root(path);
-    JSONItem arr = root.toElement();
+    auto root = std::make_unique<JSON>(path);
+    JSONItem arr = root->toElement();
 
     clDEBUG() << "Building vector" << endl;
     auto vec = arr.GetAsVector();
     clDEBUG() << "Found" << vec.size() << "lexers" << endl;
 
-    clDEBUG() << "Loading..." << endl;
+    // only index the lexers by language here, converting them is the expensive part
     for (const auto& json : vec) {
-        DoAddLexer(json);
+        wxString name = json.namedObject("Name").toString();
+        if (name.empty()) {
+            continue;
+        }
+        auto& language = m_pendingLexers[name.Lower()];
+        language.items.push_back(json);
+        language.fileSpecs.insert(FixFileSpec(name, json.namedObject("Extensions").toString()));
     }
+    m_pendingFiles.push_back(std::move(root));
     clDEBUG() << "==> Success  <==" << endl;
 }
 
+void ColoursAndFontsManager::LoadPendingLexers(const wxString& lexerName) const
+{
+    auto iter = m_pendingLexers.find(lexerName);
+    if (iter == m_pendingLexers.end()) {
+        return;
+    }
+
+    // no longer pending: DoAddLexer() may look up this language
+    std::vector<JSONItem> items = std::move(iter->second.items);
+    m_pendingLexers.erase(iter);
+
+    clDEBUG1() << "Loading" << items.size() << "lexers for:" << lexerName << endl;
+    // converting the pending lexers does not change the observable state of the manager
+    auto self = const_cast<ColoursAndFontsManager*>(this);
+    for (const auto& json : items) {
+        self->DoAddLexer(json);
+    }
+
+    if (m_pendingLexers.empty()) {
+        m_pendingFiles.clear();
+    }
+}
+
+void ColoursAndFontsManager::LoadPendingLexersForFile(const wxString& filename) const
+{
+    std::vector<wxString> names;
+    for (const auto& [name, language] : m_pendingLexers) {
+        for (const wxString& spec : language.fileSpecs) {
+            if (FileUtils::WildMatch(spec, filename)) {
+                names.push_back(name);
+                break;
+            }
+        }
+    }
+
+    for (const wxString& name : names) {
+        LoadPendingLexers(name);
+    }
+}
+
+void ColoursAndFontsManager::LoadAllPendingLexers() const
+{
+    while (!m_pendingLexers.empty()) {
+        wxString name = m_pendingLexers.begin()->first;
+        LoadPendingLexers(name);
+    }
+}
+
 LexerConf::Ptr_t ColoursAndFontsManager::DoAddLexer(JSONItem json)
 {
     LexerConf::Ptr_t lexer(new LexerConf());
@@ -875,15 +1040,12 @@ LexerConf::Ptr_t ColoursAndFontsManager::DoAddLexer(JSONItem json)
     wxString themeName = lexer->GetThemeName();
     themeName = themeName.Mid(0, 1).Capitalize() + themeName.Mid(1);
     lexer->SetThemeName(themeName);
+    lexer->SetFileSpec(FixFileSpec(lexer->GetName(), lexer->GetFileSpec()));
 
     // Fix C++ lexer
     if (lexer->GetName() == "c++") {
         AddLexerKeywords(
             lexer, 0, { "override", "final", "constexpr", "co_return", "co_await", "co_yield", "requires", "concept" });
-        wxString filespec = lexer->GetFileSpec();
-        filespec.Replace("*.javascript", wxEmptyString);
-        filespec.Replace("*.js", wxEmptyString);
-        lexer->SetFileSpec(filespec);
     }
 
     if (lexer->GetName() == "diff") {
@@ -900,76 +1062,16 @@ LexerConf::Ptr_t ColoursAndFontsManager::DoAddLexer(JSONItem json)
         AddLexerKeywords(lexer, 0, { "async", "await" });
     }
 
-    // Hack: fix Java lexer which is using the same
-    // file extensions as C++...
-    if (lexer->GetName() == "java" && lexer->GetFileSpec().Contains(".cpp")) {
-        lexer->SetFileSpec("*.java");
-    }
-
     if (lexer->GetName() == "java") {
         AddLexerKeywords(lexer, 0, { "async", "await", "enum" });
     }
 
-    // Append *.sqlite to the SQL lexer if missing
-    if (lexer->GetName() == "sql" && !lexer->GetFileSpec().Contains(".sqlite")) {
-        lexer->SetFileSpec(lexer->GetFileSpec() + ";*.sqlite");
-    }
-
-    // Hack2: since we now provide our own PHP and javaScript lexer, remove the PHP/JS extensions from
-    // the HTML lexer
-    if (lexer->GetName() == "html" &&
-        (lexer->GetFileSpec().Contains(".php") || lexer->GetFileSpec().Contains("*.js"))) {
-        lexer->SetFileSpec("*.htm;*.html;*.xhtml");
-    }
-
-    // Hack3: all the HTML support to PHP which have much more colour themes
-    if (lexer->GetName() == "html" && lexer->GetFileSpec().Contains(".html")) {
-        lexer->SetFileSpec("*.vbs;*.vbe;*.wsf;*.wsc;*.asp;*.aspx");
-    }
-
-    // Hack5: all the remove *.scss from the css lexer (it now has its own lexer)
-    if (lexer->GetName() == "css" && lexer->GetFileSpec().Contains(".scss")) {
-        lexer->SetFileSpec("*.css");
-    }
-
-    // Add *.less file extension to the css lexer
-    if (lexer->GetName() == "css" && !lexer->GetFileSpec().Contains(".less")) {
-        lexer->SetFileSpec(lexer->GetFileSpec() + ";*.less");
-    }
-
-    if (lexer->GetName() == "php" && !lexer->GetFileSpec().Contains(".html")) {
-        lexer->SetFileSpec(lexer->GetFileSpec() + ";*.html;*.htm;*.xhtml");
-    }
-
     if (lexer->GetName() == "php" && !lexer->GetKeyWords(4).Contains("<?php")) {
         lexer->SetKeyWords(lexer->GetKeyWords(4) + " <?php <? ", 4);
     }
 
-    if (lexer->GetName() == "php" && !lexer->GetFileSpec().Contains(".php5")) {
-        lexer->SetFileSpec(lexer->GetFileSpec() + ";*.php5");
-    }
-
-    if (lexer->GetName() == "php" && !lexer->GetFileSpec().Contains(".ctp")) {
-        lexer->SetFileSpec(lexer->GetFileSpec() + ";*.ctp");
-    }
-
-    // Add wxcp file extension to the JavaScript lexer
+    // Add the TypeScript keywords to the JavaScript lexer
     if (lexer->GetName() == "javascript") {
-        // remove the JSON file from the JavaScript
-        if (lexer->GetFileSpec().Contains("*.json")) {
-            auto specs = ::wxStringTokenize(lexer->GetFileSpec(), ";,", wxTOKEN_STRTOK);
-            int where = specs.Index("*.json");
-            if (where != wxNOT_FOUND) {
-                specs.RemoveAt(where);
-            }
-            lexer->SetFileSpec(wxJoin(specs, ';'));
-        }
-        // wxCrafter files
-        AddFileExtension(lexer, "*.wxcp");
-        AddFileExtension(lexer, "*.qml");
-        AddFileExtension(lexer, "*.ts");
-        AddFileExtension(lexer, "*.tsx");
-
         const wxString ts_keywords = "break as any "
                                      "case implements boolean "
                                      "catch interface constructor "
@@ -1037,10 +1139,6 @@ LexerConf::Ptr_t ColoursAndFontsManager::DoAddLexer(JSONItem json)
                            "popd" });
     }
 
-    if (lexer->GetName() == "text") {
-        lexer->SetFileSpec(wxEmptyString);
-    }
-
     // Set the JavaScript keywords
     if (lexer->GetName() == "php" && !lexer->GetKeyWords(1).Contains("instanceof")) {
         lexer->SetKeyWords(
@@ -1069,35 +1167,6 @@ LexerConf::Ptr_t ColoursAndFontsManager::DoAddLexer(JSONItem json)
         }
     }
 
-    // make sure we include Rakefile as a Ruby file
-    if (lexer->GetName() == "ruby") {
-        if (!lexer->GetFileSpec().Contains("Rakefile")) {
-            lexer->SetFileSpec(lexer->GetFileSpec() + ";Rakefile");
-        }
-    }
-
-    if (lexer->GetName() == "makefile" && !lexer->GetFileSpec().Contains("*akefile.am")) {
-        lexer->SetFileSpec(lexer->GetFileSpec() + ";*akefile.in;*akefile.am");
-    }
-
-    if (lexer->GetName() == "properties") {
-        AddFileExtension(lexer, "*.toml");
-    }
-
-    // .clangd is of type "yaml"
-    if (lexer->GetName() == "yaml") {
-        AddFileExtension(lexer, ".clangd");
-    }
-
-    if (lexer->GetName() == "fortran") {
-        RemoveFileExtension(lexer, "*f");
-        AddFileExtension(lexer, "*.f");
-    }
-
-    if (lexer->GetName() == "json") {
-        AddFileExtension(lexer, "*.conf");
-    }
-
     if (lexer->GetName() == "cmake") {
         AddLexerKeywords(lexer, 0, CMAKE_KEYWORDS);
     }
@@ -1142,6 +1211,8 @@ LexerConf::Ptr_t ColoursAndFontsManager::DoAddLexer(JSONItem json)
 void ColoursAndFontsManager::AddLexer(LexerConf::Ptr_t lexer)
 {
     CHECK_PTR_RET(lexer);
+    // the pending lexers of this language must not override the new one
+    LoadPendingLexers(lexer->GetName().Lower());
     DoAddLexer(lexer->ToJSON());
 }
 
@@ -1167,6 +1238,7 @@ bool ColoursAndFontsManager::ExportThemesToFile(const wxFileName& outputFile, co
         M.insert(names.Item(i).Lower());
     }
 
+    LoadAllPendingLexers();
     JSON root(cJSON_Array);
     JSONItem arr = root.toElement();
     std::vector<LexerConf::Ptr_t> Lexers;
@@ -1199,6 +1271,7 @@ bool ColoursAndFontsManager::ImportLexersFile(const wxFileName& inputFile, bool
         }
     }
 
+    LoadAllPendingLexers();
     std::vector<LexerConf::Ptr_t> Lexers;
     JSONItem arr = root.toElement();
     int arrSize = arr.arraySize();
@@ -1245,6 +1318,7 @@ bool ColoursAndFontsManager::ImportLexersFile(const wxFileName& inputFile, bool
 
 wxArrayString ColoursAndFontsManager::GetAllThemes() const
 {
+    LoadAllPendingLexers();
     wxStringSet_t themes;
     for (const auto& lexer : m_allLexers) {
         themes.insert(lexer->GetThemeName());
@@ -1310,6 +1384,7 @@ void ColoursAndFontsManager::SetThemeTextSelectionColours(const wxString& theme_
                                                           const wxColour& fg,
                                                           bool useCustomerFgColour)
 {
+    LoadAllPendingLexers();
     wxString theme_name_lc = theme_name.Lower();
     for (auto& lexer : m_allLexers) {
         if (lexer->GetThemeName().CmpNoCase(theme_name) == 0) {
@@ -1349,7 +1424,8 @@ void ColoursAndFontsManager::LoadLexersFromJSON()
 
 void ColoursAndFontsManager::SetGlobalLineNumbersColour(const wxColour& col, bool dark_theme)
 {
-    // Loop for every lexer and update the font per style
+    // Loop for every lexer and update the colour
+    LoadAllPendingLexers();
     for (auto lexer : m_allLexers) {
         if ((lexer->IsDark() && dark_theme) || (!lexer->IsDark() && !dark_theme)) {
             auto& prop = lexer->GetProperty(LINE_NUMBERS_ATTR_ID);
@@ -26,12 +26,15 @@
 #ifndef LEXERCONFMANAGER_H
 #define LEXERCONFMANAGER_H
 
+#include "JSON.h"
 #include "cl_command_event.h"
 #include "codelite_exports.h"
 #include "lexer_configuration.h"
 #include "wxStringHash.h"
 
 #include <map>
+#include <memory>
+#include <unordered_set>
 #include <vector>
 #include <wx/event.h>
 #include <wx/filename.h>
@@ -62,6 +65,17 @@ protected:
     int m_lexersVersion = wxNOT_FOUND;
     wxFont m_globalFont;
 
+    /// The lexers of a language, parsed from the JSON files but not loaded yet.
+    /// A language is loaded the first time one of its lexers is needed
+    struct PendingLanguage {
+        std::vector<JSONItem> items;            // in the files order, later items override earlier ones
+        std::unordered_set<wxString> fileSpecs; // to find the languages of a file without loading them
+    };
+    /// Pending languages, by lower case name
+    mutable std::unordered_map<wxString, PendingLanguage> m_pendingLexers;
+    /// The JSON files that own the pending items
+    mutable std::vector<std::unique_ptr<JSON>> m_pendingFiles;
+
 private:
     ColoursAndFontsManager();
     virtual ~ColoursAndFontsManager();
@@ -70,6 +84,9 @@ private:
     void Clear();
     wxFileName GetConfigFile() const;
     void LoadJSON(const wxFileName& path);
+    void LoadPendingLexers(const wxString& lexerName) const;
+    void LoadPendingLexersForFile(const wxString& filename) const;
+    void LoadAllPendingLexers() const;
     void LoadDb(const wxFileName& path);
     bool IsBackupRequired() const;
     void BackupUserOldJsonFileIfNeeded();
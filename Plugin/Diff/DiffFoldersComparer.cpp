@@ -0,0 +1,246 @@
+#include "DiffFoldersComparer.h"
+
+#include "clFilesCollector.h"
+#include "file_logger.h"
+#include "wxStringHash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+
+namespace
+{
+constexpr size_t READ_CHUNK_SIZE = 256 * 1024;
+// smaller files are compared while their folder is processed, larger files are queued so idle workers can pick them
+constexpr wxFileOffset LARGE_FILE_SIZE = 1024 * 1024;
+// comparing is mostly I/O bound, more threads just compete for the disk
+constexpr unsigned MAX_THREADS = 8;
+constexpr auto POST_INTERVAL = std::chrono::milliseconds(200);
+
+wxString join_path(const wxString& folder, const wxString& name)
+{
+    if(folder.empty()) {
+        return name;
+    }
+    return folder + wxFileName::GetPathSeparator() + name;
+}
+
+bool get_file_info(const wxString& path, wxFileOffset& size, time_t& mtime)
+{
+    wxStructStat st;
+    if(wxStat(path, &st) != 0) {
+        return false;
+    }
+    size = st.st_size;
+    mtime = st.st_mtime;
+    return true;
+}
+} // namespace
+
+DiffFoldersComparer::DiffFoldersComparer(const wxString& left, const wxString& right, const Callback_t& callback)
+    : m_left(wxFileName(left, "").GetPath())
+    , m_right(wxFileName(right, "").GetPath())
+    , m_callback(callback)
+{
+}
+
+DiffFoldersComparer::~DiffFoldersComparer() { Stop(); }
+
+void DiffFoldersComparer::Start()
+{
+    Stop();
+    m_stop = false;
+    m_jobs.push_back({ wxEmptyString, true });
+    m_pending = 1;
+    m_results.clear();
+    m_posted = false;
+    m_done = false;
+    m_running = true;
+    m_lastPost = std::chrono::steady_clock::now();
+
+    unsigned count = std::clamp(std::thread::hardware_concurrency(), 2u, MAX_THREADS);
+    for(unsigned i = 0; i < count; ++i) {
+        m_threads.emplace_back(&DiffFoldersComparer::WorkerMain, this);
+    }
+    clDEBUG() << "Comparing folders" << m_left << "and" << m_right << "with" << count << "threads" << endl;
+}
+
+void DiffFoldersComparer::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    for(auto& thr : m_threads) {
+        thr.join();
+    }
+    m_threads.clear();
+    m_jobs.clear();
+    m_running = false;
+}
+
+void DiffFoldersComparer::WorkerMain()
+{
+    while(true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stop || !m_jobs.empty() || m_pending == 0; });
+            if(m_stop || m_jobs.empty()) {
+                // cancelled, or all the jobs completed
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        std::vector<Job> jobs;
+        std::vector<Result> results;
+        if(job.is_folder) {
+            CompareFolder(job.path, jobs, results);
+        } else {
+            bool same = CompareFiles(join_path(m_left, job.path), join_path(m_right, job.path));
+            results.push_back({ job.path, same ? eStatus::kSame : eStatus::kChanged, false });
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending += jobs.size();
+            m_pending--;
+            m_jobs.insert(m_jobs.end(), std::make_move_iterator(jobs.begin()), std::make_move_iterator(jobs.end()));
+            m_results.insert(m_results.end(), std::make_move_iterator(results.begin()),
+                             std::make_move_iterator(results.end()));
+            m_done = (m_pending == 0);
+
+            auto now = std::chrono::steady_clock::now();
+            if(!m_stop && !m_posted && (m_done || now - m_lastPost >= POST_INTERVAL)) {
+                m_posted = true;
+                m_lastPost = now;
+                CallAfter(&DiffFoldersComparer::OnResults);
+            }
+        }
+        m_cv.notify_all();
+    }
+}
+
+void DiffFoldersComparer::CompareFolder(const wxString& path, std::vector<Job>& jobs, std::vector<Result>& results)
+{
+    if(m_stop) {
+        return;
+    }
+
+    clFilesScanner scanner;
+    clFilesScanner::EntryData::Vec_t leftEntries;
+    clFilesScanner::EntryData::Vec_t rightEntries;
+    scanner.ScanNoRecurse(join_path(m_left, path), leftEntries);
+    scanner.ScanNoRecurse(join_path(m_right, path), rightEntries);
+
+    // name -> flags
+    std::unordered_map<wxString, size_t> rightFlags;
+    rightFlags.reserve(rightEntries.size());
+    for(const auto& entry : rightEntries) {
+        rightFlags.insert({ wxFileName(entry.fullpath).GetFullName(), entry.flags });
+    }
+
+    for(const auto& entry : leftEntries) {
+        wxString name = wxFileName(entry.fullpath).GetFullName();
+        wxString child = join_path(path, name);
+        bool isFolder = entry.flags & clFilesScanner::kIsFolder;
+
+        auto iter = rightFlags.find(name);
+        if(iter == rightFlags.end() || isFolder != bool(iter->second & clFilesScanner::kIsFolder)) {
+            // a file replaced by a folder (or vice versa) is reported as removed and added
+            results.push_back({ child, eStatus::kLeftOnly, isFolder });
+            continue;
+        }
+        size_t flags = entry.flags | iter->second;
+        rightFlags.erase(iter);
+
+        if(isFolder) {
+            // don't follow symlinks, they may point to a parent folder
+            if(!(flags & clFilesScanner::kIsSymlink)) {
+                jobs.push_back({ child, true });
+            }
+            continue;
+        }
+
+        wxFileOffset leftSize = 0, rightSize = 0;
+        time_t leftTime = 0, rightTime = 0;
+        if(!get_file_info(entry.fullpath, leftSize, leftTime) ||
+           !get_file_info(join_path(m_right, child), rightSize, rightTime)) {
+            results.push_back({ child, eStatus::kChanged, false });
+        } else if(leftSize != rightSize) {
+            results.push_back({ child, eStatus::kChanged, false });
+        } else if(leftSize == 0 || leftTime == rightTime) {
+            // same size and modification time: assume the content is the same, as rsync does
+            results.push_back({ child, eStatus::kSame, false });
+        } else if(leftSize >= LARGE_FILE_SIZE) {
+            jobs.push_back({ child, false });
+        } else {
+            bool same = CompareFiles(entry.fullpath, join_path(m_right, child));
+            results.push_back({ child, same ? eStatus::kSame : eStatus::kChanged, false });
+        }
+    }
+
+    for(const auto& [name, flags] : rightFlags) {
+        results.push_back({ join_path(path, name), eStatus::kRightOnly, bool(flags & clFilesScanner::kIsFolder) });
+    }
+}
+
+void DiffFoldersComparer::OnResults()
+{
+    if(!m_running) {
+        // queued before Stop()
+        return;
+    }
+
+    std::vector<Result> results;
+    bool done = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        results.swap(m_results);
+        done = m_done;
+        m_posted = false;
+    }
+
+    if(done) {
+        // the workers are exiting (or already exited)
+        for(auto& thr : m_threads) {
+            thr.join();
+        }
+        m_threads.clear();
+        m_running = false;
+        clDEBUG() << "Folders comparison completed" << endl;
+    }
+    m_callback(results, done);
+}
+
+bool DiffFoldersComparer::CompareFiles(const wxString& left, const wxString& right)
+{
+    wxFFile fpLeft;
+    wxFFile fpRight;
+    if(!wxFileExists(left) || !wxFileExists(right) || !fpLeft.Open(left, "rb") || !fpRight.Open(right, "rb")) {
+        return false;
+    }
+
+    // compare chunk by chunk: unlike a checksum, this stops at the first difference
+    std::vector<char> leftBuffer(READ_CHUNK_SIZE);
+    std::vector<char> rightBuffer(READ_CHUNK_SIZE);
+    while(true) {
+        size_t leftCount = fpLeft.Read(leftBuffer.data(), leftBuffer.size());
+        size_t rightCount = fpRight.Read(rightBuffer.data(), rightBuffer.size());
+        if(leftCount != rightCount || fpLeft.Error() || fpRight.Error()) {
+            return false;
+        }
+        if(leftCount == 0) {
+            return true;
+        }
+        if(std::memcmp(leftBuffer.data(), rightBuffer.data(), leftCount) != 0) {
+            return false;
+        }
+    }
+}
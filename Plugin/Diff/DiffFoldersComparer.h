@@ -0,0 +1,81 @@
+#ifndef DIFFFOLDERSCOMPARER_H
+#define DIFFFOLDERSCOMPARER_H
+
+#include "codelite_exports.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <wx/event.h>
+#include <wx/string.h>
+
+/// Recursive comparison of two folders.
+/// The folders are walked and the files compared on a pool of worker threads. Results are delivered on the main
+/// thread in batches, while the comparison is still running
+class WXDLLIMPEXP_SDK DiffFoldersComparer : public wxEvtHandler
+{
+public:
+    enum class eStatus {
+        kSame,
+        kChanged,
+        kLeftOnly,
+        kRightOnly,
+    };
+
+    struct Result {
+        wxString path; // relative to the compared folders
+        eStatus status = eStatus::kSame;
+        bool is_folder = false;
+    };
+
+    /// called on the main thread with the next batch of results, `done` is set on the last call
+    using Callback_t = std::function<void(const std::vector<Result>& results, bool done)>;
+
+private:
+    struct Job {
+        wxString path;
+        bool is_folder = false;
+    };
+
+    wxString m_left;
+    wxString m_right;
+    Callback_t m_callback;
+    std::vector<std::thread> m_threads;
+    std::atomic_bool m_stop{ false };
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Job> m_jobs;
+    size_t m_pending = 0;          // queued or running jobs
+    std::vector<Result> m_results; // not delivered yet
+    bool m_posted = false;         // OnResults() is queued
+    bool m_done = false;           // the last job completed
+    bool m_running = false;
+    std::chrono::steady_clock::time_point m_lastPost;
+
+    void WorkerMain();
+    void CompareFolder(const wxString& path, std::vector<Job>& jobs, std::vector<Result>& results);
+    void OnResults();
+
+public:
+    DiffFoldersComparer(const wxString& left, const wxString& right, const Callback_t& callback);
+    ~DiffFoldersComparer() override;
+
+    /// start comparing the folders
+    void Start();
+
+    /// cancel the comparison and wait for the worker threads. No results are delivered afterwards
+    void Stop();
+
+    bool IsRunning() const { return m_running; }
+
+    /// compare the content of two files
+    static bool CompareFiles(const wxString& left, const wxString& right);
+};
+
+#endif // DIFFFOLDERSCOMPARER_H
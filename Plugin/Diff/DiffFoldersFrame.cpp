@@ -28,6 +28,8 @@ DiffFoldersFrame::DiffFoldersFrame(wxWindow* parent)
     m_toolbar->AddSeparator();
     m_toolbar->AddTool(XRCID("diff-intersection"), _("Show similar files only"), images->Add("intersection"), "",
                        wxITEM_CHECK);
+    m_toolbar->AddTool(XRCID("diff-recursive"), _("Compare sub-folders recursively"),
+                       images->Add("folder-yellow-opened"), "", wxITEM_CHECK);
     m_toolbar->AddSeparator();
     m_toolbar->AddTool(XRCID("diff-up-folder"), _("Parent folder"), images->Add("up"));
     m_toolbar->AssignBitmaps(images);
@@ -37,6 +39,8 @@ DiffFoldersFrame::DiffFoldersFrame(wxWindow* parent)
     m_toolbar->Bind(wxEVT_TOOL, &DiffFoldersFrame::OnClose, this, wxID_CLOSE);
     m_toolbar->Bind(wxEVT_TOOL, &DiffFoldersFrame::OnShowSimilarFiles, this, XRCID("diff-intersection"));
     m_toolbar->Bind(wxEVT_UPDATE_UI, &DiffFoldersFrame::OnShowSimilarFilesUI, this, XRCID("diff-intersection"));
+    m_toolbar->Bind(wxEVT_TOOL, &DiffFoldersFrame::OnRecursive, this, XRCID("diff-recursive"));
+    m_toolbar->Bind(wxEVT_UPDATE_UI, &DiffFoldersFrame::OnRecursiveUI, this, XRCID("diff-recursive"));
     m_toolbar->Bind(wxEVT_TOOL, &DiffFoldersFrame::OnRefresh, this, wxID_REFRESH);
     m_toolbar->Bind(wxEVT_UPDATE_UI, &DiffFoldersFrame::OnRefreshUI, this, wxID_REFRESH);
     m_toolbar->Bind(wxEVT_TOOL, &DiffFoldersFrame::OnUpFolder, this, XRCID("diff-up-folder"));
@@ -46,12 +50,15 @@ DiffFoldersFrame::DiffFoldersFrame(wxWindow* parent)
 
     // Load persistent items
     m_showSimilarItems = clConfig::Get().Read("DiffFolders/ShowSimilarItems", false);
+    m_recursive = clConfig::Get().Read("DiffFolders/Recursive", false);
 }
 
 DiffFoldersFrame::~DiffFoldersFrame()
 {
     clConfig::Get().Write("DiffFolders/ShowSimilarItems", m_showSimilarItems);
+    clConfig::Get().Write("DiffFolders/Recursive", m_recursive);
     StopChecksumThread();
+    m_comparer.reset();
 }
 
 void DiffFoldersFrame::OnClose(wxCommandEvent& event)
@@ -75,40 +82,6 @@ void DiffFoldersFrame::OnNewComparison(wxCommandEvent& event)
     }
 }
 
-#define CLOSE_FP(fp)      \
-    {                     \
-        if(fp) {          \
-            fclose(fp);   \
-            fp = nullptr; \
-        }                 \
-    }
-
-static bool CompareFilesCheckSum(const wxString& fn1, const wxString& fn2)
-{
-    // The sizes are the same
-    unsigned char checksum1 = 0;
-    unsigned char checksum2 = 0;
-
-    FILE* fp1 = fopen(fn1.mb_str(), "rb");
-    FILE* fp2 = fopen(fn2.mb_str(), "rb");
-    if(!fp1 || !fp2) {
-        CLOSE_FP(fp1);
-        CLOSE_FP(fp2);
-        return false;
-    }
-
-    while(!feof(fp1) && !ferror(fp1) && !feof(fp2) && !ferror(fp2)) {
-        checksum1 ^= fgetc(fp1);
-        checksum2 ^= fgetc(fp2);
-        if(checksum1 != checksum2) {
-            break;
-        }
-    }
-    CLOSE_FP(fp1);
-    CLOSE_FP(fp2);
-    return (checksum1 == checksum2);
-}
-
 static void HelperThreadCalculateChecksum(int callId, const wxArrayString& items, const wxString& left,
                                           const wxString& right, DiffFoldersFrame* sink)
 {
@@ -124,7 +97,7 @@ static void HelperThreadCalculateChecksum(int callId, const wxArrayString& items
                 // If the size is different, no need to go further
                 results.Add("different");
             } else {
-                bool isSame = CompareFilesCheckSum(fnLeft.GetFullPath(), fnRight.GetFullPath());
+                bool isSame = DiffFoldersComparer::CompareFiles(fnLeft.GetFullPath(), fnRight.GetFullPath());
                 results.Add(isSame ? "same" : "different");
             }
         } else {
@@ -139,9 +112,12 @@ static void HelperThreadCalculateChecksum(int callId, const wxArrayString& items
 void DiffFoldersFrame::BuildTrees(const wxString& left, const wxString& right)
 {
     StopChecksumThread();
+    m_comparer.reset();
     wxBusyCursor bc;
     m_dvListCtrl->DeleteAllItems();
     m_entries.clear();
+    m_recursiveEntries.clear();
+    m_summaries.clear();
     m_dvListCtrl->SetSortFunction(nullptr);
     m_leftFolder = left;
     m_rightFolder = right;
@@ -149,8 +125,11 @@ void DiffFoldersFrame::BuildTrees(const wxString& left, const wxString& right)
     m_dvListCtrl->GetColumn(1)->SetLabel(right);
     m_dvListCtrl->SetBitmaps(clGetManager()->GetStdIcons()->GetStandardMimeBitmapListPtr());
 
-    // Set up the roots
-    wxVector<wxVariant> cols;
+    if(m_recursive) {
+        BuildRecursive(left, right);
+        return;
+    }
+    SetTitle(_("Diff Folders"));
 
     clFilesScanner::EntryData::Vec_t leftFiles;
     clFilesScanner::EntryData::Vec_t rightFiles;
@@ -190,7 +169,6 @@ void DiffFoldersFrame::BuildTrees(const wxString& left, const wxString& right)
     m_entries = viewList.ToSortedVector();
     wxArrayString displayedItems;
     for(size_t i = 0; i < m_entries.size(); ++i) {
-        cols.clear();
         const DiffViewEntry& entry = m_entries[i];
 
         // If the "show similar files" button is clicked, display only files that exists in both lists
@@ -200,23 +178,206 @@ void DiffFoldersFrame::BuildTrees(const wxString& left, const wxString& right)
 
         // This will be passed to the checksum thread
         displayedItems.Add(entry.GetFullName());
+        DoAppendEntry(entry);
+    }
 
-        if(entry.IsExistsInLeft()) {
-            cols.push_back(::MakeBitmapIndexText(entry.GetLeft().fullpath, entry.GetImageId(true)));
-        } else {
-            cols.push_back(::MakeBitmapIndexText("", wxNOT_FOUND));
+    m_checksumThread = new std::thread(&HelperThreadCalculateChecksum, (++nCallCounter), displayedItems, m_leftFolder,
+                                       m_rightFolder, this);
+}
+
+wxDataViewItem DiffFoldersFrame::DoAppendEntry(const DiffViewEntry& entry)
+{
+    wxVector<wxVariant> cols;
+    if(entry.IsExistsInLeft()) {
+        cols.push_back(::MakeBitmapIndexText(entry.GetLeft().fullpath, entry.GetImageId(true)));
+    } else {
+        cols.push_back(::MakeBitmapIndexText("", wxNOT_FOUND));
+    }
+
+    if(entry.IsExistsInRight()) {
+        cols.push_back(::MakeBitmapIndexText(entry.GetRight().fullpath, entry.GetImageId(false)));
+    } else {
+        cols.push_back(::MakeBitmapIndexText("", wxNOT_FOUND));
+    }
+    return m_dvListCtrl->AppendItem(cols, (wxUIntPtr)&entry);
+}
+
+wxColour DiffFoldersFrame::GetModifiedColour() const
+{
+    bool isDark = DrawingUtils::IsDark(m_dvListCtrl->GetColours().GetBgColour());
+    return isDark ? wxColour("rgb(255, 128, 64)") : *wxRED;
+}
+
+void DiffFoldersFrame::BuildRecursive(const wxString& left, const wxString& right)
+{
+    m_sameCount = 0;
+    m_comparer.reset(new DiffFoldersComparer(
+        left, right, [this](const std::vector<DiffFoldersComparer::Result>& results, bool done) {
+            OnCompareResults(results, done);
+        }));
+    m_comparer->Start();
+    UpdateTitle(false);
+}
+
+void DiffFoldersFrame::OnCompareResults(const std::vector<DiffFoldersComparer::Result>& results, bool done)
+{
+    const wxString sep = wxFileName::GetPathSeparator();
+    wxColour modifiedColour = GetModifiedColour();
+
+    m_dvListCtrl->Freeze();
+    for(const auto& result : results) {
+        if(result.status == DiffFoldersComparer::eStatus::kSame) {
+            ++m_sameCount;
+            continue;
         }
 
-        if(entry.IsExistsInRight()) {
-            cols.push_back(::MakeBitmapIndexText(entry.GetRight().fullpath, entry.GetImageId(false)));
-        } else {
-            cols.push_back(::MakeBitmapIndexText("", wxNOT_FOUND));
+        // roll the difference up to all the parent folders, the root folder is ""
+        wxString folder = result.path.BeforeLast(sep[0]);
+        while(true) {
+            FolderSummary& summary = m_summaries[folder];
+            switch(result.status) {
+            case DiffFoldersComparer::eStatus::kChanged:
+                ++summary.changed;
+                break;
+            case DiffFoldersComparer::eStatus::kLeftOnly:
+                ++summary.leftOnly;
+                break;
+            case DiffFoldersComparer::eStatus::kRightOnly:
+            default:
+                ++summary.rightOnly;
+                break;
+            }
+            if(folder.empty()) {
+                break;
+            }
+            folder = folder.BeforeLast(sep[0]);
+        }
+
+        clFilesScanner::EntryData data;
+        data.flags = result.is_folder ? clFilesScanner::kIsFolder : clFilesScanner::kIsFile;
+        DiffViewEntry entry;
+        if(result.status != DiffFoldersComparer::eStatus::kRightOnly) {
+            data.fullpath = m_leftFolder + sep + result.path;
+            entry.SetLeft(data);
+        }
+        if(result.status != DiffFoldersComparer::eStatus::kLeftOnly) {
+            data.fullpath = m_rightFolder + sep + result.path;
+            entry.SetRight(data);
+        }
+        m_recursiveEntries.push_back(entry);
+
+        // the sorted view is built once the comparison is completed, until then the rows are displayed as they arrive
+        if(!done && (!m_showSimilarItems || entry.IsExistsInBoth())) {
+            wxDataViewItem item = DoAppendEntry(m_recursiveEntries.back());
+            if(entry.IsExistsInBoth()) {
+                m_dvListCtrl->SetItemTextColour(item, modifiedColour, 0);
+                m_dvListCtrl->SetItemTextColour(item, modifiedColour, 1);
+            }
         }
-        m_dvListCtrl->AppendItem(cols, (wxUIntPtr)&entry);
     }
+    m_dvListCtrl->Thaw();
 
-    m_checksumThread = new std::thread(&HelperThreadCalculateChecksum, (++nCallCounter), displayedItems, m_leftFolder,
-                                       m_rightFolder, this);
+    if(done) {
+        ShowRecursiveResults();
+    }
+    UpdateTitle(done);
+}
+
+void DiffFoldersFrame::ShowRecursiveResults()
+{
+    const wxString sep = wxFileName::GetPathSeparator();
+    // sort with the separator before any other character, so each folder is followed by its content
+    auto sort_key = [&sep](const wxString& path) {
+        wxString key = path;
+        key.Replace(sep, "\x01");
+        return key;
+    };
+
+    struct Row {
+        wxString key;
+        const DiffViewEntry* entry = nullptr;
+        const FolderSummary* summary = nullptr; // set for the folder rows
+    };
+
+    std::vector<Row> rows;
+    rows.reserve(m_recursiveEntries.size() + m_summaries.size());
+    for(const DiffViewEntry& entry : m_recursiveEntries) {
+        if(!m_showSimilarItems || entry.IsExistsInBoth()) {
+            const wxString& fullpath = entry.IsExistsInLeft() ? entry.GetLeft().fullpath : entry.GetRight().fullpath;
+            const wxString& root = entry.IsExistsInLeft() ? m_leftFolder : m_rightFolder;
+            rows.push_back({ sort_key(fullpath.Mid(root.length() + 1)), &entry, nullptr });
+        }
+    }
+
+    for(const auto& [folder, summary] : m_summaries) {
+        // the totals of the root folder are displayed in the title
+        if(folder.empty() || (m_showSimilarItems && summary.changed == 0)) {
+            continue;
+        }
+        clFilesScanner::EntryData data;
+        data.flags = clFilesScanner::kIsFolder;
+        DiffViewEntry entry;
+        data.fullpath = m_leftFolder + sep + folder;
+        entry.SetLeft(data);
+        data.fullpath = m_rightFolder + sep + folder;
+        entry.SetRight(data);
+        m_recursiveEntries.push_back(entry);
+        rows.push_back({ sort_key(folder), &m_recursiveEntries.back(), &summary });
+    }
+
+    std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) { return a.key < b.key; });
+
+    wxColour modifiedColour = GetModifiedColour();
+    int folderImage = clGetManager()->GetStdIcons()->GetMimeImageId(FileExtManager::TypeFolder);
+
+    m_dvListCtrl->Freeze();
+    m_dvListCtrl->DeleteAllItems();
+    for(const Row& row : rows) {
+        if(row.summary) {
+            wxString counts;
+            auto add_count = [&counts](size_t count, const wxString& label) {
+                if(count) {
+                    counts << (counts.empty() ? "" : ", ") << count << label;
+                }
+            };
+            add_count(row.summary->changed, _(" changed"));
+            add_count(row.summary->leftOnly, _(" only in left"));
+            add_count(row.summary->rightOnly, _(" only in right"));
+
+            wxString folder = row.entry->GetLeft().fullpath.Mid(m_leftFolder.length() + 1);
+            wxVector<wxVariant> cols;
+            cols.push_back(::MakeBitmapIndexText(folder, folderImage));
+            cols.push_back(::MakeBitmapIndexText(counts, wxNOT_FOUND));
+            wxDataViewItem item = m_dvListCtrl->AppendItem(cols, (wxUIntPtr)row.entry);
+            m_dvListCtrl->SetItemBold(item, true, 0);
+            m_dvListCtrl->SetItemBold(item, true, 1);
+            continue;
+        }
+
+        wxDataViewItem item = DoAppendEntry(*row.entry);
+        if(row.entry->IsExistsInBoth()) {
+            m_dvListCtrl->SetItemTextColour(item, modifiedColour, 0);
+            m_dvListCtrl->SetItemTextColour(item, modifiedColour, 1);
+        }
+    }
+    m_dvListCtrl->Thaw();
+}
+
+void DiffFoldersFrame::UpdateTitle(bool done)
+{
+    FolderSummary total;
+    auto iter = m_summaries.find(wxEmptyString);
+    if(iter != m_summaries.end()) {
+        total = iter->second;
+    }
+
+    wxString title;
+    title << _("Diff Folders") << " - " << total.changed << _(" changed, ") << total.leftOnly << _(" only in left, ")
+          << total.rightOnly << _(" only in right, ") << m_sameCount << _(" identical");
+    if(!done) {
+        title << _(" (comparing...)");
+    }
+    SetTitle(title);
 }
 
 void DiffFoldersFrame::OnItemActivated(wxDataViewEvent& event)
@@ -228,14 +389,12 @@ void DiffFoldersFrame::OnItemActivated(wxDataViewEvent& event)
 
     if(entry->IsExistsInBoth() && (entry->GetLeft().flags & clFilesScanner::kIsFolder) &&
        (entry->GetRight().flags & clFilesScanner::kIsFolder)) {
-        // Refresh the view to the current folder
-        wxFileName left(m_leftFolder, "");
-        wxFileName right(m_rightFolder, "");
-        left.AppendDir(entry->GetFullName());
-        right.AppendDir(entry->GetFullName());
+        // Refresh the view to the current folder. In the recursive view, the folder may be several levels below
+        wxFileName left(entry->GetLeft().fullpath, "");
+        wxFileName right(entry->GetRight().fullpath, "");
+        m_depth += left.GetDirCount() - wxFileName(m_leftFolder, "").GetDirCount();
         m_leftFolder = left.GetPath();
         m_rightFolder = right.GetPath();
-        ++m_depth;
         CallAfter(&DiffFoldersFrame::BuildTrees, m_leftFolder, m_rightFolder);
     } else {
         DoOpenDiff(event.GetItem());
@@ -249,6 +408,17 @@ void DiffFoldersFrame::OnItemContextMenu(wxDataViewEvent& event)
     wxString right = m_dvListCtrl->GetItemText(item, 1);
 
     wxMenu menu;
+    if(m_recursive) {
+        // copying is only supported for the items of the displayed folder
+        DiffViewEntry* entry = reinterpret_cast<DiffViewEntry*>(m_dvListCtrl->GetItemData(item));
+        if(entry && entry->IsExistsInBoth() && !(entry->GetLeft().flags & clFilesScanner::kIsFolder)) {
+            menu.Append(XRCID("diff-open-diff"), _("Diff"));
+            menu.Bind(wxEVT_MENU, &DiffFoldersFrame::OnMenuDiff, this, XRCID("diff-open-diff"));
+            m_dvListCtrl->PopupMenu(&menu);
+        }
+        return;
+    }
+
     if(!right.IsEmpty()) {
         menu.Append(XRCID("diff-copy-right-to-left"), _("Copy from Right to Left"));
         menu.Bind(wxEVT_MENU, &DiffFoldersFrame::OnCopyToLeft, this, XRCID("diff-copy-right-to-left"));
@@ -291,6 +461,19 @@ void DiffFoldersFrame::OnShowSimilarFilesUI(wxUpdateUIEvent& event)
     }
 }
 
+void DiffFoldersFrame::OnRecursive(wxCommandEvent& event)
+{
+    event.Skip();
+    m_recursive = event.IsChecked();
+    BuildTrees(m_leftFolder, m_rightFolder);
+}
+
+void DiffFoldersFrame::OnRecursiveUI(wxUpdateUIEvent& event)
+{
+    event.Enable(!m_leftFolder.IsEmpty() && !m_rightFolder.IsEmpty());
+    event.Check(m_recursive);
+}
+
 void DiffFoldersFrame::DoOpenDiff(const wxDataViewItem& item)
 {
     if(!item.IsOk()) {
@@ -340,8 +523,7 @@ void DiffFoldersFrame::OnChecksum(int callId, const wxArrayString& checksumArray
     if(callId != nCallCounter) {
         return;
     }
-    bool isDark = DrawingUtils::IsDark(m_dvListCtrl->GetColours().GetBgColour());
-    wxColour modifiedColour = isDark ? wxColour("rgb(255, 128, 64)") : *wxRED;
+    wxColour modifiedColour = GetModifiedColour();
     for(size_t i = 0; i < checksumArray.size(); ++i) {
         const wxString& answer = checksumArray.Item(i);
         if(answer == "different") {
@@ -367,7 +549,7 @@ void DiffFoldersFrame::OnRefreshUI(wxUpdateUIEvent& event)
 
 void DiffFoldersFrame::StopChecksumThread()
 {
-    checksumThreadStop.store(false);
+    checksumThreadStop.store(true);
     if(m_checksumThread) {
         m_checksumThread->join();
     }
@@ -1,6 +1,7 @@
 #ifndef DIFFFOLDERSFRAME_H
 #define DIFFFOLDERSFRAME_H
 
+#include "DiffFoldersComparer.h"
 #include "DiffUI.h"
 #include "bitmap_loader.h"
 #include "clFilesCollector.h"
@@ -8,6 +9,9 @@
 #include "globals.h"
 #include "imanager.h"
 
+#include <deque>
+#include <map>
+#include <memory>
 #include <thread>
 
 struct WXDLLIMPEXP_SDK DiffViewEntry {
@@ -109,6 +113,19 @@ class WXDLLIMPEXP_SDK DiffFoldersFrame : public DiffFoldersBaseDlg
     std::thread* m_checksumThread = nullptr;
     DiffViewEntry::Vect_t m_entries;
 
+    struct FolderSummary {
+        size_t changed = 0;
+        size_t leftOnly = 0;
+        size_t rightOnly = 0;
+    };
+
+    // recursive comparison
+    bool m_recursive = false;
+    std::unique_ptr<DiffFoldersComparer> m_comparer;
+    std::deque<DiffViewEntry> m_recursiveEntries;  // a deque, so the rows can keep pointers while results arrive
+    std::map<wxString, FolderSummary> m_summaries; // relative folder -> differences found below it
+    size_t m_sameCount = 0;
+
 public:
     explicit DiffFoldersFrame(wxWindow* parent);
     ~DiffFoldersFrame() override;
@@ -116,6 +133,12 @@ public:
     void OnChecksum(int callId, const wxArrayString& checksumArray);
 protected:
     void BuildTrees(const wxString& left, const wxString& right);
+    void BuildRecursive(const wxString& left, const wxString& right);
+    void OnCompareResults(const std::vector<DiffFoldersComparer::Result>& results, bool done);
+    void ShowRecursiveResults();
+    void UpdateTitle(bool done);
+    wxDataViewItem DoAppendEntry(const DiffViewEntry& entry);
+    wxColour GetModifiedColour() const;
     void DoOpenDiff(const wxDataViewItem& item);
     void StopChecksumThread();
     bool CanUp() const;
@@ -131,6 +154,8 @@ protected:
     void OnNewComparison(wxCommandEvent& event);
     void OnShowSimilarFiles(wxCommandEvent& event);
     void OnShowSimilarFilesUI(wxUpdateUIEvent& event);
+    void OnRecursive(wxCommandEvent& event);
+    void OnRecursiveUI(wxUpdateUIEvent& event);
     void OnRefresh(wxCommandEvent& event);
     void OnRefreshUI(wxUpdateUIEvent& event);
     void OnUpFolder(wxCommandEvent& event);
@@ -27,11 +27,250 @@
 
 #include "dtl/dtl.hpp"
 #include "fileutils.h"
+#include "wxStringHash.h"
 
+#include <algorithm>
+#include <unordered_map>
 #include <wx/ffile.h>
-#include <wx/tokenzr.h>
 #include <wx/utils.h>
 
+namespace
+{
+// lines repeated more than this in a region (braces, empty lines) are not used as anchors by the histogram diff
+constexpr int MAX_CHAIN_LENGTH = 64;
+
+enum class EditType { COMMON, ADD, DELETE };
+
+struct Edit {
+    EditType type;
+    int index; // line in `before` for COMMON and DELETE, line in `after` for ADD
+};
+
+/// split `text` into lines, each line keeps its terminating "\n"
+std::vector<wxString> split_lines(const wxString& text)
+{
+    std::vector<wxString> lines;
+    size_t start = 0;
+    while (start < text.length()) {
+        size_t eol = text.find('\n', start);
+        if (eol == wxString::npos) {
+            lines.push_back(text.substr(start));
+            break;
+        }
+        lines.push_back(text.substr(start, eol - start + 1));
+        start = eol + 1;
+    }
+    return lines;
+}
+
+struct LineHash {
+    size_t operator()(const wxString* line) const { return std::hash<wxString>{}(*line); }
+};
+
+struct LineEqual {
+    bool operator()(const wxString* a, const wxString* b) const { return *a == *b; }
+};
+
+/// map the lines of both files to integers, equal lines get the same ID. Return the number of distinct lines
+size_t intern_lines(const std::vector<wxString>& before,
+                    const std::vector<wxString>& after,
+                    std::vector<int>& before_ids,
+                    std::vector<int>& after_ids)
+{
+    std::unordered_map<const wxString*, int, LineHash, LineEqual> ids;
+    ids.reserve(before.size() + after.size());
+    auto intern = [&ids](const std::vector<wxString>& lines, std::vector<int>& result) {
+        result.reserve(lines.size());
+        for (const wxString& line : lines) {
+            result.push_back(ids.insert({ &line, (int)ids.size() }).first->second);
+        }
+    };
+    intern(before, before_ids);
+    intern(after, after_ids);
+    return ids.size();
+}
+
+/// Histogram diff (as in git and JGit) of sequences of line IDs.
+/// Lines that are rare in both sequences are used as anchors: the longest common run containing the rarest line is
+/// matched and the regions before and after it are processed the same way. Regions without such a line fall back
+/// to the Myers diff of dtl
+class HistogramDiff
+{
+    struct Region {
+        int l0, l1; // [l0, l1) in m_left
+        int r0, r1; // [r0, r1) in m_right
+    };
+
+    const std::vector<int>& m_left;
+    const std::vector<int>& m_right;
+    std::vector<int> m_matches; // left line -> matching right line or -1
+    std::vector<int> m_count;   // ID -> number of occurrences in the left side of the current region
+    std::vector<int> m_last;    // ID -> last occurrence in the left side of the current region
+    std::vector<int> m_prev;    // left line -> previous occurrence of the same ID
+
+    /// return false if there is no anchor. `has_common` is set if the region has any common line
+    bool FindAnchor(const Region& region, Region& anchor, bool& has_common)
+    {
+        for (int i = region.l0; i < region.l1; ++i) {
+            int id = m_left[i];
+            m_prev[i] = m_last[id];
+            m_last[id] = i;
+            ++m_count[id];
+        }
+
+        has_common = false;
+        int best_count = MAX_CHAIN_LENGTH;
+        int best_len = 0;
+        for (int j = region.r0; j < region.r1;) {
+            int next_j = j + 1;
+            int count = m_count[m_right[j]];
+            has_common = has_common || count > 0;
+            if (count == 0 || count > best_count) {
+                j = next_j;
+                continue;
+            }
+
+            for (int i = m_last[m_right[j]]; i != -1; i = m_prev[i]) {
+                // extend the match in both directions
+                int ls = i, rs = j;
+                while (ls > region.l0 && rs > region.r0 && m_left[ls - 1] == m_right[rs - 1]) {
+                    --ls;
+                    --rs;
+                }
+                int le = i + 1, re = j + 1;
+                while (le < region.l1 && re < region.r1 && m_left[le] == m_right[re]) {
+                    ++le;
+                    ++re;
+                }
+
+                int low = count;
+                for (int k = ls; k < le; ++k) {
+                    low = std::min(low, m_count[m_left[k]]);
+                }
+                if (best_len == 0 || low < best_count || (low == best_count && le - ls > best_len)) {
+                    best_count = low;
+                    best_len = le - ls;
+                    anchor = { ls, le, rs, re };
+                    // the lines of this run were already checked
+                    next_j = std::max(next_j, re);
+                }
+            }
+            j = next_j;
+        }
+
+        for (int i = region.l0; i < region.l1; ++i) {
+            m_count[m_left[i]] = 0;
+            m_last[m_left[i]] = -1;
+        }
+        return best_len > 0;
+    }
+
+    void FallbackDiff(const Region& region)
+    {
+        std::vector<int> left(m_left.begin() + region.l0, m_left.begin() + region.l1);
+        std::vector<int> right(m_right.begin() + region.r0, m_right.begin() + region.r1);
+        dtl::Diff<int, std::vector<int>> diff(left, right);
+        diff.onHuge();
+        diff.compose();
+
+        int i = region.l0;
+        int j = region.r0;
+        for (const auto& elem : diff.getSes().getSequence()) {
+            switch (elem.second.type) {
+            case dtl::SES_COMMON:
+                m_matches[i++] = j++;
+                break;
+            case dtl::SES_DELETE:
+                ++i;
+                break;
+            case dtl::SES_ADD:
+                ++j;
+                break;
+            }
+        }
+    }
+
+public:
+    HistogramDiff(const std::vector<int>& left, const std::vector<int>& right, size_t ids_count)
+        : m_left(left)
+        , m_right(right)
+        , m_matches(left.size(), -1)
+        , m_count(ids_count, 0)
+        , m_last(ids_count, -1)
+        , m_prev(left.size(), -1)
+    {
+    }
+
+    /// match the lines of m_left and m_right, return the matching right line of each left line (or -1)
+    const std::vector<int>& Compute()
+    {
+        int l0 = 0, r0 = 0;
+        int l1 = (int)m_left.size(), r1 = (int)m_right.size();
+
+        // common prefix and suffix
+        while (l0 < l1 && r0 < r1 && m_left[l0] == m_right[r0]) {
+            m_matches[l0++] = r0++;
+        }
+        while (l0 < l1 && r0 < r1 && m_left[l1 - 1] == m_right[r1 - 1]) {
+            m_matches[--l1] = --r1;
+        }
+
+        // regions are independent, so a work list is used instead of recursion (which may be very deep)
+        std::vector<Region> regions{ { l0, l1, r0, r1 } };
+        while (!regions.empty()) {
+            Region region = regions.back();
+            regions.pop_back();
+            if (region.l0 >= region.l1 || region.r0 >= region.r1) {
+                continue;
+            }
+
+            Region anchor;
+            bool has_common = false;
+            if (FindAnchor(region, anchor, has_common)) {
+                for (int i = anchor.l0; i < anchor.l1; ++i) {
+                    m_matches[i] = anchor.r0 + (i - anchor.l0);
+                }
+                regions.push_back({ region.l0, anchor.l0, region.r0, anchor.r0 });
+                regions.push_back({ anchor.l1, region.l1, anchor.r1, region.r1 });
+            } else if (has_common) {
+                FallbackDiff(region);
+            }
+        }
+        return m_matches;
+    }
+};
+
+/// the edit script transforming `before` into `after`. Deletions of a changed block come before its additions
+std::vector<Edit> compute_edits(const std::vector<wxString>& before, const std::vector<wxString>& after)
+{
+    std::vector<int> before_ids;
+    std::vector<int> after_ids;
+    size_t ids_count = intern_lines(before, after, before_ids, after_ids);
+
+    HistogramDiff diff(before_ids, after_ids, ids_count);
+    const std::vector<int>& matches = diff.Compute();
+
+    std::vector<Edit> edits;
+    edits.reserve(std::max(before.size(), after.size()));
+    int j = 0;
+    for (int i = 0; i < (int)matches.size(); ++i) {
+        if (matches[i] == -1) {
+            edits.push_back({ EditType::DELETE, i });
+            continue;
+        }
+        while (j < matches[i]) {
+            edits.push_back({ EditType::ADD, j++ });
+        }
+        edits.push_back({ EditType::COMMON, i });
+        ++j;
+    }
+    while (j < (int)after.size()) {
+        edits.push_back({ EditType::ADD, j++ });
+    }
+    return edits;
+}
+} // namespace
+
 void clDTL::Diff(const wxFileName& fnLeft, const wxFileName& fnRight, DiffMode mode)
 {
     wxString leftFile, rightFile;
@@ -46,26 +285,19 @@ void clDTL::DiffStrings(const wxString& before, const wxString& after, DiffMode
     m_resultRight.clear();
     m_sequences.clear();
 
-    using elem = wxString;
-    using sesElem = std::pair<elem, dtl::elemInfo>;
+    std::vector<wxString> leftLines = split_lines(before);
+    std::vector<wxString> rightLines = split_lines(after);
+    std::vector<Edit> seq = compute_edits(leftLines, rightLines);
 
-    wxArrayString leftLines = wxStringTokenize(before, "\n", wxTOKEN_RET_DELIMS);
-    wxArrayString rightLines = wxStringTokenize(after, "\n", wxTOKEN_RET_DELIMS);
-
-    std::vector<elem> leftLinesVec;
-    std::vector<elem> rightLinesVec;
-    leftLinesVec.insert(leftLinesVec.end(), leftLines.begin(), leftLines.end());
-    rightLinesVec.insert(rightLinesVec.end(), rightLines.begin(), rightLines.end());
-
-    dtl::Diff<elem, std::vector<elem>> diff(leftLinesVec, rightLinesVec);
-    diff.onHuge();
-    diff.compose();
-
-    if(0 == diff.getEditDistance()) {
+    if(std::all_of(seq.begin(), seq.end(), [](const Edit& edit) { return edit.type == EditType::COMMON; })) {
         // nothing to be done - files are identical
         return;
     }
 
+    auto line_of = [&](const Edit& edit) -> const wxString& {
+        return edit.type == EditType::ADD ? rightLines[edit.index] : leftLines[edit.index];
+    };
+
     if(mode & clDTL::kTwoPanes) {
 
         ///////////////////////////////////////////////////////////////////
@@ -74,8 +306,6 @@ void clDTL::DiffStrings(const wxString& before, const wxString& after, DiffMode
         // pane all deletions while on the right pane all the new lines
         ///////////////////////////////////////////////////////////////////
 
-        // Loop over the diff and check if it is a whitespace only diff
-        std::vector<sesElem> seq = diff.getSes().getSequence();
         m_resultLeft.reserve(seq.size());
         m_resultRight.reserve(seq.size());
 
@@ -90,8 +320,8 @@ void clDTL::DiffStrings(const wxString& before, const wxString& after, DiffMode
         LineInfoVec_t tmpSeqRight;
 
         for(size_t i = 0; i < seq.size(); ++i) {
-            switch(seq.at(i).second.type) {
-            case dtl::SES_COMMON: {
+            switch(seq.at(i).type) {
+            case EditType::COMMON: {
                 if(state == STATE_IN_SEQ) {
 
                     // set the sequence size
@@ -112,13 +342,13 @@ void clDTL::DiffStrings(const wxString& before, const wxString& after, DiffMode
                     tmpSeqRight.clear();
                     seqSize = 0;
                 }
-                clDTL::LineInfo line(seq.at(i).first, LINE_COMMON);
+                clDTL::LineInfo line(line_of(seq.at(i)), LINE_COMMON);
                 m_resultLeft.push_back(line);
                 m_resultRight.push_back(line);
                 break;
             }
-            case dtl::SES_ADD: {
-                clDTL::LineInfo lineRight(seq.at(i).first, LINE_ADDED);
+            case EditType::ADD: {
+                clDTL::LineInfo lineRight(line_of(seq.at(i)), LINE_ADDED);
                 tmpSeqRight.push_back(lineRight);
 
                 if(state == STATE_NONE) {
@@ -127,8 +357,8 @@ void clDTL::DiffStrings(const wxString& before, const wxString& after, DiffMode
                 }
                 break;
             }
-            case dtl::SES_DELETE: {
-                clDTL::LineInfo lineLeft(seq.at(i).first, LINE_REMOVED);
+            case EditType::DELETE: {
+                clDTL::LineInfo lineLeft(line_of(seq.at(i)), LINE_REMOVED);
                 tmpSeqLeft.push_back(lineLeft);
 
                 if(state == STATE_NONE) {
@@ -165,33 +395,32 @@ void clDTL::DiffStrings(const wxString& before, const wxString& after, DiffMode
         // One pane diff view
         // designed for displayed on a single editor
         ///////////////////////////////////////////////////////////////////
-        std::vector<sesElem> seq = diff.getSes().getSequence();
         m_resultLeft.reserve(seq.size());
         int seqStartLine = wxNOT_FOUND;
         for(size_t i = 0; i < seq.size(); ++i) {
-            switch(seq.at(i).second.type) {
-            case dtl::SES_COMMON: {
+            switch(seq.at(i).type) {
+            case EditType::COMMON: {
                 if(seqStartLine != wxNOT_FOUND) {
                     m_sequences.push_back(std::make_pair(seqStartLine, m_resultLeft.size()));
                     seqStartLine = wxNOT_FOUND;
                 }
-                clDTL::LineInfo line(seq.at(i).first, LINE_COMMON);
+                clDTL::LineInfo line(line_of(seq.at(i)), LINE_COMMON);
                 m_resultLeft.push_back(line);
                 break;
             }
-            case dtl::SES_ADD: {
+            case EditType::ADD: {
                 if(seqStartLine == wxNOT_FOUND) {
                     seqStartLine = m_resultLeft.size();
                 }
-                clDTL::LineInfo line(seq.at(i).first, LINE_ADDED);
+                clDTL::LineInfo line(line_of(seq.at(i)), LINE_ADDED);
                 m_resultLeft.push_back(line);
                 break;
             }
-            case dtl::SES_DELETE: {
+            case EditType::DELETE: {
                 if(seqStartLine == wxNOT_FOUND) {
                     seqStartLine = m_resultLeft.size();
                 }
-                clDTL::LineInfo line(seq.at(i).first, LINE_REMOVED);
+                clDTL::LineInfo line(line_of(seq.at(i)), LINE_REMOVED);
                 m_resultLeft.push_back(line);
                 break;
             }
@@ -207,38 +436,24 @@ void clDTL::DiffStrings(const wxString& before, const wxString& after, DiffMode
 
 std::vector<PatchStep> clDTL::CreatePatch(const wxString& before, const wxString& after) const
 {
-    using elem = wxString;
-    using sesElem = std::pair<elem, dtl::elemInfo>;
-
-    wxArrayString leftLines = wxStringTokenize(before, "\n", wxTOKEN_RET_DELIMS);
-    wxArrayString rightLines = wxStringTokenize(after, "\n", wxTOKEN_RET_DELIMS);
-
-    std::vector<elem> leftLinesVec;
-    std::vector<elem> rightLinesVec;
-    leftLinesVec.insert(leftLinesVec.end(), leftLines.begin(), leftLines.end());
-    rightLinesVec.insert(rightLinesVec.end(), rightLines.begin(), rightLines.end());
-
-    dtl::Diff<elem, std::vector<elem>> diff(leftLinesVec, rightLinesVec);
-    diff.onHuge();
-    diff.compose();
-
-    std::vector<sesElem> sesSeq = diff.getSes().getSequence();
+    std::vector<wxString> leftLines = split_lines(before);
+    std::vector<wxString> rightLines = split_lines(after);
+    std::vector<Edit> edits = compute_edits(leftLines, rightLines);
 
     int line = 0;
     std::vector<PatchStep> steps;
-    steps.reserve(sesSeq.size() * 2);
-    for(auto sesIt = sesSeq.begin(); sesIt != sesSeq.end(); ++sesIt, ++line) {
-        switch(sesIt->second.type) {
-        case dtl::SES_ADD: {
-            steps.push_back({ line, PatchAction::ADD_LINE, sesIt->first });
+    for(auto editIt = edits.begin(); editIt != edits.end(); ++editIt, ++line) {
+        switch(editIt->type) {
+        case EditType::ADD: {
+            steps.push_back({ line, PatchAction::ADD_LINE, rightLines[editIt->index] });
             break;
         }
-        case dtl::SES_DELETE: {
+        case EditType::DELETE: {
             steps.push_back({ line, PatchAction::DELETE_LINE, wxEmptyString });
             --line;
             break;
         }
-        case dtl::SES_COMMON:
+        case EditType::COMMON:
         default:
             break;
         }
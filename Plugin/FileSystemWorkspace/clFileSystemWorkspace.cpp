@@ -166,8 +166,8 @@ void clFileSystemWorkspace::GetWorkspaceFiles(wxArrayString& files) const
 {
     files.clear();
     files.Alloc(m_files.GetSize());
-    for (const wxFileName& file : m_files) {
-        files.Add(file.GetFullPath());
+    for (const wxString& file : m_files) {
+        files.Add(file);
     }
 }
 
@@ -439,6 +439,7 @@ void clFileSystemWorkspace::OnScanCompleted(clFileSystemEvent& event)
     for (const wxString& filename : event.GetPaths()) {
         m_files.Add(filename);
     }
+    clDEBUG() << "FSW: the file cache uses" << (m_files.GetPaths().GetMemoryUsage() / 1024) << "KB" << endl;
     clGetManager()->SetStatusMessage(_("File system scan completed"));
 
     // Trigger a non full reparse
@@ -168,7 +168,7 @@ public:
      */
     bool IsOpen() const { return m_isLoaded; }
 
-    const std::vector<wxFileName>& GetFiles() const { return m_files.GetFiles(); }
+    const clFileCache& GetFiles() const { return m_files; }
 
     wxString GetName() const override { return m_filename.GetName(); }
     void SetName(const wxString& name) { m_settings.SetName(name); }
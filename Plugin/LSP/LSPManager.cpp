@@ -694,6 +694,16 @@ LanguageServerProtocol::Ptr_t Manager::GetServerByName(const wxString& name)
     return m_servers[name];
 }
 
+std::vector<LanguageServerProtocol::Ptr_t> Manager::GetServers() const
+{
+    std::vector<LanguageServerProtocol::Ptr_t> servers;
+    servers.reserve(m_servers.size());
+    for (const auto& [_, server] : m_servers) {
+        servers.push_back(server);
+    }
+    return servers;
+}
+
 void Manager::RestartServer(const wxString& name)
 {
     {
@@ -54,6 +54,7 @@ public:
     void Reload(const std::unordered_set<wxString>& languages = {});
     LanguageServerProtocol::Ptr_t GetServerForEditor(IEditor* editor);
     LanguageServerProtocol::Ptr_t GetServerByName(const wxString& name);
+    std::vector<LanguageServerProtocol::Ptr_t> GetServers() const;
     LanguageServerProtocol::Ptr_t GetServerForLanguage(const wxString& lang);
     LanguageServerProtocol::Ptr_t GetServerForFileType(FileExtManager::FileType file_type);
     void ClearRestartCounters();
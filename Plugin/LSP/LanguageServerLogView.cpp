@@ -1,10 +1,36 @@
 #include "LanguageServerLogView.h"
 
+#include "LSPManager.hpp"
 #include "codelite_events.h"
 #include "event_notifier.h"
 
 #include <wx/menu.h>
 
+namespace
+{
+constexpr int LATENCY_REFRESH_INTERVAL_MS = 1000;
+
+wxString FormatLatencyRow(const wxString& method,
+                          const wxString& count,
+                          const wxString& avg,
+                          const wxString& p50,
+                          const wxString& p95,
+                          const wxString& max,
+                          const wxString& cancelled,
+                          const wxString& dropped)
+{
+    return wxString::Format("  %-40s %7s %7s %7s %7s %7s %7s %7s ",
+                            method,
+                            count,
+                            avg,
+                            p50,
+                            p95,
+                            max,
+                            cancelled,
+                            dropped);
+}
+} // namespace
+
 LanguageServerLogView::LanguageServerLogView(wxWindow* parent)
     : LanguageServerLogViewBase(parent)
 {
@@ -21,11 +47,32 @@ LanguageServerLogView::LanguageServerLogView(wxWindow* parent)
             wxID_CLEAR);
         m_dvListCtrl->PopupMenu(&menu);
     });
+    m_dvListCtrlLatency->Bind(wxEVT_CONTEXT_MENU, [this](wxContextMenuEvent& event) {
+        wxMenu menu;
+        menu.Append(wxID_CLEAR, _("Reset statistics"));
+        menu.Bind(
+            wxEVT_MENU,
+            [this](wxCommandEvent& event) {
+                wxUnusedVar(event);
+                for (auto server : LSP::Manager::GetInstance().GetServers()) {
+                    server->ClearLatencyStats();
+                }
+                UpdateLatencyView();
+            },
+            wxID_CLEAR);
+        m_dvListCtrlLatency->PopupMenu(&menu);
+    });
+    m_dvListCtrlLatency->SetScrollToBottom(false);
+
     EventNotifier::Get()->Bind(wxEVT_WORKSPACE_CLOSED, &LanguageServerLogView::OnWorkspaceClosed, this);
+    m_latencyTimer.Bind(wxEVT_TIMER, &LanguageServerLogView::OnLatencyTimer, this);
+    m_latencyTimer.Start(LATENCY_REFRESH_INTERVAL_MS);
 }
 
 LanguageServerLogView::~LanguageServerLogView()
 {
+    m_latencyTimer.Stop();
+    m_latencyTimer.Unbind(wxEVT_TIMER, &LanguageServerLogView::OnLatencyTimer, this);
     EventNotifier::Get()->Unbind(wxEVT_WORKSPACE_CLOSED, &LanguageServerLogView::OnWorkspaceClosed, this);
 }
 
@@ -34,3 +81,72 @@ void LanguageServerLogView::OnWorkspaceClosed(clWorkspaceEvent& event)
     event.Skip();
     m_dvListCtrl->DeleteAllItems();
 }
+
+void LanguageServerLogView::OnLatencyTimer(wxTimerEvent& event)
+{
+    wxUnusedVar(event);
+    // don't bother rendering a page that no one is looking at
+    if (!m_panelLatency->IsShownOnScreen()) {
+        return;
+    }
+    UpdateLatencyView();
+}
+
+void LanguageServerLogView::UpdateLatencyView()
+{
+    m_dvListCtrlLatency->Begin();
+    m_dvListCtrlLatency->DeleteAllItems();
+
+    // the histogram header: "<=10ms <=25ms ... >1000ms"
+    wxString buckets_header;
+    for (size_t bound : LSPLatencyHistogram::BUCKET_BOUNDS) {
+        buckets_header << wxString::Format("%7s ", wxString::Format("<=%zu", bound));
+    }
+    buckets_header << wxString::Format(
+        "%7s", wxString::Format(">%zu", LSPLatencyHistogram::BUCKET_BOUNDS[LSPLatencyHistogram::BUCKETS_COUNT - 2]));
+
+    for (auto server : LSP::Manager::GetInstance().GetServers()) {
+        const auto& stats = server->GetLatencyStats();
+        if (stats.empty()) {
+            continue;
+        }
+
+        auto& builder = m_dvListCtrlLatency->GetBuilder(true);
+        builder.Add(server->GetName(), AnsiColours::Magenta(), true);
+        m_dvListCtrlLatency->AddLine(builder.GetString(), false);
+
+        builder.Clear();
+        builder.Add(FormatLatencyRow(_("Method (times in ms)"),
+                                     _("Count"),
+                                     _("Avg"),
+                                     _("P50"),
+                                     _("P95"),
+                                     _("Max"),
+                                     _("Cancel"),
+                                     _("Stale")) +
+                        buckets_header,
+                    AnsiColours::Gray());
+        m_dvListCtrlLatency->AddLine(builder.GetString(), false);
+
+        for (const auto& [method, histogram] : stats) {
+            wxString buckets;
+            for (size_t count : histogram.GetBuckets()) {
+                buckets << wxString::Format("%7zu ", count);
+            }
+
+            builder.Clear();
+            builder.Add(FormatLatencyRow(method,
+                                         wxString() << histogram.GetCount(),
+                                         wxString() << histogram.GetAverage(),
+                                         wxString() << histogram.GetPercentile(50),
+                                         wxString() << histogram.GetPercentile(95),
+                                         wxString() << histogram.GetMax(),
+                                         wxString() << histogram.GetCancelled(),
+                                         wxString() << histogram.GetDropped()),
+                        AnsiColours::NormalText());
+            builder.Add(buckets, AnsiColours::Green());
+            m_dvListCtrlLatency->AddLine(builder.GetString(), false);
+        }
+    }
+    m_dvListCtrlLatency->Commit();
+}
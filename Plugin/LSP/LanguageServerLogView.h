@@ -3,13 +3,23 @@
 #include "UI.h"
 #include "clWorkspaceEvent.hpp"
 
+#include <wx/timer.h>
+
 class WXDLLIMPEXP_SDK LSPManager;
 class WXDLLIMPEXP_SDK LanguageServerLogView : public LanguageServerLogViewBase
 {
+    wxTimer m_latencyTimer;
+
 public:
     LanguageServerLogView(wxWindow* parent);
     virtual ~LanguageServerLogView();
 
 protected:
     void OnWorkspaceClosed(clWorkspaceEvent& event);
+    void OnLatencyTimer(wxTimerEvent& event);
+
+    /**
+     * @brief render the per-method response latency histograms of all the running servers
+     */
+    void UpdateLatencyView();
 };
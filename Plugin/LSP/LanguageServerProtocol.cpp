@@ -1,5 +1,6 @@
 #include "LanguageServerProtocol.h"
 
+#include "LSP/CancelRequestNotification.hpp"
 #include "LSP/CodeActionRequest.hpp"
 #include "LSP/CompletionRequest.h"
 #include "LSP/DidChangeTextDocumentRequest.h"
@@ -25,6 +26,7 @@
 #include "LSP/SignatureHelpRequest.h"
 #include "LSP/WorkspaceExecuteCommand.hpp"
 #include "LSP/WorkspaceSymbolRequest.hpp"
+#include "clTrace.hpp"
 #include "clWorkspaceManager.h"
 #include "cl_exception.h"
 #include "codelite_events.h"
@@ -38,12 +40,24 @@
 #include "imanager.h"
 #include "macros.h"
 
+#include <algorithm>
 #include <unordered_map>
 #include <wx/filesys.h>
 #include <wx/stc/stc.h>
 #include <wx/textdlg.h>
 
 thread_local wxString emptyString;
+
+namespace
+{
+// the maximum number of requests sent to the server without getting a response
+constexpr size_t MAX_REQUESTS_IN_FLIGHT = 32;
+// a request that was not answered by then no longer holds its in flight slot
+constexpr std::chrono::seconds IN_FLIGHT_TIMEOUT{ 30 };
+// the cancelled requests whose response may still arrive
+constexpr size_t MAX_CANCELLED_REQUESTS = 256;
+} // namespace
+
 FileExtManager::FileType LanguageServerProtocol::workspace_file_type = FileExtManager::TypeOther;
 
 LanguageServerProtocol::LanguageServerProtocol(const wxString& name, eNetworkType netType, wxEvtHandler* owner)
@@ -173,8 +187,16 @@ void LanguageServerProtocol::QueueMessage(LSP::MessageWithParams::Ptr_t request)
     }
 
     LSP_DEBUG() << "Sending" << request->GetMethod() << "request..." << endl;
-    if (request->As<LSP::CompletionRequest>()) {
-        m_lastCompletionRequestId = request->As<LSP::CompletionRequest>()->GetId();
+    LSP::Request* req = request->As<LSP::Request>();
+    if (req && !req->GetSupersedeKey().empty()) {
+        // older requests of the same kind for the same document are no longer needed: tell the server to stop
+        // working on them. Their responses (if any) are dropped once they arrive
+        for (int id : m_Queue.TakeSuperseded(req)) {
+            LSP_DEBUG() << GetLogPrefix() << "Cancelling request ID#" << id << "(superseded by ID#" << req->GetId()
+                        << ")" << endl;
+            m_latency[req->GetMethod()].AddCancelled();
+            m_Queue.Push(LSP::MessageWithParams::MakeRequest(new LSP::CancelRequestNotification(id)));
+        }
     }
     m_Queue.Push(request);
     ProcessQueue();
@@ -240,7 +262,6 @@ void LanguageServerProtocol::DoClear()
     m_state = kUnInitialized;
     m_initializeRequestID = wxNOT_FOUND;
     m_Queue.Clear();
-    m_lastCompletionRequestId = wxNOT_FOUND;
     // Destroy the current connection
     m_network->Close();
 }
@@ -249,6 +270,11 @@ bool LanguageServerProtocol::IsRunning() const { return m_network->IsConnected()
 
 bool LanguageServerProtocol::CanHandle(IEditor* editor) const
 {
+    if (editor->IsLargeFileMode()) {
+        // we do not sync files opened in "large file" mode with the server
+        return false;
+    }
+
     // use the local file path
     wxString lang = GetLanguageId(editor);
     return IsRunning() && m_languages.count(lang) != 0;
@@ -514,22 +540,35 @@ void LanguageServerProtocol::ProcessQueue()
     if (m_Queue.IsEmpty()) {
         return;
     }
-    if (m_Queue.IsWaitingReponse()) {
-        LSP_DEBUG() << "LSP is busy, will not send message";
-        return;
-    }
-    LSP::MessageWithParams::Ptr_t req = m_Queue.Get();
     if (!IsRunning()) {
         LSP_DEBUG() << GetLogPrefix() << "is down.";
         return;
     }
 
-    // Write the message length as string of 10 bytes
-    m_network->Send(req->ToString());
-    m_Queue.SetWaitingReponse(true);
-    m_Queue.Pop();
-    if (!req->GetStatusMessage().IsEmpty()) {
-        clGetManager()->SetStatusMessage(req->GetStatusMessage(), 1);
+    // Pipeline the queue: send everything we have without waiting for the responses. Responses are matched to
+    // their requests by ID. Messages are still sent in order, so a `didChange` always precedes the requests
+    // that depend on it
+    while (!m_Queue.IsEmpty()) {
+        if (m_Queue.GetInFlightCount() >= MAX_REQUESTS_IN_FLIGHT) {
+            for (const auto& [id, method] : m_Queue.TakeExpired(IN_FLIGHT_TIMEOUT)) {
+                LSP_DEBUG() << GetLogPrefix() << "Cancelling request ID#" << id << "(" << method
+                            << "), no response after" << IN_FLIGHT_TIMEOUT.count() << "seconds" << endl;
+                m_latency[method].AddCancelled();
+                m_Queue.Push(LSP::MessageWithParams::MakeRequest(new LSP::CancelRequestNotification(id)));
+            }
+        }
+        if (m_Queue.GetInFlightCount() >= MAX_REQUESTS_IN_FLIGHT) {
+            LSP_DEBUG() << GetLogPrefix() << m_Queue.GetInFlightCount()
+                        << "requests are waiting for a response, will send more messages later" << endl;
+            break;
+        }
+
+        LSP::MessageWithParams::Ptr_t req = m_Queue.Get();
+        m_network->Send(req->ToString());
+        m_Queue.Pop();
+        if (!req->GetStatusMessage().IsEmpty()) {
+            clGetManager()->SetStatusMessage(req->GetStatusMessage(), 1);
+        }
     }
 }
 
@@ -611,10 +650,10 @@ void LanguageServerProtocol::OnNetError(clCommandEvent& event)
 
 void LanguageServerProtocol::EventMainLoop(clCommandEvent& event)
 {
+    CL_TRACE_ZONE("LSP process messages");
     m_outputBuffer.append(event.GetStringRaw());
     LSP_DEBUG() << "Received data from LSP server of size:" << m_outputBuffer.size() << "bytes" << endl;
 
-    m_Queue.SetWaitingReponse(false);
     while (!m_outputBuffer.empty()) {
         // attempt to consume a complete JSON payload from the aggregated network buffer
         auto json = LSP::Message::GetJSONPayload(m_outputBuffer);
@@ -669,7 +708,30 @@ void LanguageServerProtocol::EventMainLoop(clCommandEvent& event)
             // other response
             LSP::ResponseMessage res(std::move(json));
             if (IsInitialized()) {
-                LSP::MessageWithParams::Ptr_t msg_ptr = m_Queue.TakePendingReplyMessage(res.GetId());
+                // only a response (no method) is matched to our requests: the ID of a request sent by the server
+                // comes from the server's own sequence and may be equal to the ID of one of ours
+                LSP::MessageWithParams::Ptr_t msg_ptr;
+                if (message_method.empty()) {
+                    size_t latency_ms = 0;
+                    msg_ptr = m_Queue.TakePendingReplyMessage(res.GetId(), &latency_ms);
+                    if (msg_ptr) {
+                        m_latency[msg_ptr->GetMethod()].Add(latency_ms);
+
+                    } else {
+                        // a response to a request we are no longer waiting for (cancelled, superseded or expired)
+                        wxString cancelled_method;
+                        if (m_Queue.TakeCancelled(res.GetId(), &cancelled_method)) {
+                            m_latency[cancelled_method].AddDropped();
+                        }
+                        LOG_IF_TRACE
+                        {
+                            LSP_TRACE() << GetLogPrefix() << "Dropping stale response for message ID#"
+                                        << res.GetId() << endl;
+                        }
+                        continue;
+                    }
+                }
+
                 // Is this an error message?
                 if (res.IsErrorResponse()) {
                     // an error response arrived, handle it
@@ -680,9 +742,14 @@ void LanguageServerProtocol::EventMainLoop(clCommandEvent& event)
                 }
             } else {
                 // Server is not initialized yet: only accept initialization responses here
-                if (res.GetId() == m_initializeRequestID) {
+                if (message_method.empty() && res.GetId() == m_initializeRequestID) {
                     m_state = kInitialized;
 
+                    size_t latency_ms = 0;
+                    if (m_Queue.TakePendingReplyMessage(res.GetId(), &latency_ms)) {
+                        m_latency["initialize"].Add(latency_ms);
+                    }
+
                     // Keep the semantic tokens array
                     if (CheckCapability(res, "semanticTokensProvider", "textDocument/semanticTokens/full")) {
                         m_semanticTokensTypes =
@@ -846,7 +913,7 @@ void LanguageServerProtocol::HandleResponseError(LSP::ResponseMessage& response,
     }
 
     // finally, call the request handler
-    if (msg_ptr->As<LSP::Request>()) {
+    if (msg_ptr && msg_ptr->As<LSP::Request>()) {
         msg_ptr->As<LSP::Request>()->OnError(response, m_cluster);
     }
 }
@@ -856,12 +923,6 @@ void LanguageServerProtocol::HandleResponse(LSP::ResponseMessage& response, LSP:
     if (msg_ptr && msg_ptr->As<LSP::Request>()) {
         LOG_IF_TRACE { LSP_TRACE() << GetLogPrefix() << "received a response"; }
         LSP::Request* preq = msg_ptr->As<LSP::Request>();
-        if (preq->As<LSP::CompletionRequest>() && (preq->GetId() < m_lastCompletionRequestId)) {
-            LSP_TRACE() << "Received a response for completion message ID#" << preq->GetId()
-                        << ". However, a newer completion request with ID#" << m_lastCompletionRequestId
-                        << "was already sent. Dropping response";
-            return;
-        }
         preq->SetServerName(GetName());
         LSP_DEBUG() << "Processing response for request:" << preq->GetMethod() << endl;
         LSP_TRACE() << response.ToString() << endl;
@@ -982,21 +1043,35 @@ void LanguageServerProtocol::SetStartedCallback(LSPOnConnectedCallback_t&& cb)
 
 void LSPRequestMessageQueue::Push(LSP::MessageWithParams::Ptr_t message)
 {
-    m_Queue.push(message);
+    m_Queue.push_back(message);
 
     // Messages of type 'Request' require responses from the server
     LSP::Request* req = message->As<LSP::Request>();
     if (req) {
-        m_pendingReplyMessages.insert({req->GetId(), message});
+        m_pendingReplyMessages.insert({req->GetId(), PendingReply{message, {}, false}});
+        wxString key = req->GetSupersedeKey();
+        if (!key.empty()) {
+            m_supersedeKeys[key] = req->GetId();
+        }
     }
 }
 
 void LSPRequestMessageQueue::Pop()
 {
-    if (!m_Queue.empty()) {
-        m_Queue.pop();
+    if (m_Queue.empty()) {
+        return;
+    }
+
+    LSP::Request* req = m_Queue.front()->As<LSP::Request>();
+    if (req) {
+        auto iter = m_pendingReplyMessages.find(req->GetId());
+        if (iter != m_pendingReplyMessages.end() && !iter->second.sent) {
+            iter->second.sent = true;
+            iter->second.sent_at = std::chrono::steady_clock::now();
+            ++m_inFlight;
+        }
     }
-    SetWaitingReponse(false);
+    m_Queue.pop_front();
 }
 
 LSP::MessageWithParams::Ptr_t LSPRequestMessageQueue::Get()
@@ -1009,35 +1084,168 @@ LSP::MessageWithParams::Ptr_t LSPRequestMessageQueue::Get()
 
 void LSPRequestMessageQueue::Clear()
 {
-    while (!m_Queue.empty()) {
-        m_Queue.pop();
-    }
-    SetWaitingReponse(false);
+    m_Queue.clear();
     m_pendingReplyMessages.clear();
+    m_supersedeKeys.clear();
+    m_cancelled.clear();
+    m_inFlight = 0;
 }
 
 void LSPRequestMessageQueue::Move(LSPRequestMessageQueue& other)
 {
     while (!other.m_Queue.empty()) {
-        m_Queue.push(other.m_Queue.front());
-        other.m_Queue.pop();
+        Push(other.m_Queue.front());
+        other.m_Queue.pop_front();
     }
-
-    SetWaitingReponse(false);
-    m_pendingReplyMessages.clear();
+    other.Clear();
 }
 
-LSP::MessageWithParams::Ptr_t LSPRequestMessageQueue::TakePendingReplyMessage(int msgid)
+LSP::MessageWithParams::Ptr_t LSPRequestMessageQueue::TakePendingReplyMessage(int msgid, size_t* latency_ms)
 {
-    if (m_pendingReplyMessages.empty()) {
+    auto iter = m_pendingReplyMessages.find(msgid);
+    if (iter == m_pendingReplyMessages.end()) {
         return LSP::MessageWithParams::Ptr_t(nullptr);
     }
-    if (m_pendingReplyMessages.count(msgid) == 0) {
-        return LSP::MessageWithParams::Ptr_t(nullptr);
+
+    PendingReply pending = std::move(iter->second);
+    m_pendingReplyMessages.erase(iter);
+    if (pending.sent) {
+        --m_inFlight;
+        if (clTrace::IsEnabled()) {
+            // requests overlap each other, record them as async zones
+            clTrace::RecordAsync(clTrace::Intern("LSP " + pending.message->GetMethod()),
+                                 clTrace::ToTimestamp(pending.sent_at),
+                                 clTrace::Now());
+        }
+        if (latency_ms) {
+            *latency_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                                                                                pending.sent_at)
+                              .count();
+        }
+    }
+
+    LSP::Request* req = pending.message->As<LSP::Request>();
+    wxString key = req->GetSupersedeKey();
+    if (!key.empty()) {
+        auto key_iter = m_supersedeKeys.find(key);
+        if (key_iter != m_supersedeKeys.end() && key_iter->second == msgid) {
+            m_supersedeKeys.erase(key_iter);
+        }
+    }
+    return pending.message;
+}
+
+std::vector<int> LSPRequestMessageQueue::TakeSuperseded(const LSP::Request* req)
+{
+    std::vector<int> cancelled;
+    auto key_iter = m_supersedeKeys.find(req->GetSupersedeKey());
+    if (key_iter == m_supersedeKeys.end()) {
+        return cancelled;
+    }
+
+    int old_id = key_iter->second;
+    m_supersedeKeys.erase(key_iter);
+
+    auto iter = m_pendingReplyMessages.find(old_id);
+    if (iter == m_pendingReplyMessages.end()) {
+        return cancelled;
+    }
+
+    if (iter->second.sent) {
+        // already on the wire, the caller should cancel it
+        --m_inFlight;
+        AddCancelled(old_id, iter->second.message->GetMethod());
+        cancelled.push_back(old_id);
+    } else {
+        // still in the queue, simply remove it
+        auto msg = iter->second.message;
+        m_Queue.erase(std::remove(m_Queue.begin(), m_Queue.end(), msg), m_Queue.end());
+    }
+    m_pendingReplyMessages.erase(iter);
+    return cancelled;
+}
+
+std::vector<std::pair<int, wxString>> LSPRequestMessageQueue::TakeExpired(std::chrono::milliseconds timeout)
+{
+    std::vector<std::pair<int, wxString>> expired;
+    auto now = std::chrono::steady_clock::now();
+    for (auto iter = m_pendingReplyMessages.begin(); iter != m_pendingReplyMessages.end();) {
+        const PendingReply& pending = iter->second;
+        if (!pending.sent || now - pending.sent_at < timeout) {
+            ++iter;
+            continue;
+        }
+
+        int msgid = iter->first;
+        wxString method = pending.message->GetMethod();
+        wxString key = pending.message->As<LSP::Request>()->GetSupersedeKey();
+        if (!key.empty()) {
+            auto key_iter = m_supersedeKeys.find(key);
+            if (key_iter != m_supersedeKeys.end() && key_iter->second == msgid) {
+                m_supersedeKeys.erase(key_iter);
+            }
+        }
+
+        --m_inFlight;
+        AddCancelled(msgid, method);
+        expired.push_back({ msgid, method });
+        iter = m_pendingReplyMessages.erase(iter);
+    }
+    return expired;
+}
+
+void LSPRequestMessageQueue::AddCancelled(int msgid, const wxString& method)
+{
+    m_cancelled.insert({ msgid, method });
+    while (m_cancelled.size() > MAX_CANCELLED_REQUESTS) {
+        // the server will most likely never answer the oldest ones
+        m_cancelled.erase(m_cancelled.begin());
+    }
+}
+
+bool LSPRequestMessageQueue::TakeCancelled(int msgid, wxString* method)
+{
+    auto iter = m_cancelled.find(msgid);
+    if (iter == m_cancelled.end()) {
+        return false;
+    }
+    *method = iter->second;
+    m_cancelled.erase(iter);
+    return true;
+}
+
+//===------------------------------------------------------------------
+// LSPLatencyHistogram
+//===------------------------------------------------------------------
+
+void LSPLatencyHistogram::Add(size_t ms)
+{
+    size_t bucket = 0;
+    while (bucket < BUCKET_BOUNDS.size() && ms > BUCKET_BOUNDS[bucket]) {
+        ++bucket;
+    }
+    m_buckets[bucket]++;
+    m_count++;
+    m_totalMs += ms;
+    m_maxMs = std::max(m_maxMs, ms);
+}
+
+size_t LSPLatencyHistogram::GetPercentile(size_t percent) const
+{
+    if (m_count == 0) {
+        return 0;
+    }
+
+    // the rank of the requested percentile, rounded up
+    size_t rank = (m_count * percent + 99) / 100;
+    size_t seen = 0;
+    for (size_t i = 0; i < BUCKET_BOUNDS.size(); ++i) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            return std::min(BUCKET_BOUNDS[i], m_maxMs);
+        }
     }
-    LSP::MessageWithParams::Ptr_t msgptr = m_pendingReplyMessages[msgid];
-    m_pendingReplyMessages.erase(msgid);
-    return msgptr;
+    return m_maxMs;
 }
 
 void LanguageServerProtocol::OnWorkspaceLoaded(clWorkspaceEvent& e) { e.Skip(); }
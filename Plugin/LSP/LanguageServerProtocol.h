@@ -8,6 +8,7 @@
 #include "LSP/LSPEvent.h"
 #include "LSP/LSPNetwork.h"
 #include "LSP/MessageWithParams.h"
+#include "LSP/Request.h"
 #include "SocketAPI/clSocketClientAsync.h"
 #include "cl_command_event.h"
 #include "codelite_events.h"
@@ -16,35 +17,114 @@
 #include "macros.h"
 #include "wxStringHash.h"
 
+#include <array>
+#include <chrono>
+#include <deque>
 #include <functional>
+#include <map>
 #include <memory>
-#include <queue>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <wx/arrstr.h>
 #include <wx/filename.h>
 
 using LSPOnConnectedCallback_t = std::function<void()>;
 
 class IEditor;
+
+/**
+ * @brief response latency of a single LSP method, kept as a fixed size histogram
+ */
+class WXDLLIMPEXP_SDK LSPLatencyHistogram
+{
+public:
+    static constexpr size_t BUCKETS_COUNT = 8;
+    /// the upper bound (in milliseconds) of each bucket. The last bucket is open ended
+    static constexpr std::array<size_t, BUCKETS_COUNT - 1> BUCKET_BOUNDS = {10, 25, 50, 100, 250, 500, 1000};
+
+private:
+    std::array<size_t, BUCKETS_COUNT> m_buckets = {};
+    size_t m_count = 0;
+    size_t m_totalMs = 0;
+    size_t m_maxMs = 0;
+    size_t m_cancelled = 0;
+    size_t m_dropped = 0;
+
+public:
+    void Add(size_t ms);
+    void AddCancelled() { ++m_cancelled; }
+    void AddDropped() { ++m_dropped; }
+
+    /// return the upper bound of the bucket that contains the `percent` percentile
+    size_t GetPercentile(size_t percent) const;
+    size_t GetAverage() const { return m_count == 0 ? 0 : (m_totalMs / m_count); }
+    size_t GetCount() const { return m_count; }
+    size_t GetMax() const { return m_maxMs; }
+    size_t GetCancelled() const { return m_cancelled; }
+    size_t GetDropped() const { return m_dropped; }
+    const std::array<size_t, BUCKETS_COUNT>& GetBuckets() const { return m_buckets; }
+};
+
+/**
+ * @brief the outgoing message queue. Messages are sent in order, without waiting for the previous request to be
+ * answered. Requests that were sent and are waiting for a response are kept here, keyed by their ID
+ */
 class WXDLLIMPEXP_SDK LSPRequestMessageQueue
 {
-    std::queue<LSP::MessageWithParams::Ptr_t> m_Queue;
-    std::unordered_map<int, LSP::MessageWithParams::Ptr_t> m_pendingReplyMessages;
-    bool m_waitingReponse = false;
+    struct PendingReply {
+        LSP::MessageWithParams::Ptr_t message;
+        std::chrono::steady_clock::time_point sent_at;
+        bool sent = false;
+    };
+
+    std::deque<LSP::MessageWithParams::Ptr_t> m_Queue;
+    std::unordered_map<int, PendingReply> m_pendingReplyMessages;
+    // supersede key -> ID of the latest request with this key
+    std::unordered_map<wxString, int> m_supersedeKeys;
+    // requests that were cancelled after they were sent: ID -> method. The IDs grow, so the oldest entries come
+    // first and are dropped when the server never answers them
+    std::map<int, wxString> m_cancelled;
+    size_t m_inFlight = 0;
+
+    void AddCancelled(int msgid, const wxString& method);
 
 public:
     LSPRequestMessageQueue() = default;
     virtual ~LSPRequestMessageQueue() = default;
 
-    LSP::MessageWithParams::Ptr_t TakePendingReplyMessage(int msgid);
+    /**
+     * @brief remove and return the request with ID `msgid`. If `latency_ms` is provided, it is set to the time
+     * passed since the request was sent
+     */
+    LSP::MessageWithParams::Ptr_t TakePendingReplyMessage(int msgid, size_t* latency_ms = nullptr);
+
+    /**
+     * @brief forget all requests that are superseded by `req`. Requests that were not sent yet are removed from
+     * the queue, the IDs of requests already sent are returned so the caller can cancel them
+     */
+    std::vector<int> TakeSuperseded(const LSP::Request* req);
+
+    /**
+     * @brief stop waiting for the requests that were sent more than `timeout` ago. They no longer count as in
+     * flight, and their late responses are dropped. Return their IDs and methods so the caller can cancel them
+     */
+    std::vector<std::pair<int, wxString>> TakeExpired(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief if `msgid` belongs to a cancelled request, return true and set its method
+     */
+    bool TakeCancelled(int msgid, wxString* method);
+
     void Push(LSP::MessageWithParams::Ptr_t message);
+    /// remove the head of the queue, marking it as sent
     void Pop();
     LSP::MessageWithParams::Ptr_t Get();
     void Clear();
     bool IsEmpty() const { return m_Queue.empty(); }
-    void SetWaitingReponse(bool waitingReponse) { this->m_waitingReponse = waitingReponse; }
-    bool IsWaitingReponse() const { return m_waitingReponse; }
+
+    /// number of requests that were sent and are waiting for a response
+    size_t GetInFlightCount() const { return m_inFlight; }
 
     /// move the content of `other` into `this` while consuming the `other` queue
     void Move(LSPRequestMessageQueue& other);
@@ -80,7 +160,7 @@ class WXDLLIMPEXP_SDK LanguageServerProtocol : public wxEvtHandler
 
     wxStringSet_t m_providers;
     bool m_displayDiagnostics = true;
-    int m_lastCompletionRequestId = wxNOT_FOUND;
+    std::map<wxString, LSPLatencyHistogram> m_latency;
     wxArrayString m_semanticTokensTypes;
     LSPOnConnectedCallback_t m_onServerStartedCallback = nullptr;
     bool m_incrementalChangeSupported = false;
@@ -179,6 +259,13 @@ public:
     }
 
     const wxStringSet_t& GetProviders() const { return m_providers; }
+
+    /**
+     * @brief response latency per method, collected across server restarts
+     */
+    const std::map<wxString, LSPLatencyHistogram>& GetLatencyStats() const { return m_latency; }
+    void ClearLatencyStats() { m_latency.clear(); }
+
     const wxString& GetName() const { return m_name; }
     bool IsInitialized() const { return (m_state == kInitialized); }
 
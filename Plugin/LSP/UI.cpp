@@ -525,6 +525,21 @@ LanguageServerLogViewBase::LanguageServerLogViewBase(
 
     boxSizer210->Add(m_dvListCtrl, 1, wxEXPAND, WXC_FROM_DIP(5));
 
+    m_panelLatency = new wxPanel(
+        m_notebook207, wxID_ANY, wxDefaultPosition, wxDLG_UNIT(m_notebook207, wxSize(-1, -1)), wxTAB_TRAVERSAL);
+    m_notebook207->AddPage(m_panelLatency, _("Latency"), false);
+
+    wxBoxSizer* boxSizerLatency = new wxBoxSizer(wxVERTICAL);
+    m_panelLatency->SetSizer(boxSizerLatency);
+
+    m_dvListCtrlLatency = new clTerminalViewCtrl(m_panelLatency,
+                                                 wxID_ANY,
+                                                 wxDefaultPosition,
+                                                 wxDLG_UNIT(m_panelLatency, wxSize(-1, -1)),
+                                                 wxDV_NO_HEADER | wxDV_ROW_LINES | wxDV_SINGLE);
+
+    boxSizerLatency->Add(m_dvListCtrlLatency, 1, wxEXPAND, WXC_FROM_DIP(5));
+
     SetName(wxT("LanguageServerLogViewBase"));
     SetSize(wxDLG_UNIT(this, wxSize(500, 300)));
     if (GetSizer()) {
@@ -194,11 +194,15 @@ protected:
     Notebook* m_notebook207;
     wxPanel* m_panel208;
     clTerminalViewCtrl* m_dvListCtrl;
+    wxPanel* m_panelLatency;
+    clTerminalViewCtrl* m_dvListCtrlLatency;
 
 protected:
 public:
     clTerminalViewCtrl* GetDvListCtrl() { return m_dvListCtrl; }
     wxPanel* GetPanel208() { return m_panel208; }
+    clTerminalViewCtrl* GetDvListCtrlLatency() { return m_dvListCtrlLatency; }
+    wxPanel* GetPanelLatency() { return m_panelLatency; }
     Notebook* GetNotebook207() { return m_notebook207; }
     LanguageServerLogViewBase(wxWindow* parent,
                               wxWindowID id = wxID_ANY,
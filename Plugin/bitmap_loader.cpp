@@ -25,7 +25,6 @@
 #include "bitmap_loader.h"
 
 #include "Zip/clZipReader.h"
-#include "clFilesCollector.h"
 #include "clSystemSettings.h"
 #include "cl_standard_paths.h"
 #include "editor_config.h"
@@ -50,20 +49,34 @@
 
 namespace
 {
+// an invalid bundle is kept for the names without an SVG file, so the file is looked up only once
 std::unordered_map<wxString, wxBitmapBundle> DARK_THEME_BMPBUNLES;
 std::unordered_map<wxString, wxBitmapBundle> LIGHT_THEME_BMPBUNLES;
 }; // namespace
 
 BitmapLoader::BitmapLoader(wxWindow* win, bool darkTheme)
     : m_win(win)
+    , m_darkTheme(darkTheme)
 {
-    wxUnusedVar(m_win);
-    Initialize(darkTheme);
+    Initialize();
 }
 
-std::unordered_map<wxString, wxBitmapBundle>* BitmapLoader::GetBundles(bool darkTheme) const
+const wxBitmapBundle* BitmapLoader::LoadBundle(const wxString& name, bool darkTheme)
 {
-    return darkTheme ? &DARK_THEME_BMPBUNLES : &LIGHT_THEME_BMPBUNLES;
+    auto& bundles = darkTheme ? DARK_THEME_BMPBUNLES : LIGHT_THEME_BMPBUNLES;
+    auto iter = bundles.find(name);
+    if (iter == bundles.end()) {
+        wxFileName svg_path{clStandardPaths::Get().GetDataDir(), name + ".svg"};
+        svg_path.AppendDir("svgs");
+        svg_path.AppendDir(darkTheme ? "dark-theme" : "light-theme");
+
+        wxBitmapBundle bundle;
+        if (svg_path.FileExists()) {
+            bundle = wxBitmapBundle::FromSVGFile(svg_path.GetFullPath(), wxSize(16, 16));
+        }
+        iter = bundles.insert({name, bundle}).first;
+    }
+    return iter->second.IsOk() ? &iter->second : nullptr;
 }
 
 const wxBitmap& BitmapLoader::LoadBitmap(const wxString& name, int requestedSize)
@@ -72,11 +85,23 @@ const wxBitmap& BitmapLoader::LoadBitmap(const wxString& name, int requestedSize
     wxUnusedVar(requestedSize);
     wxString newName = name.AfterLast('/');
 
-    if (m_toolbarsBitmaps.count(newName) == 0) {
+    auto iter = m_toolbarsBitmaps.find(newName);
+    if (iter != m_toolbarsBitmaps.end()) {
+        return iter->second;
+    }
+
+    // first use: rasterise the SVG file
+    wxBitmap bmp;
+    const wxBitmapBundle* bundle = LoadBundle(newName, m_darkTheme);
+    if (bundle) {
+        wxWindow* win = wxTheApp->GetTopWindow() ? wxTheApp->GetTopWindow() : m_win;
+        bmp = bundle->GetBitmapFor(win);
+    }
+    if (!bmp.IsOk()) {
         LOG_IF_WARN { clWARNING() << "requested image:" << newName << "does not exist" << endl; }
-        return wxNullBitmap;
     }
-    return m_toolbarsBitmaps.find(newName)->second;
+    // missing images are kept as well, so they are reported once
+    return m_toolbarsBitmaps.insert({newName, bmp}).first->second;
 }
 
 int BitmapLoader::GetMimeImageId(int type, bool disabled) { return GetMimeBitmaps().GetIndex(type, disabled); }
@@ -93,56 +118,16 @@ wxIcon BitmapLoader::GetIcon(const wxBitmap& bmp) const
     return icn;
 }
 
-void BitmapLoader::AddBitmapInternal(const wxBitmapBundle& bundle, const wxString& base_name)
+void BitmapLoader::Initialize()
 {
-    wxBitmap bmp = bundle.GetBitmapFor(wxTheApp->GetTopWindow());
-    if (bmp.IsOk()) {
-        m_toolbarsBitmaps.insert({base_name, bmp});
-    }
-}
-
-void BitmapLoader::LoadSVGFiles(bool darkTheme)
-{
-    // Load the bitmaps based on the current theme background colour
     wxFileName svg_path{clStandardPaths::Get().GetDataDir(), wxEmptyString};
     svg_path.AppendDir("svgs");
-    svg_path.AppendDir(darkTheme ? "dark-theme" : "light-theme");
-
+    svg_path.AppendDir(m_darkTheme ? "dark-theme" : "light-theme");
     if (!svg_path.DirExists()) {
         clWARNING() << "Unable to load SVG images. Broken installation" << endl;
-        return;
     }
-    auto bitmap_bundle_cache = GetBundles(darkTheme);
-
-    // load the cache
-    if (bitmap_bundle_cache->empty()) {
-        clFilesScanner scanner;
-        clDEBUG() << "Loading SVG files from:" << svg_path.GetPath() << endl;
-        scanner.ScanWithCallbacks(svg_path.GetPath(), nullptr, [&](const wxArrayString& files) -> bool {
-            for (const wxString& filepath : files) {
-                auto bmpbundle = wxBitmapBundle::FromSVGFile(filepath, wxSize(16, 16));
-                if (bmpbundle.IsOk()) {
-                    bitmap_bundle_cache->insert({wxFileName(filepath).GetName(), bmpbundle});
-                }
-            }
-            return true;
-        });
-    }
-}
-
-void BitmapLoader::Initialize(bool darkTheme)
-{
-    LoadSVGFiles(darkTheme);
-    auto bitmap_bundle_cache = GetBundles(darkTheme);
-
-    m_toolbarsBitmaps.clear();
-    m_toolbarsBitmaps.reserve(bitmap_bundle_cache->size());
 
-    for (const auto& vt : *bitmap_bundle_cache) {
-        AddBitmapInternal(vt.second, vt.first);
-    }
-
-    // Create the mime-list
+    // The SVG files are loaded on first use, only the mime-list images are needed right away
     CreateMimeList();
 }
 
@@ -259,15 +244,8 @@ const wxBitmap& BitmapLoader::GetBitmapForFile(const wxString& filename, bool di
 const wxBitmapBundle& BitmapLoader::GetBundle(const wxString& name) const
 {
     static wxBitmapBundle NullBundle;
-    bool darkTheme = clSystemSettings::Get().IsDark();
-    auto bitmap_bundle_cache = GetBundles(darkTheme);
-
-    auto bundle = bitmap_bundle_cache->find(name);
-    if (bundle == bitmap_bundle_cache->end()) {
-        return NullBundle;
-    } else {
-        return bundle->second;
-    }
+    const wxBitmapBundle* bundle = LoadBundle(name, clSystemSettings::Get().IsDark());
+    return bundle ? *bundle : NullBundle;
 }
 
 //===---------------------------
@@ -368,8 +346,7 @@ BitmapLoader* clBitmaps::GetLoader() { return m_activeBitmaps; }
 
 void clBitmaps::InitialiseInternal(wxWindow* win)
 {
-    m_darkBitmaps = new BitmapLoader(win, true);
-    m_lightBitmaps = new BitmapLoader(win, false);
+    m_win = win;
     SysColoursChanged();
 }
 
@@ -377,6 +354,11 @@ void clBitmaps::SysColoursChanged()
 {
     auto old_ptr = m_activeBitmaps;
     bool isDark = clSystemSettings::IsDark();
+    if (isDark && !m_darkBitmaps) {
+        m_darkBitmaps = new BitmapLoader(m_win, true);
+    } else if (!isDark && !m_lightBitmaps) {
+        m_lightBitmaps = new BitmapLoader(m_win, false);
+    }
     m_activeBitmaps = isDark ? m_darkBitmaps : m_lightBitmaps;
 
     if (old_ptr != m_activeBitmaps) {
@@ -556,13 +538,12 @@ const wxString& clBitmapList::GetBitmapName(size_t index) const
 
 bool BitmapLoader::GetIconBundle(const wxString& name, wxIconBundle* bundle)
 {
-    LoadSVGFiles(clSystemSettings::IsDark());
-    auto bundles = GetBundles(clSystemSettings::IsDark());
-    if (bundles->count(name) == 0) {
+    const wxBitmapBundle* bundle_ptr = LoadBundle(name, clSystemSettings::IsDark());
+    if (!bundle_ptr) {
         return false;
     }
 
-    const auto& bmp_bundle = bundles->find(name)->second;
+    const auto& bmp_bundle = *bundle_ptr;
     std::array<int, 5> sizes = {24, 32, 64, 128, 256};
     for (int size : sizes) {
         size = wxTheApp->GetTopWindow()->FromDIP(size);
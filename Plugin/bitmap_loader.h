@@ -206,25 +206,28 @@ private:
     BitmapLoader(wxWindow* win, bool darkTheme);
     virtual ~BitmapLoader() = default;
 
-    void AddBitmapInternal(const wxBitmapBundle& bundle, const wxString& base_name);
-    void Initialize(bool darkTheme);
-    void LoadSVGFiles(bool darkTheme);
+    void Initialize();
 
-    wxFileName m_zipPath;
+    /// return the bundle of an SVG file of the theme, the file is loaded on first use. nullptr if there is no such
+    /// file
+    static const wxBitmapBundle* LoadBundle(const wxString& name, bool darkTheme);
+
+    /// rasterised bitmaps, loaded on first use. The entries are never removed, callers keep pointers to them
     std::unordered_map<wxString, wxBitmap> m_toolbarsBitmaps;
-    std::unordered_map<wxString, wxString> m_manifest;
     std::unordered_map<int, int> m_fileIndexMap;
     clMimeBitmaps m_mimeBitmaps;
-    std::unordered_map<wxString, wxBitmapBundle>* GetBundles(bool darkTheme) const;
     wxWindow* m_win{nullptr};
+    bool m_darkTheme = false;
 };
 
 wxDECLARE_EXPORTED_EVENT(WXDLLIMPEXP_SDK, wxEVT_BITMAPS_UPDATED, clCommandEvent);
 class WXDLLIMPEXP_SDK clBitmaps : public wxEvtHandler
 {
+    // the loader of a theme is created when the theme is used for the first time
     BitmapLoader* m_lightBitmaps = nullptr;
     BitmapLoader* m_darkBitmaps = nullptr;
     BitmapLoader* m_activeBitmaps = nullptr;
+    wxWindow* m_win = nullptr;
 
 protected:
     void InitialiseInternal(wxWindow* win);
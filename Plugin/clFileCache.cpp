@@ -1,24 +1,9 @@
 #include "clFileCache.hpp"
 
-void clFileCache::Add(const wxFileName& fn)
-{
-    if(Contains(fn)) {
-        return;
-    }
-    m_files.push_back(fn);
-    m_filesSet.insert(fn.GetFullPath());
-}
+void clFileCache::Add(const wxFileName& fn) { m_paths.Add(fn.GetFullPath()); }
 
-void clFileCache::Clear()
-{
-    m_filesSet.clear();
-    m_files.clear();
-}
+void clFileCache::Clear() { m_paths.Clear(); }
 
-bool clFileCache::Contains(const wxFileName& fn) const { return m_filesSet.count(fn.GetFullPath()); }
+bool clFileCache::Contains(const wxFileName& fn) const { return m_paths.Contains(fn.GetFullPath()); }
 
-void clFileCache::Alloc(size_t size)
-{
-    m_files.reserve(size);
-    m_filesSet.reserve(size);
-}
+void clFileCache::Alloc(size_t size) { m_paths.Reserve(size); }
@@ -1,36 +1,33 @@
 #ifndef CLFILECACHE_HPP
 #define CLFILECACHE_HPP
 
+#include "clPathStore.hpp"
 #include "codelite_exports.h"
-#include "wxStringHash.h"
 
-#include <unordered_set>
-#include <vector>
 #include <wx/filename.h>
 
+/// The files of a workspace. The paths are kept in a clPathStore, iterating yields the full paths
 class WXDLLIMPEXP_SDK clFileCache
 {
-    std::vector<wxFileName> m_files;
-    std::unordered_set<wxString> m_filesSet;
+    clPathStore m_paths;
 
 public:
-    using const_iterator = std::vector<wxFileName>::const_iterator;
-    using iterator = std::vector<wxFileName>::iterator;
+    using const_iterator = clPathStore::const_iterator;
 
 public:
     clFileCache() = default;
     ~clFileCache() = default;
 
-    const std::vector<wxFileName>& GetFiles() const { return m_files; }
-    const_iterator begin() const { return m_files.begin(); }
-    const_iterator end() const { return m_files.end(); }
+    const clPathStore& GetPaths() const { return m_paths; }
+    const_iterator begin() const { return m_paths.begin(); }
+    const_iterator end() const { return m_paths.end(); }
 
     void Alloc(size_t size);
     void Add(const wxFileName& fn);
     void Clear();
     bool Contains(const wxFileName& fn) const;
-    size_t GetSize() const { return m_files.size(); }
-    bool IsEmpty() const { return m_files.empty(); }
+    size_t GetSize() const { return m_paths.GetCount(); }
+    bool IsEmpty() const { return m_paths.IsEmpty(); }
 };
 
 #endif // CLFILECACHE_HPP
@@ -5,6 +5,8 @@
 #include "globals.h"
 #include "macros.h"
 
+#include <algorithm>
+#include <iterator>
 #include <wx/dataview.h>
 #include <wx/sizer.h>
 
@@ -63,16 +65,39 @@ void clTableWithPagination::SetColumns(const wxArrayString& columns)
 
 void clTableWithPagination::SetData(std::vector<wxArrayString>& data)
 {
-    m_data.clear();
-    m_data.swap(data);
+    m_data.assign(std::make_move_iterator(data.begin()), std::make_move_iterator(data.end()));
+    data.clear();
     ShowPage(0);
 }
 
+void clTableWithPagination::AppendData(const std::vector<wxArrayString>& data)
+{
+    if(data.empty()) {
+        return;
+    }
+
+    size_t pageEnd = (size_t)(m_currentPage + 1) * m_linesPerPage;
+    size_t first = m_data.size();
+    m_data.insert(m_data.end(), data.begin(), data.end());
+    if(first < pageEnd) {
+        // the current page is not full yet, add the new rows that belong to it
+        size_t last = std::min(pageEnd, m_data.size());
+        m_ctrl->Begin();
+        for(size_t i = first; i < last; ++i) {
+            AppendLine(m_data[i]);
+        }
+        m_ctrl->Commit();
+    }
+    UpdateLabel();
+}
+
 void clTableWithPagination::ClearAll()
 {
     m_data.clear();
+    m_currentPage = 0;
     m_ctrl->DeleteAllItems();
     m_ctrl->ClearColumns();
+    m_staticText->SetLabel(wxEmptyString);
 }
 
 void clTableWithPagination::ShowPage(int nPage)
@@ -88,15 +113,31 @@ void clTableWithPagination::ShowPage(int nPage)
     m_currentPage = nPage;
     m_ctrl->Begin();
     for(int i = startIndex; i <= lastIndex; ++i) {
-        wxVector<wxVariant> cols;
-        const wxArrayString& items = m_data[i];
-        for(size_t j = 0; j < items.size(); ++j) {
-            const wxString& cellContent = items.Item(j);
-            cols.push_back(wxVariant(MakeDisplayString(cellContent)));
-        }
-        m_ctrl->AppendItem(cols, (wxUIntPtr)&items);
+        AppendLine(m_data[i]);
     }
     m_ctrl->Commit();
+    UpdateLabel();
+}
+
+void clTableWithPagination::AppendLine(const wxArrayString& items)
+{
+    // only the displayed cells are converted to their display string
+    wxVector<wxVariant> cols;
+    for(size_t j = 0; j < items.size(); ++j) {
+        const wxString& cellContent = items.Item(j);
+        cols.push_back(wxVariant(MakeDisplayString(cellContent)));
+    }
+    m_ctrl->AppendItem(cols, (wxUIntPtr)&items);
+}
+
+void clTableWithPagination::UpdateLabel()
+{
+    if(m_data.empty()) {
+        m_staticText->SetLabel(wxEmptyString);
+        return;
+    }
+    int startIndex = (m_currentPage * m_linesPerPage);
+    int lastIndex = std::min(startIndex + m_linesPerPage, (int)m_data.size()) - 1;
     m_staticText->SetLabel(wxString() << _("Showing entries from: ") << startIndex << _(":") << lastIndex
                                       << " Total of: " << m_data.size() << _(" entries"));
 }
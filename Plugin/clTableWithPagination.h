@@ -3,6 +3,7 @@
 
 #include "codelite_exports.h"
 
+#include <deque>
 #include <vector>
 #include <wx/arrstr.h>
 #include <wx/button.h>
@@ -15,7 +16,7 @@ class WXDLLIMPEXP_SDK clTableWithPagination : public wxPanel
 {
     int m_linesPerPage;
     int m_currentPage;
-    std::vector<wxArrayString> m_data;
+    std::deque<wxArrayString> m_data; // a deque, so the rows referenced by the displayed items never move
     wxArrayString m_columns;
     clThemedListCtrl* m_ctrl = nullptr;
     wxButton* m_btnNextPage = nullptr;
@@ -27,6 +28,8 @@ protected:
     bool CanPrev() const;
 
     void ClearAllItems();
+    void AppendLine(const wxArrayString& items);
+    void UpdateLabel();
     wxString MakeDisplayString(const wxString& str) const;
     void OnLineActivated(wxDataViewEvent& event);
 
@@ -50,6 +53,12 @@ public:
      */
     void SetData(std::vector<wxArrayString>& data);
 
+    /**
+     * @brief append rows to the table, e.g. while they are fetched
+     * The current page is filled up if it is not full, the page is not scrolled
+     */
+    void AppendData(const std::vector<wxArrayString>& data);
+
     /**
      * @brief clear all data and columns from the table
      */
@@ -110,9 +110,10 @@ OpenResourceDialog::OpenResourceDialog(wxWindow* parent, IManager* manager, cons
                 }
             }
         } else if (clFileSystemWorkspace::Get().IsOpen()) {
-            const std::vector<wxFileName>& files = clFileSystemWorkspace::Get().GetFiles();
-            for (const wxFileName& fn : files) {
-                m_files.insert({fn.GetFullName(), fn.GetFullPath()});
+            // take the names from the path store, without splitting each path again
+            const clPathStore& paths = clFileSystemWorkspace::Get().GetFiles().GetPaths();
+            for (clPathStore::Id id = 0; id < paths.GetCount(); ++id) {
+                m_files.insert({paths.GetFullName(id), paths.GetFullPath(id)});
             }
         }
     } else if (clWorkspaceManager::Get().IsWorkspaceOpened()) {
@@ -177,6 +177,7 @@ OptionsConfig::OptionsConfig(wxXmlNode* node)
         m_smartParen = XmlUtils::ReadBool(node, wxT("SmartParen"), m_smartParen);
         m_showRightMarginIndicator = XmlUtils::ReadBool(node, wxT("ShowRightMargin"), m_showRightMarginIndicator);
         m_rightMarginColumn = XmlUtils::ReadLong(node, wxT("RightMarginnColumn"), m_rightMarginColumn);
+        m_largeFileThresholdMB = XmlUtils::ReadLong(node, wxT("LargeFileThresholdMB"), m_largeFileThresholdMB);
 
         m_programConsoleCommand = XmlUtils::ReadString(node, wxT("ConsoleCommand"), m_programConsoleCommand);
         m_eolMode = XmlUtils::ReadString(node, wxT("EOLMode"), m_eolMode);
@@ -328,6 +329,7 @@ wxXmlNode* OptionsConfig::ToXml() const
     n->AddAttribute(wxT("SmartParen"), BoolToString(m_smartParen));
     n->AddAttribute(wxT("ShowRightMargin"), BoolToString(m_showRightMarginIndicator));
     n->AddAttribute(wxT("RightMarginnColumn"), wxString() << m_rightMarginColumn);
+    n->AddAttribute(wxT("LargeFileThresholdMB"), wxString() << m_largeFileThresholdMB);
 
     wxString tmp;
     tmp << m_indentWidth;
@@ -162,6 +162,7 @@ protected:
     bool m_lineNumberHighlightCurrent = false;
     bool m_showRightMarginIndicator = false;
     int m_rightMarginColumn = 120;
+    int m_largeFileThresholdMB = 50; // files bigger than this are opened in "large file" mode, 0 disables it
 
 public:
     // Helpers
@@ -399,6 +400,8 @@ public:
     void SetRightMarginColumn(int rightMarginColumn) { this->m_rightMarginColumn = rightMarginColumn; }
     bool IsShowRightMarginIndicator() const { return m_showRightMarginIndicator; }
     int GetRightMarginColumn() const { return m_rightMarginColumn; }
+    void SetLargeFileThresholdMB(int largeFileThresholdMB) { this->m_largeFileThresholdMB = largeFileThresholdMB; }
+    int GetLargeFileThresholdMB() const { return m_largeFileThresholdMB; }
     void SetHighlightMatchedBraces(bool highlightMatchedBraces)
     {
         this->m_highlightMatchedBraces = highlightMatchedBraces;
@@ -24,6 +24,9 @@
 //////////////////////////////////////////////////////////////////////////////
 #include "plugindata.h"
 
+#include <wx/filefn.h>
+#include <wx/filename.h>
+
 PluginInfo::PluginInfo()
     : m_flags(kNone)
 {
@@ -36,6 +39,7 @@ void PluginInfo::FromJSON(const JSONItem& json)
     m_description = json.namedObject("description").toString();
     m_version = json.namedObject("version").toString();
     m_flags = json.namedObject("flags").toSize_t();
+    m_triggers = json.namedObject("triggers").toArrayString();
 }
 
 JSONItem PluginInfo::ToJSON() const
@@ -46,9 +50,23 @@ JSONItem PluginInfo::ToJSON() const
     e.addProperty("description", m_description);
     e.addProperty("version", m_version);
     e.addProperty("flags", m_flags);
+    if(!m_triggers.empty()) {
+        e.addProperty("triggers", m_triggers);
+    }
     return e;
 }
 
+bool PluginInfo::IsTriggeredBy(const wxString& filepath) const
+{
+    wxString fullname = wxFileName(filepath).GetFullName().Lower();
+    for(const auto& mask : m_triggers) {
+        if(::wxMatchWild(mask.Lower(), fullname)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 //-------------------------------------------
 // PluginConfig
 //-------------------------------------------
@@ -65,6 +83,18 @@ bool PluginInfoArray::CanLoad(const PluginInfo& plugin) const
 
 void PluginInfoArray::FromJSON(const JSONItem& json)
 {
+    m_manifests.clear();
+    JSONItem manifests = json.namedObject("manifests");
+    int count = manifests.arraySize();
+    for(int i = 0; i < count; ++i) {
+        JSONItem item = manifests.arrayItem(i);
+        Manifest manifest;
+        manifest.modified = item.namedObject("modified").toSize_t();
+        manifest.interfaceVersion = item.namedObject("interfaceVersion").toInt();
+        manifest.info.FromJSON(item.namedObject("info"));
+        m_manifests.insert({ item.namedObject("library").toString(), manifest });
+    }
+
     m_enabledPlugins.Clear();
     if(json.hasNamedObject("enabledPlugins")) {
         m_enabledPlugins = json.namedObject("enabledPlugins").toArrayString();
@@ -95,9 +125,30 @@ JSONItem PluginInfoArray::ToJSON() const
 {
     JSONItem el = JSONItem::createObject(GetName());
     el.addProperty("enabledPlugins", m_enabledPlugins);
+
+    JSONItem manifests = JSONItem::createArray("manifests");
+    for(const auto& [library, manifest] : m_manifests) {
+        JSONItem item = JSONItem::createObject();
+        item.addProperty("library", library);
+        item.addProperty("modified", (size_t)manifest.modified);
+        item.addProperty("interfaceVersion", manifest.interfaceVersion);
+        item.addProperty("info", manifest.info.ToJSON());
+        manifests.arrayAppend(item);
+    }
+    el.append(manifests);
     return el;
 }
 
+const PluginInfoArray::Manifest* PluginInfoArray::GetManifest(const wxString& library, time_t modified) const
+{
+    auto iter = m_manifests.find(library);
+    if(iter == m_manifests.end() || iter->second.modified != modified ||
+       iter->second.interfaceVersion != PLUGIN_INTERFACE_VERSION) {
+        return nullptr;
+    }
+    return &iter->second;
+}
+
 void PluginInfoArray::EnablePlugin(const wxString& plugin)
 {
     if(m_enabledPlugins.Index(plugin) == wxNOT_FOUND) {
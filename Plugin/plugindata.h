@@ -39,6 +39,9 @@ public:
     enum eFlags {
         kNone = 0,
         kDisabledByDefault = (1 << 0),
+        // construct the plugin only when a file matching one of its triggers is opened (see SetTriggers()). The
+        // plugin misses the event that activated it, so it must check the current state in its constructor
+        kLoadOnDemand = (1 << 1),
     };
 
 protected:
@@ -47,6 +50,7 @@ protected:
     wxString m_description;
     wxString m_version;
     size_t m_flags;
+    wxArrayString m_triggers;
 
 public:
     using PluginMap_t = std::map<wxString, PluginInfo>;
@@ -71,6 +75,12 @@ public:
     }
     bool HasFlag(PluginInfo::eFlags flag) const { return m_flags & flag; }
 
+    /// file masks (e.g. "*.rs", "Cargo.toml") that activate a kLoadOnDemand plugin, matched against the name of the
+    /// files opened in the editor and of the loaded workspace
+    void SetTriggers(const wxArrayString& triggers) { this->m_triggers = triggers; }
+    const wxArrayString& GetTriggers() const { return m_triggers; }
+    bool IsTriggeredBy(const wxString& filepath) const;
+
     // Getters
     const wxString& GetAuthor() const { return m_author; }
     const wxString& GetDescription() const { return m_description; }
@@ -83,8 +93,18 @@ public:
 
 class WXDLLIMPEXP_SDK PluginInfoArray : public clConfigItem
 {
+public:
+    /// the info of a kLoadOnDemand plugin, cached so its library does not need to be loaded at startup
+    struct Manifest {
+        time_t modified = 0; // of the library, the manifest is outdated once the library changes
+        int interfaceVersion = 0;
+        PluginInfo info;
+    };
+
+private:
     PluginInfo::PluginMap_t m_plugins;
     wxArrayString m_enabledPlugins;
+    std::map<wxString, Manifest> m_manifests; // library path -> manifest
 
 public:
     PluginInfoArray();
@@ -99,6 +119,11 @@ public:
     void DisablePlugin(const wxString& plugin);
     const wxArrayString& GetEnabledPlugins() const { return m_enabledPlugins; }
 
+    /// return the cached manifest of `library`, or nullptr if there is none or it is outdated
+    const Manifest* GetManifest(const wxString& library, time_t modified) const;
+    void SetManifest(const wxString& library, const Manifest& manifest) { m_manifests[library] = manifest; }
+    void RemoveManifest(const wxString& library) { m_manifests.erase(library); }
+
     virtual void FromJSON(const JSONItem& json);
     virtual JSONItem ToJSON() const;
 };
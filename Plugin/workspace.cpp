@@ -26,6 +26,7 @@
 
 #include "StringUtils.h"
 #include "build_settings_config.h"
+#include "clTrace.hpp"
 #include "cl_command_event.h"
 #include "codelite_events.h"
 #include "compiler_command_line_parser.h"
@@ -95,6 +96,7 @@ void clCxxWorkspace::CloseWorkspace()
 
 bool clCxxWorkspace::OpenWorkspace(const wxString& fileName, wxString& errMsg)
 {
+    CL_TRACE_ZONE("Load C++ workspace");
     if (!DoLoadWorkspace(fileName, errMsg)) {
         return false;
     }
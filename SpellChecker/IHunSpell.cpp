@@ -167,6 +167,7 @@ void HighlightWord(IEditor* editor, int pos)
 
 // ------------------------------------------------------------
 #define MIN_TOKEN_LEN 3
+#define MAX_CACHED_WORDS 100000
 // ------------------------------------------------------------
 IHunSpell::IHunSpell()
     : m_caseSensitiveUserDictionary(true)
@@ -189,6 +190,7 @@ IHunSpell::~IHunSpell()
 // ------------------------------------------------------------
 bool IHunSpell::InitEngine()
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     // check if we are already initialized
     if (m_pSpell != NULL)
         return true;
@@ -230,17 +232,20 @@ bool IHunSpell::InitEngine()
 // ------------------------------------------------------------
 void IHunSpell::CloseEngine()
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     if (m_pSpell != NULL) {
         Hunspell_destroy(m_pSpell);
         SaveUserDict(m_userDictPath + s_userDict);
     }
     m_pSpell = NULL;
+    m_wordCache.clear();
 }
 // ------------------------------------------------------------
 bool IHunSpell::CheckWord(const wxString& word) const
 {
     static thread_local wxRegEx rehex(s_dectHex, wxRE_ADVANCED);
 
+    std::lock_guard<std::mutex> lock(m_mutex);
     // look in ignore list
     if (m_ignoreList.count(word) != 0)
         return true;
@@ -249,11 +254,73 @@ bool IHunSpell::CheckWord(const wxString& word) const
     if (m_userDict.count(word) != 0)
         return true;
 
-    // see if hex number
-    if (rehex.Matches(word))
+    // the language is being changed
+    if (m_pSpell == NULL)
         return true;
 
-    return Hunspell_spell(m_pSpell, word.ToUTF8()) != 0;
+    auto iter = m_wordCache.find(word);
+    if (iter != m_wordCache.end())
+        return iter->second;
+
+    // see if hex number
+    bool found = rehex.Matches(word) || Hunspell_spell(m_pSpell, word.ToUTF8()) != 0;
+    if (m_wordCache.size() >= MAX_CACHED_WORDS)
+        m_wordCache.clear();
+    m_wordCache.insert({ word, found });
+    return found;
+}
+// ------------------------------------------------------------
+std::vector<int> IHunSpell::FindMisspelledWords(const std::string& styledText, int startPos, int lexerId) const
+{
+    std::vector<int> misspelled;
+
+    auto strings = ALLOWED_STYLES_STRINGS.find(lexerId);
+    auto comments = ALLOWED_STYLES_COMMENTS.find(lexerId);
+    const std::unordered_set<int>* STRING_STYLES = strings == ALLOWED_STYLES_STRINGS.end() ? nullptr : &strings->second;
+    const std::unordered_set<int>* COMMENT_STYLES =
+        comments == ALLOWED_STYLES_COMMENTS.end() ? nullptr : &comments->second;
+
+    // the delimiters are plain ASCII, so the UTF-8 text can be split byte by byte
+    bool delimiters[256] = {};
+    for (wxUniChar ch : s_defDelimiters) {
+        delimiters[(unsigned char)ch.GetValue()] = true;
+    }
+
+    // styled text is a sequence of (character byte, style byte) pairs
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(styledText.data());
+    const size_t count = styledText.size() / 2;
+    std::string token;
+    size_t i = 0;
+    while (i < count) {
+        while (i < count && delimiters[data[2 * i]]) {
+            ++i;
+        }
+
+        size_t start = i;
+        size_t chars = 0;
+        token.clear();
+        for (; i < count && !delimiters[data[2 * i]]; ++i) {
+            token += (char)data[2 * i];
+            // don't count UTF-8 continuation bytes
+            if ((data[2 * i] & 0xC0) != 0x80) {
+                ++chars;
+            }
+        }
+
+        // ignore token shorter then MIN_TOKEN_LEN
+        if (chars <= MIN_TOKEN_LEN)
+            continue;
+
+        // Check the style at the middle of the token
+        size_t middle = start + (i - start) / 2;
+        int style_at_pos = data[2 * middle + 1];
+        bool allowed = !STRING_STYLES || STRING_STYLES->count(style_at_pos) || !COMMENT_STYLES ||
+                       COMMENT_STYLES->count(style_at_pos);
+        if (allowed && !CheckWord(wxString::FromUTF8(token.c_str(), token.length()))) {
+            misspelled.push_back(startPos + (int)middle);
+        }
+    }
+    return misspelled;
 }
 // ------------------------------------------------------------
 wxArrayString IHunSpell::GetSuggestions(const wxString& misspelled)
@@ -261,6 +328,7 @@ wxArrayString IHunSpell::GetSuggestions(const wxString& misspelled)
     wxArrayString suggestions;
     suggestions.Empty();
 
+    std::lock_guard<std::mutex> lock(m_mutex);
     if (m_pSpell) {
         char** wlst;
 
@@ -393,6 +461,7 @@ void IHunSpell::AddWordToIgnoreList(const wxString& word)
     if (word.IsEmpty())
         return;
 
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_ignoreList.insert(word);
 }
 // ------------------------------------------------------------
@@ -401,6 +470,7 @@ void IHunSpell::AddWordToUserDict(const wxString& word)
     if (word.IsEmpty())
         return;
 
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_userDict.insert(word);
 }
 // ------------------------------------------------------------
@@ -556,6 +626,7 @@ void IHunSpell::EnableScannerType(int type, bool state)
 // ------------------------------------------------------------
 void IHunSpell::SetCaseSensitiveUserDictionary(const bool caseSensitiveUserDictionary)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     if (caseSensitiveUserDictionary != m_caseSensitiveUserDictionary) {
         m_caseSensitiveUserDictionary = caseSensitiveUserDictionary;
 
@@ -39,6 +39,9 @@
 #include "wxStringHash.h"
 
 #include <hunspell/hunspell.h>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -103,15 +106,22 @@ public:
     virtual ~IHunSpell();
 
     /// Clears the ignore list
-    void ClearIgnoreList() { m_ignoreList.clear(); }
+    void ClearIgnoreList()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_ignoreList.clear();
+    }
     /// initializes spelling engine. This will be done automatic on the first check.
     bool InitEngine();
     /// close the engine. The engine must be closed before a new init or when the program finishes.
     void CloseEngine();
     /// changes the engines language. Must be in format like 'en_US'. No Close, Init necessary
     bool ChangeLanguage(const wxString& language);
-    /// check spelling for one word. Return true if the word was found.
+    /// check spelling for one word. Return true if the word was found. Thread safe.
     bool CheckWord(const wxString& word) const;
+    /// check the words of a range styled by the lexer `lexerId`, as returned by wxStyledTextCtrl::GetStyledText().
+    /// Returns the positions of the misspelled words (their middle). Thread safe.
+    std::vector<int> FindMisspelledWords(const std::string& styledText, int startPos, int lexerId) const;
     /// returns an array with suggestions for the misspelled word.
     wxArrayString GetSuggestions(const wxString& misspelled);
     /// makes a spell check for the given plain text. Canceled is set to true when the user cancels.
@@ -189,6 +199,11 @@ protected:
     languageMap m_languageList;    // list with predefined language keys
     SpellCheck* m_pPlugIn;         // pointer to plugin
 
+    // the continuous check runs on a secondary thread: the engine, the dictionaries and the cache are protected by
+    // this mutex
+    mutable std::mutex m_mutex;
+    mutable std::unordered_map<wxString, bool> m_wordCache; // hunspell results of this session
+
     CorrectSpellingDlg* m_pSpellDlg; // pointer to correction dialog
 
     partList m_parseValues; // list with position results for CPP parsing
@@ -0,0 +1,66 @@
+#include "SpellCheckWorker.h"
+
+#include "IHunSpell.h"
+#include "file_logger.h"
+
+SpellCheckWorker::SpellCheckWorker(IHunSpell* engine, const Callback_t& callback)
+    : m_engine(engine)
+    , m_callback(callback)
+{
+    m_thread = std::thread(&SpellCheckWorker::WorkerMain, this);
+}
+
+SpellCheckWorker::~SpellCheckWorker()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_one();
+    m_thread.join();
+}
+
+void SpellCheckWorker::Check(Request&& request)
+{
+    m_busy = true;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_request = std::move(request);
+    }
+    m_cv.notify_one();
+}
+
+void SpellCheckWorker::WorkerMain()
+{
+    while(true) {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stop || m_request.has_value(); });
+            if(m_stop) {
+                return;
+            }
+            request = std::move(*m_request);
+            m_request.reset();
+        }
+
+        Result result;
+        result.ctrl = request.ctrl;
+        result.startPos = request.startPos;
+        result.endPos = request.endPos;
+        result.modificationCount = request.modificationCount;
+        result.misspelled = m_engine->FindMisspelledWords(request.styledText, request.startPos, request.lexerId);
+        LOG_IF_TRACE
+        {
+            clDEBUG1() << "SpellChecker: checked" << (request.endPos - request.startPos) << "bytes,"
+                       << result.misspelled.size() << "misspelled words" << endl;
+        }
+        CallAfter(&SpellCheckWorker::OnResult, result);
+    }
+}
+
+void SpellCheckWorker::OnResult(const Result& result)
+{
+    m_busy = false;
+    m_callback(result);
+}
@@ -0,0 +1,66 @@
+#ifndef SPELLCHECKWORKER_H
+#define SPELLCHECKWORKER_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <wx/event.h>
+
+class IHunSpell;
+class wxStyledTextCtrl;
+
+/// Checks ranges of an editor for the continuous mode on a secondary thread.
+/// Only one range is checked at a time, the results are delivered on the main thread
+class SpellCheckWorker : public wxEvtHandler
+{
+public:
+    struct Request {
+        wxStyledTextCtrl* ctrl = nullptr; // identifies the editor, not accessed by the worker thread
+        int startPos = 0;
+        int endPos = 0;
+        int lexerId = 0;
+        wxUint64 modificationCount = 0; // the results are outdated if the editor was modified in the meantime
+        // the range, as returned by wxStyledTextCtrl::GetStyledText(). A deep copy: the reference count of a
+        // wxMemoryBuffer is not thread safe
+        std::string styledText;
+    };
+
+    struct Result {
+        wxStyledTextCtrl* ctrl = nullptr;
+        int startPos = 0;
+        int endPos = 0;
+        wxUint64 modificationCount = 0;
+        std::vector<int> misspelled; // the middle of each misspelled word
+    };
+
+    using Callback_t = std::function<void(const Result&)>;
+
+    SpellCheckWorker(IHunSpell* engine, const Callback_t& callback);
+    ~SpellCheckWorker() override;
+
+    /// true while a range is being checked
+    bool IsBusy() const { return m_busy; }
+
+    /// check a range. Must not be called while busy
+    void Check(Request&& request);
+
+private:
+    void WorkerMain();
+    void OnResult(const Result& result);
+
+    IHunSpell* m_engine = nullptr;
+    Callback_t m_callback;
+    bool m_busy = false;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::optional<Request> m_request;
+    bool m_stop = false;
+};
+
+#endif // SPELLCHECKWORKER_H
@@ -41,6 +41,7 @@
 #include "ctags_manager.h"
 #include "event_notifier.h"
 #include "globals.h"
+#include "lexer_configuration.h"
 #include "macros.h"
 #include "scGlobals.h"
 #include "workspace.h"
@@ -50,6 +51,7 @@
 #ifndef WX_PRECOMP
 #include <wx/wx.h>
 #endif
+#include <algorithm>
 #include <wx/mstream.h>
 #include <wx/stc/stc.h>
 #include <wx/tokenzr.h>
@@ -73,6 +75,7 @@ const int SPC_SUGGESTION_ID = wxWindow::NewControlId(maxSuggestions);
 const int IDM_SETTINGS = XRCID("spellcheck_settings");
 
 constexpr int PARSE_TIME = 500;
+constexpr size_t MAX_DIRTY_RANGES = 16;
 
 } // namespace
 
@@ -117,7 +120,11 @@ SpellCheck::~SpellCheck()
                      SPC_SUGGESTION_ID + maxSuggestions - 1);
     m_topWin->Unbind(wxEVT_MENU, &SpellCheck::OnAddWord, this, SPC_ADD_WORD);
     m_topWin->Unbind(wxEVT_MENU, &SpellCheck::OnIgnoreWord, this, SPC_IGNORE_WORD);
+    EventNotifier::Get()->Unbind(wxEVT_EDITOR_CLOSING, &SpellCheck::OnEditorClosing, this);
+    EventNotifier::Get()->Unbind(wxEVT_ALL_EDITORS_CLOSING, &SpellCheck::OnEditorClosing, this);
 
+    // the worker thread uses the engine
+    m_worker.reset();
     if(m_pEngine != NULL) {
         SaveSettings();
         wxDELETE(m_pEngine);
@@ -151,6 +158,8 @@ void SpellCheck::Init()
         if(!m_options.GetDictionaryFileName().IsEmpty()) {
             m_pEngine->InitEngine();
         }
+        m_worker.reset(new SpellCheckWorker(
+            m_pEngine, [this](const SpellCheckWorker::Result& result) { OnCheckResult(result); }));
     }
 
     m_timer.Bind(wxEVT_TIMER, &SpellCheck::OnTimer, this);
@@ -162,6 +171,8 @@ void SpellCheck::Init()
                    SPC_SUGGESTION_ID + maxSuggestions - 1);
     m_topWin->Bind(wxEVT_MENU, &SpellCheck::OnAddWord, this, SPC_ADD_WORD);
     m_topWin->Bind(wxEVT_MENU, &SpellCheck::OnIgnoreWord, this, SPC_IGNORE_WORD);
+    EventNotifier::Get()->Bind(wxEVT_EDITOR_CLOSING, &SpellCheck::OnEditorClosing, this);
+    EventNotifier::Get()->Bind(wxEVT_ALL_EDITORS_CLOSING, &SpellCheck::OnEditorClosing, this);
 }
 // ------------------------------------------------------------
 void SpellCheck::CreateToolBar(clToolBarGeneric* toolbar)
@@ -249,6 +260,7 @@ void SpellCheck::UnPlug()
     if(m_timer.IsRunning()) {
         m_timer.Stop();
     }
+    StopTracking();
 }
 
 // ------------------------------------------------------------
@@ -370,13 +382,7 @@ void SpellCheck::OnContinuousCheck(wxCommandEvent& e)
         return;
     }
 
-    IEditor* editor = m_mgr->GetActiveEditor();
-    CHECK_PTR_RET(editor);
-
-    m_pEngine->CheckSpelling();
-    if(!GetCheckContinuous()) {
-        editor->ClearUserIndicators();
-    }
+    CheckActiveEditor();
     m_timer.Start(PARSE_TIME);
 }
 
@@ -388,22 +394,174 @@ void SpellCheck::OnTimer(wxTimerEvent& e)
     if(!pWnd->IsActive()) {
         return;
     }
+    CheckActiveEditor();
+}
 
+// ------------------------------------------------------------
+void SpellCheck::CheckActiveEditor()
+{
     IEditor* editor = m_mgr->GetActiveEditor();
     CHECK_PTR_RET(editor);
+    CHECK_PTR_RET(m_worker);
     CHECK_COND_RET(GetCheckContinuous());
+    CHECK_COND_RET(m_pEngine->InitEngine());
 
-    // Only run the checks if we've not run them or the file is modified.
-    const auto modificationCount(editor->GetModificationCount());
-    if(!m_forceCheck && ((editor == m_pLastEditor) && (m_lastModificationCount == modificationCount))) {
+    // One range at a time: the remaining ranges are checked when the result arrives
+    if(m_worker->IsBusy()) {
         return;
     }
 
-    m_pLastEditor = editor;
-    m_lastModificationCount = modificationCount;
-    m_pLastEditor->ClearUserIndicators();
-    m_pEngine->CheckSpelling();
-    m_forceCheck = false; // consume it
+    wxStyledTextCtrl* ctrl = editor->GetCtrl();
+    if(m_forceCheck || editor != m_pLastEditor || ctrl != m_trackedCtrl) {
+        // Check the whole file, from now on only the modified lines are checked
+        StopTracking();
+        m_pLastEditor = editor;
+        m_trackedCtrl = ctrl;
+        m_trackedCtrl->Bind(wxEVT_STC_MODIFIED, &SpellCheck::OnEditorModified, this);
+        MarkDirty(0, ctrl->GetLineCount() - 1);
+        m_forceCheck = false; // consume it
+    }
+
+    // Only run the checks if the file is modified.
+    if(m_dirtyRanges.empty()) {
+        return;
+    }
+
+    int lastLine = std::min(m_dirtyRanges.front().second, ctrl->GetLineCount() - 1);
+    int firstLine = std::min(m_dirtyRanges.front().first, lastLine);
+    m_dirtyRanges.erase(m_dirtyRanges.begin());
+
+    // Copying the text with its styles is all the work done here, the words are checked by the worker thread
+    SpellCheckWorker::Request request;
+    request.ctrl = ctrl;
+    request.startPos = ctrl->PositionFromLine(firstLine);
+    request.endPos = ctrl->GetLineEndPosition(lastLine);
+    request.lexerId = editor->GetLexerId();
+    request.modificationCount = editor->GetModificationCount();
+    const wxMemoryBuffer styled_text = ctrl->GetStyledText(request.startPos, request.endPos);
+    request.styledText.assign(static_cast<const char*>(styled_text.GetData()), styled_text.GetDataLen());
+    m_worker->Check(std::move(request));
+}
+
+// ------------------------------------------------------------
+void SpellCheck::OnCheckResult(const SpellCheckWorker::Result& result)
+{
+    // The editor may have been switched or closed in the meantime
+    if(!GetCheckContinuous() || !m_pLastEditor || result.ctrl != m_trackedCtrl) {
+        return;
+    }
+
+    wxStyledTextCtrl* ctrl = m_trackedCtrl;
+    if(m_pLastEditor->GetModificationCount() != result.modificationCount) {
+        // The positions are outdated, check these lines again
+        int length = ctrl->GetLength();
+        MarkDirty(ctrl->LineFromPosition(std::min(result.startPos, length)),
+                  ctrl->LineFromPosition(std::min(result.endPos, length)));
+        return;
+    }
+
+    ctrl->SetIndicatorCurrent(INDICATOR_USER);
+    ctrl->IndicatorClearRange(result.startPos, result.endPos - result.startPos);
+    for(int pos : result.misspelled) {
+        int start = ctrl->WordStartPosition(pos, true);
+        int end = ctrl->WordEndPosition(pos, true);
+        m_pLastEditor->SetUserIndicator(start, end - start);
+    }
+
+    // The worker is idle again, move on to the next dirty range instead of waiting for the timer
+    if(!m_dirtyRanges.empty()) {
+        CheckActiveEditor();
+    }
+}
+
+// ------------------------------------------------------------
+void SpellCheck::OnEditorModified(wxStyledTextEvent& e)
+{
+    e.Skip();
+    CHECK_PTR_RET(m_trackedCtrl);
+
+    int type = e.GetModificationType();
+    if(!(type & (wxSTC_MOD_INSERTTEXT | wxSTC_MOD_DELETETEXT | wxSTC_MOD_CHANGESTYLE))) {
+        return;
+    }
+
+    int line = m_trackedCtrl->LineFromPosition(e.GetPosition());
+    int linesAdded = e.GetLinesAdded();
+    if(linesAdded != 0 && !m_dirtyRanges.empty()) {
+        // The dirty lines below the modification moved, deleted lines collapse onto the modified one
+        for(auto& range : m_dirtyRanges) {
+            if(range.first > line) {
+                range.first = std::max(line, range.first + linesAdded);
+            }
+            if(range.second > line) {
+                range.second = std::max(line, range.second + linesAdded);
+            }
+        }
+        MergeDirtyRanges();
+    }
+
+    // A style change (e.g. a comment was opened) may span many lines
+    int lastLine = (type & wxSTC_MOD_CHANGESTYLE) ? m_trackedCtrl->LineFromPosition(e.GetPosition() + e.GetLength())
+                                                  : line + std::max(linesAdded, 0);
+    MarkDirty(line, lastLine);
+}
+
+// ------------------------------------------------------------
+void SpellCheck::MarkDirty(int firstLine, int lastLine)
+{
+    auto where = std::lower_bound(m_dirtyRanges.begin(), m_dirtyRanges.end(), std::make_pair(firstLine, lastLine));
+    m_dirtyRanges.insert(where, { firstLine, lastLine });
+    MergeDirtyRanges();
+}
+
+// ------------------------------------------------------------
+void SpellCheck::MergeDirtyRanges()
+{
+    // Join the overlapping and adjacent ranges, m_dirtyRanges is sorted by the first line
+    std::vector<std::pair<int, int>> merged;
+    merged.reserve(m_dirtyRanges.size());
+    for(const auto& range : m_dirtyRanges) {
+        if(!merged.empty() && range.first <= merged.back().second + 1) {
+            merged.back().second = std::max(merged.back().second, range.second);
+        } else {
+            merged.push_back(range);
+        }
+    }
+
+    // Keep the set small: join the two ranges with the smallest gap between them
+    while(merged.size() > MAX_DIRTY_RANGES) {
+        size_t closest = 0;
+        for(size_t i = 1; i + 1 < merged.size(); ++i) {
+            if(merged[i + 1].first - merged[i].second < merged[closest + 1].first - merged[closest].second) {
+                closest = i;
+            }
+        }
+        merged[closest].second = merged[closest + 1].second;
+        merged.erase(merged.begin() + closest + 1);
+    }
+    m_dirtyRanges.swap(merged);
+}
+
+// ------------------------------------------------------------
+void SpellCheck::StopTracking()
+{
+    if(m_trackedCtrl) {
+        m_trackedCtrl->Unbind(wxEVT_STC_MODIFIED, &SpellCheck::OnEditorModified, this);
+        m_trackedCtrl = nullptr;
+    }
+    m_dirtyRanges.clear();
+}
+
+// ------------------------------------------------------------
+void SpellCheck::OnEditorClosing(wxCommandEvent& e)
+{
+    e.Skip();
+    // The control is about to be destroyed
+    IEditor* editor = reinterpret_cast<IEditor*>(e.GetClientData());
+    if(!editor || editor == m_pLastEditor || editor->GetCtrl() == m_trackedCtrl) {
+        StopTracking();
+        m_pLastEditor = nullptr;
+    }
 }
 
 // ------------------------------------------------------------
@@ -36,13 +36,18 @@
 #ifndef __SpellCheck__
 #define __SpellCheck__
 //------------------------------------------------------------
+#include "SpellCheckWorker.h"
 #include "cl_command_event.h"
 #include "plugin.h"
 #include "spellcheckeroptions.h"
 
+#include <memory>
+#include <utility>
+#include <vector>
 #include <wx/timer.h>
 //------------------------------------------------------------
 class IHunSpell;
+class wxStyledTextEvent;
 class SpellCheck : public IPlugin
 {
 public:
@@ -68,6 +73,8 @@ public:
     void OnTimer(wxTimerEvent& e);
     void OnWspLoaded(clWorkspaceEvent& e);
     void OnWspClosed(clWorkspaceEvent& e);
+    void OnEditorClosing(wxCommandEvent& e);
+    void OnEditorModified(wxStyledTextEvent& e);
     void OnSuggestion(wxCommandEvent& e);
     void OnIgnoreWord(wxCommandEvent& e);
     void OnAddWord(wxCommandEvent& e);
@@ -84,15 +91,24 @@ protected:
     void ClearIndicatorsFromEditors();
     void OnContextMenu(clContextMenuEvent& e);
     void AppendSubMenuItems(wxMenu& subMenu);
+    void CheckActiveEditor();
+    void OnCheckResult(const SpellCheckWorker::Result& result);
+    void MarkDirty(int firstLine, int lastLine);
+    void MergeDirtyRanges();
+    void StopTracking();
 
 protected:
     IHunSpell* m_pEngine;
     wxTimer m_timer;
     wxString m_currentWspPath;
 
-    IEditor* m_pLastEditor;           // The editor checked last time the spell check ran.
-    wxUint64 m_lastModificationCount; // Modification count of the editor last time the spell check ran.
-    bool m_forceCheck = false;        // Force re-check if user added or ignored a word to the list
+    IEditor* m_pLastEditor;    // The editor checked last time the spell check ran.
+    bool m_forceCheck = false; // Force re-check if user added or ignored a word to the list
+
+    // continuous mode: only the lines modified since the last check are checked again, on a secondary thread
+    std::unique_ptr<SpellCheckWorker> m_worker;
+    wxStyledTextCtrl* m_trackedCtrl = nullptr; // the control of m_pLastEditor
+    std::vector<std::pair<int, int>> m_dirtyRanges; // sorted, disjoint [first, last] line ranges
 };
 //------------------------------------------------------------
 #endif // SpellCheck
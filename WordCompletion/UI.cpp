@@ -45,6 +45,9 @@ WordCompletionSettingsBaseDlg::WordCompletionSettingsBaseDlg(wxWindow* parent, w
     m_pgPropComparisonMethod = m_pgMgr->Append(  new wxEnumProperty( _("Comparison Method"), wxPG_LABEL, m_pgMgrArr, m_pgMgrIntArr, 0) );
     m_pgPropComparisonMethod->SetHelpString(_("Select the word completion comparison method:\n\"Starts With\" - suggest all words that starts with the partial word that the user typed\n\"Contains\" - suggest all words that contains the partial word that the user typed"));
     
+    m_pgPropIndexWorkspace = m_pgMgr->Append(  new wxBoolProperty( _("Index Workspace Files"), wxPG_LABEL, 0) );
+    m_pgPropIndexWorkspace->SetHelpString(_("Suggest words from all the workspace files, and not only from the open editors.\nThe workspace files are indexed in the background when the workspace is loaded"));
+    
     m_stdBtnSizer4 = new wxStdDialogButtonSizer();
     
     boxSizer2->Add(m_stdBtnSizer4, 0, wxALL|wxALIGN_CENTER_HORIZONTAL, 5);
@@ -61,6 +61,7 @@ protected:
     wxPropertyGridManager* m_pgMgr;
     wxPGProperty* m_pgPropEnabled;
     wxPGProperty* m_pgPropComparisonMethod;
+    wxPGProperty* m_pgPropIndexWorkspace;
     wxStdDialogButtonSizer* m_stdBtnSizer4;
     wxButton* m_button6;
     wxButton* m_button8;
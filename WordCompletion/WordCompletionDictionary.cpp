@@ -1,7 +1,10 @@
 #include "WordCompletionDictionary.h"
+#include "WordCompletionSettings.h"
 #include "event_notifier.h"
 #include "codelite_events.h"
 #include <algorithm>
+#include "clWorkspaceManager.h"
+#include "file_logger.h"
 #include "globals.h"
 #include "ieditor.h"
 #include "imanager.h"
@@ -12,6 +15,8 @@ WordCompletionDictionary::WordCompletionDictionary()
     EventNotifier::Get()->Bind(wxEVT_ACTIVE_EDITOR_CHANGED, &WordCompletionDictionary::OnEditorChanged, this);
     EventNotifier::Get()->Bind(wxEVT_ALL_EDITORS_CLOSED, &WordCompletionDictionary::OnAllEditorsClosed, this);
     EventNotifier::Get()->Bind(wxEVT_FILE_SAVED, &WordCompletionDictionary::OnFileSaved, this);
+    EventNotifier::Get()->Bind(wxEVT_WORKSPACE_LOADED, &WordCompletionDictionary::OnWorkspaceLoaded, this);
+    EventNotifier::Get()->Bind(wxEVT_WORKSPACE_CLOSED, &WordCompletionDictionary::OnWorkspaceClosed, this);
 
     m_thread = new WordCompletionThread(this);
     m_thread->Start();
@@ -22,11 +27,26 @@ WordCompletionDictionary::~WordCompletionDictionary()
     EventNotifier::Get()->Unbind(wxEVT_ACTIVE_EDITOR_CHANGED, &WordCompletionDictionary::OnEditorChanged, this);
     EventNotifier::Get()->Unbind(wxEVT_ALL_EDITORS_CLOSED, &WordCompletionDictionary::OnAllEditorsClosed, this);
     EventNotifier::Get()->Unbind(wxEVT_FILE_SAVED, &WordCompletionDictionary::OnFileSaved, this);
+    EventNotifier::Get()->Unbind(wxEVT_WORKSPACE_LOADED, &WordCompletionDictionary::OnWorkspaceLoaded, this);
+    EventNotifier::Get()->Unbind(wxEVT_WORKSPACE_CLOSED, &WordCompletionDictionary::OnWorkspaceClosed, this);
+    DoUnbindEditors();
 
     m_thread->Stop();   // Stop the thread
     wxDELETE(m_thread); // Delete it
 }
 
+void WordCompletionDictionary::DoUnbindEditors()
+{
+    // only unbind the editors that are still alive, a destroyed control has already disconnected us
+    IEditor::List_t allEditors;
+    ::clGetManager()->GetAllEditors(allEditors);
+    for (IEditor* editor : allEditors) {
+        editor->GetCtrl()->Unbind(wxEVT_STC_MODIFIED, &WordCompletionDictionary::OnEditorModified, this);
+        editor->GetCtrl()->Unbind(wxEVT_DESTROY, &WordCompletionDictionary::OnEditorDestroyed, this);
+    }
+    m_ctrls.clear();
+}
+
 void WordCompletionDictionary::OnEditorChanged(wxCommandEvent& event)
 {
     event.Skip();
@@ -62,24 +82,114 @@ void WordCompletionDictionary::OnEditorChanged(wxCommandEvent& event)
         m_files.erase(closedEditorName);
     }
 
+    // forget about controls that no longer belong to an open editor
+    std::unordered_map<wxStyledTextCtrl*, wxString> ctrls;
+    for (IEditor* editor : allEditors) {
+        auto iter = m_ctrls.find(editor->GetCtrl());
+        if (iter != m_ctrls.end()) {
+            ctrls.insert(*iter);
+        }
+    }
+    m_ctrls.swap(ctrls);
+
     // 2: cache the active editor
     DoCacheActiveEditor(false);
 }
 
 void WordCompletionDictionary::OnSuggestThread(const WordCompletionThreadReply& reply)
 {
-    // Remove the current file's dictionary
-    std::map<wxString, wxStringSet_t>::iterator iter = m_files.find(reply.filename.GetFullPath());
-    if(iter != m_files.end()) m_files.erase(iter);
+    auto iter = m_files.find(reply.filename.GetFullPath());
+    if (iter == m_files.end()) {
+        // the editor was closed while we were parsing it
+        return;
+    }
+
+    // replay the edits that were made while the index was being built
+    FileIndex& file_index = iter->second;
+    file_index.index = reply.index;
+    for (const auto& [line, linesAdded] : file_index.pendingEdits) {
+        file_index.index->OnLinesChanged(line, linesAdded);
+    }
+    file_index.pendingEdits.clear();
+}
 
-    // Keep the words
-    m_files.insert(std::make_pair(reply.filename.GetFullPath(), reply.suggest));
+void WordCompletionDictionary::OnWorkspaceIndexReady(WordCompletionIndex::Ptr_t index)
+{
+    if (!clWorkspaceManager::Get().IsWorkspaceOpened()) {
+        return;
+    }
+    m_workspaceIndex = index;
 }
 
 void WordCompletionDictionary::OnAllEditorsClosed(wxCommandEvent& event)
 {
     event.Skip();
     m_files.clear();
+    m_ctrls.clear();
+}
+
+void WordCompletionDictionary::OnEditorModified(wxStyledTextEvent& event)
+{
+    event.Skip();
+    if (!(event.GetModificationType() & (wxSTC_MOD_INSERTTEXT | wxSTC_MOD_DELETETEXT))) {
+        return;
+    }
+
+    wxStyledTextCtrl* stc = dynamic_cast<wxStyledTextCtrl*>(event.GetEventObject());
+    CHECK_PTR_RET(stc);
+
+    auto ctrl_iter = m_ctrls.find(stc);
+    if (ctrl_iter == m_ctrls.end()) {
+        return;
+    }
+
+    auto iter = m_files.find(ctrl_iter->second);
+    if (iter == m_files.end()) {
+        return;
+    }
+
+    size_t line = stc->LineFromPosition(event.GetPosition());
+    FileIndex& file_index = iter->second;
+    if (file_index.index) {
+        file_index.index->OnLinesChanged(line, event.GetLinesAdded());
+    } else {
+        file_index.pendingEdits.push_back({ line, event.GetLinesAdded() });
+    }
+}
+
+void WordCompletionDictionary::OnEditorDestroyed(wxWindowDestroyEvent& event)
+{
+    event.Skip();
+    // the control address may be reused by the next editor, forget about it now
+    m_ctrls.erase(static_cast<wxStyledTextCtrl*>(event.GetEventObject()));
+}
+
+void WordCompletionDictionary::OnWorkspaceLoaded(clWorkspaceEvent& event)
+{
+    event.Skip();
+    WordCompletionSettings settings;
+    settings.Load();
+    if (settings.IsEnabled() && settings.IsIndexWorkspace()) {
+        IndexWorkspace();
+    }
+}
+
+void WordCompletionDictionary::OnWorkspaceClosed(clWorkspaceEvent& event)
+{
+    event.Skip();
+    m_workspaceIndex.reset();
+}
+
+void WordCompletionDictionary::IndexWorkspace()
+{
+    if (!clWorkspaceManager::Get().IsWorkspaceOpened()) {
+        return;
+    }
+
+    WordCompletionWorkspaceRequest* req = new WordCompletionWorkspaceRequest;
+    clWorkspaceManager::Get().GetWorkspace()->GetWorkspaceFiles(req->files);
+    clDEBUG() << "Word completion: indexing" << req->files.size() << "workspace files" << endl;
+    m_thread->Add(req);
 }
 
 void WordCompletionDictionary::DoCacheActiveEditor(bool overwrite)
@@ -88,18 +198,23 @@ void WordCompletionDictionary::DoCacheActiveEditor(bool overwrite)
     IEditor* activeEditor = ::clGetManager()->GetActiveEditor();
     CHECK_PTR_RET(activeEditor);
 
-    if(!overwrite && m_files.count(activeEditor->GetFileName().GetFullPath()))
+    wxString fullpath = activeEditor->GetFileName().GetFullPath();
+    if (!overwrite && m_files.count(fullpath))
         return; // we already have this file in the cache
-        
-    m_files.erase(activeEditor->GetFileName().GetFullPath());
-    
-    // Insert a dummy entry, so we won't queue this file if not needed
-    m_files.insert(std::make_pair(activeEditor->GetFileName().GetFullPath(), wxStringSet_t()));
-    
-    // Queue this file
+
+    // Insert an empty entry, so we won't queue this file if not needed
+    // edits made from now on are kept until the index arrives
+    m_files.erase(fullpath);
+    m_files.insert({ fullpath, FileIndex() });
+
     wxStyledTextCtrl* stc = activeEditor->GetCtrl();
-    
-    // Invoke the thread to parse and suggest words for this file
+    if (m_ctrls.count(stc) == 0) {
+        stc->Bind(wxEVT_STC_MODIFIED, &WordCompletionDictionary::OnEditorModified, this);
+        stc->Bind(wxEVT_DESTROY, &WordCompletionDictionary::OnEditorDestroyed, this);
+    }
+    m_ctrls[stc] = fullpath;
+
+    // Invoke the thread to build the index for this file
     WordCompletionThreadRequest* req = new WordCompletionThreadRequest;
     req->buffer = stc->GetText();
     req->filename = activeEditor->GetFileName();
@@ -110,14 +225,78 @@ void WordCompletionDictionary::DoCacheActiveEditor(bool overwrite)
 void WordCompletionDictionary::OnFileSaved(clCommandEvent& event)
 {
     event.Skip();
-    DoCacheActiveEditor(true);
+    // the index is kept up to date while editing, only index files we don't know about
+    DoCacheActiveEditor(false);
 }
 
-wxStringSet_t WordCompletionDictionary::GetWords() const
+wxArrayString WordCompletionDictionary::Query(IEditor* activeEditor, const wxString& filter, bool startsWith)
 {
-    wxStringSet_t words;
-    for (const auto& p : m_files) {
-        words.insert(p.second.begin(), p.second.end());
+    std::unordered_map<wxString, WordCompletionIndex::Match> matches;
+
+    wxString activeFile;
+    if (activeEditor) {
+        activeFile = activeEditor->GetFileName().GetFullPath();
+    }
+
+    bool activeIndexed = false;
+    for (auto& [filepath, file_index] : m_files) {
+        if (!file_index.index) {
+            continue;
+        }
+
+        int caretLine = wxNOT_FOUND;
+        if (filepath == activeFile) {
+            // bring the active editor's index up to date before querying it
+            wxStyledTextCtrl* stc = activeEditor->GetCtrl();
+            file_index.index->Update(stc);
+            caretLine = stc->GetCurrentLine();
+            activeIndexed = true;
+        }
+        file_index.index->Query(filter, startsWith, caretLine, matches);
+    }
+
+    if (activeEditor && !activeIndexed) {
+        // the active editor index is not ready yet, for performance (this is done in the main thread)
+        // only parse the visible area of the document
+        wxStyledTextCtrl* stc = activeEditor->GetCtrl();
+        int startPos = stc->PositionFromLine(stc->GetFirstVisibleLine());
+        int endPos = stc->GetCurrentPos();
+
+        WordCompletionIndex visibleIndex(false);
+        visibleIndex.AddBuffer(stc->GetTextRange(startPos, endPos));
+        visibleIndex.Query(filter, startsWith, wxNOT_FOUND, matches);
+    }
+
+    if (m_workspaceIndex) {
+        m_workspaceIndex->Query(filter, startsWith, wxNOT_FOUND, matches);
+    }
+
+    std::vector<WordCompletionIndex::Match> sorted;
+    sorted.reserve(matches.size());
+    for (auto& [word, match] : matches) {
+        sorted.push_back(std::move(match));
+    }
+
+    // rank: words near the caret first (closest first), then by frequency
+    std::sort(sorted.begin(),
+              sorted.end(),
+              [](const WordCompletionIndex::Match& a, const WordCompletionIndex::Match& b) {
+                  if (a.distance != b.distance) {
+                      if (a.distance == -1 || b.distance == -1) {
+                          return b.distance == -1;
+                      }
+                      return a.distance < b.distance;
+                  }
+                  if (a.frequency != b.frequency) {
+                      return a.frequency > b.frequency;
+                  }
+                  return a.word < b.word;
+              });
+
+    wxArrayString words;
+    words.reserve(sorted.size());
+    for (const auto& match : sorted) {
+        words.Add(match.word);
     }
     return words;
 }
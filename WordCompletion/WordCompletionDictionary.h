@@ -27,24 +27,47 @@
 #define WORDCOMPLETIONDICTIONARY_H
 
 #include "macros.h"
+#include <map>
+#include <unordered_map>
+#include <vector>
 #include <wx/string.h>
 #include <wx/event.h>
+#include "WordCompletionIndex.h"
 #include "WordCompletionThread.h"
 #include "WordCompletionRequestReply.h"
 #include "cl_command_event.h"
+#include "clWorkspaceEvent.hpp"
+
+class IEditor;
+class wxStyledTextCtrl;
+class wxStyledTextEvent;
 
 class WordCompletionDictionary : public wxEvtHandler
 {
-    std::map<wxString, wxStringSet_t> m_files;
+    struct FileIndex {
+        // null while the index is being built by the worker thread
+        WordCompletionIndex::Ptr_t index;
+        // edits received while the index was being built, replayed once it arrives
+        std::vector<std::pair<size_t, int>> pendingEdits;
+    };
+
+    std::map<wxString, FileIndex> m_files;
+    std::unordered_map<wxStyledTextCtrl*, wxString> m_ctrls;
+    WordCompletionIndex::Ptr_t m_workspaceIndex;
     WordCompletionThread* m_thread;
 
 protected:
     void OnEditorChanged(wxCommandEvent& event);
     void OnAllEditorsClosed(wxCommandEvent& event);
     void OnFileSaved(clCommandEvent& event);
+    void OnEditorModified(wxStyledTextEvent& event);
+    void OnEditorDestroyed(wxWindowDestroyEvent& event);
+    void OnWorkspaceLoaded(clWorkspaceEvent& event);
+    void OnWorkspaceClosed(clWorkspaceEvent& event);
 
 private:
     void DoCacheActiveEditor(bool overwrite);
+    void DoUnbindEditors();
 
 public:
     WordCompletionDictionary();
@@ -55,11 +78,22 @@ public:
      * @param reply
      */
     void OnSuggestThread(const WordCompletionThreadReply& reply);
-    
+
+    /**
+     * @brief called by the word completion thread when the workspace index is ready
+     */
+    void OnWorkspaceIndexReady(WordCompletionIndex::Ptr_t index);
+
+    /**
+     * @brief index the files of the current workspace in the background
+     */
+    void IndexWorkspace();
+
     /**
-     * @brief return a set of words from the current editors
+     * @brief return the words matching `filter` from the open editors (and the workspace, if indexed),
+     * ranked by their distance from the caret and then by their frequency
      */
-    wxStringSet_t GetWords() const;
+    wxArrayString Query(IEditor* activeEditor, const wxString& filter, bool startsWith);
 };
 
 #endif // WORDCOMPLETIONDICTIONARY_H
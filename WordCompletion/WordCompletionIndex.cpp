@@ -0,0 +1,352 @@
+#include "WordCompletionIndex.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <wx/stc/stc.h>
+#include <wx/tokenzr.h>
+
+namespace
+{
+const wxChar KEY_SEPARATOR = wxT('\x01');
+
+// words that appear within this number of lines from the caret are ranked by proximity
+constexpr int PROXIMITY_WINDOW = 50;
+
+typedef std::pair<wxString, size_t> WordEntry;
+
+inline bool KeyLess(const WordEntry& entry, const wxString& key) { return entry.first < key; }
+
+inline bool IsDelimiter(wxChar ch)
+{
+    switch (ch) {
+    case '\r':
+    case '\n':
+    case ' ':
+    case '\t':
+    case '.':
+    case '/':
+    case '\\':
+    case '"':
+    case '\'':
+    case '[':
+    case ']':
+    case '(':
+    case ')':
+    case '<':
+    case '>':
+    case '*':
+    case '&':
+    case '^':
+    case '%':
+    case '#':
+    case '!':
+    case '@':
+    case '+':
+    case '=':
+    case ':':
+    case ';':
+    case ',':
+    case '{':
+    case '}':
+    case '|':
+    case '`':
+    case '?':
+        return true;
+    default:
+        return false;
+    }
+}
+} // namespace
+
+WordCompletionIndex::WordCompletionIndex(bool trackLines)
+    : m_trackLines(trackLines)
+{
+}
+
+wxString WordCompletionIndex::MakeKey(const wxString& word)
+{
+    wxString key;
+    key.reserve(word.length() * 2 + 1);
+    key << word.Lower() << KEY_SEPARATOR << word;
+    return key;
+}
+
+wxString WordCompletionIndex::WordFromKey(const wxString& key) { return key.AfterFirst(KEY_SEPARATOR); }
+
+void WordCompletionIndex::Tokenize(const wxString& text, std::vector<wxString>& words)
+{
+    wxString curword;
+    size_t len = text.length();
+    for (size_t i = 0; i < len; ++i) {
+        wxChar ch = text[i];
+        // "->" is a delimiter
+        bool arrow = (ch == '-' && (i + 1) < len && text[i + 1] == '>');
+        if (IsDelimiter(ch) || arrow) {
+            if (!curword.empty()) {
+                words.push_back(curword);
+                curword.clear();
+            }
+            if (arrow) {
+                ++i;
+            }
+            continue;
+        }
+
+        // numbers are only allowed as part of a word
+        if (curword.empty() && wxIsdigit(ch)) {
+            if (ch == '0' && (i + 1) < len && (text[i + 1] == 'x' || text[i + 1] == 'X')) {
+                // hex constant
+                ++i;
+                while ((i + 1) < len && wxIsxdigit(text[i + 1])) {
+                    ++i;
+                }
+                continue;
+            }
+            while ((i + 1) < len && !IsDelimiter(text[i + 1]) && !wxIsalpha(text[i + 1]) && text[i + 1] != '_') {
+                ++i;
+            }
+            continue;
+        }
+        curword << ch;
+    }
+
+    if (!curword.empty()) {
+        words.push_back(curword);
+    }
+}
+
+void WordCompletionIndex::AddWord(const wxString& word, size_t count)
+{
+    wxString key = MakeKey(word);
+    auto iter = std::lower_bound(m_words.begin(), m_words.end(), key, KeyLess);
+    if (iter != m_words.end() && iter->first == key) {
+        iter->second += count;
+    } else {
+        m_words.insert(iter, { key, count });
+    }
+}
+
+void WordCompletionIndex::AddWords(const std::unordered_map<wxString, size_t>& counts)
+{
+    std::vector<WordEntry> added;
+    added.reserve(counts.size());
+    for (const auto& [word, count] : counts) {
+        added.push_back({ MakeKey(word), count });
+    }
+    std::sort(added.begin(), added.end());
+
+    // merge the two sorted lists in one pass instead of inserting the words one by one
+    std::vector<WordEntry> merged;
+    merged.reserve(m_words.size() + added.size());
+    auto iter = m_words.begin();
+    for (auto& entry : added) {
+        while (iter != m_words.end() && iter->first < entry.first) {
+            merged.push_back(std::move(*iter++));
+        }
+        if (iter != m_words.end() && iter->first == entry.first) {
+            entry.second += iter->second;
+            ++iter;
+        }
+        merged.push_back(std::move(entry));
+    }
+    std::move(iter, m_words.end(), std::back_inserter(merged));
+    m_words.swap(merged);
+}
+
+void WordCompletionIndex::RemoveWord(const wxString& word)
+{
+    wxString key = MakeKey(word);
+    auto iter = std::lower_bound(m_words.begin(), m_words.end(), key, KeyLess);
+    if (iter == m_words.end() || iter->first != key) {
+        return;
+    }
+
+    if (iter->second <= 1) {
+        m_words.erase(iter);
+    } else {
+        --iter->second;
+    }
+}
+
+void WordCompletionIndex::SetLineWords(size_t line, std::vector<wxString>&& words)
+{
+    if (line >= m_lines.size()) {
+        m_lines.resize(line + 1);
+    }
+
+    // add before removing, so the words that are still on the line are not erased and inserted again
+    for (const wxString& word : words) {
+        AddWord(word);
+    }
+    for (const wxString& word : m_lines[line]) {
+        RemoveWord(word);
+    }
+    m_lines[line].swap(words);
+}
+
+void WordCompletionIndex::Build(const wxString& buffer)
+{
+    m_words.clear();
+    m_lines.clear();
+    m_dirtyLines.clear();
+
+    if (!m_trackLines) {
+        AddBuffer(buffer);
+        return;
+    }
+
+    wxArrayString lines = ::wxStringTokenize(buffer, "\n", wxTOKEN_RET_EMPTY_ALL);
+    m_lines.resize(lines.size());
+    std::unordered_map<wxString, size_t> counts;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        Tokenize(lines[i], m_lines[i]);
+        for (const wxString& word : m_lines[i]) {
+            counts[word]++;
+        }
+    }
+    AddWords(counts);
+}
+
+void WordCompletionIndex::AddBuffer(const wxString& buffer)
+{
+    std::vector<wxString> words;
+    Tokenize(buffer, words);
+
+    // count locally first, then merge the counts into the sorted index at once
+    std::unordered_map<wxString, size_t> counts;
+    for (const wxString& word : words) {
+        counts[word]++;
+    }
+    AddWords(counts);
+}
+
+void WordCompletionIndex::OnLinesChanged(size_t line, int linesAdded)
+{
+    if (!m_trackLines) {
+        return;
+    }
+
+    if (line >= m_lines.size()) {
+        m_lines.resize(line + 1);
+    }
+
+    if (linesAdded > 0) {
+        // shift the dirty lines that are placed after the insertion point
+        std::set<size_t> dirty;
+        for (size_t dirty_line : m_dirtyLines) {
+            dirty.insert(dirty_line > line ? dirty_line + linesAdded : dirty_line);
+        }
+        m_dirtyLines.swap(dirty);
+
+        m_lines.insert(m_lines.begin() + line + 1, linesAdded, std::vector<wxString>());
+        for (int i = 0; i <= linesAdded; ++i) {
+            m_dirtyLines.insert(line + i);
+        }
+
+    } else if (linesAdded < 0) {
+        // the lines following `line` were removed, remove their words
+        size_t first = line + 1;
+        size_t last = std::min(m_lines.size(), first + static_cast<size_t>(-linesAdded));
+        for (size_t i = first; i < last; ++i) {
+            for (const wxString& word : m_lines[i]) {
+                RemoveWord(word);
+            }
+        }
+        m_lines.erase(m_lines.begin() + first, m_lines.begin() + last);
+
+        std::set<size_t> dirty;
+        for (size_t dirty_line : m_dirtyLines) {
+            if (dirty_line < first) {
+                dirty.insert(dirty_line);
+            } else if (dirty_line >= last) {
+                dirty.insert(dirty_line - (last - first));
+            }
+        }
+        m_dirtyLines.swap(dirty);
+        m_dirtyLines.insert(line);
+
+    } else {
+        m_dirtyLines.insert(line);
+    }
+}
+
+void WordCompletionIndex::Update(wxStyledTextCtrl* stc)
+{
+    if (!m_trackLines || m_dirtyLines.empty()) {
+        return;
+    }
+
+    size_t line_count = static_cast<size_t>(stc->GetLineCount());
+    if (m_lines.size() > line_count) {
+        // should not happen, but keep the index in sync with the editor
+        for (size_t i = line_count; i < m_lines.size(); ++i) {
+            for (const wxString& word : m_lines[i]) {
+                RemoveWord(word);
+            }
+        }
+        m_lines.resize(line_count);
+    }
+
+    for (size_t line : m_dirtyLines) {
+        if (line >= line_count) {
+            continue;
+        }
+        std::vector<wxString> words;
+        Tokenize(stc->GetLine(line), words);
+        SetLineWords(line, std::move(words));
+    }
+    m_dirtyLines.clear();
+}
+
+void WordCompletionIndex::Query(const wxString& filter,
+                                bool startsWith,
+                                int caretLine,
+                                std::unordered_map<wxString, Match>& matches) const
+{
+    wxString lcFilter = filter.Lower();
+    auto add_match = [&](const wxString& key, size_t frequency) {
+        wxString word = WordFromKey(key);
+        if (word == filter) {
+            return;
+        }
+        Match& match = matches[word];
+        match.word = word;
+        match.frequency += frequency;
+    };
+
+    if (startsWith) {
+        // prefix query: all the keys starting with the lower case filter are placed together
+        for (auto iter = std::lower_bound(m_words.begin(), m_words.end(), lcFilter, KeyLess);
+             iter != m_words.end() && iter->first.StartsWith(lcFilter);
+             ++iter) {
+            add_match(iter->first, iter->second);
+        }
+    } else {
+        for (const auto& [key, frequency] : m_words) {
+            if (key.BeforeFirst(KEY_SEPARATOR).Contains(lcFilter)) {
+                add_match(key, frequency);
+            }
+        }
+    }
+
+    if (caretLine == wxNOT_FOUND || !m_trackLines || matches.empty()) {
+        return;
+    }
+
+    // proximity: use the lines around the caret
+    int first_line = std::max(0, caretLine - PROXIMITY_WINDOW);
+    int last_line = std::min(static_cast<int>(m_lines.size()) - 1, caretLine + PROXIMITY_WINDOW);
+    for (int line = first_line; line <= last_line; ++line) {
+        int distance = std::abs(line - caretLine);
+        for (const wxString& word : m_lines[line]) {
+            auto iter = matches.find(word);
+            if (iter == matches.end()) {
+                continue;
+            }
+            if (iter->second.distance == -1 || distance < iter->second.distance) {
+                iter->second.distance = distance;
+            }
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef WORDCOMPLETIONINDEX_H
+#define WORDCOMPLETIONINDEX_H
+
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <wx/string.h>
+
+class wxStyledTextCtrl;
+
+/**
+ * @class WordCompletionIndex
+ * @brief a word frequency index for a single document (or for a set of files).
+ * Words are kept sorted (case insensitive) so completion is a prefix query. When
+ * the index is created with line tracking, it can be updated incrementally from
+ * the editor modification events
+ */
+class WordCompletionIndex
+{
+public:
+    typedef std::shared_ptr<WordCompletionIndex> Ptr_t;
+
+    struct Match {
+        wxString word;
+        size_t frequency = 0;
+        int distance = -1; // distance in lines from the caret, -1 if not near the caret
+    };
+
+private:
+    // sorted by key: "<lower case word>\x01<word>", value: number of occurrences. A flat vector keeps
+    // the prefix queries cache friendly, new words are rare once the index is built
+    std::vector<std::pair<wxString, size_t>> m_words;
+    std::vector<std::vector<wxString>> m_lines;
+    std::set<size_t> m_dirtyLines;
+    bool m_trackLines = true;
+
+private:
+    static wxString MakeKey(const wxString& word);
+    static wxString WordFromKey(const wxString& key);
+    void AddWord(const wxString& word, size_t count = 1);
+    void AddWords(const std::unordered_map<wxString, size_t>& counts);
+    void RemoveWord(const wxString& word);
+    void SetLineWords(size_t line, std::vector<wxString>&& words);
+
+public:
+    WordCompletionIndex(bool trackLines = true);
+    ~WordCompletionIndex() = default;
+
+    /**
+     * @brief split `text` into words, using the same delimiters as the word tokenizer
+     */
+    static void Tokenize(const wxString& text, std::vector<wxString>& words);
+
+    /**
+     * @brief (re)build the index from a buffer
+     */
+    void Build(const wxString& buffer);
+
+    /**
+     * @brief add the words from `buffer` without line tracking (used for the workspace index)
+     */
+    void AddBuffer(const wxString& buffer);
+
+    /**
+     * @brief notify the index about text inserted/deleted at `line`. The affected lines are
+     * marked as dirty and re-tokenized on the next call to `Update()`
+     */
+    void OnLinesChanged(size_t line, int linesAdded);
+
+    /**
+     * @brief re-tokenize the dirty lines from the editor
+     */
+    void Update(wxStyledTextCtrl* stc);
+
+    /**
+     * @brief return the words that match `filter` (case insensitive)
+     * @param startsWith when true, return words starting with filter, otherwise words containing it
+     * @param caretLine when not wxNOT_FOUND, words found near this line get a proximity distance
+     */
+    void Query(const wxString& filter, bool startsWith, int caretLine, std::unordered_map<wxString, Match>& matches) const;
+
+    size_t GetWordsCount() const { return m_words.size(); }
+    bool IsDirty() const { return !m_dirtyLines.empty(); }
+};
+
+#endif // WORDCOMPLETIONINDEX_H
@@ -26,8 +26,11 @@
 #ifndef WordCompletionRequestReply_H__
 #define WordCompletionRequestReply_H__
 
+#include "WordCompletionIndex.h"
 #include "worker_thread.h"
 
+#include <wx/arrstr.h>
+
 struct WordCompletionThreadRequest : public ThreadRequest {
     wxString buffer;
     wxString filter;
@@ -36,10 +39,15 @@ struct WordCompletionThreadRequest : public ThreadRequest {
 };
 
 struct WordCompletionThreadReply {
-    wxStringSet_t suggest;
+    WordCompletionIndex::Ptr_t index;
     wxFileName filename;
     wxString filter;
     bool insertSingleMatch;
 };
 
+/// Build a word index from a list of files (no line tracking)
+struct WordCompletionWorkspaceRequest : public ThreadRequest {
+    wxArrayString files;
+};
+
 #endif
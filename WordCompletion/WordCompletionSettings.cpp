@@ -4,6 +4,7 @@ WordCompletionSettings::WordCompletionSettings()
     : clConfigItem("WordCompletionSettings")
     , m_comparisonMethod(kComparisonStartsWith)
     , m_enabled(true)
+    , m_indexWorkspace(false)
 {
 }
 
@@ -11,6 +12,7 @@ void WordCompletionSettings::FromJSON(const JSONItem& json)
 {
     m_comparisonMethod = json.namedObject("m_comparisonMethod").toInt(m_comparisonMethod);
     m_enabled = json.namedObject("m_enabled").toBool(m_enabled);
+    m_indexWorkspace = json.namedObject("m_indexWorkspace").toBool(m_indexWorkspace);
 }
 
 JSONItem WordCompletionSettings::ToJSON() const
@@ -18,6 +20,7 @@ JSONItem WordCompletionSettings::ToJSON() const
     JSONItem element = JSONItem::createObject(GetName());
     element.addProperty("m_comparisonMethod", m_comparisonMethod);
     element.addProperty("m_enabled", m_enabled);
+    element.addProperty("m_indexWorkspace", m_indexWorkspace);
     return element;
 }
 
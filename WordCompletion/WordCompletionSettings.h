@@ -39,6 +39,7 @@ public:
 private:
     int m_comparisonMethod;
     bool m_enabled;
+    bool m_indexWorkspace;
 
 public:
     WordCompletionSettings();
@@ -53,6 +54,9 @@ public:
 
     void SetEnabled(bool enabled) { this->m_enabled = enabled; }
     bool IsEnabled() const { return m_enabled; }
+
+    void SetIndexWorkspace(bool indexWorkspace) { this->m_indexWorkspace = indexWorkspace; }
+    bool IsIndexWorkspace() const { return m_indexWorkspace; }
     
     WordCompletionSettings& Load();
     WordCompletionSettings& Save();
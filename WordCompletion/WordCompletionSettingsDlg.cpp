@@ -11,6 +11,7 @@ WordCompletionSettingsDlg::WordCompletionSettingsDlg(wxWindow* parent)
     settings.Load();
     m_pgPropComparisonMethod->SetChoiceSelection(settings.GetComparisonMethod());
     m_pgPropEnabled->SetValue(settings.IsEnabled());
+    m_pgPropIndexWorkspace->SetValue(settings.IsIndexWorkspace());
     SetName("WordCompletionSettingsDlg");
     WindowAttrManager::Load(this);
 }
@@ -28,6 +29,7 @@ void WordCompletionSettingsDlg::OnOk(wxCommandEvent& event)
     settings.Load();
     settings.SetComparisonMethod(m_pgPropComparisonMethod->GetChoiceSelection());
     settings.SetEnabled(m_pgPropEnabled->GetValue().GetBool());
+    settings.SetIndexWorkspace(m_pgPropIndexWorkspace->GetValue().GetBool());
     settings.Save();
     EndModal(wxID_OK);
 }
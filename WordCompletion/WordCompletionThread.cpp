@@ -2,12 +2,40 @@
 
 #include "WordCompletionDictionary.h"
 #include "WordCompletionSettings.h"
-#include "WordTokenizerAPI.h"
+#include "clFileContentCache.hpp"
+#include "file_logger.h"
+#include "fileextmanager.h"
+#include "fileutils.h"
 #include "macros.h"
 #include "wordcompletion.h"
 
 #include <wx/strconv.h>
 
+namespace
+{
+// files bigger than this are not added to the workspace index
+constexpr wxULongLong_t MAX_WORKSPACE_FILE_SIZE = 2 * 1024 * 1024;
+
+bool CanIndexFile(const wxString& filepath)
+{
+    switch (FileExtManager::GetTypeFromExtension(filepath)) {
+    case FileExtManager::TypeOther:
+    case FileExtManager::TypeExe:
+    case FileExtManager::TypeArchive:
+    case FileExtManager::TypeZip:
+    case FileExtManager::TypeDll:
+    case FileExtManager::TypeBmp:
+    case FileExtManager::TypeSvg:
+    case FileExtManager::TypeDatabase:
+    case FileExtManager::TypePhar:
+    case FileExtManager::TypeTar:
+        return false;
+    default:
+        return true;
+    }
+}
+} // namespace
+
 WordCompletionThread::WordCompletionThread(WordCompletionDictionary* dict)
     : m_dict(dict)
 {
@@ -15,58 +43,56 @@ WordCompletionThread::WordCompletionThread(WordCompletionDictionary* dict)
 
 void WordCompletionThread::ProcessRequest(ThreadRequest* request)
 {
+    WordCompletionWorkspaceRequest* workspace_req = dynamic_cast<WordCompletionWorkspaceRequest*>(request);
+    if (workspace_req) {
+        ProcessWorkspaceRequest(workspace_req);
+        return;
+    }
+
     WordCompletionThreadRequest* req = dynamic_cast<WordCompletionThreadRequest*>(request);
     CHECK_PTR_RET(req);
 
-    wxStringSet_t suggestions;
-    ParseBuffer(req->buffer, suggestions);
+    WordCompletionIndex::Ptr_t index = std::make_shared<WordCompletionIndex>();
+    index->Build(req->buffer);
 
     // Parse and send back the reply
     WordCompletionThreadReply reply;
     reply.filename = req->filename;
     reply.filter = req->filter;
     reply.insertSingleMatch = req->insertSingleMatch;
-    reply.suggest.swap(suggestions);
+    reply.index = index;
     m_dict->CallAfter(&WordCompletionDictionary::OnSuggestThread, reply);
 }
 
-void WordCompletionThread::ParseBuffer(const wxString& buffer, wxStringSet_t& suggest)
+void WordCompletionThread::ProcessWorkspaceRequest(WordCompletionWorkspaceRequest* request)
 {
-#if 0
-    wxArrayString filteredWords;
-    wxArrayString words = ::wxStringTokenize(buffer, "\r\n \t->./\\'\"[]()<>*&^%#!@+=:,;{}|/", wxTOKEN_STRTOK);
-    for(size_t i=0; i<words.size(); ++i) {
-        if(!wxIsdigit(words.Item(i).at(0))) {
-            filteredWords.Add(words.Item(i));
+    WordCompletionIndex::Ptr_t index = std::make_shared<WordCompletionIndex>(false);
+    size_t files_indexed = 0;
+    for (const wxString& filepath : request->files) {
+        if (TestDestroy()) {
+            return;
         }
-    }
-    suggest.insert(filteredWords.begin(), filteredWords.end());
-#else
-    WordScanner_t scanner = ::WordLexerNew(buffer);
-    if(!scanner)
-        return;
-    WordLexerToken token;
-    std::string curword;
-    while(::WordLexerNext(scanner, token)) {
-        switch(token.type) {
-        case kWordDelim:
-            if(!curword.empty()) {
-                suggest.insert(wxString(curword.c_str(), wxConvUTF8, curword.length()));
-            }
-            curword.clear();
-            break;
 
-        case kWordNumber: {
-            if(!curword.empty()) {
-                curword += token.text;
-            }
-            break;
+        if (!CanIndexFile(filepath)) {
+            continue;
         }
-        default:
-            curword += token.text;
-            break;
+
+        wxFileName fn(filepath);
+        wxULongLong file_size = fn.GetSize();
+        if (file_size == wxInvalidSize || file_size > MAX_WORKSPACE_FILE_SIZE) {
+            continue;
         }
+
+        auto content = clFileContentCache::Get().Read(filepath);
+        if (!content) {
+            continue;
+        }
+        index->AddBuffer(*content);
+        ++files_indexed;
     }
-    ::WordLexerDestroy(&scanner);
-#endif
+
+    clDEBUG() << "Word completion: workspace index ready." << files_indexed << "files," << index->GetWordsCount()
+              << "unique words" << endl;
+    clFileContentCache::Get().LogStats("Word completion:");
+    m_dict->CallAfter(&WordCompletionDictionary::OnWorkspaceIndexReady, index);
 }
@@ -43,11 +43,11 @@ public:
     WordCompletionThread(WordCompletionDictionary* dict);
     ~WordCompletionThread() = default;
     virtual void ProcessRequest(ThreadRequest* request);
-    
+
     /**
-     * @brief parse 'buffer' and return set of words to complete
+     * @brief build a single index from a list of files
      */
-    static void ParseBuffer(const wxString& buffer, wxStringSet_t& suggest);
+    void ProcessWorkspaceRequest(WordCompletionWorkspaceRequest* request);
 };
 
 #endif // WORDCOMPLETIONTHREAD_H
@@ -103,22 +103,10 @@ void WordCompletionPlugin::OnWordComplete(clCodeCompletionEvent& event)
 
     wxString filter = event.GetWord().Lower(); // stc->GetTextRange(start, curPos);
 
-    wxStringSet_t words = m_dictionary->GetWords();
-    // Parse the current buffer (if modified), to include non saved words
-    if(activeEditor->IsEditorModified()) {
-        // For performance (this parsing is done in the main thread)
-        // only parse the visible area of the document
-        wxStringSet_t unsavedBufferWords;
-        wxStyledTextCtrl* stc = activeEditor->GetCtrl();
-        int startPos = stc->PositionFromLine(stc->GetFirstVisibleLine());
-        int endPos = stc->GetCurrentPos();
-
-        wxString buffer = stc->GetTextRange(startPos, endPos);
-        WordCompletionThread::ParseBuffer(buffer, unsavedBufferWords);
-
-        // Merge the results
-        words.insert(unsavedBufferWords.begin(), unsavedBufferWords.end());
-    }
+    // Query the word indexes (the active editor's index is updated incrementally)
+    bool startsWith = settings.GetComparisonMethod() == WordCompletionSettings::kComparisonStartsWith;
+    wxArrayString words = m_dictionary->Query(activeEditor, filter, startsWith);
+    wxStringSet_t uniqueWords{ words.begin(), words.end() };
 
     // Get the editor keywords and add them
     LexerConf::Ptr_t lexer = ColoursAndFontsManager::Get().GetLexerForFile(activeEditor->GetFileName().GetFullName());
@@ -128,28 +116,19 @@ void WordCompletionPlugin::OnWordComplete(clCodeCompletionEvent& event)
             keywords << lexer->GetKeyWords(i) << " ";
         }
         wxArrayString langWords = ::wxStringTokenize(keywords, "\n\t \r", wxTOKEN_STRTOK);
-        words.insert(langWords.begin(), langWords.end());
-    }
-
-    wxStringSet_t filteredSet;
-    if(filter.IsEmpty()) {
-        filteredSet.swap(words);
-    } else {
-        for (const auto& word : words) {
+        langWords.Sort();
+        for (const auto& word : langWords) {
             wxString lcWord = word.Lower();
-            if(settings.GetComparisonMethod() == WordCompletionSettings::kComparisonStartsWith) {
-                if(lcWord.StartsWith(filter) && filter != word) {
-                    filteredSet.insert(word);
-                }
-            } else {
-                if(lcWord.Contains(filter) && filter != word) {
-                    filteredSet.insert(word);
-                }
+            bool match = startsWith ? lcWord.StartsWith(filter) : lcWord.Contains(filter);
+            if(match && filter != word && uniqueWords.insert(word).second) {
+                words.Add(word);
             }
         }
     }
+
     wxCodeCompletionBoxEntry::Vec_t entries;
-    for (const auto& text : filteredSet) {
+    entries.reserve(words.size());
+    for (const auto& text : words) {
         entries.push_back(wxCodeCompletionBoxEntry::New(text, sBmp));
     }
     event.GetEntries().insert(event.GetEntries().end(), entries.begin(), entries.end());
@@ -158,7 +137,13 @@ void WordCompletionPlugin::OnWordComplete(clCodeCompletionEvent& event)
 void WordCompletionPlugin::OnSettings(wxCommandEvent& event)
 {
     WordCompletionSettingsDlg dlg(EventNotifier::Get()->TopFrame());
-    dlg.ShowModal();
+    if(dlg.ShowModal() == wxID_OK) {
+        WordCompletionSettings settings;
+        settings.Load();
+        if(settings.IsEnabled() && settings.IsIndexWorkspace()) {
+            m_dictionary->IndexWorkspace();
+        }
+    }
 }
 
 IEditor* WordCompletionPlugin::GetEditor(const wxString& filepath) const
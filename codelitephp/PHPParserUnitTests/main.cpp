@@ -868,6 +868,35 @@ TEST_FUNC(test_func_arg_in_lambda_in_assignment)
     return true;
 }
 
+TEST_FUNC(test_lookup_cache_invalidation)
+{
+    wxFileName fn("../Tests/test_lookup_cache_invalidation.php");
+    {
+        PHPSourceFile sourceFile("<?php class TestLookupCache { public function foo() {} }", &lookup);
+        sourceFile.SetFilename(fn);
+        sourceFile.Parse();
+        lookup.UpdateSourceFile(sourceFile);
+    }
+
+    PHPEntityBase::Ptr_t cls = lookup.FindClass("\\TestLookupCache");
+    CHECK_BOOL(cls);
+    CHECK_SIZE(lookup.FindChildren(cls->GetDbId()).size(), 1);
+
+    // re-parsing the file must invalidate the cached results
+    {
+        PHPSourceFile sourceFile("<?php class TestLookupCache { public function foo() {} public function bar() {} }",
+                                 &lookup);
+        sourceFile.SetFilename(fn);
+        sourceFile.Parse();
+        lookup.UpdateSourceFile(sourceFile);
+    }
+
+    cls = lookup.FindClass("\\TestLookupCache");
+    CHECK_BOOL(cls);
+    CHECK_SIZE(lookup.FindChildren(cls->GetDbId()).size(), 2);
+    return true;
+}
+
 
 //======================-------------------------------------------------
 // Main
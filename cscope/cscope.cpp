@@ -40,6 +40,7 @@
 #include "procutils.h"
 #include "workspace.h"
 
+#include <memory>
 #include <wx/app.h>
 #include <wx/aui/framemanager.h>
 #include <wx/ffile.h>
@@ -84,6 +85,7 @@ Cscope::Cscope(IManager* manager)
     m_mgr->BookAddPage(PaneId::BOTTOM_BAR, m_cscopeWin, CSCOPE_NAME);
     m_tabHelper.reset(new clTabTogglerHelper(CSCOPE_NAME, m_cscopeWin, "", NULL));
 
+    Connect(wxEVT_CSCOPE_THREAD_RESULTS, wxCommandEventHandler(Cscope::OnCScopeThreadResults), NULL, this);
     Connect(wxEVT_CSCOPE_THREAD_DONE, wxCommandEventHandler(Cscope::OnCScopeThreadEnded), NULL, this);
     Connect(wxEVT_CSCOPE_THREAD_UPDATE_STATUS, wxCommandEventHandler(Cscope::OnCScopeThreadUpdateStatus), NULL, this);
 
@@ -303,9 +305,9 @@ wxString Cscope::DoCreateListFile(bool force)
     if(createFileList) {
         std::vector<wxFileName> files;
         if(clFileSystemWorkspace::Get().IsOpen()) {
-            const std::vector<wxFileName>& all_files = clFileSystemWorkspace::Get().GetFiles();
-            if(!all_files.empty()) {
-                files.reserve(all_files.size());
+            const auto& all_files = clFileSystemWorkspace::Get().GetFiles();
+            if(!all_files.IsEmpty()) {
+                files.reserve(all_files.GetSize());
                 for(wxFileName fn : all_files) {
                     wxString ext = fn.GetExt();
                     if(ext == "exe" || ext == "" || ext == "xpm" || ext == "png") {
@@ -354,7 +356,13 @@ wxString Cscope::DoCreateListFile(bool force)
             wxFileName fn(files.at(i));
             content << fn.GetFullPath(wxPATH_UNIX) << "\n";
         }
-        FileUtils::WriteFileContent(list_file, content, wxConvUTF8);
+
+        // keep the file untouched when the list did not change, so the database is reused as is
+        wxString current;
+        if(!list_file.FileExists() || !FileUtils::ReadFileContent(list_file, current, wxConvUTF8) ||
+           current != content) {
+            FileUtils::WriteFileContent(list_file, content, wxConvUTF8);
+        }
     }
 
     return list_file.GetFullPath();
@@ -362,6 +370,9 @@ wxString Cscope::DoCreateListFile(bool force)
 
 void Cscope::DoCscopeCommand(const wxString& command, const wxString& findWhat, const wxString& endMsg)
 {
+    // stop the running query, if any
+    m_requestId = CScopeThreadST::Get()->NewRequestId();
+
     // We haven't yet found a valid cscope exe, so look for one
     wxString where;
     if(!ExeLocator::Locate(GetCscopeExeName(), where)) {
@@ -393,6 +404,7 @@ void Cscope::DoCscopeCommand(const wxString& command, const wxString& findWhat,
     req->SetEndMsg(endMsg);
     req->SetFindWhat(findWhat);
     req->SetWorkingDir(GetWorkingDirectory());
+    req->SetId(m_requestId);
 
     CScopeThreadST::Get()->Add(req);
 }
@@ -417,7 +429,7 @@ void Cscope::OnFindGlobalDefinition(wxCommandEvent& e)
     // Do the actual search
     wxString command;
     wxString endMsg;
-    command << GetCscopeExeName() << " -d -L -1 " << word << " -i " << list_file;
+    command << GetCscopeExeName() << GetDatabaseOptions(false) << " -L -1 " << word << " -i " << list_file;
     endMsg << _("cscope results for: find global definition of '") << word << "'";
     DoCscopeCommand(command, word, endMsg);
 }
@@ -432,19 +444,10 @@ void Cscope::OnFindFunctionsCalledByThisFunction(wxCommandEvent& e)
     m_cscopeWin->Clear();
     wxString list_file = DoCreateListFile(false);
 
-    // get the rebuild option
-    wxString rebuildOption = "";
-    CScopeConfData settings;
-
-    m_mgr->GetConfigTool()->ReadObject("CscopeSettings", &settings);
-    if(!settings.GetRebuildOption()) {
-        rebuildOption = " -d";
-    }
-
     // Do the actual search
     wxString command;
     wxString endMsg;
-    command << GetCscopeExeName() << rebuildOption << " -L -2 " << word << " -i " << list_file;
+    command << GetCscopeExeName() << GetDatabaseOptions(true) << " -L -2 " << word << " -i " << list_file;
     endMsg << _("cscope results for: functions called by '") << word << "'";
     DoCscopeCommand(command, word, endMsg);
 }
@@ -459,19 +462,10 @@ void Cscope::OnFindFunctionsCallingThisFunction(wxCommandEvent& e)
     m_cscopeWin->Clear();
     wxString list_file = DoCreateListFile(false);
 
-    // get the rebuild option
-    wxString rebuildOption = "";
-    CScopeConfData settings;
-
-    m_mgr->GetConfigTool()->ReadObject("CscopeSettings", &settings);
-    if(!settings.GetRebuildOption()) {
-        rebuildOption = " -d";
-    }
-
     // Do the actual search
     wxString command;
     wxString endMsg;
-    command << GetCscopeExeName() << rebuildOption << " -L -3 " << word << " -i " << list_file;
+    command << GetCscopeExeName() << GetDatabaseOptions(true) << " -L -3 " << word << " -i " << list_file;
     endMsg << _("cscope results for: functions calling '") << word << "'";
     DoCscopeCommand(command, word, endMsg);
 }
@@ -501,19 +495,10 @@ void Cscope::OnFindFilesIncludingThisFname(wxCommandEvent& e)
     m_cscopeWin->Clear();
     wxString list_file = DoCreateListFile(false);
 
-    // get the rebuild option
-    wxString rebuildOption = "";
-    CScopeConfData settings;
-
-    m_mgr->GetConfigTool()->ReadObject("CscopeSettings", &settings);
-    if(!settings.GetRebuildOption()) {
-        rebuildOption = " -d";
-    }
-
     // Do the actual search
     wxString command;
     wxString endMsg;
-    command << GetCscopeExeName() << rebuildOption << " -L -8 " << word << " -i " << list_file;
+    command << GetCscopeExeName() << GetDatabaseOptions(true) << " -L -8 " << word << " -i " << list_file;
     endMsg << _("cscope results for: files that #include '") << word << "'";
     DoCscopeCommand(command, word, endMsg);
 }
@@ -567,6 +552,27 @@ void Cscope::OnDoSettings(wxCommandEvent& e)
     }
 }
 
+wxString Cscope::GetDatabaseOptions(bool allowUpdate) const
+{
+    CScopeConfData settings;
+    m_mgr->GetConfigTool()->ReadObject("CscopeSettings", &settings);
+
+    wxString options;
+    if(allowUpdate && settings.GetRebuildOption()) {
+        // cscope only rebuilds the database if a file changed, keep the inverted index up to date as well
+        if(settings.GetBuildRevertedIndexOption()) {
+            options << " -q";
+        }
+    } else {
+        // use the database as is, with its inverted index if it has one
+        options << " -d";
+        if(settings.GetBuildRevertedIndexOption() && wxFileName(GetWorkingDirectory(), "cscope.in.out").FileExists()) {
+            options << " -q";
+        }
+    }
+    return options;
+}
+
 wxString Cscope::GetCscopeExeName()
 {
     CScopeConfData settings;
@@ -574,10 +580,18 @@ wxString Cscope::GetCscopeExeName()
     return settings.GetCscopeExe();
 }
 
+void Cscope::OnCScopeThreadResults(wxCommandEvent& e)
+{
+    std::unique_ptr<CScopeResultTable_t> result((CScopeResultTable_t*)e.GetClientData());
+    if(e.GetExtraLong() == m_requestId) {
+        m_cscopeWin->AppendResults(*result);
+    }
+}
+
 void Cscope::OnCScopeThreadEnded(wxCommandEvent& e)
 {
-    CScopeResultTable_t* result = (CScopeResultTable_t*)e.GetClientData();
-    m_cscopeWin->BuildTable(result);
+    // the event holds the last batch of results
+    OnCScopeThreadResults(e);
 }
 
 void Cscope::OnCScopeThreadUpdateStatus(wxCommandEvent& e)
@@ -642,19 +656,10 @@ void Cscope::DoFindSymbol(const wxString& word)
     m_cscopeWin->Clear();
     wxString list_file = DoCreateListFile(false);
 
-    // get the rebuild option
-    wxString rebuildOption = "";
-    CScopeConfData settings;
-
-    m_mgr->GetConfigTool()->ReadObject("CscopeSettings", &settings);
-    if(!settings.GetRebuildOption()) {
-        rebuildOption = " -d";
-    }
-
     // Do the actual search
     wxString command;
     wxString endMsg;
-    command << GetCscopeExeName() << rebuildOption << " -L -0 " << word << " -i " << list_file;
+    command << GetCscopeExeName() << GetDatabaseOptions(true) << " -L -0 " << word << " -i " << list_file;
     endMsg << "cscope results for: find C symbol '" << word << "'";
     DoCscopeCommand(command, word, endMsg);
 }
@@ -40,6 +40,7 @@ class Cscope : public IPlugin
     wxEvtHandler* m_topWindow;
     CscopeTab* m_cscopeWin;
     clTabTogglerHelper::Ptr_t m_tabHelper;
+    long m_requestId = 0; // the results of the older requests are ignored
 
 public:
     Cscope(IManager* manager);
@@ -60,6 +61,7 @@ protected:
     wxString DoCreateListFile(bool force);
     void DoCscopeCommand(const wxString& command, const wxString& findWhat, const wxString& endMsg);
     void DoFindSymbol(const wxString& word);
+    wxString GetDatabaseOptions(bool allowUpdate) const;
     wxString GetSearchPattern() const;
     wxString GetWorkingDirectory() const;
     bool IsWorkspaceOpen() const;
@@ -74,6 +76,7 @@ protected:
     void OnFindFilesIncludingThisFname(wxCommandEvent& e);
     void OnCreateDB(wxCommandEvent& e);
     void OnDoSettings(wxCommandEvent& e);
+    void OnCScopeThreadResults(wxCommandEvent& e);
     void OnCScopeThreadEnded(wxCommandEvent& e);
     void OnCScopeThreadUpdateStatus(wxCommandEvent& e);
     void OnCscopeUI(wxUpdateUIEvent& e);
@@ -30,91 +30,133 @@
 #include "file_logger.h"
 #include "procutils.h"
 
+#include <chrono>
 #include <wx/filefn.h>
 
 int wxEVT_CSCOPE_THREAD_DONE = wxNewId();
+int wxEVT_CSCOPE_THREAD_RESULTS = wxNewId();
 int wxEVT_CSCOPE_THREAD_UPDATE_STATUS = wxNewId();
 
+namespace
+{
+// the results are sent to the view in batches, so it fills while cscope is still running
+constexpr size_t MAX_BATCH_SIZE = 5000;
+constexpr auto POST_INTERVAL = std::chrono::milliseconds(100);
+} // namespace
+
 void CscopeDbBuilderThread::ProcessRequest(ThreadRequest* request)
 {
     CscopeRequest* req = (CscopeRequest*)request;
 
+    // a newer query was requested while this one was queued, the database requests are always processed
+    auto is_cancelled = [this, req]() { return !req->GetFindWhat().IsEmpty() && req->GetId() != m_lastRequestId; };
+    if(is_cancelled()) {
+        return;
+    }
+
     // change dir to the workspace directory
     DirSaver ds;
 
     wxSetWorkingDirectory(req->GetWorkingDir());
     SendStatusEvent(_("Executing cscope..."), 10, req->GetFindWhat(), req->GetOwner());
 
-    // notify the database creation process as completed
-    wxArrayString output;
-
     // set environment variables required by cscope
     wxSetEnv(wxT("TMPDIR"), wxFileName::GetTempDir());
     clDEBUG() << "CScope:" << req->GetCmd() << clEndl;
-    ProcUtils::SafeExecuteCommand(req->GetCmd(), output);
-    SendStatusEvent(_("Parsing results..."), 50, wxEmptyString, req->GetOwner());
-    clDEBUG1() << "CScope:\n" << output << clEndl;
-    CScopeResultTable_t* result = ParseResults(output);
+
+    auto start = std::chrono::steady_clock::now();
+    auto lastPost = start;
+    size_t batchSize = 0;
+    size_t count = 0;
+    bool cancelled = false;
+    CScopeResultTable_t* results = new CScopeResultTable_t();
+
+    // parse the output while it is produced
+    ProcUtils::SafeExecuteCommandWithCallback(req->GetCmd(), [&](const wxString& line) -> bool {
+        if(is_cancelled()) {
+            cancelled = true;
+            return true;
+        }
+
+        CscopeEntryData data;
+        if(!ParseLine(line, data)) {
+            return false;
+        }
+
+        // cscope reports the matches file by file
+        if(results->empty() || results->back().first != data.GetFile()) {
+            results->push_back({ data.GetFile(), {} });
+        }
+        results->back().second.push_back(data);
+        ++batchSize;
+        ++count;
+
+        auto now = std::chrono::steady_clock::now();
+        if(batchSize >= MAX_BATCH_SIZE || now - lastPost >= POST_INTERVAL) {
+            SendResults(wxEVT_CSCOPE_THREAD_RESULTS, results, req);
+            results = new CScopeResultTable_t();
+            batchSize = 0;
+            lastPost = now;
+        }
+        return false;
+    });
+
+    if(cancelled) {
+        clDEBUG() << "CScope: query for" << req->GetFindWhat() << "cancelled" << clEndl;
+        wxDELETE(results);
+        return;
+    }
+
+    clDEBUG() << "CScope:" << count << "results in"
+              << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count()
+              << "ms" << clEndl;
     SendStatusEvent(_("Done"), 100, wxEmptyString, req->GetOwner());
 
     // send status message
     SendStatusEvent(req->GetEndMsg(), 100, wxEmptyString, req->GetOwner());
 
-    // send the results
-    wxCommandEvent e(wxEVT_CSCOPE_THREAD_DONE);
-    e.SetClientData(result);
-    req->GetOwner()->AddPendingEvent(e);
+    // send the remaining results
+    SendResults(wxEVT_CSCOPE_THREAD_DONE, results, req);
 }
 
-CScopeResultTable_t* CscopeDbBuilderThread::ParseResults(const wxArrayString& output)
+bool CscopeDbBuilderThread::ParseLine(const wxString& output, CscopeEntryData& data) const
 {
-    CScopeResultTable_t* results = new CScopeResultTable_t();
-    for(size_t i = 0; i < output.GetCount(); i++) {
-        // parse each line
-        wxString line = output.Item(i);
-        CscopeEntryData data;
+    // first is the file name
+    wxString line = output;
+    line = line.Trim().Trim(false);
+    // skip errors
+    if(line.IsEmpty() || line.StartsWith(wxT("cscope:"))) { return false; }
+
+    wxString file = line.BeforeFirst(wxT(' '));
+    data.SetFile(file);
+    line = line.AfterFirst(wxT(' '));
+
+    // next is the scope
+    line = line.Trim().Trim(false);
+    wxString scope = line.BeforeFirst(wxT(' '));
+    line = line.AfterFirst(wxT(' '));
+    data.SetScope(scope);
+
+    // next is the line number
+    line = line.Trim().Trim(false);
+    long nn;
+    wxString line_number = line.BeforeFirst(wxT(' '));
+    line_number.ToLong(&nn);
+    data.SetLine(nn);
+    line = line.AfterFirst(wxT(' '));
+
+    // the rest is the pattern
+    wxString pattern = line;
+    data.SetPattern(pattern);
+    return true;
+}
 
-        // first is the file name
-        line = line.Trim().Trim(false);
-        // skip errors
-        if(line.StartsWith(wxT("cscope:"))) { continue; }
-
-        wxString file = line.BeforeFirst(wxT(' '));
-        data.SetFile(file);
-        line = line.AfterFirst(wxT(' '));
-
-        // next is the scope
-        line = line.Trim().Trim(false);
-        wxString scope = line.BeforeFirst(wxT(' '));
-        line = line.AfterFirst(wxT(' '));
-        data.SetScope(scope);
-
-        // next is the line number
-        line = line.Trim().Trim(false);
-        long nn;
-        wxString line_number = line.BeforeFirst(wxT(' '));
-        line_number.ToLong(&nn);
-        data.SetLine(nn);
-        line = line.AfterFirst(wxT(' '));
-
-        // the rest is the pattern
-        wxString pattern = line;
-        data.SetPattern(pattern);
-
-        // insert the result
-        CScopeResultTable_t::const_iterator iter = results->find(data.GetFile());
-        std::vector<CscopeEntryData>* vec(NULL);
-        if(iter != results->end()) {
-            // this file already exist, append the result
-            vec = iter->second;
-        } else {
-            vec = new std::vector<CscopeEntryData>();
-            // add it to the map
-            (*results)[data.GetFile()] = vec;
-        }
-        vec->push_back(data);
-    }
-    return results;
+void CscopeDbBuilderThread::SendResults(int eventType, CScopeResultTable_t* results, CscopeRequest* req)
+{
+    wxCommandEvent e(eventType);
+    e.SetClientData(results);
+    e.SetExtraLong(req->GetId());
+    req->GetOwner()->AddPendingEvent(e);
 }
 
 void CscopeDbBuilderThread::SendStatusEvent(const wxString& msg, int percent, const wxString& findWhat,
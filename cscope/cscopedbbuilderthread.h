@@ -29,7 +29,8 @@
 #include "singleton.h"
 #include "worker_thread.h"
 
-#include <map>
+#include <atomic>
+#include <utility>
 #include <vector>
 #include <wx/event.h>
 #include <wx/gdicmn.h>
@@ -37,10 +38,12 @@
 #include <wx/thread.h>
 
 extern int wxEVT_CSCOPE_THREAD_DONE;
+extern int wxEVT_CSCOPE_THREAD_RESULTS;
 extern int wxEVT_CSCOPE_THREAD_UPDATE_STATUS;
 
 using CScopeEntryDataVec_t = std::vector<CscopeEntryData>;
-using CScopeResultTable_t = std::map<wxString, CScopeEntryDataVec_t*>;
+// the matches grouped by file, in the order reported by cscope
+using CScopeResultTable_t = std::vector<std::pair<wxString, CScopeEntryDataVec_t>>;
 
 /**
  * \class CscopeRequest
@@ -56,6 +59,7 @@ class CscopeRequest : public ThreadRequest
     wxString m_outfile;
     wxString m_endMsg;
     wxString m_findWhat;
+    long m_id = 0;
 
 public:
     CscopeRequest() = default;
@@ -77,22 +81,33 @@ public:
     const wxString& GetFindWhat() const { return m_findWhat; }
     void SetEndMsg(const wxString& endMsg) { this->m_endMsg = endMsg; }
     const wxString& GetEndMsg() const { return m_endMsg; }
+    void SetId(long id) { this->m_id = id; }
+    long GetId() const { return m_id; }
 };
 
 class CscopeDbBuilderThread : public WorkerThread
 {
     friend class Singleton<CscopeDbBuilderThread>;
 
+    std::atomic_long m_lastRequestId{ 0 };
+
 protected:
     void ProcessRequest(ThreadRequest* req);
-    CScopeResultTable_t* ParseResults(const wxArrayString& output);
+    bool ParseLine(const wxString& line, CscopeEntryData& data) const;
 
 protected:
     void SendStatusEvent(const wxString& msg, int percent, const wxString& findWhat, wxEvtHandler* owner);
+    void SendResults(int eventType, CScopeResultTable_t* results, CscopeRequest* req);
 
 public:
     CscopeDbBuilderThread() = default;
     ~CscopeDbBuilderThread() = default;
+
+    /**
+     * @brief return the id of a new request. The queries (the requests with a "find what") with an older id are
+     * stopped, their results are no longer needed
+     */
+    long NewRequestId() { return ++m_lastRequestId; }
 };
 
 using CScopeThreadST = Singleton<CscopeDbBuilderThread>;
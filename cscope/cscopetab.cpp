@@ -46,7 +46,6 @@
 
 CscopeTab::CscopeTab(wxWindow* parent, IManager* mgr)
     : CscopeTabBase(parent)
-    , m_table(NULL)
     , m_mgr(mgr)
 {
     m_styler = std::make_unique<clFindResultsStyler>(m_stc);
@@ -77,55 +76,45 @@ CscopeTab::~CscopeTab()
 
 void CscopeTab::Clear()
 {
-    FreeTable();
-    m_stc->SetEditable(true);
-    m_stc->ClearAll();
-    m_stc->SetEditable(false);
-    m_matchesInStc.clear();
-}
-
-void CscopeTab::BuildTable(CScopeResultTable_t* table)
-{
-    CHECK_PTR_RET(table);
-    // Free the old table
-    FreeTable();
-
-    m_table = table;
     ClearText();
     m_matchesInStc.clear();
+    m_insertedItems.clear();
+    m_lastFile.clear();
     m_styler->SetStyles(m_stc);
+}
 
-    wxStringSet_t insertedItems;
-    for (const auto& [file, vec] : *m_table) {
-        // Add line for the file
-        AddFile(file);
+void CscopeTab::AppendResults(const CScopeResultTable_t& table)
+{
+    // build the text of the whole batch and append it at once, the STC only draws the visible lines
+    wxString text;
+    int lineno = m_stc->GetLineCount() - 1; // STC line number of the next line
+    for (const auto& [file, vec] : table) {
+        // a batch usually continues the file of the previous one
+        if (file != m_lastFile) {
+            text << file << "\n";
+            ++lineno;
+            m_lastFile = file;
+        }
 
         // Add the entries for this file
-        for (const CscopeEntryData& entry : *vec) {
+        for (const CscopeEntryData& entry : vec) {
             // Don't insert duplicate entries to the match view
             wxString display_string;
-            display_string << _("Line: ") << entry.GetLine() << wxT(", ") << entry.GetScope() << wxT(", ")
+            display_string << file << wxT(":") << entry.GetLine() << wxT(", ") << entry.GetScope() << wxT(", ")
                            << entry.GetPattern();
-            if(insertedItems.count(display_string) == 0) {
-                insertedItems.insert(display_string);
-                int lineno = m_stc->GetLineCount() - 1; // STC line number *before* we add the result
-                AddMatch(entry.GetLine(), entry.GetPattern());
-                m_matchesInStc.insert(std::make_pair(lineno, entry));
+            if(!m_insertedItems.insert(display_string).second) {
+                continue;
             }
+            text << wxString::Format(wxT(" %5d: "), entry.GetLine()) << entry.GetPattern() << "\n";
+            m_matchesInStc.emplace_hint(m_matchesInStc.end(), lineno, entry);
+            ++lineno;
         }
     }
-    FreeTable();
-}
 
-void CscopeTab::FreeTable()
-{
-    if(m_table) {
-        for (auto& [_, vec] : *m_table) {
-            // delete the vector
-            delete vec;
-        }
-        m_table->clear();
-        wxDELETE(m_table);
+    if(!text.IsEmpty()) {
+        m_stc->SetEditable(true);
+        m_stc->AppendText(text);
+        m_stc->SetEditable(false);
     }
 }
 
@@ -187,21 +176,6 @@ void CscopeTab::ClearText()
     m_stc->SetEditable(false);
 }
 
-void CscopeTab::AddMatch(int line, const wxString& pattern)
-{
-    m_stc->SetEditable(true);
-    wxString linenum = wxString::Format(wxT(" %5d: "), line);
-    m_stc->AppendText(linenum + pattern + "\n");
-    m_stc->SetEditable(false);
-}
-
-void CscopeTab::AddFile(const wxString& filename)
-{
-    m_stc->SetEditable(true);
-    m_stc->AppendText(filename + "\n");
-    m_stc->SetEditable(false);
-}
-
 void CscopeTab::OnHotspotClicked(wxStyledTextEvent& e)
 {
     if(!IsWorkspaceOpen()) { return; }
@@ -36,6 +36,7 @@ Subclass of CscopeTabBase, which is generated by wxFormBuilder.
 #include "cscopedbbuilderthread.h"
 #include "bitmap_loader.h"
 #include "clFindResultsStyler.h"
+#include "macros.h"
 
 class IManager;
 class CscopeTabClientData : public wxClientData
@@ -57,16 +58,16 @@ public:
 
 class CscopeTab : public CscopeTabBase
 {
-    CScopeResultTable_t* m_table;
     IManager* m_mgr;
     wxString m_findWhat;
     StringManager m_stringManager;
     wxFont m_font;
     clFindResultsStyler::Ptr_t m_styler;
     std::map<int, CscopeEntryData> m_matchesInStc;
+    wxStringSet_t m_insertedItems; // to skip the duplicate matches
+    wxString m_lastFile;           // the file of the last match added to the view
 
 protected:
-    void FreeTable();
     void OnClearResults(wxCommandEvent& e);
     void OnClearResultsUI(wxUpdateUIEvent& e);
     void OnChangeSearchScope(wxCommandEvent& e);
@@ -75,8 +76,6 @@ protected:
     void OnThemeChanged(wxCommandEvent& e);
     void OnHotspotClicked(wxStyledTextEvent& e);
     void ClearText();
-    void AddMatch(int line, const wxString& pattern);
-    void AddFile(const wxString& filename);
     void CenterEditorLine(int lineno);
     wxString GetWorkingDirectory() const;
     bool IsWorkspaceOpen() const;
@@ -86,7 +85,8 @@ public:
     CscopeTab(wxWindow* parent, IManager* mgr);
     virtual ~CscopeTab();
 
-    void BuildTable(CScopeResultTable_t* table);
+    /// append a batch of results to the view, the results of a query arrive while cscope is still running
+    void AppendResults(const CScopeResultTable_t& table);
     void Clear();
     void SetMessage(const wxString& msg, int percent);
 
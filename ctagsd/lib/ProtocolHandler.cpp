@@ -12,6 +12,7 @@
 #include "Scanner.hpp"
 #include "Settings.hpp"
 #include "SimpleTokenizer.hpp"
+#include "clFileContentCache.hpp"
 #include "clFilesCollector.h"
 #include "cl_calltip.h"
 #include "ctags_manager.h"
@@ -28,6 +29,8 @@
 using LSP::CompletionItem;
 using LSP::eSymbolKind;
 
+std::atomic_size_t ProtocolHandler::ms_tags_generation{ 0 };
+
 namespace
 {
 FileLogger& operator<<(FileLogger& logger, const TagEntry& tag)
@@ -202,6 +205,7 @@ void ProtocolHandler::parse_buffer(const wxFileName& filename, const wxString& b
 
     // Commit whats left
     db->Commit();
+    ms_tags_generation++;
     clDEBUG() << "Success" << endl;
 }
 
@@ -245,6 +249,7 @@ void ProtocolHandler::do_parse_chunk(ITagsStoragePtr db,
 
     // Commit whats left
     db->Commit();
+    ms_tags_generation++;
 }
 
 void ProtocolHandler::parse_files(const std::vector<wxString>& file_list, const CTagsdSettings& settings)
@@ -669,6 +674,8 @@ wxString ProtocolHandler::minimize_buffer(const wxString& filepath,
     // at one point, we can reduce the processing needed by only using the code from
     // current function downward
     CompletionHelper helper;
+    // drop the completer cached analysis if the database was updated since the last request
+    m_completer->set_tags_generation(ms_tags_generation.load());
     m_completer->set_text(wxEmptyString, filepath, line);
 
     wxString truncated_text;
@@ -875,6 +882,7 @@ void ProtocolHandler::on_did_save(std::unique_ptr<JSON>&& msg, Channel::ptr_t ch
 
     // delete the symbols generated from this file
     TagsManagerST::Get()->GetDatabase()->DeleteByFileName({}, filepath, true);
+    ms_tags_generation++;
 
     // re-parse the file
     std::vector<wxString> files;
@@ -1564,6 +1572,7 @@ wxArrayString ProtocolHandler::get_files_to_parse(const wxArrayString& files)
 
     result.Shrink();
     clDEBUG() << "List of files to parse:" << result.size() << endl;
+    clFileContentCache::Get().LogStats("ctagsd:");
     return result;
 }
 
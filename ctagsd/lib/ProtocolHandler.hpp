@@ -11,6 +11,7 @@
 #include "database/istorage.h"
 #include "macros.h"
 
+#include <atomic>
 #include <memory>
 #include <wx/string.h>
 
@@ -47,6 +48,9 @@ private:
     CxxCodeCompletion::ptr_t m_completer;
     ParseThread m_parse_thread;
 
+    // incremented whenever the tags database is updated (by any thread)
+    static std::atomic_size_t ms_tags_generation;
+
 private:
     JSONItem build_result(JSONItem& reply, size_t id, int result_kind);
 
@@ -3,16 +3,17 @@
 #include "Cxx/CxxLexerAPI.h"
 #include "Cxx/CxxScannerTokens.h"
 #include "Cxx/CxxTokenizer.h"
-#include "fileutils.h"
+#include "clFileContentCache.hpp"
 
 void Scanner::scan(const wxFileName& current_file, const wxArrayString& search_path, wxStringSet_t* includes_set,
                    wxStringSet_t* using_ns_set)
 {
-    wxString content;
-    if(!FileUtils::ReadFileContent(current_file, content)) {
+    // headers are scanned again for every translation unit that includes them
+    auto content = clFileContentCache::Get().Read(current_file.GetFullPath());
+    if(!content) {
         return;
     }
-    scan_buffer(current_file, content, search_path, includes_set, using_ns_set);
+    scan_buffer(current_file, *content, search_path, includes_set, using_ns_set);
 }
 
 void Scanner::scan_buffer(const wxFileName& current_file, const wxString& content, const wxArrayString& search_path,
@@ -6,10 +6,13 @@
 #include "Cxx/CxxTokenizer.h"
 #include "Cxx/CxxVariableScanner.h"
 #include "LSPUtils.hpp"
+#include "LineRanges.hpp"
 #include "Settings.hpp"
 #include "SimpleTokenizer.hpp"
 #include "clFilesCollector.h"
+#include "clPathStore.hpp"
 #include "ctags_manager.h"
+#include "database/tag_entry_pool.h"
 #include "database/tags_storage_sqlite3.h"
 #include "fileutils.h"
 #include "macros.h"
@@ -17,6 +20,7 @@
 #include "tester.hpp"
 
 #include <iostream>
+#include <thread>
 #include <wx/init.h>
 #include <wx/log.h>
 #include <wx/wxcrtvararg.h>
@@ -214,6 +218,39 @@ TEST_FUNC(text_cxx_cc_with_problematic_typedef)
     return true;
 }
 
+TEST_FUNC(test_cxx_cc_locals_cache)
+{
+    ENSURE_DB_LOADED();
+
+    wxString filepath;
+    if(is_file_exists("CodeLite/JSON.cpp", &filepath)) {
+        // the text is the current function, up to the cursor
+        const wxString body = "JSONItem item = JSONItem::createObject();\n";
+        completer->set_text(body, filepath, 191);
+        CHECK_NOT_NULL(completer->get_current_function_tag());
+        size_t hits = completer->get_locals_cache_hits();
+
+        // typing on the current line does not re-scan the function
+        completer->set_text(body + "item.", filepath, 191);
+        CHECK_SIZE(completer->get_locals_cache_hits(), hits + 1);
+        auto resolved = completer->code_complete("item.", {}, nullptr);
+        CHECK_NOT_NULL(resolved);
+        CHECK_STRING(resolved->GetPath(), "JSONItem");
+
+        // a variable declared on the current line is visible too
+        completer->set_text(body + "wxString str; str.", filepath, 191);
+        CHECK_SIZE(completer->get_locals_cache_hits(), hits + 2);
+        resolved = completer->code_complete("str.", {}, nullptr);
+        CHECK_NOT_NULL(resolved);
+        CHECK_STRING(resolved->GetPath(), "wxString");
+
+        // modifying the lines above the current line scans the function again
+        completer->set_text(body + "int x = 0;\nitem.", filepath, 191);
+        CHECK_SIZE(completer->get_locals_cache_hits(), hits + 2);
+    }
+    return true;
+}
+
 TEST_FUNC(TestLSPLocation)
 {
     ENSURE_DB_LOADED();
@@ -1512,6 +1549,247 @@ TEST_FUNC(test_cxx_code_completion)
     return true;
 }
 
+TEST_FUNC(test_tag_entry_interned_strings)
+{
+    TagEntry tag1;
+    tag1.SetFile("/usr/include/c++/11/bits/basic_string.h");
+    tag1.SetKind("function ");
+    tag1.SetScope("std::basic_string");
+
+    TagEntry tag2;
+    tag2.SetFile(wxString("/usr/include/c++/11/bits/") + "basic_string.h");
+    tag2.SetKind("function");
+    tag2.SetScope("std::basic_string");
+
+    // equal strings share the same pooled copy
+    CHECK_BOOL(&tag1.GetFile() == &tag2.GetFile());
+    CHECK_BOOL(&tag1.GetKind() == &tag2.GetKind());
+    CHECK_BOOL(&tag1.GetScope() == &tag2.GetScope());
+    CHECK_STRING(tag1.GetKind(), "function");
+    CHECK_BOOL(tag1.IsFunction());
+
+    tag2.SetScope("std::vector");
+    CHECK_STRING(tag1.GetScope(), "std::basic_string");
+    CHECK_STRING(tag2.GetScope(), "std::vector");
+
+    // copies share the pooled strings as well
+    TagEntry tag3 = tag1;
+    CHECK_BOOL(&tag3.GetFile() == &tag1.GetFile());
+    CHECK_BOOL(tag3 == tag1);
+
+    // tags allocated from an arena outlive the arena handle
+    std::vector<TagEntryPtr> tags;
+    {
+        auto arena = TagEntryArena::Create();
+        for (size_t i = 0; i < 100; ++i) {
+            TagEntryPtr tag = arena->Allocate();
+            tag->SetName(wxString() << "name_" << i);
+            tag->SetScope("std::basic_string");
+            tags.push_back(tag);
+        }
+    }
+    CHECK_SIZE(tags.size(), 100);
+    CHECK_STRING(tags[99]->GetName(), "name_99");
+    CHECK_BOOL(&tags[99]->GetScope() == &tag1.GetScope());
+    return true;
+}
+
+TEST_FUNC(test_line_ranges_add)
+{
+    LineRanges ranges;
+    ranges.Add(10, 12);
+    ranges.Add(1, 2);
+    ranges.Add(20, 20);
+    CHECK_SIZE(ranges.GetRanges().size(), 3);
+    CHECK_EXPECTED(ranges.GetRanges()[0], LineRanges::Range(1, 2));
+    CHECK_EXPECTED(ranges.GetRanges()[1], LineRanges::Range(10, 12));
+    CHECK_EXPECTED(ranges.GetRanges()[2], LineRanges::Range(20, 20));
+
+    // overlapping and adjacent ranges are merged
+    ranges.Add(11, 14);
+    ranges.Add(3, 3);
+    CHECK_SIZE(ranges.GetRanges().size(), 3);
+    CHECK_EXPECTED(ranges.GetRanges()[0], LineRanges::Range(1, 3));
+    CHECK_EXPECTED(ranges.GetRanges()[1], LineRanges::Range(10, 14));
+
+    // a reversed range swallowing all the others
+    ranges.Add(25, 1);
+    CHECK_SIZE(ranges.GetRanges().size(), 1);
+    CHECK_EXPECTED(ranges.GetRanges()[0], LineRanges::Range(1, 25));
+
+    // editor lines are 0 based
+    LineRanges from_lines = LineRanges::FromLines({ 4, 0, 5, 6, -1, 9 });
+    CHECK_SIZE(from_lines.GetRanges().size(), 3);
+    CHECK_EXPECTED(from_lines.GetRanges()[0], LineRanges::Range(1, 1));
+    CHECK_EXPECTED(from_lines.GetRanges()[1], LineRanges::Range(5, 7));
+    CHECK_EXPECTED(from_lines.GetRanges()[2], LineRanges::Range(10, 10));
+    return true;
+}
+
+TEST_FUNC(test_line_ranges_from_unified_diff)
+{
+    wxString diff;
+    diff << "diff --git a/main.cpp b/main.cpp\n"
+         << "--- a/main.cpp\n"
+         << "+++ b/main.cpp\n"
+         << "@@ -1,2 +3,4 @@ int main()\n"
+         << "+    return 0;\n"
+         << "@@ -9 +7 @@\n"
+         << "@@ -20,3 +15,0 @@\n"
+         << "@@ -1,1 +0,0 @@\n"
+         << "@@ -30,2 +40,2 @@\n"
+         << "@@ -33 +42 @@\n";
+
+    LineRanges ranges = LineRanges::FromUnifiedDiff(diff);
+    CHECK_SIZE(ranges.GetRanges().size(), 3);
+    // +3,4 and +7 are adjacent
+    CHECK_EXPECTED(ranges.GetRanges()[0], LineRanges::Range(3, 7));
+    // a pure deletion keeps the line before it
+    CHECK_EXPECTED(ranges.GetRanges()[1], LineRanges::Range(15, 15));
+    CHECK_EXPECTED(ranges.GetRanges()[2], LineRanges::Range(40, 42));
+
+    CHECK_BOOL(LineRanges::FromUnifiedDiff("").IsEmpty());
+    CHECK_BOOL(LineRanges::FromUnifiedDiff("@@ -1,1 +0,0 @@").IsEmpty());
+    return true;
+}
+
+TEST_FUNC(test_tag_entry_arena)
+{
+    // tags allocated from an arena intern their strings like the other tags
+    TagEntry heap_tag;
+    heap_tag.SetFile("/usr/include/c++/11/bits/stl_vector.h");
+    heap_tag.SetKind("function");
+    heap_tag.SetScope("std::vector");
+
+    std::vector<TagEntryPtr> tags;
+    {
+        auto arena = TagEntryArena::Create();
+        for (size_t i = 0; i < 1000; ++i) {
+            TagEntryPtr tag = arena->Allocate();
+            tag->SetName(wxString() << "member_" << i);
+            tag->SetFile(wxString("/usr/include/c++/11/bits/") + "stl_vector.h");
+            tag->SetKind("function");
+            tag->SetScope(wxString("std::") + "vector");
+            tags.push_back(tag);
+        }
+        CHECK_BOOL(arena->GetCapacity() >= 1000 * sizeof(TagEntry));
+
+        // a tag changed after it was allocated
+        tags[1]->SetScope("std::deque");
+        tags[1]->SetFile("/usr/include/c++/11/bits/stl_deque.h");
+    }
+
+    // the arena handle is gone, the tags keep its memory alive
+    CHECK_SIZE(tags.size(), 1000);
+    for (size_t i : { 0, 500, 999 }) {
+        CHECK_STRING(tags[i]->GetName(), wxString() << "member_" << i);
+        CHECK_WXSTRING(tags[i]->GetScope(), heap_tag.GetScope());
+        CHECK_BOOL(&tags[i]->GetFile() == &heap_tag.GetFile());
+        CHECK_BOOL(&tags[i]->GetKind() == &heap_tag.GetKind());
+        CHECK_BOOL(&tags[i]->GetScope() == &heap_tag.GetScope());
+    }
+    CHECK_STRING(tags[1]->GetScope(), "std::deque");
+    CHECK_STRING(tags[1]->GetFile(), "/usr/include/c++/11/bits/stl_deque.h");
+    CHECK_BOOL(&tags[1]->GetScope() == &TagStringPool::Intern("std::deque"));
+
+    // the strings interned by another thread are the same pooled copies
+    const wxString* other_thread_scope = nullptr;
+    std::thread thr([&other_thread_scope]() {
+        TagEntry tag;
+        tag.SetScope("std::vector");
+        other_thread_scope = &tag.GetScope();
+    });
+    thr.join();
+    CHECK_BOOL(other_thread_scope == &heap_tag.GetScope());
+    return true;
+}
+
+TEST_FUNC(test_path_store_intern)
+{
+    clPathStore store;
+    CHECK_BOOL(store.IsEmpty());
+
+    auto id_main = store.Add("/home/user/project/src/main.cpp");
+    auto id_utils = store.Add("/home/user/project/src/utils.cpp");
+    auto id_header = store.Add("/home/user/project/include/utils.cpp");
+    CHECK_SIZE(store.GetCount(), 3);
+
+    // ids are given in insertion order
+    CHECK_SIZE(id_main, 0);
+    CHECK_SIZE(id_utils, 1);
+    CHECK_SIZE(id_header, 2);
+
+    // the shared directories and names are stored once
+    size_t memory = store.GetMemoryUsage();
+    for (size_t i = 0; i < 100; ++i) {
+        store.Add("/home/user/project/src/main.cpp");
+        store.Add("/home/user/project/include/utils.cpp");
+    }
+    CHECK_SIZE(store.GetCount(), 3);
+    CHECK_SIZE(store.GetMemoryUsage(), memory);
+
+    store.Clear();
+    CHECK_BOOL(store.IsEmpty());
+    CHECK_BOOL(!store.Contains("/home/user/project/src/main.cpp"));
+    CHECK_SIZE(store.Add("/home/user/project/src/utils.cpp"), 0);
+    return true;
+}
+
+TEST_FUNC(test_path_store_find)
+{
+    clPathStore store;
+    auto id = store.Add("/home/user/project/src/main.cpp");
+    store.Add("/home/user/project/src/utils.cpp");
+
+    CHECK_SIZE(store.Add("/home/user/project/src/main.cpp"), id);
+    CHECK_SIZE(store.Find("/home/user/project/src/main.cpp"), id);
+    CHECK_BOOL(store.Contains("/home/user/project/src/utils.cpp"));
+
+    // a directory, an unknown directory, an unknown name in a known directory and a known name elsewhere
+    CHECK_BOOL(store.Find("/home/user/project/src") == clPathStore::npos);
+    CHECK_BOOL(store.Find("/home/other/project/src/main.cpp") == clPathStore::npos);
+    CHECK_BOOL(store.Find("/home/user/project/src/main.h") == clPathStore::npos);
+    CHECK_BOOL(store.Find("/home/user/project/main.cpp") == clPathStore::npos);
+    CHECK_BOOL(store.Find("main.cpp") == clPathStore::npos);
+    CHECK_SIZE(store.GetCount(), 2);
+    return true;
+}
+
+TEST_FUNC(test_path_store_full_path)
+{
+    std::vector<wxString> paths = { "/home/user/project/src/main.cpp",
+                                    "/home/user/project/src/utils.cpp",
+                                    "/home/user/project/CMakeLists.txt",
+                                    "/usr/include/c++/11/vector",
+                                    "/a.txt",
+                                    "relative/file.txt",
+                                    "file.txt",
+                                    wxString::FromUTF8("/home/user/caf\xc3\xa9/r\xc3\xa9sum\xc3\xa9.txt") };
+
+    clPathStore store;
+    for (const wxString& path : paths) {
+        store.Add(path);
+    }
+    CHECK_SIZE(store.GetCount(), paths.size());
+
+    size_t index = 0;
+    for (auto iter = store.begin(); iter != store.end(); ++iter, ++index) {
+        CHECK_SIZE(iter.GetId(), index);
+        CHECK_WXSTRING(*iter, paths[index]);
+        CHECK_WXSTRING(store.GetFullPath(iter.GetId()), paths[index]);
+    }
+    CHECK_SIZE(index, paths.size());
+
+    CHECK_STRING(store.GetFullName(0), "main.cpp");
+    CHECK_STRING(store.GetPath(0), "/home/user/project/src");
+    CHECK_STRING(store.GetPath(2), "/home/user/project");
+    CHECK_STRING(store.GetFullName(5), "file.txt");
+    CHECK_STRING(store.GetPath(5), "relative");
+    CHECK_STRING(store.GetPath(6), "");
+    CHECK_WXSTRING(store.GetFullName(7), wxString::FromUTF8("r\xc3\xa9sum\xc3\xa9.txt"));
+    return true;
+}
+
 int main(int argc, char** argv)
 {
     wxInitializer initializer(argc, argv);